@@ -1,9 +1,15 @@
 #include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
 #include "ubench.h"
 
 #include "value-types.hh"
 #include "prim-types.hh"
 #include "usdGeom.hh"
+#include "tinyusdz.hh"
+#include "ascii-scan.hh"
+#include "tydra/render-data.hh"
 
 using namespace tinyusdz;
 
@@ -61,8 +67,7 @@ UBENCH(perf, timesamples_double_10M)
   tinyusdz::value::TimeSamples ts;
 
   for (size_t i = 0; i < ns; i++) {
-    ts.times.push_back(double(i));
-    ts.values.push_back(double(i));
+    ts.add_sample(double(i), value::Value(double(i)));
   }
 }
 
@@ -104,6 +109,155 @@ UBENCH(perf, string_vector_10M)
 
 }
 
+// Measure USDA numeric array parsing throughput(input MB/s).
+UBENCH(perf, usda_parse_point3f_array_100K)
+{
+  constexpr size_t npoints = 100 * 1000;
+
+  static std::string src;
+  static bool reported = false;
+  if (src.empty()) {
+    std::stringstream ss;
+    ss << "#usda 1.0\ndef Mesh \"m\" {\n  point3f[] points = [";
+    for (size_t i = 0; i < npoints; i++) {
+      if (i > 0) {
+        ss << ", ";
+      }
+      ss << "(" << float(i) * 0.001f << ", " << -float(i) * 1.5e-3f << ", "
+         << float(i % 97) / 7.0f << ")";
+    }
+    ss << "]\n}\n";
+    src = ss.str();
+  }
+
+  auto s = std::chrono::steady_clock::now();
+
+  Stage stage;
+  std::string warn, err;
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(src.data()),
+                                src.size(), "", &stage, &warn, &err);
+
+  auto e = std::chrono::steady_clock::now();
+  double sec = std::chrono::duration<double>(e - s).count();
+
+  if (!ret) {
+    std::printf("Failed to parse USDA: %s\n", err.c_str());
+  } else if ((sec > 0.0) && !reported) {
+    // ubench runs the body many times, so report throughput only once.
+    reported = true;
+    std::printf("usda_parse_point3f_array: %.1f MB/s\n",
+                double(src.size()) / (1024.0 * 1024.0) / sec);
+  }
+}
+
+// Skip 1MB of blanks: scalar vs vectorized scan.
+static const std::string &BlankBuffer() {
+  static std::string buf = std::string(1024 * 1024, ' ') + "x";
+  return buf;
+}
+
+UBENCH(perf, ascii_skip_blanks_scalar_1M)
+{
+  const std::string &buf = BlankBuffer();
+  size_t n = ascii::scan::SkipCharsScalar(buf.data(), buf.size(),
+                                          ascii::scan::kBlankChars,
+                                          sizeof(ascii::scan::kBlankChars));
+  UBENCH_DO_NOTHING(&n);
+}
+
+UBENCH(perf, ascii_skip_blanks_simd_1M)
+{
+  const std::string &buf = BlankBuffer();
+  size_t n = ascii::scan::SkipBlanks(buf.data(), buf.size());
+  UBENCH_DO_NOTHING(&n);
+}
+
+// Vertex dedup in BuildIndices: std::unordered_map vs open-addressing table.
+// 1M facevarying vertices of 512x512 quads grid(4 face-vertices share a
+// point).
+static const tydra::DefaultVertexInput<tydra::DefaultPackedVertexData> &
+GridVertexInput() {
+  static tydra::DefaultVertexInput<tydra::DefaultPackedVertexData> input;
+  if (input.point_indices.empty()) {
+    constexpr uint32_t n = 512;
+    for (uint32_t y = 0; y < n; y++) {
+      for (uint32_t x = 0; x < n; x++) {
+        const uint32_t quad[4] = {y * (n + 1) + x, y * (n + 1) + x + 1,
+                                  (y + 1) * (n + 1) + x + 1,
+                                  (y + 1) * (n + 1) + x};
+        for (uint32_t k = 0; k < 4; k++) {
+          input.point_indices.push_back(quad[k]);
+          input.normals.push_back({0.0f, 1.0f, 0.0f});
+          input.uv0s.push_back({float(quad[k] % (n + 1)) / float(n),
+                                float(quad[k] / (n + 1)) / float(n)});
+        }
+      }
+    }
+  }
+  return input;
+}
+
+static void BuildGridIndices(bool use_flat_hash_table) {
+  const auto &input = GridVertexInput();
+  tydra::DefaultVertexOutput<tydra::DefaultPackedVertexData> output;
+  std::vector<uint32_t> indices;
+  std::vector<uint32_t> point_indices;
+  tydra::BuildIndices<
+      tydra::DefaultVertexInput<tydra::DefaultPackedVertexData>,
+      tydra::DefaultVertexOutput<tydra::DefaultPackedVertexData>,
+      tydra::DefaultPackedVertexData, tydra::DefaultPackedVertexDataHasher,
+      tydra::DefaultPackedVertexDataEqual>(input, output, indices,
+                                           point_indices, use_flat_hash_table);
+  UBENCH_DO_NOTHING(indices.data());
+}
+
+UBENCH(perf, build_vertex_indices_unordered_map_1M)
+{
+  BuildGridIndices(/* use_flat_hash_table */false);
+}
+
+UBENCH(perf, build_vertex_indices_flat_table_1M)
+{
+  BuildGridIndices(/* use_flat_hash_table */true);
+}
+
+// Sequential(playback) lookup of 100K samples: binary search vs cursor.
+static const TypedTimeSamples<float> &SequentialTimeSamples() {
+  static TypedTimeSamples<float> ts;
+  if (ts.empty()) {
+    for (size_t i = 0; i < 100000; i++) {
+      ts.add_sample(double(i), float(i));
+    }
+  }
+  return ts;
+}
+
+UBENCH(perf, timesamples_sequential_get_100K)
+{
+  const auto &ts = SequentialTimeSamples();
+  float sum = 0.0f;
+  for (size_t i = 0; i < ts.size(); i++) {
+    float v;
+    ts.get(&v, double(i) + 0.5);
+    sum += v;
+  }
+  UBENCH_DO_NOTHING(&sum);
+}
+
+UBENCH(perf, timesamples_sequential_get_cursor_100K)
+{
+  const auto &ts = SequentialTimeSamples();
+  value::TimeSampleCursor cursor;
+  float sum = 0.0f;
+  for (size_t i = 0; i < ts.size(); i++) {
+    float v;
+    ts.get(&v, double(i) + 0.5, value::TimeSampleInterpolationType::Linear,
+           &cursor);
+    sum += v;
+  }
+  UBENCH_DO_NOTHING(&sum);
+}
+
 //int main(int argc, char **argv)
 //{
 //  benchmark_any_type();
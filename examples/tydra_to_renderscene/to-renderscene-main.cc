@@ -35,6 +35,10 @@ int main(int argc, char **argv) {
     std::cout
         << "  --dumpobj: Dump mesh as wavefront .obj(for visual debugging)\n";
     std::cout << "  --dumpusd: Dump scene as USD(USDA Ascii)\n";
+    std::cout << "  --threads N: The number of threads for mesh conversion"
+                 "(default 1. <= 0: use all hardware threads)\n";
+    std::cout << "  --texture-threads N: The number of threads for texture "
+                 "loading(default 1. <= 0: use all hardware threads)\n";
     return EXIT_FAILURE;
   }
 
@@ -48,6 +52,8 @@ int main(int argc, char **argv) {
   bool export_obj = false;
   bool export_usd = false;
   bool no_usdprint = false;
+  int num_threads = 1;
+  int num_texture_load_threads = 1;
 
   std::string filepath;
   for (int i = 1; i < argc; i++) {
@@ -69,6 +75,20 @@ int main(int argc, char **argv) {
       timecode = std::stod(argv[i + 1]);
       std::cout << "Use timecode: " << timecode << "\n";
       i++;
+    } else if (strcmp(argv[i], "--threads") == 0) {
+      if ((i + 1) >= argc) {
+        std::cerr << "arg is missing for --threads flag.\n";
+        return -1;
+      }
+      num_threads = std::stoi(argv[i + 1]);
+      i++;
+    } else if (strcmp(argv[i], "--texture-threads") == 0) {
+      if ((i + 1) >= argc) {
+        std::cerr << "arg is missing for --texture-threads flag.\n";
+        return -1;
+      }
+      num_texture_load_threads = std::stoi(argv[i + 1]);
+      i++;
     } else {
       filepath = argv[i];
     }
@@ -106,6 +126,13 @@ int main(int argc, char **argv) {
               << "\n";
   }
 
+  // Build lookup caches of the Stage, so that Tydra can access the Stage from
+  // multiple threads without a lock.
+  if (!stage.commit()) {
+    std::cerr << "Failed to commit Stage: " << stage.get_error() << "\n";
+    return EXIT_FAILURE;
+  }
+
   // RenderScene: Scene graph object which is suited for GL/Vulkan renderer
   tinyusdz::tydra::RenderScene render_scene;
   tinyusdz::tydra::RenderSceneConverter converter;
@@ -116,6 +143,8 @@ int main(int argc, char **argv) {
   std::cout << "Rebuild vertex indices : " << (build_indices ? "true" : "false")
             << "\n";
   env.mesh_config.build_vertex_indices = build_indices;
+  env.scene_config.num_threads = num_threads;
+  env.scene_config.num_texture_load_threads = num_texture_load_threads;
 
   // Add base directory of .usd file to search path.
   std::string usd_basedir = tinyusdz::io::GetBaseDir(filepath);
@@ -141,11 +141,12 @@ int parseInt(const std::string &s, int *out_result) {
   return 0;  // OK
 }
 
-nonstd::expected<float, std::string> ParseFloat(const std::string &s) {
+nonstd::expected<float, std::string> ParseFloat(const char *begin,
+                                                const char *end) {
 
   // Parse with fast_float
   float result;
-  auto ans = fast_float::from_chars(s.data(), s.data() + s.size(), result);
+  auto ans = fast_float::from_chars(begin, end, result);
   if (ans.ec != std::errc()) {
     // Current `fast_float` implementation does not report detailed parsing err.
     return nonstd::make_unexpected("Parse failed.");
@@ -154,11 +155,12 @@ nonstd::expected<float, std::string> ParseFloat(const std::string &s) {
   return result;
 }
 
-nonstd::expected<double, std::string> ParseDouble(const std::string &s) {
+nonstd::expected<double, std::string> ParseDouble(const char *begin,
+                                                  const char *end) {
 
   // Parse with fast_float
   double result;
-  auto ans = fast_float::from_chars(s.data(), s.data() + s.size(), result);
+  auto ans = fast_float::from_chars(begin, end, result);
   if (ans.ec != std::errc()) {
     // Current `fast_float` implementation does not report detailed parsing err.
     return nonstd::make_unexpected("Parse failed.");
@@ -794,14 +796,13 @@ bool AsciiParser::ReadBasicType(nonstd::optional<bool> *value) {
 }
 
 bool AsciiParser::ReadBasicType(int *value) {
-  std::stringstream ss;
-
   // pxrUSD allow floating-point value to `int` type.
   // so first try fp parsing.
   auto loc = CurrLoc();
-  std::string fp_str;
-  if (LexFloat(&fp_str)) {
-    auto flt = ParseDouble(fp_str);
+  const char *fp_begin{nullptr};
+  const char *fp_end{nullptr};
+  if (LexFloat(&fp_begin, &fp_end)) {
+    auto flt = ParseDouble(fp_begin, fp_end);
     if (!flt) {
       PUSH_ERROR_AND_RETURN("Failed to parse floating value.");
     } else {
@@ -813,6 +814,8 @@ bool AsciiParser::ReadBasicType(int *value) {
   // revert
   SeekTo(loc);
 
+  std::stringstream ss;
+
   // head character
   bool has_sign = false;
   // bool negative = false;
@@ -1648,6 +1651,63 @@ bool AsciiParser::SepBy1BasicType(const char sep, std::vector<T> *result) {
   return true;
 }
 
+template <typename T>
+bool AsciiParser::SepBy1BasicType(const char sep, const size_t max_n,
+                                  T *result, size_t *n) {
+  (*n) = 0;
+
+  if (!SkipWhitespaceAndNewline()) {
+    return false;
+  }
+
+  {
+    T value;
+    if (!ReadBasicType(&value)) {
+      PushError("Not starting with the value of requested type.\n");
+      return false;
+    }
+
+    if ((*n) < max_n) {
+      result[(*n)] = value;
+    }
+    (*n)++;
+  }
+
+  while (!Eof()) {
+    // sep
+    if (!SkipWhitespaceAndNewline()) {
+      return false;
+    }
+
+    char c;
+    if (!Char1(&c)) {
+      return false;
+    }
+
+    if (c != sep) {
+      // end
+      _sr->seek_from_current(-1);  // unwind single char
+      break;
+    }
+
+    if (!SkipWhitespaceAndNewline()) {
+      return false;
+    }
+
+    T value;
+    if (!ReadBasicType(&value)) {
+      break;
+    }
+
+    if ((*n) < max_n) {
+      result[(*n)] = value;
+    }
+    (*n)++;
+  }
+
+  return true;
+}
+
 ///
 /// Parses 1 or more occurences of value with basic type 'T', separated by
 /// `sep`.
@@ -2056,8 +2116,10 @@ bool AsciiParser::ParseBasicTypeTuple(std::array<T, N> *result) {
     return false;
   }
 
-  std::vector<T> values;
-  if (!SepBy1BasicType<T>(',', &values)) {
+  // Parse into `result` directly(no heap allocation).
+  std::array<T, N> values;
+  size_t n{0};
+  if (!SepBy1BasicType<T>(',', N, values.data(), &n)) {
     return false;
   }
 
@@ -2065,17 +2127,15 @@ bool AsciiParser::ParseBasicTypeTuple(std::array<T, N> *result) {
     return false;
   }
 
-  if (values.size() != N) {
+  if (n != N) {
     std::string msg = "The number of tuple elements must be " +
                       std::to_string(N) + ", but got " +
-                      std::to_string(values.size()) + "\n";
+                      std::to_string(n) + "\n";
     PushError(msg);
     return false;
   }
 
-  for (size_t i = 0; i < N; i++) {
-    (*result)[i] = values[i];
-  }
+  (*result) = values;
 
   return true;
 }
@@ -2303,6 +2363,30 @@ bool AsciiParser::ParseBasicTypeArray(std::vector<Path> *result) {
 
 template <typename T>
 bool AsciiParser::MaybeNonFinite(T *out) {
+  // Fast path: Look up the input buffer directly.
+  {
+    uint64_t avail{0};
+    const uint8_t *p = _sr->current(&avail);
+    if (avail >= 4) {
+      if ((p[0] == 'i') && (p[1] == 'n') && (p[2] == 'f')) {
+        (*out) = std::numeric_limits<T>::infinity();
+        return true;
+      }
+
+      if ((p[0] == 'n') && (p[1] == 'a') && (p[2] == 'n')) {
+        (*out) = std::numeric_limits<T>::quiet_NaN();
+        return true;
+      }
+
+      if ((p[0] == '-') && (p[1] == 'i') && (p[2] == 'n') && (p[3] == 'f')) {
+        (*out) = -std::numeric_limits<T>::infinity();
+        return true;
+      }
+
+      return false;
+    }
+  }
+
   auto loc = CurrLoc();
 
   // "-inf", "inf" or "nan"
@@ -2822,12 +2906,13 @@ bool AsciiParser::ReadBasicType(float *value) {
     }
   }
 
-  std::string value_str;
-  if (!LexFloat(&value_str)) {
+  const char *value_begin{nullptr};
+  const char *value_end{nullptr};
+  if (!LexFloat(&value_begin, &value_end)) {
     PUSH_ERROR_AND_RETURN("Failed to lex floating value literal.");
   }
 
-  auto flt = ParseFloat(value_str);
+  auto flt = ParseFloat(value_begin, value_end);
   if (flt) {
     (*value) = flt.value();
   } else {
@@ -2862,12 +2947,13 @@ bool AsciiParser::ReadBasicType(double *value) {
     }
   }
 
-  std::string value_str;
-  if (!LexFloat(&value_str)) {
+  const char *value_begin{nullptr};
+  const char *value_end{nullptr};
+  if (!LexFloat(&value_begin, &value_end)) {
     PUSH_ERROR_AND_RETURN("Failed to lex floating value literal.");
   }
 
-  auto flt = ParseDouble(value_str);
+  auto flt = ParseDouble(value_begin, value_end);
   if (!flt) {
     PUSH_ERROR_AND_RETURN("Failed to parse floating value.");
   } else {
@@ -3295,6 +3381,9 @@ template bool AsciiParser::ParseBasicTypeArray(std::vector<std::string> *result)
 //template bool AsciiParser::ParseBasicTypeArray(std::vector<Path> *result);
 template bool AsciiParser::ParseBasicTypeArray(std::vector<value::AssetPath> *result);
 
+// Used in usdMtlx.cc
+template bool AsciiParser::SepBy1BasicType<float>(const char sep, std::vector<float> *result);
+
 
 }  // namespace ascii
 }  // namespace tinyusdz
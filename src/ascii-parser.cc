@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "ascii-parser.hh"
+#include "ascii-scan.hh"
 #include "path-util.hh"
 #include "str-util.hh"
 #include "tiny-format.hh"
@@ -1185,7 +1186,7 @@ bool AsciiParser::IsSupportedAPISchema(const std::string &ty) {
 }
 
 bool AsciiParser::ReadStringLiteral(std::string *literal) {
-  std::stringstream ss;
+  std::string buf;
 
   char c0;
   if (!Char1(&c0)) {
@@ -1209,7 +1210,24 @@ bool AsciiParser::ReadStringLiteral(std::string *literal) {
 
   bool end_with_quotation{false};
 
+  const char stop_chars[] = {single_quote ? '\'' : '"', '\n', '\r'};
+
   while (!Eof()) {
+    // Copy chars up to the closing quote or newline in bulk.
+    {
+      uint64_t avail;
+      const char *s = reinterpret_cast<const char *>(_sr->current(&avail));
+      size_t k =
+          scan::FindFirstOf(s, size_t(avail), stop_chars, sizeof(stop_chars));
+      if (k > 0) {
+        buf.append(s, k);
+        if (!_sr->seek_from_current(int64_t(k))) {
+          return false;
+        }
+        continue;
+      }
+    }
+
     char c;
     if (!Char1(&c)) {
       // this should not happen.
@@ -1230,7 +1248,7 @@ bool AsciiParser::ReadStringLiteral(std::string *literal) {
       break;
     }
 
-    ss << c;
+    buf += c;
   }
 
   if (!end_with_quotation) {
@@ -1239,7 +1257,7 @@ bool AsciiParser::ReadStringLiteral(std::string *literal) {
                     single_quote ? "'" : "\""));
   }
 
-  (*literal) = ss.str();
+  (*literal) = buf;
 
   _curr_cursor.col += int(literal->size() + 2);  // +2 for quotation chars
 
@@ -1247,7 +1265,7 @@ bool AsciiParser::ReadStringLiteral(std::string *literal) {
 }
 
 bool AsciiParser::MaybeString(value::StringData *str) {
-  std::stringstream ss;
+  std::string buf;
 
   if (!str) {
     return false;
@@ -1272,7 +1290,25 @@ bool AsciiParser::MaybeString(value::StringData *str) {
 
   bool end_with_quotation{false};
 
+  const char stop_chars[] = {c0, '\\', '\n', '\r'};
+
   while (!Eof()) {
+    // Copy plain chars in bulk.
+    {
+      uint64_t avail;
+      const char *s = reinterpret_cast<const char *>(_sr->current(&avail));
+      size_t k =
+          scan::FindFirstOf(s, size_t(avail), stop_chars, sizeof(stop_chars));
+      if (k > 0) {
+        buf.append(s, k);
+        if (!_sr->seek_from_current(int64_t(k))) {
+          SeekTo(loc);
+          return false;
+        }
+        continue;
+      }
+    }
+
     char c;
     if (!Char1(&c)) {
       // this should not happen.
@@ -1293,11 +1329,11 @@ bool AsciiParser::MaybeString(value::StringData *str) {
       }
 
       if (nc == '\'') {
-        ss << "'";
+        buf += '\'';
         _sr->seek_from_current(1);  // advance 1 char
         continue;
       } else if (nc == '"') {
-        ss << "\"";
+        buf += '"';
         _sr->seek_from_current(1);  // advance 1 char
         continue;
       }
@@ -1315,7 +1351,7 @@ bool AsciiParser::MaybeString(value::StringData *str) {
       }
     }
 
-    ss << c;
+    buf += c;
   }
 
   if (!end_with_quotation) {
@@ -1326,8 +1362,8 @@ bool AsciiParser::MaybeString(value::StringData *str) {
   DCOUT("Single quoted string found. col " << start_cursor.col << ", row "
                                            << start_cursor.row);
 
-  size_t displayed_string_len = ss.str().size();
-  str->value = unescapeControlSequence(ss.str());
+  size_t displayed_string_len = buf.size();
+  str->value = unescapeControlSequence(buf);
   str->line_col = start_cursor.col;
   str->line_row = start_cursor.row;
   str->is_triple_quoted = false;
@@ -1510,7 +1546,7 @@ bool AsciiParser::ReadPrimAttrIdentifier(std::string *token) {
   // - xformOp:transform
   // - primvars:uvmap1
 
-  std::stringstream ss;
+  std::string tok;
 
   while (!Eof()) {
     char c;
@@ -1523,17 +1559,17 @@ bool AsciiParser::ReadPrimAttrIdentifier(std::string *token) {
       // ok
     } else if (c == ':') {  // namespace
       // ':' must lie in the middle of string literal
-      if (ss.str().size() == 0) {
+      if (tok.empty()) {
         PUSH_ERROR_AND_RETURN("PrimAttr name must not starts with `:`");
       }
     } else if (c == '.') {  // delimiter for `connect`
       // '.' must lie in the middle of string literal
-      if (ss.str().size() == 0) {
+      if (tok.empty()) {
         PUSH_ERROR_AND_RETURN("PrimAttr name must not starts with `.`");
       }
     } else if (std::isalnum(int(c))) {
       // number must not be allowed for the first char.
-      if (ss.str().size() == 0) {
+      if (tok.empty()) {
         if (!std::isalpha(int(c))) {
           PUSH_ERROR_AND_RETURN("PrimAttr name must not starts with number.");
         }
@@ -1545,26 +1581,24 @@ bool AsciiParser::ReadPrimAttrIdentifier(std::string *token) {
 
     _curr_cursor.col++;
 
-    ss << c;
+    tok += c;
   }
 
   {
     std::string name_err;
-    if (!pathutil::ValidatePropPath(Path("", ss.str()), &name_err)) {
+    if (!pathutil::ValidatePropPath(Path("", tok), &name_err)) {
       PUSH_ERROR_AND_RETURN_TAG(
           kAscii,
-          fmt::format("Invalid Property name `{}`: {}", ss.str(), name_err));
+          fmt::format("Invalid Property name `{}`: {}", tok, name_err));
     }
   }
 
   // '.' must lie in the middle of string literal
-  if (ss.str().back() == '.') {
+  if (tok.back() == '.') {
     PUSH_ERROR_AND_RETURN("PrimAttr name must not ends with `.`\n");
     return false;
   }
 
-  std::string tok = ss.str();
-
   if (contains(tok, '.')) {
     if (endsWith(tok, ".connect") || endsWith(tok, ".timeSamples")) {
       // OK
@@ -1584,14 +1618,14 @@ bool AsciiParser::ReadPrimAttrIdentifier(std::string *token) {
     }
   }
 
-  (*token) = ss.str();
+  (*token) = tok;
   DCOUT("primAttr identifier = " << (*token));
   return true;
 }
 
 bool AsciiParser::ReadIdentifier(std::string *token) {
   // identifier = (`_` | [a-zA-Z]) (`_` | [a-zA-Z0-9]+)
-  std::stringstream ss;
+  std::string tok;
 
   // The first character.
   {
@@ -1611,10 +1645,25 @@ bool AsciiParser::ReadIdentifier(std::string *token) {
     }
     _curr_cursor.col++;
 
-    ss << c;
+    tok += c;
   }
 
   while (!Eof()) {
+    // Read identifier chars in bulk.
+    {
+      uint64_t avail;
+      const char *s = reinterpret_cast<const char *>(_sr->current(&avail));
+      size_t k = scan::SkipIdentifierChars(s, size_t(avail));
+      if (k > 0) {
+        tok.append(s, k);
+        if (!_sr->seek_from_current(int64_t(k))) {
+          return false;
+        }
+        _curr_cursor.col += int(k);
+        continue;
+      }
+    }
+
     char c;
     if (!Char1(&c)) {
       // this should not happen.
@@ -1630,10 +1679,10 @@ bool AsciiParser::ReadIdentifier(std::string *token) {
 
     _curr_cursor.col++;
 
-    ss << c;
+    tok += c;
   }
 
-  (*token) = ss.str();
+  (*token) = std::move(tok);
   return true;
 }
 
@@ -1727,6 +1776,19 @@ bool AsciiParser::ReadUntilNewline(std::string *str) {
 
 bool AsciiParser::SkipUntilNewline() {
   while (!Eof()) {
+    // Skip comment text in bulk.
+    {
+      uint64_t avail;
+      const char *s = reinterpret_cast<const char *>(_sr->current(&avail));
+      size_t k = scan::FindNewline(s, size_t(avail));
+      if (k > 0) {
+        if (!_sr->seek_from_current(int64_t(k))) {
+          return false;
+        }
+        continue;
+      }
+    }
+
     char c;
     if (!Char1(&c)) {
       // this should not happen.
@@ -2115,6 +2177,24 @@ bool AsciiParser::PopParserState(ParseState *state) {
 }
 
 bool AsciiParser::SkipWhitespace() {
+  {
+    uint64_t avail;
+    const char *s = reinterpret_cast<const char *>(_sr->current(&avail));
+    size_t k = scan::SkipBlanks(s, size_t(avail));
+    if (k > 0) {
+      if (!_sr->seek_from_current(int64_t(k))) {
+        return false;
+      }
+      _curr_cursor.col += int(k);
+    }
+    if (k < avail) {
+      // Stopped at non-whitespace char.
+      return true;
+    }
+    // Reached the end of the buffer. Continue with the code below to handle
+    // EOF or the next chunk.
+  }
+
   while (!Eof()) {
     char c;
     if (!Char1(&c)) {
@@ -2139,9 +2219,29 @@ bool AsciiParser::SkipWhitespace() {
   return true;
 }
 
+bool AsciiParser::SkipBlankRun(const bool allow_semicolon) {
+  uint64_t avail;
+  const char *s = reinterpret_cast<const char *>(_sr->current(&avail));
+  size_t k = scan::SkipBlanks(s, size_t(avail), allow_semicolon);
+  if (k == 0) {
+    return false;
+  }
+
+  if (!_sr->seek_from_current(int64_t(k))) {
+    return false;
+  }
+  _curr_cursor.col += int(k);
+
+  return true;
+}
+
 bool AsciiParser::SkipWhitespaceAndNewline(const bool allow_semicolon) {
   // USDA also allow C-style ';' as a newline separator.
   while (!Eof()) {
+    if (SkipBlankRun(allow_semicolon)) {
+      continue;
+    }
+
     char c;
     if (!Char1(&c)) {
       // this should not happen.
@@ -2198,6 +2298,10 @@ bool AsciiParser::SkipCommentAndWhitespaceAndNewline(
     const bool allow_semicolon) {
   // Skip multiple line of comments.
   while (!Eof()) {
+    if (SkipBlankRun(allow_semicolon)) {
+      continue;
+    }
+
     char c;
     if (!Char1(&c)) {
       // this should not happen.
@@ -2791,6 +2895,234 @@ bool AsciiParser::ParseMetaValue(const VariableDef &def, MetaVariable *outvar) {
   return true;
 }
 
+namespace {
+
+enum class LexFloatResult {
+  Ok,
+  Fail,      // Reached end of input.
+  NeedMore,  // Reached end of the accessible bytes(chunked input).
+  ErrSign,
+  ErrEmptyExp,
+  ErrMultipleExpSign
+};
+
+//
+// Lex FLOATVAL in [begin, end) without allocation.
+// Accepts exactly the same input as `AsciiParser::LexFloat(std::string *)`.
+//
+// `is_last` : true when `end` is the end of the input.
+// `consumed_end` : Location after the consumed characters.
+// `literal_end` : End of the literal(can be before `consumed_end`).
+// `col` : Column advance.
+//
+LexFloatResult LexFloatLiteral(const char *begin, const char *end,
+                               const bool is_last, const char **consumed_end,
+                               const char **literal_end, int *col) {
+  const char *p = begin;
+
+  // Char1()
+#define LEX_CHAR1(__c)                                                 \
+  do {                                                                 \
+    if (p == end) {                                                    \
+      (*consumed_end) = p;                                             \
+      return is_last ? LexFloatResult::Fail : LexFloatResult::NeedMore; \
+    }                                                                  \
+    __c = *p++;                                                        \
+  } while (0)
+
+  // Eof()
+  auto eof = [&](bool *need_more) {
+    if (p == end) {
+      (*need_more) = !is_last;
+      return true;
+    }
+    return (*p == '\0');
+  };
+
+#define LEX_IF_EOF                               \
+  bool need_more{false};                         \
+  bool at_eof = eof(&need_more);                 \
+  if (need_more) {                               \
+    return LexFloatResult::NeedMore;             \
+  }                                              \
+  if (at_eof)
+
+  auto is_digit = [](char c) { return (c >= '0') && (c <= '9'); };
+
+  (*col) = 0;
+
+  bool leading_decimal_dots{false};
+  {
+    char sc;
+    LEX_CHAR1(sc);
+    (*col)++;
+
+    if ((sc == '+') || (sc == '-')) {
+      char c;
+      LEX_CHAR1(c);
+
+      if (c == '.') {
+        leading_decimal_dots = true;
+        (*col)++;
+      } else {
+        p--;
+      }
+    } else if (is_digit(sc)) {
+      // ok
+    } else if (sc == '.') {
+      leading_decimal_dots = true;
+      p--;
+      (*col)--;
+    } else {
+      (*consumed_end) = p;
+      return LexFloatResult::ErrSign;
+    }
+  }
+
+  // 1. Read the integer part
+  char curr;
+  if (!leading_decimal_dots) {
+    while (true) {
+      {
+        LEX_IF_EOF { break; }
+      }
+      LEX_CHAR1(curr);
+      if (!is_digit(curr)) {
+        p--;
+        break;
+      }
+    }
+  }
+
+  {
+    LEX_IF_EOF {
+      (*consumed_end) = p;
+      (*literal_end) = p;
+      return LexFloatResult::Ok;
+    }
+  }
+
+  LEX_CHAR1(curr);
+
+  // 2. Read the decimal part
+  const char *lit_end = p;
+  if (curr == '.') {
+    lit_end = p;
+    while (true) {
+      {
+        LEX_IF_EOF { break; }
+      }
+      LEX_CHAR1(curr);
+      if (!is_digit(curr)) {
+        break;  // `curr` is consumed but not a part of the literal.
+      }
+      lit_end = p;
+    }
+  } else if ((curr == 'e') || (curr == 'E')) {
+    // go to 3.
+    lit_end = p - 1;
+  } else {
+    p--;
+    (*consumed_end) = p;
+    (*literal_end) = p;
+    return LexFloatResult::Ok;
+  }
+
+  {
+    LEX_IF_EOF {
+      (*consumed_end) = p;
+      (*literal_end) = lit_end;
+      return LexFloatResult::Ok;
+    }
+  }
+
+  // 3. Read the exponent part
+  bool has_exp_sign{false};
+  if ((curr == 'e') || (curr == 'E')) {
+    LEX_CHAR1(curr);
+
+    if ((curr == '+') || (curr == '-')) {
+      has_exp_sign = true;
+    } else if (is_digit(curr)) {
+      // ok
+    } else {
+      (*consumed_end) = p;
+      return LexFloatResult::ErrEmptyExp;
+    }
+
+    while (true) {
+      {
+        LEX_IF_EOF { break; }
+      }
+      LEX_CHAR1(curr);
+
+      if (is_digit(curr)) {
+        // ok
+      } else if ((curr == '+') || (curr == '-')) {
+        if (has_exp_sign) {
+          (*consumed_end) = p;
+          return LexFloatResult::ErrMultipleExpSign;
+        }
+        has_exp_sign = true;
+      } else {
+        p--;
+        break;
+      }
+    }
+  } else {
+    p--;
+  }
+
+#undef LEX_IF_EOF
+#undef LEX_CHAR1
+
+  (*consumed_end) = p;
+  (*literal_end) = p;
+  return LexFloatResult::Ok;
+}
+
+}  // namespace
+
+bool AsciiParser::LexFloat(const char **literal_begin,
+                           const char **literal_end) {
+  uint64_t avail{0};
+  const char *p = reinterpret_cast<const char *>(_sr->current(&avail));
+  const bool is_last = (_sr->tell() + avail) >= _sr->size();
+
+  const char *consumed_end{p};
+  const char *lit_end{p};
+  int col{0};
+  LexFloatResult ret =
+      LexFloatLiteral(p, p + avail, is_last, &consumed_end, &lit_end, &col);
+
+  if (ret == LexFloatResult::NeedMore) {
+    // The literal crosses the end of the chunk. Use the slow path.
+    if (!LexFloat(&_lex_buf)) {
+      return false;
+    }
+    (*literal_begin) = _lex_buf.data();
+    (*literal_end) = _lex_buf.data() + _lex_buf.size();
+    return true;
+  }
+
+  _sr->seek_from_current(int64_t(consumed_end - p));
+  _curr_cursor.col += col;
+
+  if (ret == LexFloatResult::Ok) {
+    (*literal_begin) = p;
+    (*literal_end) = lit_end;
+    return true;
+  } else if (ret == LexFloatResult::ErrSign) {
+    PUSH_ERROR_AND_RETURN("Sign or `.` or 0-9 expected.");
+  } else if (ret == LexFloatResult::ErrEmptyExp) {
+    PUSH_ERROR_AND_RETURN("Empty `E' is not allowed.");
+  } else if (ret == LexFloatResult::ErrMultipleExpSign) {
+    PUSH_ERROR_AND_RETURN("No multiple exponential sign characters.");
+  }
+
+  return false;
+}
+
 bool AsciiParser::LexFloat(std::string *result) {
   // FLOATVAL : ('+' or '-')? FLOAT
   // FLOAT
@@ -5094,13 +5426,27 @@ bool AsciiParser::ParseBlock(const Specifier spec, const int64_t primIdx,
 /// Parser entry point
 /// TODO: Refactor and use unified code path regardless of LoadState.
 ///
-bool AsciiParser::Parse(const uint32_t load_states,
-                        const AsciiParserOption &parser_option) {
+void AsciiParser::SetLoadStates(const uint32_t load_states,
+                                const AsciiParserOption &parser_option) {
   _toplevel = (load_states & static_cast<uint32_t>(LoadState::Toplevel));
   _sub_layered = (load_states & static_cast<uint32_t>(LoadState::Sublayer));
   _referenced = (load_states & static_cast<uint32_t>(LoadState::Reference));
   _payloaded = (load_states & static_cast<uint32_t>(LoadState::Payload));
   _option = parser_option;
+}
+
+bool AsciiParser::Parse(const uint32_t load_states,
+                        const AsciiParserOption &parser_option) {
+  if (!ParseHeader(load_states, parser_option)) {
+    return false;
+  }
+
+  return ParseToplevelBlocks(_sr->size());
+}
+
+bool AsciiParser::ParseHeader(const uint32_t load_states,
+                              const AsciiParserOption &parser_option) {
+  SetLoadStates(load_states, parser_option);
 
   bool header_ok = ParseMagicHeader();
   if (!header_ok) {
@@ -5139,15 +5485,196 @@ bool AsciiParser::Parse(const uint32_t load_states,
     PUSH_WARN("Stage metadata processing callback is not set.");
   }
 
+  return true;
+}
+
+bool AsciiParser::ScanToplevelBlocks(std::vector<BlockRange> *ranges) {
+  if (!ranges) {
+    return false;
+  }
+
+  if (_sr->is_chunked()) {
+    return false;
+  }
+
+  const char *data = reinterpret_cast<const char *>(_sr->data());
+  const uint64_t n = _sr->size();
+  uint64_t i = _sr->tell();
+  int row = _curr_cursor.row;
+
+  auto skip_until_newline = [&]() {
+    i += scan::FindNewline(data + i, size_t(n - i));
+  };
+
+  // Skip string literal or asset path. `i` points to the opening quote.
+  auto skip_quoted = [&]() -> bool {
+    const char q = data[i];
+    bool triple = ((i + 2) < n) && (data[i + 1] == q) && (data[i + 2] == q);
+    i += triple ? 3 : 1;
+    bool at_escaped{false};  // `\@@@` in triple '@'
+    const char stop_chars[] = {q, '\\', '\n'};
+    while (i < n) {
+      i += scan::FindFirstOf(data + i, size_t(n - i), stop_chars,
+                             sizeof(stop_chars));
+      if (i >= n) {
+        break;
+      }
+      const char c = data[i];
+      if (c == '\n') {
+        row++;
+      } else if (c == '\\') {
+        if (q == '@') {
+          at_escaped = triple;
+        } else {
+          // escaped char
+          if (((i + 1) < n) && (data[i + 1] == '\n')) {
+            row++;
+          }
+          i += 2;
+          continue;
+        }
+      } else if (c == q) {
+        if (!triple) {
+          i++;
+          return true;
+        }
+        if (((i + 2) < n) && (data[i + 1] == q) && (data[i + 2] == q)) {
+          i += 3;
+          if (at_escaped) {
+            at_escaped = false;
+            continue;
+          }
+          return true;
+        }
+      }
+      i++;
+    }
+    return false;  // unterminated
+  };
+
+  // Chars handled in the block scan loop below. Others are skipped.
+  const char kStructuralChars[] = {'"', '\'', '@', '#', '\n',
+                                   '\0', '(', ')', '{', '}'};
+
+  std::vector<BlockRange> result;
+
+  while (i < n) {
+    // Skip whitespaces and comments between blocks.
+    const char c = data[i];
+    if (c == '\n') {
+      row++;
+      i++;
+      continue;
+    } else if ((c == ' ') || (c == '\t') || (c == '\r') || (c == ';')) {
+      i++;
+      continue;
+    } else if (c == '#') {
+      skip_until_newline();
+      continue;
+    } else if (c == '\0') {
+      break;
+    }
+
+    BlockRange range;
+    range.begin = i;
+    range.row = row;
+
+    // Prim metas `( ... )` may contain dictionary braces, so the body starts
+    // at the first `{` outside of parentheses.
+    int paren_depth = 0;
+    int brace_depth = 0;
+    bool in_body = false;
+    bool closed = false;
+
+    while (i < n) {
+      // Jump to the next char which affects the block structure.
+      i += scan::FindFirstOf(data + i, size_t(n - i), kStructuralChars,
+                             sizeof(kStructuralChars));
+      if (i >= n) {
+        break;
+      }
+      const char b = data[i];
+      if ((b == '"') || (b == '\'') || (b == '@')) {
+        if (!skip_quoted()) {
+          return false;
+        }
+        continue;
+      } else if (b == '#') {
+        skip_until_newline();
+        continue;
+      } else if (b == '\n') {
+        row++;
+      } else if (b == '\0') {
+        return false;
+      } else if (!in_body) {
+        if (b == '(') {
+          paren_depth++;
+        } else if (b == ')') {
+          paren_depth--;
+          if (paren_depth < 0) {
+            return false;
+          }
+        } else if ((b == '{') && (paren_depth == 0)) {
+          in_body = true;
+          brace_depth = 1;
+        } else if (b == '}') {
+          if (paren_depth == 0) {
+            return false;
+          }
+        }
+      } else {
+        if (b == '{') {
+          brace_depth++;
+        } else if (b == '}') {
+          brace_depth--;
+          if (brace_depth == 0) {
+            i++;
+            closed = true;
+            break;
+          }
+        }
+      }
+      i++;
+    }
+
+    if (!closed) {
+      return false;
+    }
+
+    range.end = i;
+    result.push_back(range);
+  }
+
+  (*ranges) = std::move(result);
+
+  return true;
+}
+
+bool AsciiParser::ParseToplevelBlocks(const uint64_t begin, const uint64_t end,
+                                      const int row,
+                                      const uint32_t load_states,
+                                      const AsciiParserOption &parser_option) {
+  SetLoadStates(load_states, parser_option);
+
+  if (!SeekTo(begin)) {
+    PUSH_ERROR_AND_RETURN("Invalid byte location for toplevel block.");
+  }
+  _curr_cursor.row = row;
+  _curr_cursor.col = 0;
+
+  return ParseToplevelBlocks(end);
+}
+
+bool AsciiParser::ParseToplevelBlocks(const uint64_t end) {
   PushPrimPath("/");
 
   // parse blocks
-  while (!Eof()) {
+  while (!Eof() && (CurrLoc() < end)) {
     if (!SkipCommentAndWhitespaceAndNewline()) {
       return false;
     }
 
-    if (Eof()) {
+    if (Eof() || (CurrLoc() >= end)) {
       // Whitespaces in the end of line.
       break;
     }
@@ -326,6 +326,49 @@ class AsciiParser {
       const uint32_t load_states = static_cast<uint32_t>(LoadState::Toplevel),
       const AsciiParserOption &parser_option = AsciiParserOption());
 
+  ///
+  /// Byte range of a toplevel Prim block(`def`, `over` or `class`).
+  ///
+  struct BlockRange {
+    uint64_t begin{0};  // Byte location of the specifier.
+    uint64_t end{0};    // Byte location after the closing `}`.
+    int row{0};         // Line number at `begin`(for error message).
+  };
+
+  ///
+  /// -- For parallel parsing --
+  /// `Parse` is equivalent to `ParseHeader` followed by
+  /// `ParseToplevelBlocks(CurrLoc(), size)`.
+  ///
+
+  ///
+  /// Parse magic header and Stage metadatum(then invoke StageMeta callback).
+  ///
+  bool ParseHeader(
+      const uint32_t load_states = static_cast<uint32_t>(LoadState::Toplevel),
+      const AsciiParserOption &parser_option = AsciiParserOption());
+
+  ///
+  /// Find byte ranges of toplevel Prim blocks from the current location
+  /// without parsing them. Braces, parentheses and quotes in strings, asset
+  /// paths and comments are skipped. Stream position is not changed.
+  /// Only available for non-chunked StreamReader.
+  ///
+  /// Returns false when the input is not brace-balanced or the input is not
+  /// accessible as a whole(Use `ParseToplevelBlocks` in such case so that
+  /// syntax errors are reported).
+  ///
+  bool ScanToplevelBlocks(std::vector<BlockRange> *ranges);
+
+  ///
+  /// Parse toplevel Prim blocks in [begin, end) byte range.
+  /// `row` is the line number at `begin`.
+  ///
+  bool ParseToplevelBlocks(
+      const uint64_t begin, const uint64_t end, const int row,
+      const uint32_t load_states = static_cast<uint32_t>(LoadState::Toplevel),
+      const AsciiParserOption &parser_option = AsciiParserOption());
+
   ///
   /// Parse TimeSample value with specified array type of
   /// `type_id`(value::TypeId) (You can obrain type_id from string using
@@ -532,6 +575,14 @@ class AsciiParser {
   template <typename T>
   bool SepBy1BasicType(const char sep, std::vector<T> *result);
 
+  ///
+  /// Allocation-free version for fixed-size tuples. Stores the first
+  /// `max_n` values to `result` and the number of parsed values to `n`.
+  ///
+  template <typename T>
+  bool SepBy1BasicType(const char sep, const size_t max_n, T *result,
+                       size_t *n);
+
   ///
   /// Allow the appearance of `sep` in the last item of array.
   /// (e.g. `[1, 2, 3,]`)
@@ -682,6 +733,12 @@ class AsciiParser {
 
   bool LexFloat(std::string *result);
 
+  ///
+  /// Allocation-free version of `LexFloat`. [literal_begin, literal_end)
+  /// points to the literal in the input buffer. Valid until the next read.
+  ///
+  bool LexFloat(const char **literal_begin, const char **literal_end);
+
   bool Expect(char expect_c);
 
   bool ReadStringLiteral(
@@ -707,6 +764,11 @@ class AsciiParser {
   bool SkipWhitespaceAndNewline(const bool allow_semicolon = true);
   bool SkipCommentAndWhitespaceAndNewline(const bool allow_semicolon = true);
 
+  // Skip a run of ' ', '\t', '\f'(and ';' when `allow_semicolon` is true) in
+  // the current buffer using vectorized scan. Returns false when no char is
+  // skipped.
+  bool SkipBlankRun(const bool allow_semicolon);
+
   bool SkipUntilNewline();
 
   // bool ParseAttributeMeta();
@@ -763,6 +825,9 @@ class AsciiParser {
   //
   StageMetas GetStageMetas() const { return _stage_metas; }
 
+  // Current line/column(for error message)
+  Cursor GetCursor() const { return _curr_cursor; }
+
   // primIdx is assigned through `PrimIdxAssignFunctin`
   // parentPrimIdx = -1 => root prim
   // depth = tree level(recursion count)
@@ -791,6 +856,12 @@ class AsciiParser {
   ///
   void Setup();
 
+  void SetLoadStates(const uint32_t load_states,
+                     const AsciiParserOption &parser_option);
+
+  // Parse toplevel blocks until `end`(or EOF)
+  bool ParseToplevelBlocks(const uint64_t end);
+
   nonstd::optional<std::pair<ListEditQual, MetaVariable>> ParsePrimMeta();
   bool ParsePrimProps(std::map<std::string, Property> *props,
                       std::vector<value::token> *propNames);
@@ -860,6 +931,9 @@ class AsciiParser {
 
   StageMetas _stage_metas;
 
+  // Fallback buffer for `LexFloat(const char **, const char **)`
+  std::string _lex_buf;
+
   //
   // Callbacks
   //
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+//
+// Vectorized character scanning used by the USDA lexer.
+//
+// Each function has a SIMD path(AVX2, SSE2 or NEON, selected at compile time)
+// and a scalar fallback(`*Scalar`) which always gives the same result.
+// Define `TINYUSDZ_NO_SIMD_SCAN` to force the scalar path.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(TINYUSDZ_NO_SIMD_SCAN)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TINYUSDZ_ASCII_SCAN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define TINYUSDZ_ASCII_SCAN_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define TINYUSDZ_ASCII_SCAN_NEON
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace tinyusdz {
+namespace ascii {
+namespace scan {
+
+/// Max number of characters in a character set.
+constexpr size_t kMaxCharSetSize = 16;
+
+/// Characters skipped by `SkipWhitespace`(without newline).
+constexpr char kBlankChars[] = {' ', '\t', '\f'};
+
+/// Blank characters + `;`(C-style statement separator allowed in USDA).
+constexpr char kBlankOrSemicolonChars[] = {' ', '\t', '\f', ';'};
+
+/// Newline characters.
+constexpr char kNewlineChars[] = {'\n', '\r'};
+
+namespace detail {
+
+inline uint32_t CountTrailingZeros(uint32_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long idx;
+  _BitScanForward(&idx, x);
+  return uint32_t(idx);
+#else
+  return uint32_t(__builtin_ctz(x));
+#endif
+}
+
+inline uint32_t CountTrailingZeros64(uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  uint32_t lo = uint32_t(x & 0xffffffffu);
+  if (lo) {
+    return CountTrailingZeros(lo);
+  }
+  return 32 + CountTrailingZeros(uint32_t(x >> 32));
+#else
+  return uint32_t(__builtin_ctzll(x));
+#endif
+}
+
+inline bool InSet(const char c, const char *set, const size_t nset) {
+  for (size_t k = 0; k < nset; k++) {
+    if (c == set[k]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace detail
+
+///
+/// Returns the index of the first character in [p, p + n) which is(or is not
+/// when `negate` is true) one of `set`. Returns `n` when not found.
+///
+inline size_t FindFirstOfScalar(const char *p, const size_t n, const char *set,
+                                const size_t nset, const bool negate = false) {
+  for (size_t i = 0; i < n; i++) {
+    if (detail::InSet(p[i], set, nset) != negate) {
+      return i;
+    }
+  }
+  return n;
+}
+
+///
+/// SIMD version of `FindFirstOfScalar`. `nset` must be <= kMaxCharSetSize.
+///
+inline size_t FindFirstOf(const char *p, const size_t n, const char *set,
+                          const size_t nset, const bool negate = false) {
+  size_t i = 0;
+
+  if (nset > kMaxCharSetSize) {
+    return FindFirstOfScalar(p, n, set, nset, negate);
+  }
+
+#if defined(TINYUSDZ_ASCII_SCAN_AVX2)
+  __m256i needles[kMaxCharSetSize];
+  for (size_t k = 0; k < nset; k++) {
+    needles[k] = _mm256_set1_epi8(set[k]);
+  }
+
+  for (; (i + 32) <= n; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+    __m256i m = _mm256_setzero_si256();
+    for (size_t k = 0; k < nset; k++) {
+      m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, needles[k]));
+    }
+    uint32_t bits = uint32_t(_mm256_movemask_epi8(m));
+    if (negate) {
+      bits = ~bits;
+    }
+    if (bits) {
+      return i + detail::CountTrailingZeros(bits);
+    }
+  }
+#elif defined(TINYUSDZ_ASCII_SCAN_SSE2)
+  __m128i needles[kMaxCharSetSize];
+  for (size_t k = 0; k < nset; k++) {
+    needles[k] = _mm_set1_epi8(set[k]);
+  }
+
+  for (; (i + 16) <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+    __m128i m = _mm_setzero_si128();
+    for (size_t k = 0; k < nset; k++) {
+      m = _mm_or_si128(m, _mm_cmpeq_epi8(v, needles[k]));
+    }
+    uint32_t bits = uint32_t(_mm_movemask_epi8(m));
+    if (negate) {
+      bits = (~bits) & 0xffffu;
+    }
+    if (bits) {
+      return i + detail::CountTrailingZeros(bits);
+    }
+  }
+#elif defined(TINYUSDZ_ASCII_SCAN_NEON)
+  uint8x16_t needles[kMaxCharSetSize];
+  for (size_t k = 0; k < nset; k++) {
+    needles[k] = vdupq_n_u8(uint8_t(set[k]));
+  }
+
+  for (; (i + 16) <= n; i += 16) {
+    const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(p + i));
+    uint8x16_t m = vdupq_n_u8(0);
+    for (size_t k = 0; k < nset; k++) {
+      m = vorrq_u8(m, vceqq_u8(v, needles[k]));
+    }
+    if (negate) {
+      m = vmvnq_u8(m);
+    }
+    // Narrow each 8bit lane to 4bits to get a 64bit mask.
+    const uint64_t bits = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+    if (bits) {
+      return i + (detail::CountTrailingZeros64(bits) >> 2);
+    }
+  }
+#endif
+
+  return i + FindFirstOfScalar(p + i, n - i, set, nset, negate);
+}
+
+///
+/// Returns the number of leading characters in [p, p + n) which are in `set`.
+///
+inline size_t SkipCharsScalar(const char *p, const size_t n, const char *set,
+                              const size_t nset) {
+  return FindFirstOfScalar(p, n, set, nset, /* negate */ true);
+}
+
+inline size_t SkipChars(const char *p, const size_t n, const char *set,
+                        const size_t nset) {
+  return FindFirstOf(p, n, set, nset, /* negate */ true);
+}
+
+///
+/// Returns the number of leading blank(' ', '\t', '\f') characters.
+/// `;` is also skipped when `allow_semicolon` is true.
+///
+inline size_t SkipBlanks(const char *p, const size_t n,
+                         const bool allow_semicolon = false) {
+  if (allow_semicolon) {
+    return SkipChars(p, n, kBlankOrSemicolonChars,
+                     sizeof(kBlankOrSemicolonChars));
+  }
+  return SkipChars(p, n, kBlankChars, sizeof(kBlankChars));
+}
+
+///
+/// Returns the index of the first '\n' or '\r'. `n` when not found.
+///
+inline size_t FindNewline(const char *p, const size_t n) {
+  return FindFirstOf(p, n, kNewlineChars, sizeof(kNewlineChars));
+}
+
+///
+/// Returns the number of leading identifier characters([A-Za-z0-9_]).
+/// Identifiers are usually short, so this is a scalar loop.
+///
+inline size_t SkipIdentifierChars(const char *p, const size_t n) {
+  size_t i = 0;
+  for (; i < n; i++) {
+    const char c = p[i];
+    if (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+        ((c >= '0') && (c <= '9')) || (c == '_')) {
+      continue;
+    }
+    break;
+  }
+  return i;
+}
+
+}  // namespace scan
+}  // namespace ascii
+}  // namespace tinyusdz
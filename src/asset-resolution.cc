@@ -136,6 +136,25 @@ bool AssetResolutionResolver::open_asset(const std::string &resolvedPath, const
   std::string ext = io::GetFileExtension(resolvedPath);
 
   if (_asset_resolution_handlers.count(ext)) {
+    if (_asset_resolution_handlers.at(ext).view_fun) {
+      void *userdata = _asset_resolution_handlers.at(ext).userdata;
+
+      const uint8_t *addr{nullptr};
+      uint64_t sz{0};
+      std::shared_ptr<const void> keep_alive;
+      std::string view_err;
+      int ret = _asset_resolution_handlers.at(ext).view_fun(resolvedPath.c_str(), &addr, &sz, &keep_alive, &view_err, userdata);
+      if ((ret == 0) && addr) {
+        DCOUT("asset_size(view): " << sz);
+        tinyusdz::Asset asset;
+        asset.set_view(addr, size_t(sz), std::move(keep_alive));
+        (*asset_out) = std::move(asset);
+        return true;
+      }
+
+      DCOUT("View asset failed. Fallback to read function: " << view_err);
+    }
+
     if (_asset_resolution_handlers.at(ext).size_fun && _asset_resolution_handlers.at(ext).read_fun) {
 
       // Use custom handler's userdata
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -23,20 +24,48 @@ namespace tinyusdz {
 ///
 class Asset {
  public:
-  size_t size() const { return buf_.size(); }
+  size_t size() const { return view_addr_ ? view_size_ : buf_.size(); }
 
-  const uint8_t *data() const { return buf_.data(); }
+  const uint8_t *data() const { return view_addr_ ? view_addr_ : buf_.data(); }
 
-  uint8_t *data() { return buf_.data(); }
+  // When this Asset is a view, its content is copied to the owned buffer
+  // first. Use const version of `data()` to read the content without a copy.
+  uint8_t *data() {
+    materialize();
+    return buf_.data();
+  }
 
-  void resize(size_t sz) { buf_.resize(sz); }
+  void resize(size_t sz) {
+    materialize();
+    buf_.resize(sz);
+  }
 
   void shrink_to_fit() { buf_.shrink_to_fit(); }
 
-  void set_data(const std::vector<uint8_t> &&rhs) {
-    buf_ = rhs;
+  void set_data(std::vector<uint8_t> &&rhs) {
+    clear_view();
+    buf_ = std::move(rhs);
   }
 
+  ///
+  /// Set non-owning view of `sz` bytes at `addr`(e.g. a file in the
+  /// memory-mapped USDZ) as the content of this Asset.
+  ///
+  /// @param[in] keep_alive Object owning the memory(e.g. the file mapping).
+  /// Retained while this Asset(or its copy) is alive. Can be nullptr when the
+  /// memory outlives this Asset.
+  ///
+  void set_view(const uint8_t *addr, size_t sz,
+                std::shared_ptr<const void> keep_alive = nullptr) {
+    buf_.clear();
+    buf_.shrink_to_fit();
+    view_addr_ = addr;
+    view_size_ = sz;
+    keep_alive_ = std::move(keep_alive);
+  }
+
+  bool is_view() const { return view_addr_ != nullptr; }
+
   void set_name(const std::string &name) {
     name_ = name;
   }
@@ -66,6 +95,24 @@ class Asset {
   std::string name_;
   std::string resolved_name_;
   std::vector<uint8_t> buf_;
+
+  // View mode
+  const uint8_t *view_addr_{nullptr};
+  size_t view_size_{0};
+  std::shared_ptr<const void> keep_alive_;
+
+  void clear_view() {
+    view_addr_ = nullptr;
+    view_size_ = 0;
+    keep_alive_.reset();
+  }
+
+  void materialize() {
+    if (view_addr_) {
+      buf_.assign(view_addr_, view_addr_ + view_size_);
+      clear_view();
+    }
+  }
 };
 
 
@@ -114,6 +161,22 @@ typedef int (*FSSizeAsset)(const char *resolved_asset_name, uint64_t *nbytes,
 typedef int (*FSReadAsset)(const char *resolved_asset_name, uint64_t req_nbytes, uint8_t *out_buf,
                           uint64_t *nbytes, std::string *err, void *userdata);
 
+// Optional. Access the content of the asset without a copy(e.g. a file in
+// memory-mapped USDZ).
+//
+// @param[in] resolved_asset_name Resolved Asset name or filepath
+// @param[out] addr Address of the asset data.
+// @param[out] nbytes Bytes of this asset.
+// @param[out] keep_alive Object owning the memory at `addr`. When not set,
+// the memory must be valid while `userdata` is alive.
+// @param[out] err Error message.
+// @param[inout] userdata Userdata.
+//
+// @return 0 upon success. negative value = error(FSReadAsset is used instead)
+typedef int (*FSViewAsset)(const char *resolved_asset_name, const uint8_t **addr,
+                          uint64_t *nbytes, std::shared_ptr<const void> *keep_alive,
+                          std::string *err, void *userdata);
+
 // @param[in] asset_name Asset name or filepath(could be empty)
 // @param[in] resolved_asset_name Resolved Asset name or filepath
 // @param[in] buffer Data.
@@ -130,6 +193,7 @@ struct AssetResolutionHandler {
   FSSizeAsset size_fun{nullptr};
   FSReadAsset read_fun{nullptr};
   FSWriteAsset write_fun{nullptr};
+  FSViewAsset view_fun{nullptr}; // optional
   void *userdata{nullptr};
 };
 
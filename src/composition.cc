@@ -18,6 +18,7 @@
 #include "prim-reconstruct.hh"
 #include "prim-types.hh"
 #include "str-util.hh"
+#include "thread-util.hh"
 #include "tiny-format.hh"
 #include "tinyusdz.hh"
 #include "usdGeom.hh"
@@ -156,82 +157,14 @@ bool PropagateAssetResolverState(uint32_t depth, PrimSpec &ps,
   return true;
 }
 
-// TODO: support loading non-USD asset
-bool LoadAsset(AssetResolutionResolver &resolver,
-               const std::string &current_working_path,
-               const std::vector<std::string> &search_paths,
-               const std::map<std::string, FileFormatHandler> &fileformats,
-               const value::AssetPath &assetPath, const Path &primPath,
-               Layer *dst_layer, const PrimSpec **dst_primspec_root,
-               const bool error_when_no_prims_found,
-               const bool error_when_asset_not_found,
-               const bool error_when_unsupported_fileformat, std::string *warn,
-               std::string *err) {
-  if (!dst_layer) {
-    PUSH_ERROR_AND_RETURN(
-        "[Internal error]. `dst_layer` output arg is nullptr.");
-  }
-
-  std::string asset_path = assetPath.GetAssetPath();
-  std::string ext = GetExtension(asset_path);
-
-  if (asset_path.empty()) {
-    PUSH_ERROR_AND_RETURN(
-        "TODO: No assetPath but Prim path(e.g. </xform>) in references.");
-  }
-
-  // TODO: Use std::stack to manage AssetResolutionResolver state?
-  if (current_working_path.size()) {
-    resolver.set_current_working_path(current_working_path);
-  }
-
-  if (search_paths.size()) {
-    resolver.set_search_paths(search_paths);
-  }
-
-  // resolve path
-  // TODO: Store resolved path to Reference?
-  std::string resolved_path = resolver.resolve(asset_path);
-
-  DCOUT("Loading references: " << resolved_path
-                               << ", asset_path: " << asset_path);
-
-  if (resolved_path.empty()) {
-    if (error_when_asset_not_found) {
-      PUSH_ERROR_AND_RETURN(
-          fmt::format("Failed to resolve asset path `{}`", asset_path));
-    } else {
-      PUSH_WARN(fmt::format("Asset not found: `{}`", asset_path));
-#if 0 // for debugging. print cwd.
-#if defined(__linux__)
-      char pathname[4096];
-      memset(pathname, 0, 4096);
-      char *pathname_p = getcwd(pathname, 4096);
-
-      if (pathname_p == nullptr) {
-        PUSH_ERROR_AND_RETURN(
-            "Getting current working directory failed.");
-      }
-
-      PUSH_WARN(fmt::format("  cwd = {}", std::string(pathname_p)));
-#endif
-#endif
-      PUSH_WARN(
-          fmt::format("  current working path: `{}`", current_working_path));
-      PUSH_WARN(fmt::format("  resolver.current_working_path: `{}`",
-                            resolver.current_working_path()));
-      PUSH_WARN(fmt::format("  search_paths: `{}`", search_paths));
-      PUSH_WARN(fmt::format("  resolver.search_paths: `{}`",
-                            resolver.search_paths()));
-      (*dst_primspec_root) = nullptr;
-      return true;
-    }
-  }
-
+// Use resolved asset_path's basedir for current working path.
+// Add resolved asset_path's basedir to search path.
+void SetResolvedAssetResolutionState(
+    AssetResolutionResolver &resolver,
+    const std::vector<std::string> &search_paths,
+    const std::string &resolved_path) {
   resolver.set_search_paths(search_paths);
 
-  // Use resolved asset_path's basedir for current working path.
-  // Add resolved asset_path's basedir to search path.
   std::string base_dir = io::GetBaseDir(resolved_path);
   if (base_dir.size()) {
     DCOUT(fmt::format("Add `{}' to asset search path.", base_dir));
@@ -240,6 +173,29 @@ bool LoadAsset(AssetResolutionResolver &resolver,
 
     resolver.add_search_path(base_dir);
   }
+}
+
+//
+// Load an asset at `resolved_path` as Layer. See `LoadAssetLayer`.
+// The asset is opened with `resolver`, and must be resolved beforehand.
+//
+bool LoadResolvedAsset(
+    AssetResolutionResolver &resolver, const std::string &resolved_path,
+    const std::string &asset_path,
+    const std::map<std::string, FileFormatHandler> &fileformats,
+    LayerCache *layer_cache, std::shared_ptr<Layer> *dst_layer,
+    std::shared_ptr<const Layer> *dst_cached_layer,
+    const bool error_when_unsupported_fileformat, std::string *warn,
+    std::string *err) {
+  std::string ext = GetExtension(asset_path);
+
+  if (layer_cache) {
+    if (auto cached = layer_cache->find(resolved_path)) {
+      DCOUT("Use cached Layer: " << resolved_path);
+      (*dst_cached_layer) = cached;
+      return true;
+    }
+  }
 
   Asset asset;
   if (!resolver.open_asset(resolved_path, asset_path, &asset, warn, err)) {
@@ -282,23 +238,20 @@ bool LoadAsset(AssetResolutionResolver &resolver,
     }
   }
 
-  Layer layer;
+  std::shared_ptr<Layer> layer = std::make_shared<Layer>();
   std::string _warn;
   std::string _err;
 
+  // Use const access so that the asset viewing the USDZ is not copied.
+  const Asset &casset = asset;
+
   if (IsUSDFileFormat(asset_path)) {
-    if (!LoadLayerFromMemory(asset.data(), asset.size(), asset_path, &layer,
-                             &_warn, &_err)) {
+    if (!LoadLayerFromMemory(casset.data(), casset.size(), asset_path,
+                             layer.get(), &_warn, &_err)) {
       PUSH_ERROR_AND_RETURN(
           fmt::format("Failed to open `{}` as Layer: {}", asset_path, _err));
     }
   } else if (IsMtlxFileFormat(asset_path)) {
-    // primPath must be '</MaterialX>'
-    if (primPath.prim_part() != "/MaterialX") {
-      PUSH_ERROR_AND_RETURN("Prim path must be </MaterialX>, but got: " +
-                            primPath.prim_part());
-    }
-
     PrimSpec ps;
     if (!LoadMaterialXFromAsset(asset, asset_path, ps, &_warn, &_err)) {
       PUSH_ERROR_AND_RETURN(
@@ -306,7 +259,7 @@ bool LoadAsset(AssetResolutionResolver &resolver,
     }
 
     ps.name() = "MaterialX";
-    layer.primspecs()["MaterialX"] = ps;
+    layer->primspecs()["MaterialX"] = ps;
 
   } else {
     if (fileformats.count(ext)) {
@@ -323,7 +276,7 @@ bool LoadAsset(AssetResolutionResolver &resolver,
             "PrimSpec element_name is empty. asset `{}`", asset_path));
       }
 
-      layer.primspecs()[ps.name()] = ps;
+      layer->primspecs()[ps.name()] = ps;
       DCOUT("Read asset from custom fileformat handler: " << ext);
     } else {
       PUSH_ERROR_AND_RETURN(fmt::format(
@@ -331,7 +284,7 @@ bool LoadAsset(AssetResolutionResolver &resolver,
     }
   }
 
-  DCOUT("layer = " << print_layer(layer, 0));
+  DCOUT("layer = " << print_layer(*layer, 0));
 
   // TODO: Recursively resolve `references`
 
@@ -341,57 +294,155 @@ bool LoadAsset(AssetResolutionResolver &resolver,
     }
   }
 
-  if (layer.primspecs().empty()) {
-    if (error_when_no_prims_found) {
-      PUSH_ERROR_AND_RETURN(fmt::format("No prims in layer `{}`", asset_path));
-    }
+  if (layer_cache) {
+    // Build lookup caches so that the shared Layer is not modified afterwards.
+    layer->commit();
+    layer_cache->insert(resolved_path, layer);
+    (*dst_cached_layer) = layer;
+  } else {
+    (*dst_layer) = layer;
+  }
 
-    if (dst_primspec_root) {
-      (*dst_primspec_root) = nullptr;
-    }
+  return true;
+}
 
-    (*dst_layer) = std::move(layer);
+//
+// Resolve `assetPath` and load it as Layer.
+//
+// `dst_layer` is set to nullptr when the asset is not found or the file format
+// is not supported(and they are not treated as an error).
+// When `layer_cache` is given, the asset is loaded only once and the Layer is
+// shared. The resolver state(current working path, search paths) is updated
+// for the resolved asset in both cases.
+//
+// TODO: support loading non-USD asset
+bool LoadAssetLayer(AssetResolutionResolver &resolver,
+                    const std::string &current_working_path,
+                    const std::vector<std::string> &search_paths,
+                    const std::map<std::string, FileFormatHandler> &fileformats,
+                    const value::AssetPath &assetPath, const Path &primPath,
+                    LayerCache *layer_cache,
+                    std::shared_ptr<Layer> *dst_layer,
+                    std::shared_ptr<const Layer> *dst_cached_layer,
+                    const bool error_when_asset_not_found,
+                    const bool error_when_unsupported_fileformat,
+                    std::string *resolved_path_out, std::string *warn,
+                    std::string *err) {
+  if (!dst_layer || !dst_cached_layer) {
+    PUSH_ERROR_AND_RETURN(
+        "[Internal error]. `dst_layer` output arg is nullptr.");
+  }
 
-    return true;
+  (*dst_layer) = nullptr;
+  (*dst_cached_layer) = nullptr;
+
+  std::string asset_path = assetPath.GetAssetPath();
+
+  if (asset_path.empty()) {
+    PUSH_ERROR_AND_RETURN(
+        "TODO: No assetPath but Prim path(e.g. </xform>) in references.");
   }
 
-  const PrimSpec *src_ps{nullptr};
+  // TODO: Use std::stack to manage AssetResolutionResolver state?
+  if (current_working_path.size()) {
+    resolver.set_current_working_path(current_working_path);
+  }
+
+  if (search_paths.size()) {
+    resolver.set_search_paths(search_paths);
+  }
+
+  // resolve path
+  // TODO: Store resolved path to Reference?
+  std::string resolved_path = resolver.resolve(asset_path);
+
+  DCOUT("Loading references: " << resolved_path
+                               << ", asset_path: " << asset_path);
 
-  if (dst_primspec_root) {
-    std::string default_prim;
-    if (primPath.is_valid()) {
-      default_prim = primPath.prim_part();
-      DCOUT("primPath = " << default_prim);
+  if (resolved_path.empty()) {
+    if (error_when_asset_not_found) {
+      PUSH_ERROR_AND_RETURN(
+          fmt::format("Failed to resolve asset path `{}`", asset_path));
     } else {
-      // Use `defaultPrim` metadatum
-      if (layer.metas().defaultPrim.valid()) {
-        default_prim = "/" + layer.metas().defaultPrim.str();
-        DCOUT("layer.meta.defaultPrim = " << default_prim);
-      } else {
-        // Use the first Prim in the layer.
-        default_prim = "/" + layer.primspecs().begin()->first;
-        DCOUT("layer.primspecs[0].name = " << default_prim);
+      PUSH_WARN(fmt::format("Asset not found: `{}`", asset_path));
+#if 0 // for debugging. print cwd.
+#if defined(__linux__)
+      char pathname[4096];
+      memset(pathname, 0, 4096);
+      char *pathname_p = getcwd(pathname, 4096);
+
+      if (pathname_p == nullptr) {
+        PUSH_ERROR_AND_RETURN(
+            "Getting current working directory failed.");
       }
-    }
 
-    if (!layer.find_primspec_at(Path(default_prim, ""), &src_ps, err)) {
-      PUSH_ERROR_AND_RETURN(fmt::format(
-          "Failed to find PrimSpec `{}` in layer `{}`(resolved path: `{}`)",
-          default_prim, asset_path, resolved_path));
+      PUSH_WARN(fmt::format("  cwd = {}", std::string(pathname_p)));
+#endif
+#endif
+      PUSH_WARN(
+          fmt::format("  current working path: `{}`", current_working_path));
+      PUSH_WARN(fmt::format("  resolver.current_working_path: `{}`",
+                            resolver.current_working_path()));
+      PUSH_WARN(fmt::format("  search_paths: `{}`", search_paths));
+      PUSH_WARN(fmt::format("  resolver.search_paths: `{}`",
+                            resolver.search_paths()));
+      return true;
     }
+  }
 
-    if (!src_ps) {
-      PUSH_ERROR_AND_RETURN("Internal error: PrimSpec pointer is nullptr.");
-    }
+  if (resolved_path_out) {
+    (*resolved_path_out) = resolved_path;
+  }
 
-    if (!PropagateAssetResolverState(0, *const_cast<PrimSpec *>(src_ps),
-                                     resolver.current_working_path(),
-                                     resolver.search_paths())) {
-      PUSH_ERROR_AND_RETURN(
-          "Store AssetResolver state to each PrimSpec failed.\n");
+  SetResolvedAssetResolutionState(resolver, search_paths, resolved_path);
+
+  if (IsMtlxFileFormat(asset_path)) {
+    // primPath must be '</MaterialX>'
+    if (primPath.prim_part() != "/MaterialX") {
+      PUSH_ERROR_AND_RETURN("Prim path must be </MaterialX>, but got: " +
+                            primPath.prim_part());
     }
+  }
+
+  return LoadResolvedAsset(resolver, resolved_path, asset_path, fileformats,
+                           layer_cache, dst_layer, dst_cached_layer,
+                           error_when_unsupported_fileformat, warn, err);
+}
+
+// Load `assetPath` as Layer for `subLayers`.
+bool LoadAsset(AssetResolutionResolver &resolver,
+               const std::string &current_working_path,
+               const std::vector<std::string> &search_paths,
+               const std::map<std::string, FileFormatHandler> &fileformats,
+               const value::AssetPath &assetPath, Layer *dst_layer,
+               const bool error_when_no_prims_found,
+               const bool error_when_asset_not_found,
+               const bool error_when_unsupported_fileformat, std::string *warn,
+               std::string *err) {
+  if (!dst_layer) {
+    PUSH_ERROR_AND_RETURN(
+        "[Internal error]. `dst_layer` output arg is nullptr.");
+  }
 
-    (*dst_primspec_root) = src_ps;
+  std::shared_ptr<Layer> layer;
+  std::shared_ptr<const Layer> cached_layer;
+  if (!LoadAssetLayer(resolver, current_working_path, search_paths,
+                      fileformats, assetPath, /* not_used */ Path::make_root_path(),
+                      /* layer_cache */ nullptr, &layer, &cached_layer,
+                      error_when_asset_not_found,
+                      error_when_unsupported_fileformat,
+                      /* resolved_path */ nullptr, warn, err)) {
+    return false;
+  }
+
+  if (!layer) {
+    // Asset not found or unsupported file format.
+    return true;
+  }
+
+  if (layer->primspecs().empty() && error_when_no_prims_found) {
+    PUSH_ERROR_AND_RETURN(fmt::format("No prims in layer `{}`",
+                                      assetPath.GetAssetPath()));
   }
 
   // FIXME: This may be redundant, since assetresulution state is stored in
@@ -399,15 +450,245 @@ bool LoadAsset(AssetResolutionResolver &resolver,
   // TODO: Remove layer-level assetresulution state store?
   //
   // save assetresolution state for nested composition.
-  layer.set_asset_resolution_state(resolver.current_working_path(),
-                                   resolver.search_paths(),
-                                   resolver.get_userdata());
+  layer->set_asset_resolution_state(resolver.current_working_path(),
+                                    resolver.search_paths(),
+                                    resolver.get_userdata());
+
+  (*dst_layer) = std::move(*layer);
+
+  return true;
+}
+
+//
+// Load PrimSpec at `primPath`(or the default Prim) in `assetPath` for
+// `references` and `payload`. PrimSpec tree is copied to `dst_primspec` with
+// AssetResolution state of the asset, since the Layer may be shared through
+// `layer_cache`.
+//
+// `found` is set to false when the asset is not found or the file format is
+// not supported(and they are not treated as an error).
+//
+bool LoadAssetPrimSpec(
+    AssetResolutionResolver &resolver, const std::string &current_working_path,
+    const std::vector<std::string> &search_paths,
+    const std::map<std::string, FileFormatHandler> &fileformats,
+    const value::AssetPath &assetPath, const Path &primPath,
+    LayerCache *layer_cache, PrimSpec *dst_primspec, bool *found,
+    const bool error_when_asset_not_found,
+    const bool error_when_unsupported_fileformat, std::string *warn,
+    std::string *err) {
+  if (!dst_primspec || !found) {
+    PUSH_ERROR_AND_RETURN(
+        "[Internal error]. `dst_primspec` output arg is nullptr.");
+  }
+
+  (*found) = false;
+
+  const std::string asset_path = assetPath.GetAssetPath();
+
+  std::shared_ptr<Layer> loaded_layer;
+  std::shared_ptr<const Layer> cached_layer;
+  std::string resolved_path;
+  if (!LoadAssetLayer(resolver, current_working_path, search_paths,
+                      fileformats, assetPath, primPath, layer_cache,
+                      &loaded_layer, &cached_layer, error_when_asset_not_found,
+                      error_when_unsupported_fileformat, &resolved_path, warn,
+                      err)) {
+    return false;
+  }
+
+  const Layer *layer = cached_layer ? cached_layer.get() : loaded_layer.get();
+  if (!layer) {
+    // Asset not found or unsupported file format.
+    return true;
+  }
+
+  if (layer->primspecs().empty()) {
+    PUSH_ERROR_AND_RETURN(fmt::format("No prims in layer `{}`", asset_path));
+  }
+
+  std::string default_prim;
+  if (primPath.is_valid()) {
+    default_prim = primPath.prim_part();
+    DCOUT("primPath = " << default_prim);
+  } else {
+    // Use `defaultPrim` metadatum
+    if (layer->metas().defaultPrim.valid()) {
+      default_prim = "/" + layer->metas().defaultPrim.str();
+      DCOUT("layer.meta.defaultPrim = " << default_prim);
+    } else {
+      // Use the first Prim in the layer.
+      default_prim = "/" + layer->primspecs().begin()->first;
+      DCOUT("layer.primspecs[0].name = " << default_prim);
+    }
+  }
+
+  const PrimSpec *src_ps{nullptr};
+  if (!layer->find_primspec_at(Path(default_prim, ""), &src_ps, err)) {
+    PUSH_ERROR_AND_RETURN(fmt::format(
+        "Failed to find PrimSpec `{}` in layer `{}`(resolved path: `{}`)",
+        default_prim, asset_path, resolved_path));
+  }
+
+  if (!src_ps) {
+    PUSH_ERROR_AND_RETURN("Internal error: PrimSpec pointer is nullptr.");
+  }
+
+  (*dst_primspec) = *src_ps;
+
+  if (!PropagateAssetResolverState(0, *dst_primspec,
+                                   resolver.current_working_path(),
+                                   resolver.search_paths())) {
+    PUSH_ERROR_AND_RETURN(
+        "Store AssetResolver state to each PrimSpec failed.\n");
+  }
 
-  (*dst_layer) = std::move(layer);
+  (*found) = true;
 
   return true;
 }
 
+//
+// Composition scheduler for `references` and `payload`.
+//
+// 1. Collect arcs to external assets in the Layer(`CollectAssetArcsRec`)
+// 2. Resolve them and load(parse) distinct assets concurrently into
+//    LayerCache(`PrefetchAssetLayers`)
+// 3. Composite arcs to PrimSpec tree in the same(depth-first) order as
+//    single-threaded composition. Assets are taken from LayerCache.
+//
+
+// Arc to an external asset(`references` or `payload`).
+struct AssetArc {
+  std::string current_working_path;
+  std::vector<std::string> search_paths;
+  value::AssetPath asset_path;
+};
+
+template <typename T>  // Reference or Payload
+void CollectAssetArcs(const PrimSpec &primspec, const std::vector<T> &items,
+                      std::vector<AssetArc> *arcs) {
+  for (const auto &item : items) {
+    if (item.asset_path.GetAssetPath().empty()) {
+      // Internal reference.
+      continue;
+    }
+
+    AssetArc arc;
+    arc.current_working_path = primspec.get_current_working_path();
+    arc.search_paths = primspec.get_asset_search_paths();
+    arc.asset_path = item.asset_path;
+    arcs->emplace_back(std::move(arc));
+  }
+}
+
+bool CollectAssetArcsRec(uint32_t depth, const PrimSpec &primspec,
+                         const bool payload, const uint32_t max_depth,
+                         std::vector<AssetArc> *arcs) {
+  if (depth > max_depth) {
+    return false;
+  }
+
+  // Same traversal order as CompositeReferencesRec/CompositePayloadRec.
+  for (const auto &child : primspec.children()) {
+    if (!CollectAssetArcsRec(depth + 1, child, payload, max_depth, arcs)) {
+      return false;
+    }
+  }
+
+  if (payload) {
+    if (primspec.metas().payload) {
+      CollectAssetArcs(primspec, primspec.metas().payload.value().second,
+                       arcs);
+    }
+  } else {
+    if (primspec.metas().references) {
+      CollectAssetArcs(primspec, primspec.metas().references.value().second,
+                       arcs);
+    }
+  }
+
+  return true;
+}
+
+//
+// Resolve and load distinct assets of `arcs` concurrently, and store them to
+// `layer_cache`. Assets are resolved in the order of `arcs`.
+//
+// Errors are not reported here. They are reported when the arc is
+// composited(asset is loaded again in that case).
+//
+void PrefetchAssetLayers(
+    const AssetResolutionResolver &resolver, const std::vector<AssetArc> &arcs,
+    const std::map<std::string, FileFormatHandler> &fileformats,
+    LayerCache *layer_cache, const bool error_when_unsupported_fileformat,
+    const int num_threads, std::string *warn) {
+  struct LoadTask {
+    AssetResolutionResolver resolver;
+    std::string resolved_path;
+    std::string asset_path;
+    std::string warn;
+  };
+
+  std::vector<LoadTask> tasks;
+  std::set<std::string> resolved_paths;
+
+  for (const auto &arc : arcs) {
+    const std::string asset_path = arc.asset_path.GetAssetPath();
+
+    AssetResolutionResolver r = resolver;
+    if (arc.current_working_path.size()) {
+      r.set_current_working_path(arc.current_working_path);
+    }
+    if (arc.search_paths.size()) {
+      r.set_search_paths(arc.search_paths);
+    }
+
+    std::string resolved_path = r.resolve(asset_path);
+    if (resolved_path.empty() || resolved_paths.count(resolved_path)) {
+      continue;
+    }
+    resolved_paths.insert(resolved_path);
+
+    if (layer_cache->find(resolved_path)) {
+      continue;
+    }
+
+    SetResolvedAssetResolutionState(r, arc.search_paths, resolved_path);
+
+    LoadTask task;
+    task.resolver = std::move(r);
+    task.resolved_path = std::move(resolved_path);
+    task.asset_path = asset_path;
+    tasks.emplace_back(std::move(task));
+  }
+
+  DCOUT("Prefetch " << tasks.size() << " assets.");
+
+  thread_util::ParallelFor(0, tasks.size(), num_threads, [&](size_t i) {
+    LoadTask &task = tasks[i];
+
+    std::shared_ptr<Layer> layer;
+    std::shared_ptr<const Layer> cached_layer;
+    std::string err;
+    if (!LoadResolvedAsset(task.resolver, task.resolved_path, task.asset_path,
+                           fileformats, layer_cache, &layer, &cached_layer,
+                           error_when_unsupported_fileformat, &task.warn,
+                           &err) ||
+        !cached_layer) {
+      // Asset is loaded(and reported) again in composition.
+      task.warn.clear();
+    }
+  });
+
+  // Report warnings in deterministic order.
+  if (warn) {
+    for (const auto &task : tasks) {
+      (*warn) += task.warn;
+    }
+  }
+}
+
 bool CompositeSublayersRec(AssetResolutionResolver &resolver,
                            const Layer &in_layer,
                            std::vector<std::set<std::string>> layer_names_stack,
@@ -447,8 +728,7 @@ bool CompositeSublayersRec(AssetResolutionResolver &resolver,
     tinyusdz::Layer sublayer;
     if (!LoadAsset(resolver, in_layer.get_current_working_path(),
                    in_layer.get_asset_search_paths(), options.fileformats,
-                   layer.assetPath, /* not_used */ Path::make_root_path(),
-                   &sublayer, /* primspec_root */ nullptr,
+                   layer.assetPath, &sublayer,
                    options.error_when_no_prims_in_sublayer,
                    options.error_when_asset_not_found,
                    options.error_when_unsupported_fileformat, warn, err)) {
@@ -665,7 +945,7 @@ bool CompositeReferencesRec(uint32_t depth, AssetResolutionResolver &resolver,
     if ((qual == ListEditQual::ResetToExplicit) ||
         (qual == ListEditQual::Prepend)) {
       for (const auto &reference : refecences) {
-        Layer layer;
+        PrimSpec loaded_ps;
         const PrimSpec *src_ps{nullptr};
 
         if (reference.asset_path.GetAssetPath().empty()) {
@@ -687,15 +967,22 @@ bool CompositeReferencesRec(uint32_t depth, AssetResolutionResolver &resolver,
           DCOUT("reference.prim_path = " << reference.prim_path);
           DCOUT("primspec.cwp = " << cwp);
           DCOUT("primspec.search_paths = " << search_paths);
-          if (!LoadAsset(resolver, cwp, search_paths, options.fileformats,
-                         reference.asset_path, reference.prim_path, &layer,
-                         &src_ps, /* error_when_no_prims_found */ true,
-                         options.error_when_asset_not_found,
-                         options.error_when_unsupported_fileformat, warn, err)) {
+          bool found{false};
+          if (!LoadAssetPrimSpec(resolver, cwp, search_paths,
+                                 options.fileformats, reference.asset_path,
+                                 reference.prim_path, options.layer_cache,
+                                 &loaded_ps, &found,
+                                 options.error_when_asset_not_found,
+                                 options.error_when_unsupported_fileformat,
+                                 warn, err)) {
             PUSH_ERROR_AND_RETURN(
                 fmt::format("Failed to `references` asset `{}`",
                             reference.asset_path.GetAssetPath()));
           }
+
+          if (found) {
+            src_ps = &loaded_ps;
+          }
         }
 
         if (!src_ps) {
@@ -731,7 +1018,7 @@ bool CompositeReferencesRec(uint32_t depth, AssetResolutionResolver &resolver,
       PUSH_ERROR_AND_RETURN("Invalid listedit qualifier to for `references`.");
     } else if (qual == ListEditQual::Append) {
       for (const auto &reference : refecences) {
-        Layer layer;
+        PrimSpec loaded_ps;
         const PrimSpec *src_ps{nullptr};
 
         if (reference.asset_path.GetAssetPath().empty()) {
@@ -749,15 +1036,22 @@ bool CompositeReferencesRec(uint32_t depth, AssetResolutionResolver &resolver,
                             reference.prim_path.full_path_name()));
           }
         } else {
-          if (!LoadAsset(resolver, cwp, search_paths, options.fileformats,
-                         reference.asset_path, reference.prim_path, &layer,
-                         &src_ps, /* error_when_no_prims */ true,
-                         options.error_when_asset_not_found,
-                         options.error_when_unsupported_fileformat, warn, err)) {
+          bool found{false};
+          if (!LoadAssetPrimSpec(resolver, cwp, search_paths,
+                                 options.fileformats, reference.asset_path,
+                                 reference.prim_path, options.layer_cache,
+                                 &loaded_ps, &found,
+                                 options.error_when_asset_not_found,
+                                 options.error_when_unsupported_fileformat,
+                                 warn, err)) {
             PUSH_ERROR_AND_RETURN(
                 fmt::format("Failed to `references` asset `{}`",
                             reference.asset_path.GetAssetPath()));
           }
+
+          if (found) {
+            src_ps = &loaded_ps;
+          }
         }
 
         if (!src_ps) {
@@ -822,7 +1116,7 @@ bool CompositePayloadRec(uint32_t depth, AssetResolutionResolver &resolver,
         std::string asset_path = pl.asset_path.GetAssetPath();
         DCOUT("asset_path = " << asset_path);
 
-        Layer layer;
+        PrimSpec loaded_ps;
         const PrimSpec *src_ps{nullptr};
 
         if (pl.asset_path.GetAssetPath().empty()) {
@@ -840,14 +1134,21 @@ bool CompositePayloadRec(uint32_t depth, AssetResolutionResolver &resolver,
           }
         } else {
 
-          if (!LoadAsset(resolver, cwp, search_paths, options.fileformats,
-                         pl.asset_path, pl.prim_path, &layer, &src_ps,
-                         /* error_when_no_prims_found */ true,
-                         options.error_when_asset_not_found,
-                         options.error_when_unsupported_fileformat, warn, err)) {
+          bool found{false};
+          if (!LoadAssetPrimSpec(resolver, cwp, search_paths,
+                                 options.fileformats, pl.asset_path,
+                                 pl.prim_path, options.layer_cache,
+                                 &loaded_ps, &found,
+                                 options.error_when_asset_not_found,
+                                 options.error_when_unsupported_fileformat,
+                                 warn, err)) {
             PUSH_ERROR_AND_RETURN(fmt::format("Failed to `references` asset `{}`",
                                               pl.asset_path.GetAssetPath()));
           }
+
+          if (found) {
+            src_ps = &loaded_ps;
+          }
         }
 
         if (!src_ps) {
@@ -885,7 +1186,7 @@ bool CompositePayloadRec(uint32_t depth, AssetResolutionResolver &resolver,
       for (const auto &pl : payloads) {
         std::string asset_path = pl.asset_path.GetAssetPath();
 
-        Layer layer;
+        PrimSpec loaded_ps;
         const PrimSpec *src_ps{nullptr};
 
         if (pl.asset_path.GetAssetPath().empty()) {
@@ -903,14 +1204,21 @@ bool CompositePayloadRec(uint32_t depth, AssetResolutionResolver &resolver,
           }
         } else {
 
-          if (!LoadAsset(resolver, cwp, search_paths, options.fileformats,
-                         pl.asset_path, pl.prim_path, &layer, &src_ps,
-                         /* error_when_no_prims_found */ true,
-                         options.error_when_asset_not_found,
-                         options.error_when_unsupported_fileformat, warn, err)) {
+          bool found{false};
+          if (!LoadAssetPrimSpec(resolver, cwp, search_paths,
+                                 options.fileformats, pl.asset_path,
+                                 pl.prim_path, options.layer_cache,
+                                 &loaded_ps, &found,
+                                 options.error_when_asset_not_found,
+                                 options.error_when_unsupported_fileformat,
+                                 warn, err)) {
             PUSH_ERROR_AND_RETURN(fmt::format("Failed to `references` asset `{}`",
                                               pl.asset_path.GetAssetPath()));
           }
+
+          if (found) {
+            src_ps = &loaded_ps;
+          }
         }
 
         if (!src_ps) {
@@ -1040,6 +1348,76 @@ bool CompositeInheritsRec(uint32_t depth, const Layer &layer,
 
 }  // namespace
 
+//
+// -- LayerCache
+//
+
+std::shared_ptr<const Layer> LayerCache::find(
+    const std::string &resolved_path) const {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
+  const auto it = _entries.find(resolved_path);
+  if (it == _entries.end()) {
+    return nullptr;
+  }
+
+  if (it->second.has_file_stat) {
+    uint64_t sz{0};
+    int64_t mtime{0};
+    if (!io::GetFileStat(resolved_path, &sz, &mtime) ||
+        (sz != it->second.file_size) || (mtime != it->second.file_mtime)) {
+      // File has been modified(or removed).
+      return nullptr;
+    }
+  }
+
+  _num_hits++;
+  return it->second.layer;
+}
+
+void LayerCache::insert(const std::string &resolved_path,
+                        std::shared_ptr<const Layer> layer) {
+  Entry entry;
+  entry.layer = std::move(layer);
+  // Asset may not be a file(e.g. an asset in USDZ or from an user-defined
+  // AssetResolution handler). Use the path only in that case.
+  entry.has_file_stat =
+      io::GetFileStat(resolved_path, &entry.file_size, &entry.file_mtime);
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
+  _entries[resolved_path] = std::move(entry);
+}
+
+void LayerCache::clear() {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
+  _entries.clear();
+  _num_hits = 0;
+}
+
+size_t LayerCache::size() const {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
+  return _entries.size();
+}
+
+uint64_t LayerCache::num_hits() const {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
+  return _num_hits;
+}
+
 bool CompositeReferences(AssetResolutionResolver &resolver,
                          const Layer &in_layer, Layer *composited_layer,
                          std::string *warn, std::string *err,
@@ -1050,8 +1428,29 @@ bool CompositeReferences(AssetResolutionResolver &resolver,
 
   std::vector<std::string> search_paths = in_layer.get_asset_search_paths();
 
+  // Load each referenced asset only once in this call.
+  LayerCache local_layer_cache;
+  if (!options.layer_cache) {
+    options.layer_cache = &local_layer_cache;
+  }
+
   Layer dst = in_layer;  // deep copy
 
+  if (options.num_threads != 1) {
+    std::vector<AssetArc> arcs;
+    for (const auto &item : dst.primspecs()) {
+      if (!CollectAssetArcsRec(/* depth */ 0, item.second, /* payload */ false,
+                               options.max_depth, &arcs)) {
+        PUSH_ERROR_AND_RETURN("Too deep.");
+      }
+    }
+
+    PrefetchAssetLayers(resolver, arcs, options.fileformats,
+                        options.layer_cache,
+                        options.error_when_unsupported_fileformat,
+                        options.num_threads, warn);
+  }
+
   for (auto &item : dst.primspecs()) {
     if (!CompositeReferencesRec(/* depth */ 0, resolver, search_paths, in_layer,
                                 item.second, warn, err, options)) {
@@ -1072,8 +1471,29 @@ bool CompositePayload(AssetResolutionResolver &resolver, const Layer &in_layer,
     return false;
   }
 
+  // Load each payload asset only once in this call.
+  LayerCache local_layer_cache;
+  if (!options.layer_cache) {
+    options.layer_cache = &local_layer_cache;
+  }
+
   Layer dst = in_layer;  // deep copy
 
+  if (options.num_threads != 1) {
+    std::vector<AssetArc> arcs;
+    for (const auto &item : dst.primspecs()) {
+      if (!CollectAssetArcsRec(/* depth */ 0, item.second, /* payload */ true,
+                               options.max_depth, &arcs)) {
+        PUSH_ERROR_AND_RETURN("Too deep.");
+      }
+    }
+
+    PrefetchAssetLayers(resolver, arcs, options.fileformats,
+                        options.layer_cache,
+                        options.error_when_unsupported_fileformat,
+                        options.num_threads, warn);
+  }
+
   for (auto &item : dst.primspecs()) {
     if (!CompositePayloadRec(/* depth */ 0, resolver,
                              item.second.get_asset_search_paths(), in_layer, item.second,
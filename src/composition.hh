@@ -5,6 +5,8 @@
 //
 #pragma once
 
+#include <memory>
+
 #include "asset-resolution.hh"
 #include "prim-types.hh"
 
@@ -47,6 +49,57 @@ struct SublayersCompositionOptions {
   std::map<std::string, FileFormatHandler> fileformats;
 };
 
+///
+/// Cache of Layers loaded in `references` and `payload` composition.
+///
+/// An asset referenced from multiple PrimSpecs is loaded(parsed) only once,
+/// and the loaded(immutable) Layer is shared across composition arcs.
+/// Entry is keyed by the resolved asset path. The size and the modification
+/// time are also recorded when the asset is a file, and the asset is loaded
+/// again when the file has been modified.
+///
+/// Thread-safe when TINYUSDZ_ENABLE_THREAD is defined.
+///
+class LayerCache {
+ public:
+  ///
+  /// Find cached Layer.
+  ///
+  /// @return nullptr when `resolved_path` is not cached or the file has been
+  /// modified.
+  ///
+  std::shared_ptr<const Layer> find(const std::string &resolved_path) const;
+
+  ///
+  /// Add Layer loaded from `resolved_path`.
+  /// Existing entry is replaced.
+  ///
+  void insert(const std::string &resolved_path,
+              std::shared_ptr<const Layer> layer);
+
+  void clear();
+
+  size_t size() const;
+
+  // The number of `find` calls which returned a cached Layer.
+  uint64_t num_hits() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const Layer> layer;
+    bool has_file_stat{false};
+    uint64_t file_size{0};
+    int64_t file_mtime{0};
+  };
+
+  std::map<std::string, Entry> _entries;
+  mutable uint64_t _num_hits{0};
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  mutable thread_util::CopyableMutex _mutex;
+#endif
+};
+
 struct ReferencesCompositionOptions {
   // The maximum depth for nested `references`
   uint32_t max_depth = 1024u;
@@ -59,6 +112,18 @@ struct ReferencesCompositionOptions {
 
   // File formats
   std::map<std::string, FileFormatHandler> fileformats;
+
+  // Optional. Share loaded Layers across `CompositeReferences` and
+  // `CompositePayload` calls. When nullptr, loaded Layers are only shared
+  // within a call.
+  LayerCache *layer_cache{nullptr};
+
+  // The number of threads to load(parse) distinct assets concurrently.
+  // 1 = single-threaded(default. reproducible order of file access and
+  // warnings). <= 0 = use all available threads.
+  // Composited result is the same regardless of the number of threads.
+  // AssetResolution handlers must be thread-safe when the value is not 1.
+  int num_threads{1};
 };
 
 struct PayloadCompositionOptions {
@@ -73,6 +138,18 @@ struct PayloadCompositionOptions {
 
   // File formats
   std::map<std::string, FileFormatHandler> fileformats;
+
+  // Optional. Share loaded Layers across `CompositeReferences` and
+  // `CompositePayload` calls. When nullptr, loaded Layers are only shared
+  // within a call.
+  LayerCache *layer_cache{nullptr};
+
+  // The number of threads to load(parse) distinct assets concurrently.
+  // 1 = single-threaded(default. reproducible order of file access and
+  // warnings). <= 0 = use all available threads.
+  // Composited result is the same regardless of the number of threads.
+  // AssetResolution handlers must be thread-safe when the value is not 1.
+  int num_threads{1};
 };
 
 ///
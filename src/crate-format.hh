@@ -314,28 +314,6 @@ inline void hash_combine(std::size_t &seed, const T &v) {
 #endif
 }
 
-struct PathHasher {
-  size_t operator()(const Path &path) const {
-    size_t seed = std::hash<std::string>()(path.prim_part());
-    hash_combine(seed, std::hash<std::string>()(path.prop_part()));
-    //hash_combine(seed, std::hash<std::string>()(path.GetLocalPart()));
-    hash_combine(seed, std::hash<bool>()(path.is_valid()));
-
-    return seed;
-  }
-};
-
-struct PathKeyEqual {
-  bool operator()(const Path &lhs, const Path &rhs) const {
-    bool ret = lhs.prim_part() == rhs.prim_part();
-    ret &= lhs.prop_part() == rhs.prop_part();
-    //ret &= lhs.GetLocalPart() == rhs.GetLocalPart();
-    ret &= lhs.is_valid() == rhs.is_valid();
-
-    return ret;
-  }
-};
-
 struct FieldHasher {
   size_t operator()(const Field &field) const {
     size_t seed = std::hash<uint32_t>()(field.token_index.value);
@@ -495,8 +473,27 @@ class CrateValue {
     return value_;
   }
 
+  // Unpacking of the value is deferred(See
+  // `CrateReaderConfig::deferValueLoading`). Use
+  // `CrateReader::UnpackDeferredValueRep` to get the actual value.
+  void SetDeferred(const ValueRep &rep) {
+    value_ = nullptr;
+    deferred_ = true;
+    deferred_rep_ = rep;
+  }
+
+  bool is_deferred() const {
+    return deferred_;
+  }
+
+  const ValueRep &deferred_rep() const {
+    return deferred_rep_;
+  }
+
  private:
   value::Value value_;
+  bool deferred_{false};
+  ValueRep deferred_rep_{0};
 };
 
 // In-memory storage for a single "spec" -- prim, property, etc.
@@ -22,6 +22,7 @@
 #endif
 
 #include <unordered_set>
+#include <memory>
 #include <stack>
 
 #include "crate-format.hh"
@@ -37,6 +38,7 @@
 #include "value-types.hh"
 #include "tiny-format.hh"
 #include "str-util.hh"
+#include "thread-util.hh"
 
 //
 #ifdef __clang__
@@ -130,8 +132,9 @@ bool CrateReader::HasField(const std::string &key) const {
 
 nonstd::optional<crate::Field> CrateReader::GetField(crate::Index index) const {
 
-  if (index.value < _fields.size()) {
-    return _fields[index.value];
+  const std::vector<crate::Field> &fields = Tables()._fields;
+  if (index.value < fields.size()) {
+    return fields[index.value];
   } else {
     return nonstd::nullopt;
   }
@@ -139,8 +142,9 @@ nonstd::optional<crate::Field> CrateReader::GetField(crate::Index index) const {
 
 const nonstd::optional<value::token> CrateReader::GetToken(
     crate::Index token_index) const {
-  if (token_index.value < _tokens.size()) {
-    return _tokens[token_index.value];
+  const std::vector<value::token> &tokens = Tables()._tokens;
+  if (token_index.value < tokens.size()) {
+    return tokens[token_index.value];
   } else {
     return nonstd::nullopt;
   }
@@ -150,8 +154,9 @@ const nonstd::optional<value::token> CrateReader::GetToken(
 const nonstd::optional<value::token> CrateReader::GetStringToken(
     crate::Index string_index) const {
 
-  if (string_index.value < _string_indices.size()) {
-    crate::Index s_idx = _string_indices[string_index.value];
+  const std::vector<crate::Index> &string_indices = Tables()._string_indices;
+  if (string_index.value < string_indices.size()) {
+    crate::Index s_idx = string_indices[string_index.value];
     return GetToken(s_idx);
   } else {
     PUSH_ERROR("String index out of range: " +
@@ -161,35 +166,38 @@ const nonstd::optional<value::token> CrateReader::GetStringToken(
 }
 
 nonstd::optional<Path> CrateReader::GetPath(crate::Index index) const {
+  const std::vector<Path> &paths = Tables()._paths;
 
-  if (index.value < _paths.size()) {
+  if (index.value < paths.size()) {
     // ok
   } else {
     return nonstd::nullopt;
   }
 
-  return _paths[index.value];
+  return paths[index.value];
 }
 
 nonstd::optional<Path> CrateReader::GetElementPath(crate::Index index) const {
-  if (index.value < _elemPaths.size()) {
+  const std::vector<Path> &elemPaths = Tables()._elemPaths;
+  if (index.value < elemPaths.size()) {
     // ok
   } else {
     return nonstd::nullopt;
   }
 
-  return _elemPaths[index.value];
+  return elemPaths[index.value];
 }
 
 nonstd::optional<std::string> CrateReader::GetPathString(
     crate::Index index) const {
-  if (index.value < _paths.size()) {
+  const std::vector<Path> &paths = Tables()._paths;
+  if (index.value < paths.size()) {
     // ok
   } else {
     return nonstd::nullopt;
   }
 
-  const Path &p = _paths[index.value];
+  const Path &p = paths[index.value];
 
   return p.full_path_name();
 }
@@ -829,8 +837,6 @@ bool CrateReader::ReadTimeSamples(value::TimeSamples *d) {
             std::to_string(offset));
   }
 
-  // TODO(syoyo): Deduplicate times?
-
   crate::ValueRep times_rep{0};
   if (!ReadValueRep(&times_rep)) {
     PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to read ValueRep for TimeSample' `times` element.");
@@ -839,6 +845,10 @@ bool CrateReader::ReadTimeSamples(value::TimeSamples *d) {
   // Save offset
   auto values_offset = _sr->tell();
 
+  // `times` is deduplicated in Crate, so decode it once.
+  const std::vector<double> *ptimes = Tables().FindCachedTimes(times_rep.GetData());
+  if (!ptimes) {
+
   // TODO: Enable Check if  type `double[]`
 #if 0
   if (times_rep.GetType() == crate::CrateDataTypeId::CRATE_DATA_TYPE_DOUBLE_VECTOR) {
@@ -850,22 +860,24 @@ bool CrateReader::ReadTimeSamples(value::TimeSamples *d) {
   }
 #endif
 
-  crate::CrateValue times_value;
-  if (!UnpackValueRep(times_rep, &times_value)) {
-    PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to unpack value of TimeSample's `times` element.");
-  }
+    crate::CrateValue times_value;
+    if (!UnpackValueRep(times_rep, &times_value)) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to unpack value of TimeSample's `times` element.");
+    }
 
-  // must be an array of double.
-  DCOUT("TimeSample times:" << times_value.type_name());
+    // must be an array of double.
+    DCOUT("TimeSample times:" << times_value.type_name());
 
-  std::vector<double> times;
-  if (auto pv = times_value.get_value<std::vector<double>>()) {
-    times = pv.value();
-    DCOUT("`times` = " << times);
-  } else {
-    PUSH_ERROR_AND_RETURN_TAG(kTag, fmt::format("`times` in TimeSamples must be type `double[]`, but got type `{}`", times_value.type_name()));
+    if (auto pv = times_value.get_value<std::vector<double>>()) {
+      DCOUT("`times` = " << pv.value());
+      ptimes = Tables().CacheTimes(times_rep.GetData(), std::move(pv.value()));
+    } else {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, fmt::format("`times` in TimeSamples must be type `double[]`, but got type `{}`", times_value.type_name()));
+    }
   }
 
+  const std::vector<double> &times = *ptimes;
+
   //
   // Parse values(elements) of TimeSamples.
   //
@@ -933,7 +945,6 @@ bool CrateReader::ReadTimeSamples(value::TimeSamples *d) {
     PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to seek over TimeSamples's values.");
   }
 
-
   return true;
 }
 
@@ -954,9 +965,9 @@ bool CrateReader::ReadStringArray(std::vector<std::string> *d) {
 
     std::vector<crate::Index> ivalue(static_cast<size_t>(n));
 
-    if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                   size_t(n) * sizeof(crate::Index),
-                   reinterpret_cast<uint8_t *>(ivalue.data()))) {
+    if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                              size_t(n) * sizeof(crate::Index),
+                              reinterpret_cast<uint8_t *>(ivalue.data()))) {
       PUSH_ERROR("Failed to read STRING_VECTOR data.");
       return false;
     }
@@ -1134,9 +1145,9 @@ bool CrateReader::ReadPathArray(std::vector<Path> *d) {
 
     std::vector<crate::Index> ivalue(static_cast<size_t>(n));
 
-    if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                   size_t(n) * sizeof(crate::Index),
-                   reinterpret_cast<uint8_t *>(ivalue.data()))) {
+    if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                              size_t(n) * sizeof(crate::Index),
+                              reinterpret_cast<uint8_t *>(ivalue.data()))) {
       _err += "Failed to read ListOp data.\n";
       return false;
     }
@@ -1195,9 +1206,9 @@ bool CrateReader::ReadTokenListOp(ListOp<value::token> *d) {
 
     std::vector<crate::Index> ivalue(static_cast<size_t>(n));
 
-    if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                   size_t(n) * sizeof(crate::Index),
-                   reinterpret_cast<uint8_t *>(ivalue.data()))) {
+    if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                              size_t(n) * sizeof(crate::Index),
+                              reinterpret_cast<uint8_t *>(ivalue.data()))) {
       _err += "Failed to read ListOp data.\n";
       return false;
     }
@@ -1308,9 +1319,9 @@ bool CrateReader::ReadStringListOp(ListOp<std::string> *d) {
 
     std::vector<crate::Index> ivalue(static_cast<size_t>(n));
 
-    if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                   size_t(n) * sizeof(crate::Index),
-                   reinterpret_cast<uint8_t *>(ivalue.data()))) {
+    if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                              size_t(n) * sizeof(crate::Index),
+                              reinterpret_cast<uint8_t *>(ivalue.data()))) {
       _err += "Failed to read ListOp data.\n";
       return false;
     }
@@ -1421,9 +1432,9 @@ bool CrateReader::ReadPathListOp(ListOp<Path> *d) {
 
     std::vector<crate::Index> ivalue(static_cast<size_t>(n));
 
-    if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                   size_t(n) * sizeof(crate::Index),
-                   reinterpret_cast<uint8_t *>(ivalue.data()))) {
+    if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                              size_t(n) * sizeof(crate::Index),
+                              reinterpret_cast<uint8_t *>(ivalue.data()))) {
       PUSH_ERROR("Failed to read ListOp data..");
       return false;
     }
@@ -2333,9 +2344,9 @@ CrateReader::UnpackArrayValue(CrateDataTypeId dty, crate::CrateValue *value_out)
   }
 
   std::vector<crate::Index> v(static_cast<size_t>(n));
-  if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                 size_t(n) * sizeof(crate::Index),
-                 reinterpret_cast<uint8_t *>(v.data()))) {
+  if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                            size_t(n) * sizeof(crate::Index),
+                            reinterpret_cast<uint8_t *>(v.data()))) {
     PUSH_ERROR("Failed to read array data.");
     return false;
   }
@@ -2487,9 +2498,9 @@ bool CrateReader::UnpackValueRep(const crate::ValueRep &rep,
         CHECK_MEMORY_USAGE(n * sizeof(crate::Index));
 
         std::vector<crate::Index> v(static_cast<size_t>(n));
-        if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                       size_t(n) * sizeof(crate::Index),
-                       reinterpret_cast<uint8_t *>(v.data()))) {
+        if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                                  size_t(n) * sizeof(crate::Index),
+                                  reinterpret_cast<uint8_t *>(v.data()))) {
           PUSH_ERROR("Failed to read StringIndex array.");
           return false;
         }
@@ -2557,9 +2568,9 @@ bool CrateReader::UnpackValueRep(const crate::ValueRep &rep,
 
         std::vector<crate::Index> v;
         v.resize(static_cast<size_t>(n));
-        if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                       size_t(n) * sizeof(crate::Index),
-                       reinterpret_cast<uint8_t *>(v.data()))) {
+        if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                                  size_t(n) * sizeof(crate::Index),
+                                  reinterpret_cast<uint8_t *>(v.data()))) {
           PUSH_ERROR("Failed to read TokenIndex array.");
           return false;
         }
@@ -2598,9 +2609,9 @@ bool CrateReader::UnpackValueRep(const crate::ValueRep &rep,
         CHECK_MEMORY_USAGE(n * sizeof(crate::Index));
 
         std::vector<crate::Index> v(static_cast<size_t>(n));
-        if (!_sr->read(size_t(n) * sizeof(crate::Index),
-                       size_t(n) * sizeof(crate::Index),
-                       reinterpret_cast<uint8_t *>(v.data()))) {
+        if ((n > 0) && !_sr->read(size_t(n) * sizeof(crate::Index),
+                                  size_t(n) * sizeof(crate::Index),
+                                  reinterpret_cast<uint8_t *>(v.data()))) {
           PUSH_ERROR("Failed to read TokenIndex array.");
           return false;
         }
@@ -4114,9 +4125,9 @@ bool CrateReader::UnpackValueRep(const crate::ValueRep &rep,
       CHECK_MEMORY_USAGE(n * sizeof(crate::Index));
 
       std::vector<crate::Index> indices(static_cast<size_t>(n));
-      if (!_sr->read(static_cast<size_t>(n) * sizeof(crate::Index),
-                     static_cast<size_t>(n) * sizeof(crate::Index),
-                     reinterpret_cast<uint8_t *>(indices.data()))) {
+      if ((n > 0) && !_sr->read(static_cast<size_t>(n) * sizeof(crate::Index),
+                                static_cast<size_t>(n) * sizeof(crate::Index),
+                                reinterpret_cast<uint8_t *>(indices.data()))) {
         PUSH_ERROR("Failed to read TokenVector value.");
         return false;
       }
@@ -5890,7 +5901,227 @@ bool CrateReader::ReadFieldSets() {
   return true;
 }
 
+bool CrateReader::UnpackFieldValues(std::vector<FieldUnpackJob> &jobs,
+                                    size_t begin, size_t end) {
+  for (size_t i = begin; i < end; i++) {
+    const crate::ValueRep &rep = jobs[i].field->value_rep;
+    const uint64_t memory_usage = _memoryUsage;
+    if (!UnpackValueRep(rep, jobs[i].dst)) {
+      PUSH_ERROR("BuildLiveFieldSets: Failed to unpack ValueRep : "
+                 << rep.GetStringRepr());
+      return false;
+    }
+    jobs[i].nbytes = _memoryUsage - memory_usage;
+  }
+  return true;
+}
+
+const std::vector<double> *CrateReader::FindCachedTimes(uint64_t key) const {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<std::mutex> lock(_timesCacheMutex);
+#endif
+
+  const auto it = _timesCache.find(key);
+  if (it == _timesCache.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+const std::vector<double> *CrateReader::CacheTimes(
+    uint64_t key, std::vector<double> &&times) const {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<std::mutex> lock(_timesCacheMutex);
+#endif
+
+  // Keep the existing entry when another worker cached it first.
+  return &(_timesCache.emplace(key, std::move(times)).first->second);
+}
+
+namespace {
+
+// Attribute value which may be large: non-inlined array `default` value or
+// `timeSamples`.
+bool IsDeferrableField(const std::string &name, const crate::ValueRep &rep) {
+  if (rep.IsInlined()) {
+    return false;
+  }
+
+  if (name == "default") {
+    return rep.IsArray();
+  }
+
+  if (name == "timeSamples") {
+    return rep.GetType() ==
+           static_cast<int32_t>(crate::CrateDataTypeId::CRATE_DATA_TYPE_TIME_SAMPLES);
+  }
+
+  return false;
+}
+
+}  // namespace
+
+bool CrateReader::UnpackDeferredValueRep(const crate::ValueRep &rep,
+                                         crate::CrateValue *value,
+                                         std::string *err) const {
+  if (!value) {
+    if (err) {
+      (*err) += "`value` is nullptr.\n";
+    }
+    return false;
+  }
+
+  // Use a worker with its own StreamReader, so that multiple deferred values
+  // can be unpacked concurrently.
+  StreamReader sr(_sr->data(), _sr->size(), _sr->swap_endian());
+  std::unique_ptr<CrateReader> worker = CreateWorker(&sr);
+  worker->_tables = this;
+
+  bool ret = worker->UnpackValueRep(rep, value);
+  if (!ret && err) {
+    (*err) += worker->_err;
+    (*err) += "Failed to unpack deferred ValueRep : " + rep.GetStringRepr() +
+              "\n";
+  }
+
+  return ret;
+}
+
+namespace {
+
+// Type id of the value unpacked from the ValueRep of crate data type `dty`.
+bool GetValueTypeIdFromCrateDataType(crate::CrateDataTypeId dty, bool is_array,
+                                     uint32_t *type_id) {
+#define CRATE_TYPE_TO_TYPE_ID(__dty, __ty)                          \
+  case crate::CrateDataTypeId::__dty: {                             \
+    (*type_id) = is_array                                           \
+                     ? value::TypeTraits<std::vector<__ty>>::type_id() \
+                     : value::TypeTraits<__ty>::type_id();          \
+    return true;                                                    \
+  }
+
+  switch (dty) {
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_INT, int32_t)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_UINT, uint32_t)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_INT64, int64_t)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_UINT64, uint64_t)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_HALF, value::half)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_FLOAT, float)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_DOUBLE, double)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_STRING, std::string)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_TOKEN, value::token)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_ASSET_PATH, value::AssetPath)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_MATRIX2D, value::matrix2d)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_MATRIX3D, value::matrix3d)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_MATRIX4D, value::matrix4d)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_QUATD, value::quatd)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_QUATF, value::quatf)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_QUATH, value::quath)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC2D, value::double2)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC2F, value::float2)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC2H, value::half2)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC2I, value::int2)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC3D, value::double3)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC3F, value::float3)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC3H, value::half3)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC3I, value::int3)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC4D, value::double4)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC4F, value::float4)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC4H, value::half4)
+    CRATE_TYPE_TO_TYPE_ID(CRATE_DATA_TYPE_VEC4I, value::int4)
+    default:
+      break;
+  }
+
+#undef CRATE_TYPE_TO_TYPE_ID
+
+  // Other types(e.g. bool[], whose element representation differs) are
+  // resolved by unpacking.
+  return false;
+}
+
+}  // namespace
+
+bool CrateReader::GetDeferredValueTypeId(const crate::ValueRep &rep,
+                                         uint32_t *type_id) const {
+  if (!type_id) {
+    return false;
+  }
+
+  if (rep.GetType() !=
+      static_cast<int32_t>(crate::CrateDataTypeId::CRATE_DATA_TYPE_TIME_SAMPLES)) {
+    if (rep.IsInlined() && rep.IsArray()) {
+      return false;
+    }
+    return GetValueTypeIdFromCrateDataType(
+        static_cast<crate::CrateDataTypeId>(rep.GetType()), rep.IsArray(),
+        type_id);
+  }
+
+  // Walk the TimeSamples layout(See ReadTimeSamples) up to the values'
+  // ValueReps.
+  StreamReader sr(_sr->data(), _sr->size(), _sr->swap_endian());
+  if (!sr.seek_set(rep.GetPayload())) {
+    return false;
+  }
+
+  int64_t offset{0};
+  if (!sr.read8(&offset) || !sr.seek_from_current(offset - 8)) {
+    return false;
+  }
+
+  // Skip ValueRep of `times`.
+  if (!sr.seek_from_current(int64_t(sizeof(uint64_t)))) {
+    return false;
+  }
+
+  if (!sr.read8(&offset) || !sr.seek_from_current(offset - 8)) {
+    return false;
+  }
+
+  uint64_t num_values{0};
+  if (!sr.read8(&num_values)) {
+    return false;
+  }
+
+  if (num_values == 0) {
+    return false;
+  }
+
+  // TimeSamples reports the type of its first sample.
+  uint64_t data{0};
+  if (!sr.read8(&data)) {
+    return false;
+  }
+
+  crate::ValueRep sample_rep(data);
+  if (sample_rep.IsInlined() && sample_rep.IsArray()) {
+    return false;
+  }
+
+  return GetValueTypeIdFromCrateDataType(
+      static_cast<crate::CrateDataTypeId>(sample_rep.GetType()),
+      sample_rep.IsArray(), type_id);
+}
+
 bool CrateReader::BuildLiveFieldSets() {
+  // First collect every field to unpack, and unpack them after all
+  // `FieldValuePairVector`s are allocated. When multi-threading is enabled,
+  // fields are unpacked in parallel. Each Field is unpacked to its own slot,
+  // so the result is identical to the serial path.
+  const bool parallel =
+      (_config.numThreads > 1) && thread_util::IsThreadingAvailable();
+  std::vector<FieldUnpackJob> jobs;
+
+  // Crate stores identical values once, and many fields(e.g.
+  // `faceVertexCounts` of meshes with the same topology) refer to the same
+  // payload. Unpack each payload only once and copy the result to the other
+  // references after unpacking.
+  // <ValueRep, index to `jobs`>
+  std::unordered_map<uint64_t, size_t> unpacked_values;
+  // <destination, index to `jobs`>
+  std::vector<std::pair<crate::CrateValue *, size_t>> shared_values;
+
   for (auto fsBegin = _fieldset_indices.begin(),
             fsEnd = std::find(fsBegin, _fieldset_indices.end(), crate::Index());
        fsBegin != _fieldset_indices.end();
@@ -5901,7 +6132,6 @@ bool CrateReader::BuildLiveFieldSets() {
 
     pairs.resize(size_t(fsEnd - fsBegin));
     DCOUT("range size = " << (fsEnd - fsBegin));
-    // TODO(syoyo): Parallelize.
     for (size_t i = 0; fsBegin != fsEnd; ++fsBegin, ++i) {
       if (fsBegin->value < _fields.size()) {
         // ok
@@ -5915,17 +6145,87 @@ bool CrateReader::BuildLiveFieldSets() {
       if (auto tokv = GetToken(field.token_index)) {
         pairs[i].first = tokv.value().str();
 
-        if (!UnpackValueRep(field.value_rep, &pairs[i].second)) {
-          PUSH_ERROR("BuildLiveFieldSets: Failed to unpack ValueRep : "
-                     << field.value_rep.GetStringRepr());
-          return false;
+        if (_config.deferValueLoading &&
+            IsDeferrableField(pairs[i].first, field.value_rep)) {
+          pairs[i].second.SetDeferred(field.value_rep);
+          continue;
         }
+
+        if (!field.value_rep.IsInlined()) {
+          auto it = unpacked_values.find(field.value_rep.GetData());
+          if (it != unpacked_values.end()) {
+            shared_values.push_back({&pairs[i].second, it->second});
+            continue;
+          }
+          unpacked_values.emplace(field.value_rep.GetData(), jobs.size());
+        }
+
+        // `pairs` is not resized anymore, so the address is stable.
+        FieldUnpackJob job;
+        job.field = &field;
+        job.dst = &pairs[i].second;
+        jobs.push_back(job);
       } else {
         PUSH_ERROR("Invalid token index.");
       }
     }
   }
 
+  if (!parallel) {
+    if (!UnpackFieldValues(jobs, 0, jobs.size())) {
+      return false;
+    }
+  } else if (!jobs.empty()) {
+    // Too small chunks are not worth to spawn a thread.
+    constexpr size_t kMinFieldsPerChunk = 256;
+
+    size_t nchunks = thread_util::GetNumChunks(jobs.size(), _config.numThreads,
+                                               kMinFieldsPerChunk);
+
+    std::vector<std::unique_ptr<StreamReader>> srs(nchunks);
+    std::vector<std::unique_ptr<CrateReader>> workers(nchunks);
+    for (size_t c = 0; c < nchunks; c++) {
+      srs[c].reset(
+          new StreamReader(_sr->data(), _sr->size(), _sr->swap_endian()));
+      workers[c] = CreateWorker(srs[c].get());
+      workers[c]->_tables = this;
+    }
+
+    std::vector<int> results(nchunks, 0);
+
+    thread_util::ParallelForChunked(
+        0, jobs.size(), _config.numThreads, kMinFieldsPerChunk,
+        [&](size_t begin, size_t end, size_t c) {
+          results[c] =
+              workers[c]->UnpackFieldValues(jobs, begin, end) ? 1 : 0;
+        });
+
+    bool ok = true;
+    for (size_t c = 0; c < nchunks; c++) {
+      _warn += workers[c]->_warn;
+      _err += workers[c]->_err;
+      _memoryUsage += workers[c]->_memoryUsage;
+      if (!results[c]) {
+        ok = false;
+      }
+    }
+
+    if (!ok) {
+      return false;
+    }
+
+    if (_memoryUsage > _config.maxMemoryBudget) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Reached to max memory budget.");
+    }
+  }
+
+  // Each copy takes the same amount of memory as the unpacked value.
+  for (auto &item : shared_values) {
+    const FieldUnpackJob &src = jobs[item.second];
+    CHECK_MEMORY_USAGE(src.nbytes);
+    (*item.first) = (*src.dst);
+  }
+
   DCOUT("# of live fieldsets = " << _live_fieldsets.size());
 
 #ifdef TINYUSDZ_LOCAL_DEBUG_PRINT
@@ -6190,6 +6490,128 @@ bool CrateReader::ReadPaths() {
   return true;
 }
 
+std::unique_ptr<CrateReader> CrateReader::CreateWorker(StreamReader *sr) const {
+  CrateReaderConfig config = _config;
+  config.numThreads = 1;
+  // Each worker can use the remaining budget. Total usage must be checked
+  // again after merging the result of workers.
+  config.maxMemoryBudget = (_memoryUsage < _config.maxMemoryBudget)
+                               ? (_config.maxMemoryBudget - _memoryUsage)
+                               : 0;
+
+  std::unique_ptr<CrateReader> w(new CrateReader(sr, config));
+
+  memcpy(w->_version, _version, sizeof(_version));
+  w->_toc = _toc;
+  w->_toc_offset = _toc_offset;
+  w->_tokens_index = _tokens_index;
+  w->_paths_index = _paths_index;
+  w->_strings_index = _strings_index;
+  w->_fields_index = _fields_index;
+  w->_fieldsets_index = _fieldsets_index;
+  w->_specs_index = _specs_index;
+
+  return w;
+}
+
+bool CrateReader::ReadKnownSections() {
+  if ((_config.numThreads <= 1) || !thread_util::IsThreadingAvailable()) {
+    if (!ReadTokens()) {
+      return false;
+    }
+    if (!ReadStrings()) {
+      return false;
+    }
+    if (!ReadFields()) {
+      return false;
+    }
+    if (!ReadFieldSets()) {
+      return false;
+    }
+    if (!ReadPaths()) {
+      return false;
+    }
+    if (!ReadSpecs()) {
+      return false;
+    }
+    return true;
+  }
+
+  //
+  // Sections are independent after TOC has been read, except that PATHS
+  // requires TOKENS for element names.
+  // Each task uses its own CrateReader(and StreamReader) so that the read
+  // cursor, error message and memory usage are not shared between threads.
+  // Results are moved back to this reader after all tasks are finished.
+  //
+  enum SectionTask {
+    kTokensAndPaths = 0,
+    kStringsAndFields,
+    kFieldSets,
+    kSpecs,
+    kNumSectionTasks
+  };
+
+  if (_memoryUsage > _config.maxMemoryBudget) {
+    PUSH_ERROR_AND_RETURN_TAG(kTag, "Reached to max memory budget.");
+  }
+
+  std::vector<std::unique_ptr<StreamReader>> task_srs(kNumSectionTasks);
+  std::vector<std::unique_ptr<CrateReader>> tasks(kNumSectionTasks);
+  for (size_t i = 0; i < kNumSectionTasks; i++) {
+    task_srs[i].reset(
+        new StreamReader(_sr->data(), _sr->size(), _sr->swap_endian()));
+    tasks[i] = CreateWorker(task_srs[i].get());
+  }
+
+  std::vector<int> results(kNumSectionTasks, 0);
+
+  thread_util::ParallelFor(
+      0, kNumSectionTasks, _config.numThreads, [&](size_t i) {
+        CrateReader *t = tasks[i].get();
+        bool ret = false;
+        if (i == kTokensAndPaths) {
+          ret = t->ReadTokens() && t->ReadPaths();
+        } else if (i == kStringsAndFields) {
+          ret = t->ReadStrings() && t->ReadFields();
+        } else if (i == kFieldSets) {
+          ret = t->ReadFieldSets();
+        } else if (i == kSpecs) {
+          ret = t->ReadSpecs();
+        }
+        results[i] = ret ? 1 : 0;
+      });
+
+  bool ok = true;
+  for (size_t i = 0; i < kNumSectionTasks; i++) {
+    _warn += tasks[i]->_warn;
+    _err += tasks[i]->_err;
+    _memoryUsage += tasks[i]->_memoryUsage;
+    if (!results[i]) {
+      ok = false;
+    }
+  }
+
+  if (!ok) {
+    return false;
+  }
+
+  if (_memoryUsage > _config.maxMemoryBudget) {
+    PUSH_ERROR_AND_RETURN_TAG(kTag, "Reached to max memory budget.");
+  }
+
+  _tokens = std::move(tasks[kTokensAndPaths]->_tokens);
+  _paths = std::move(tasks[kTokensAndPaths]->_paths);
+  _elemPaths = std::move(tasks[kTokensAndPaths]->_elemPaths);
+  _nodes = std::move(tasks[kTokensAndPaths]->_nodes);
+  _string_indices = std::move(tasks[kStringsAndFields]->_string_indices);
+  _fields = std::move(tasks[kStringsAndFields]->_fields);
+  _fieldset_indices = std::move(tasks[kFieldSets]->_fieldset_indices);
+  _specs = std::move(tasks[kSpecs]->_specs);
+
+  return true;
+}
+
 bool CrateReader::ReadBootStrap() {
   // parse header.
   uint8_t magic[8];
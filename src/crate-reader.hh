@@ -3,9 +3,15 @@
 // Copyright 2023 - Present, Light Transport Entertainment Inc.
 #pragma once
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
+#if defined(TINYUSDZ_ENABLE_THREAD)
+#include <mutex>
+#endif
+
 //
 #include "nonstd/optional.hpp"
 //
@@ -54,6 +60,13 @@ struct CrateReaderConfig {
   // Total memory budget for uncompressed USD data(vertices, `tokens`, ...)` in
   // [bytes].
   size_t maxMemoryBudget = std::numeric_limits<int32_t>::max();  // Default 2GB
+
+  // Do not unpack non-inlined array `default` values and `timeSamples` in
+  // BuildLiveFieldSets. Such fields are marked as deferred
+  // (`CrateValue::is_deferred()`) and unpacked later with
+  // `UnpackDeferredValueRep`.
+  // The input data and CrateReader must be alive until then.
+  bool deferValueLoading = false;
 };
 
 ///
@@ -162,6 +175,17 @@ class CrateReader {
   ///
   bool ReadSection(crate::Section *s);
 
+  ///
+  /// Read all known sections(TOKENS, STRINGS, FIELDS, FIELDSETS, PATHS and
+  /// SPECS).
+  ///
+  /// When `CrateReaderConfig::numThreads` > 1 and TinyUSDZ is built with
+  /// `TINYUSDZ_ENABLE_THREAD`, sections are decoded concurrently(PATHS is
+  /// decoded after TOKENS since it requires tokens). Otherwise each section is
+  /// read serially in the order listed above.
+  ///
+  bool ReadKnownSections();
+
   // Read known sections
   bool ReadPaths();
   bool ReadTokens();
@@ -170,8 +194,32 @@ class CrateReader {
   bool ReadFieldSets();
   bool ReadSpecs();
 
+  ///
+  /// Unpack the values of all fields and build `FieldValuePairVector` for
+  /// each fieldset.
+  /// When `CrateReaderConfig::numThreads` > 1(and TinyUSDZ is built with
+  /// `TINYUSDZ_ENABLE_THREAD`), values are unpacked in parallel.
+  ///
   bool BuildLiveFieldSets();
 
+  ///
+  /// Unpack a ValueRep which was deferred in `BuildLiveFieldSets`.
+  /// Can be called concurrently from multiple threads after
+  /// `BuildLiveFieldSets`, since each call decodes with its own StreamReader.
+  ///
+  bool UnpackDeferredValueRep(const crate::ValueRep &rep,
+                              crate::CrateValue *value, std::string *err) const;
+
+  ///
+  /// Get the type id(value::TypeId) of the value of a deferred ValueRep
+  /// without unpacking it. For TimeSamples, only the ValueRep of the first
+  /// sample is read.
+  ///
+  /// @return false when the type cannot be determined without unpacking.
+  ///
+  bool GetDeferredValueTypeId(const crate::ValueRep &rep,
+                              uint32_t *type_id) const;
+
   std::string GetError();
   std::string GetWarning();
 
@@ -295,6 +343,23 @@ class CrateReader {
 #endif
 
   bool UnpackValueRep(const crate::ValueRep &rep, crate::CrateValue *value);
+
+  // Field to unpack and its destination. Used in BuildLiveFieldSets().
+  struct FieldUnpackJob {
+    const crate::Field *field{nullptr};
+    crate::CrateValue *dst{nullptr};
+    uint64_t nbytes{0};  // [out] Memory usage of the unpacked value.
+  };
+
+  // Unpack jobs[begin, end)
+  bool UnpackFieldValues(std::vector<FieldUnpackJob> &jobs, size_t begin,
+                         size_t end);
+
+  // Decoded `times` of TimeSamples shared across workers. Returns nullptr when
+  // not cached.
+  const std::vector<double> *FindCachedTimes(uint64_t key) const;
+  const std::vector<double> *CacheTimes(uint64_t key,
+                                        std::vector<double> &&times) const;
   bool UnpackInlinedValueRep(const crate::ValueRep &rep,
                              crate::CrateValue *value);
 
@@ -377,6 +442,13 @@ class CrateReader {
   // Read 64bit uint with range check
   bool ReadNum(uint64_t &n, uint64_t maxnum);
 
+  ///
+  /// Create a reader which reads from `sr` with the same version and TOC as
+  /// this reader. Used for decoding Crate data concurrently(each thread must
+  /// use its own StreamReader).
+  ///
+  std::unique_ptr<CrateReader> CreateWorker(StreamReader *sr) const;
+
   // Header(bootstrap)
   uint8_t _version[3] = {0, 0, 0};
 
@@ -418,8 +490,25 @@ class CrateReader {
   // To prevent recursive Value unpack(The Value encodes itself)
   std::unordered_set<uint64_t> unpackRecursionGuard;
 
+  // Decoded `times` of TimeSamples keyed by ValueRep(payload offset and
+  // type). Animated attributes usually share the same `times` array.
+  // Workers(including the ones for deferred values) use the cache of
+  // `Tables()`. Entries are never removed, so a pointer to the cached
+  // `times` is valid while the reader is alive.
+  mutable std::unordered_map<uint64_t, std::vector<double>> _timesCache;
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  mutable std::mutex _timesCacheMutex;
+#endif
+
   CrateReaderConfig _config;
 
+  // Non-null for a worker reader created by `CreateWorker()`.
+  // Section tables(tokens, strings, fields, paths) are looked up from this
+  // reader so that workers do not need their own copy.
+  const CrateReader *_tables{nullptr};
+
+  const CrateReader &Tables() const { return _tables ? *_tables : *this; }
+
   // Approximated uncompressed memory usage(vertices, `tokens`, ...) in bytes.
   uint64_t _memoryUsage{0};
 
@@ -1,6 +1,7 @@
 #include <limits>
 #include <cstdint>
 #include <cstring>
+#include <array>
 
 #include "crate-writer.hh"
 #include "value-types.hh"
@@ -95,8 +96,8 @@ nonstd::optional<Tto> TryExactlyRepresentable(const Tfrom &from) {
 //   - Diagonal matrix as int8 x N  (n = 2, 3 or 4)
 //   - empty dictionary
 
-inline nonstd::optional<uint32_t> TryEncodeInline(double v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(double v) {
+  uint32_t dst{0};
 
   nonstd::optional<float> f = TryExactlyRepresentable<double, float>(v);
 
@@ -108,8 +109,8 @@ inline nonstd::optional<uint32_t> TryEncodeInline(double v) {
   return nonstd::nullopt;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(uint64_t v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(uint64_t v) {
+  uint32_t dst{0};
 
   nonstd::optional<uint32_t> f = TryExactlyRepresentable<uint64_t, uint32_t>(v);
 
@@ -121,8 +122,8 @@ inline nonstd::optional<uint32_t> TryEncodeInline(uint64_t v) {
   return nonstd::nullopt;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(int64_t v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(int64_t v) {
+  uint32_t dst{0};
 
   nonstd::optional<int32_t> f = TryExactlyRepresentable<int64_t, int32_t>(v);
 
@@ -134,8 +135,8 @@ inline nonstd::optional<uint32_t> TryEncodeInline(int64_t v) {
   return nonstd::nullopt;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::vector3f v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(value::vector3f v) {
+  uint32_t dst{0};
 
   // Check if each component of the vector can be represented by int8.
   std::array<int8_t, 3> ivec;
@@ -151,8 +152,8 @@ inline nonstd::optional<uint32_t> TryEncodeInline(value::vector3f v) {
   return dst;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::vector3d v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(value::vector3d v) {
+  uint32_t dst{0};
 
   // Check if each component of the vector can be represented by int8.
   std::array<int8_t, 3> ivec;
@@ -168,8 +169,8 @@ inline nonstd::optional<uint32_t> TryEncodeInline(value::vector3d v) {
   return dst;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::color4f v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(value::color4f v) {
+  uint32_t dst{0};
 
   // Check if each component of the vector can be represented by int8.
   std::array<int8_t, 4> ivec;
@@ -185,8 +186,8 @@ inline nonstd::optional<uint32_t> TryEncodeInline(value::color4f v) {
   return dst;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::color4d v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(value::color4d v) {
+  uint32_t dst{0};
 
   // Check if each component of the vector can be represented by int8.
   std::array<int8_t, 4> ivec;
@@ -202,12 +203,67 @@ inline nonstd::optional<uint32_t> TryEncodeInline(value::color4d v) {
   return dst;
 }
 
-//
-// TODO: Implement more TryEncodeInline for scalar value types
-//
+namespace {
+
+// Check if each component of the vector can be represented by int8.
+template<typename T, size_t N>
+nonstd::optional<uint32_t> TryEncodeInlineVec(const std::array<T, N> &v) {
+  static_assert(N <= 4, "");
+  uint32_t dst{0};
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix2d v) {
-  uint32_t dst;
+  std::array<int8_t, N> ivec;
+  for (size_t i = 0; i < N; i++) {
+    if (auto f = TryExactlyRepresentable<T, int8_t>(v[i])) {
+      ivec[i] = f.value();
+    } else {
+      return nonstd::nullopt;
+    }
+  }
+
+  memcpy(&dst, &ivec[0], sizeof(ivec));
+  return dst;
+}
+
+} // namespace
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::int2 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::int3 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::int4 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::float2 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::float3 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::float4 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::double2 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::double3 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::double4 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(value::matrix2d v) {
+  uint32_t dst{0};
 
   // Check if a matrix is a diagonal matrix and its diagonal component can be represented by int8.
   std::array<int8_t, 2> diag;
@@ -232,8 +288,8 @@ inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix2d v) {
   return dst;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix3d v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(value::matrix3d v) {
+  uint32_t dst{0};
 
   // Check if a matrix is a diagonal matrix and its diagonal component can be represented by int8.
   std::array<int8_t, 3> diag;
@@ -258,8 +314,8 @@ inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix3d v) {
   return dst;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix4d v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(value::matrix4d v) {
+  uint32_t dst{0};
 
   // Check if a matrix is a diagonal matrix and its diagonal component can be represented by int8.
   std::array<int8_t, 4> diag;
@@ -284,7 +340,7 @@ inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix4d v) {
   return dst;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::dict v) {
+nonstd::optional<uint32_t> TryEncodeInline(value::dict v) {
   uint32_t dst{0};
 
   if (v.empty()) {
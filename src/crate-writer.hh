@@ -5,10 +5,60 @@
 //
 #pragma once
 
+#include <cstdint>
+
+#include "value-types.hh"
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Weverything"
+#endif
+
+// TODO: Use std:: version for C++17
+#include "nonstd/optional.hpp"
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
 namespace tinyusdz {
 namespace crate {
 
+///
+/// Try to encode a value into the 32bit payload of an inlined ValueRep.
+/// Returns nullopt when the value cannot be exactly represented in inlined
+/// form and must be written to the value data section.
+///
+/// - double: as float
+/// - (u)int64: as (u)int32
+/// - vector: as int8 x N (N = 2, 3 or 4)
+/// - Diagonal matrix: as int8 x N (N = 2, 3 or 4)
+/// - dictionary: empty dictionary only
+///
+nonstd::optional<uint32_t> TryEncodeInline(double v);
+nonstd::optional<uint32_t> TryEncodeInline(uint64_t v);
+nonstd::optional<uint32_t> TryEncodeInline(int64_t v);
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::int2 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::int3 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::int4 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::float2 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::float3 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::float4 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::double2 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::double3 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::double4 &v);
+
+nonstd::optional<uint32_t> TryEncodeInline(value::vector3f v);
+nonstd::optional<uint32_t> TryEncodeInline(value::vector3d v);
+nonstd::optional<uint32_t> TryEncodeInline(value::color4f v);
+nonstd::optional<uint32_t> TryEncodeInline(value::color4d v);
+
+nonstd::optional<uint32_t> TryEncodeInline(value::matrix2d v);
+nonstd::optional<uint32_t> TryEncodeInline(value::matrix3d v);
+nonstd::optional<uint32_t> TryEncodeInline(value::matrix4d v);
+
+nonstd::optional<uint32_t> TryEncodeInline(value::dict v);
 
 } // namespace crate
 } // namespace tinyusdz
-
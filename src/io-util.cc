@@ -333,6 +333,78 @@ bool UnmapFile(const MMapFileHandle &handle, std::string *err) {
 #endif
 }
 
+FileReader::~FileReader() { close(); }
+
+bool FileReader::open(const std::string &filepath, std::string *err) {
+  close();
+
+#if defined(_WIN32)
+  _fp = _wfopen(UTF8ToWchar(filepath).c_str(), L"rb");
+#else
+  _fp = std::fopen(filepath.c_str(), "rb");
+#endif
+  if (!_fp) {
+    if (err) {
+      (*err) += "File open error : " + filepath + "\n";
+    }
+    return false;
+  }
+
+#if defined(_WIN32)
+  bool ok = (_fseeki64(_fp, 0, SEEK_END) == 0);
+  int64_t sz = ok ? int64_t(_ftelli64(_fp)) : -1;
+#else
+  bool ok = (fseeko(_fp, 0, SEEK_END) == 0);
+  int64_t sz = ok ? int64_t(ftello(_fp)) : -1;
+#endif
+  if (sz < 0) {
+    if (err) {
+      (*err) += "Invalid file size : " + filepath +
+                " (does the path point to a directory?)\n";
+    }
+    close();
+    return false;
+  }
+
+  _size = uint64_t(sz);
+  _pos = _size;
+
+  return true;
+}
+
+void FileReader::close() {
+  if (_fp) {
+    std::fclose(_fp);
+    _fp = nullptr;
+  }
+  _size = 0;
+  _pos = 0;
+}
+
+uint64_t FileReader::read(uint64_t offset, uint64_t n, uint8_t *dst) {
+  if (!_fp || !dst || (offset >= _size)) {
+    return 0;
+  }
+
+  if (offset != _pos) {
+#if defined(_WIN32)
+    bool ok = (_fseeki64(_fp, int64_t(offset), SEEK_SET) == 0);
+#else
+    bool ok = (fseeko(_fp, off_t(offset), SEEK_SET) == 0);
+#endif
+    if (!ok) {
+      return 0;
+    }
+    _pos = offset;
+  }
+
+  n = (std::min)(n, _size - offset);
+  size_t nread = std::fread(dst, 1, size_t(n), _fp);
+  _pos += nread;
+
+  return uint64_t(nread);
+}
+
 std::string ExpandFilePath(const std::string &_filepath, void *) {
   std::string filepath = _filepath;
   if (filepath.size() > 2048) {
@@ -894,6 +966,39 @@ bool FileExists(const std::string &filepath, void *userdata) {
   return ret;
 }
 
+bool GetFileStat(const std::string &filepath, uint64_t *size, int64_t *mtime) {
+  if (!size || !mtime) {
+    return false;
+  }
+
+#if defined(TINYUSDZ_ANDROID_LOAD_FROM_ASSETS) || defined(__wasi__)
+  (void)filepath;
+  return false;
+#else
+  std::error_code ec;
+#if defined(_WIN32)
+  const ghc::filesystem::path p(UTF8ToWchar(filepath));
+#else
+  const ghc::filesystem::path p(filepath);
+#endif
+
+  const uintmax_t sz = ghc::filesystem::file_size(p, ec);
+  if (ec) {
+    return false;
+  }
+
+  const auto t = ghc::filesystem::last_write_time(p, ec);
+  if (ec) {
+    return false;
+  }
+
+  (*size) = uint64_t(sz);
+  (*mtime) = int64_t(t.time_since_epoch().count());
+
+  return true;
+#endif
+}
+
 std::string FindFile(const std::string &filename,
                      const std::vector<std::string> &search_paths) {
   // TODO: Use ghc filesystem?
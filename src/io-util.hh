@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdio>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -102,6 +103,15 @@ std::string ExpandFilePath(const std::string &filepath,
 
 bool FileExists(const std::string &filepath, void *userdata = nullptr);
 
+///
+/// Get the size and the last modification time of a file.
+/// `mtime` is only meaningful for checking if the file has been modified.
+///
+/// @return false when the file does not exist or the information is not
+/// available on the platform.
+///
+bool GetFileStat(const std::string &filepath, uint64_t *size, int64_t *mtime);
+
 ///
 /// Find file from search paths.
 /// Returns empty string if a file is not found.
@@ -148,6 +158,39 @@ bool MMapFile(const std::string &filepath, MMapFileHandle *handle, bool writable
 ///
 bool UnmapFile(const MMapFileHandle &handle, std::string *err);
 
+///
+/// Read a part of a file without reading whole file content(e.g. for chunked
+/// parsing of a large USDA file).
+/// Filepath is treated as WideChar(UNICODE) on Windows.
+///
+class FileReader {
+ public:
+  FileReader() = default;
+  ~FileReader();
+
+  FileReader(const FileReader &) = delete;
+  FileReader &operator=(const FileReader &) = delete;
+
+  bool open(const std::string &filepath, std::string *err);
+  void close();
+
+  bool is_open() const { return _fp != nullptr; }
+
+  // File size in bytes.
+  uint64_t size() const { return _size; }
+
+  ///
+  /// Read up to `n` bytes at byte offset `offset` into `dst`.
+  /// Returns the number of bytes read(0 = EOF or read error).
+  ///
+  uint64_t read(uint64_t offset, uint64_t n, uint8_t *dst);
+
+ private:
+  std::FILE *_fp{nullptr};
+  uint64_t _size{0};
+  uint64_t _pos{0};
+};
+
 ///
 /// Filepath is treated as WideChar(UNICODE) on Windows.
 ///
@@ -246,14 +246,15 @@ std::string print_typed_timesamples(const TypedTimeSamples<T> &v,
 
   ss << "{\n";
 
-  const auto &samples = v.get_samples();
+  const auto &times = v.get_times();
+  const auto &values = v.get_values();
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    ss << pprint::Indent(indent + 1) << samples[i].t << ": ";
-    if (samples[i].blocked) {
+  for (size_t i = 0; i < times.size(); i++) {
+    ss << pprint::Indent(indent + 1) << times[i] << ": ";
+    if (v.is_blocked(i)) {
       ss << "None";
     } else {
-      ss << samples[i].value;
+      ss << values[i];
     }
     ss << ",\n";
   }
@@ -270,14 +271,15 @@ std::string print_typed_token_timesamples(const TypedTimeSamples<T> &v,
 
   ss << "{\n";
 
-  const auto &samples = v.get_samples();
+  const auto &times = v.get_times();
+  const auto &values = v.get_values();
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    ss << pprint::Indent(indent + 1) << samples[i].t << ": ";
-    if (samples[i].blocked) {
+  for (size_t i = 0; i < times.size(); i++) {
+    ss << pprint::Indent(indent + 1) << times[i] << ": ";
+    if (v.is_blocked(i)) {
       ss << "None";
     } else {
-      ss << quote(to_string(samples[i].value));
+      ss << quote(to_string(values[i]));
     }
     ss << ",\n";
   }
@@ -293,14 +295,15 @@ static std::string print_str_timesamples(const TypedTimeSamples<std::string> &v,
 
   ss << "{\n";
 
-  const auto &samples = v.get_samples();
+  const auto &times = v.get_times();
+  const auto &values = v.get_values();
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    ss << pprint::Indent(indent + 1) << samples[i].t << ": ";
-    if (samples[i].blocked) {
+  for (size_t i = 0; i < times.size(); i++) {
+    ss << pprint::Indent(indent + 1) << times[i] << ": ";
+    if (v.is_blocked(i)) {
       ss << "None";
     } else {
-      ss << buildEscapedAndQuotedStringForUSDA(samples[i].value);
+      ss << buildEscapedAndQuotedStringForUSDA(values[i]);
     }
     ss << ",\n";
   }
@@ -1288,8 +1291,12 @@ std::string print_timesamples(const value::TimeSamples &v,
 
   for (size_t i = 0; i < v.size(); i++) {
     ss << pprint::Indent(indent + 1);
-    ss << v.get_samples()[i].t << ": "
-       << value::pprint_value(v.get_samples()[i].value);
+    ss << v.get_times()[i] << ": ";
+    if (v.is_blocked(i)) {
+      ss << "None";
+    } else {
+      ss << value::pprint_value(v.get_value(i).value());
+    }
     ss << ",\n";  // USDA allow ',' for the last item
   }
   ss << pprint::Indent(indent) << "}\n";
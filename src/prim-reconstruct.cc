@@ -95,6 +95,122 @@ struct ParseResult
   std::string err;
 };
 
+// FNV-1a. constexpr so that the hash of a schema property name(string
+// literal) is computed at compile time.
+constexpr uint32_t PropertyNameHash(const char *s,
+                                    uint32_t h = 2166136261u) {
+  return (*s) ? PropertyNameHash(s + 1, (h ^ uint32_t(uint8_t(*s))) * 16777619u)
+              : h;
+}
+
+inline uint32_t PropertyNameHash(const std::string &s) {
+  uint32_t h = 2166136261u;
+  for (const char c : s) {
+    h = (h ^ uint32_t(uint8_t(c))) * 16777619u;
+  }
+  return h;
+}
+
+///
+/// Properties to reconstruct a Prim, and the set of already processed
+/// properties.
+///
+/// - The hash of each property name is computed once, so PARSE_*** macros
+///   only compare integers for properties which are not the target.
+/// - Processed properties are tracked with a bitset indexed by the order in
+///   PropertyMap.
+///
+class PropertyTable {
+ public:
+  struct Item {
+    Item(const std::string &name, const Property &prop, uint32_t idx)
+        : first(name), second(prop), hash(PropertyNameHash(name)), index(idx) {}
+
+    const std::string &first;
+    const Property &second;
+    uint32_t hash;
+    uint32_t index;  // Index in PropertyMap.
+  };
+
+  explicit PropertyTable(const PropertyMap &properties) {
+    _items.reserve(properties.size());
+    for (const auto &prop : properties) {
+      _items.emplace_back(prop.first, prop.second, uint32_t(_items.size()));
+    }
+    if (_items.size() > 64) {
+      _ext_bits.resize((_items.size() - 64 + 63) / 64, 0);
+    }
+  }
+
+  std::vector<Item>::const_iterator begin() const { return _items.begin(); }
+  std::vector<Item>::const_iterator end() const { return _items.end(); }
+
+  // Same API with std::set<std::string>
+  size_t count(const std::string &name) const {
+    if (const Item *item = find(name)) {
+      return count(*item);
+    }
+    return _others.count(name);
+  }
+
+  void insert(const std::string &name) {
+    if (const Item *item = find(name)) {
+      insert(*item);
+    } else {
+      _others.insert(name);
+    }
+  }
+
+  size_t count(const Item &item) const {
+    if (item.index < 64) {
+      return (_bits >> item.index) & 1;
+    }
+    size_t i = item.index - 64;
+    return (_ext_bits[i / 64] >> (i % 64)) & 1;
+  }
+
+  void insert(const Item &item) {
+    if (item.index < 64) {
+      _bits |= (uint64_t(1) << item.index);
+    } else {
+      size_t i = item.index - 64;
+      _ext_bits[i / 64] |= (uint64_t(1) << (i % 64));
+    }
+  }
+
+  // Get the names of processed properties.
+  void get_processed_names(std::set<std::string> *names) const {
+    for (const Item &item : _items) {
+      if (count(item)) {
+        names->insert(item.first);
+      }
+    }
+    names->insert(_others.begin(), _others.end());
+  }
+
+ private:
+  const Item *find(const std::string &name) const {
+    // `_items` are sorted by name since PropertyMap is std::map.
+    auto it = std::lower_bound(
+        _items.begin(), _items.end(), name,
+        [](const Item &item, const std::string &rhs) { return item.first < rhs; });
+    if ((it != _items.end()) && (it->first == name)) {
+      return &(*it);
+    }
+    return nullptr;
+  }
+
+  std::vector<Item> _items;
+  uint64_t _bits{0};
+  std::vector<uint64_t> _ext_bits;
+  std::set<std::string> _others;  // Processed names not in PropertyMap.
+};
+
+// `__name` is a string literal or constexpr string in most case, so its hash
+// is folded to a compile-time constant.
+#define IS_PROPERTY_NAME(__prop, __name) \
+  (((__prop).hash == PropertyNameHash(__name)) && ((__prop).first == (__name)))
+
 #if 0
 inline std::string to_string(ParseResult::ResultCode rescode) {
   switch (rescode) {
@@ -137,14 +253,16 @@ static nonstd::optional<Animatable<T>> ConvertToAnimatable(const primvar::PrimVa
   }
 
   if (var.has_timesamples()) {
-    for (size_t i = 0; i < var.ts_raw().size(); i++) {
-      const value::TimeSamples::Sample &s = var.ts_raw().get_samples()[i];
+    const value::TimeSamples &ts = var.ts_raw();
+    dst.reserve_timesamples(ts.size());
+    for (size_t i = 0; i < ts.size(); i++) {
+      const double t = ts.get_times()[i];
 
       // Attribute Block?
-      if (s.blocked) {
-        dst.add_blocked_sample(s.t);
-      } else if (auto pv = s.value.get_value<T>()) {
-        dst.add_sample(s.t, pv.value());
+      if (ts.is_blocked(i)) {
+        dst.add_blocked_sample(t);
+      } else if (auto pv = ts.get_value(i).value().get_value<T>()) {
+        dst.add_sample(t, pv.value());
       } else {
         // Type mismatch
         DCOUT(i << "/" << var.ts_raw().size() << " type mismatch.");
@@ -196,18 +314,19 @@ nonstd::optional<Animatable<Extent>> ConvertToAnimatable(const primvar::PrimVar
   }
 
   if (var.has_timesamples()) {
-    for (size_t i = 0; i < var.ts_raw().size(); i++) {
-      const value::TimeSamples::Sample &s = var.ts_raw().get_samples()[i];
+    const value::TimeSamples &ts = var.ts_raw();
+    for (size_t i = 0; i < ts.size(); i++) {
+      const double t = ts.get_times()[i];
 
       // Attribute Block?
-      if (s.blocked) {
-        dst.add_blocked_sample(s.t);
-      } else if (auto pv = s.value.get_value<std::vector<value::float3>>()) {
+      if (ts.is_blocked(i)) {
+        dst.add_blocked_sample(t);
+      } else if (auto pv = ts.get_value(i).value().get_value<std::vector<value::float3>>()) {
         if (pv.value().size() == 2) {
           Extent ext;
           ext.lower = pv.value()[0];
           ext.upper = pv.value()[1];
-          dst.add_sample(s.t, ext);
+          dst.add_sample(t, ext);
         } else {
           DCOUT(i << "/" << var.ts_raw().size() << " array size mismatch.");
           return nonstd::nullopt;
@@ -231,6 +350,44 @@ nonstd::optional<Animatable<Extent>> ConvertToAnimatable(const primvar::PrimVar
   return nonstd::nullopt;
 }
 
+// true when the value of `attr` is decoded on access(See
+// USDLoadOptions::defer_value_loading).
+static bool HasDeferredValue(const Attribute &attr) {
+  return attr.get_var().has_deferred_value() ||
+         attr.get_var().has_deferred_timesamples();
+}
+
+// Convert the value of `attr` to Animatable<T> when the typed attribute is
+// accessed, so that the value is not decoded during Prim reconstruction.
+template<typename T>
+static std::shared_ptr<const DeferredTypedValue<Animatable<T>>> MakeDeferredAnimatable(const Attribute &attr)
+{
+  // PrimVar shares primvar::DeferredValue, so copying it does not decode.
+  primvar::PrimVar var = attr.get_var();
+  return std::make_shared<DeferredTypedValue<Animatable<T>>>(
+    [var](Animatable<T> *dst) -> bool {
+      if (auto av = ConvertToAnimatable<T>(var)) {
+        (*dst) = std::move(av.value());
+        return true;
+      }
+      return false;
+    });
+}
+
+template<typename T>
+static std::shared_ptr<const DeferredTypedValue<T>> MakeDeferredValue(const Attribute &attr)
+{
+  primvar::PrimVar var = attr.get_var();
+  return std::make_shared<DeferredTypedValue<T>>(
+    [var](T *dst) -> bool {
+      if (auto pv = var.get_value<T>()) {
+        (*dst) = std::move(pv.value());
+        return true;
+      }
+      return false;
+    });
+}
+
 #if 0 // TODO: remove. moved to prim-types.cc
 static bool ConvertTokenAttributeToStringAttribute(
   const TypedAttribute<Animatable<value::token>> &inp,
@@ -327,7 +484,7 @@ static bool ConvertStringDataAttributeToStringAttribute(
 
 // For animatable attribute(`varying`)
 template<typename T>
-static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
+static ParseResult ParseTypedAttribute(PropertyTable &table, /* inout */
   const std::string prop_name,
   const Property &prop,
   const std::string &name,
@@ -416,7 +573,9 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
             return ret;
           }
 
-          if (auto pv = attr.get_value<T>()) {
+          if (HasDeferredValue(attr)) {
+            // Set below.
+          } else if (auto pv = attr.get_value<T>()) {
             target.set_value(pv.value());
           } else {
             ret.code = ParseResult::ResultCode::TypeMismatch;
@@ -428,7 +587,11 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
       
         Animatable<T> animatable_value;
 
-        if (attr.get_var().has_timesamples()) {
+        if (HasDeferredValue(attr)) {
+          target.set_deferred_value(MakeDeferredAnimatable<T>(attr));
+          has_default = attr.get_var().has_value();
+          has_timesamples = attr.get_var().has_timesamples();
+        } else if (attr.get_var().has_timesamples()) {
           // e.g. "float radius.timeSamples = {0: 1.2, 1: 2.3}"
 
           if (auto av = ConvertToAnimatable<T>(attr.get_var())) {
@@ -445,7 +608,7 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
           has_timesamples = true;
         }
         
-        if (attr.get_var().has_value()) {
+        if (!HasDeferredValue(attr) && attr.get_var().has_value()) {
           if (auto pv = attr.get_var().get_value<T>()) {
             //target.set_value(pv.value());
             animatable_value.set(pv.value());
@@ -458,7 +621,7 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
           has_default = true;
         }
 
-        if (has_timesamples || has_default) {
+        if (!HasDeferredValue(attr) && (has_timesamples || has_default)) {
           target.set_value(animatable_value);
         }
       }
@@ -500,7 +663,7 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
 
 // For 'uniform' attribute
 template<typename T>
-static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
+static ParseResult ParseTypedAttribute(PropertyTable &table, /* inout */
   const std::string prop_name,
   const Property &prop,
   const std::string &name,
@@ -581,7 +744,9 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
         if (attr.is_blocked()) {
           target.set_blocked(true);
         } else if (attr.get_var().has_default()) {
-          if (auto pv = attr.get_value<T>()) {
+          if (HasDeferredValue(attr)) {
+            target.set_deferred_value(MakeDeferredValue<T>(attr));
+          } else if (auto pv = attr.get_value<T>()) {
             target.set_value(pv.value());
           } else {
             ret.code = ParseResult::ResultCode::InternalError;
@@ -623,7 +788,7 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
 
 // For animatable attribute(`varying`)
 template<typename T>
-static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
+static ParseResult ParseTypedAttribute(PropertyTable &table, /* inout */
   const std::string prop_name,
   const Property &prop,
   const std::string &name,
@@ -706,7 +871,9 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
         DCOUT("has_value = " << var.has_value());
 
         if (var.has_default() || var.has_timesamples()) {
-          if (auto av = ConvertToAnimatable<T>(var)) {
+          if (HasDeferredValue(attr)) {
+            target.set_deferred_value(MakeDeferredAnimatable<T>(attr));
+          } else if (auto av = ConvertToAnimatable<T>(var)) {
             target.set_value(av.value());
           } else {
             DCOUT("ConvertToAnimatable failed.");
@@ -757,7 +924,7 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
 
 // TODO: Unify code with TypedAttribute<Animatable<T>> variant
 template<typename T>
-static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
+static ParseResult ParseTypedAttribute(PropertyTable &table, /* inout */
   const std::string prop_name,
   const Property &prop,
   const std::string &name,
@@ -844,7 +1011,10 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
           target.set_blocked(true);
           has_default = true;
         } else if (attr.get_var().has_default()) {
-          if (auto pv = attr.get_value<T>()) {
+          if (HasDeferredValue(attr)) {
+            target.set_deferred_value(MakeDeferredValue<T>(attr));
+            has_default = true;
+          } else if (auto pv = attr.get_value<T>()) {
             target.set_value(pv.value());
             has_default = true;
           } else {
@@ -888,7 +1058,7 @@ static ParseResult ParseTypedAttribute(std::set<std::string> &table, /* inout */
 
 // Special case for Extent(float3[2]) type.
 // TODO: Reuse code of ParseTypedAttribute as much as possible
-static ParseResult ParseExtentAttribute(std::set<std::string> &table, /* inout */
+static ParseResult ParseExtentAttribute(PropertyTable &table, /* inout */
   const std::string prop_name,
   const Property &prop,
   const std::string &name,
@@ -1093,7 +1263,7 @@ static nonstd::expected<bool, std::string> CheckAllowedTokens(
 // Allowed syntax:
 //   "T varname"
 template<typename T>
-static ParseResult ParseShaderOutputTerminalAttribute(std::set<std::string> &table, /* inout */
+static ParseResult ParseShaderOutputTerminalAttribute(PropertyTable &table, /* inout */
   const std::string prop_name,
   const Property &prop,
   const std::string &name,
@@ -1204,7 +1374,7 @@ static ParseResult ParseShaderOutputTerminalAttribute(std::set<std::string> &tab
 // Allowed syntax:
 //   "token outputs:surface"
 //   "token outputs:surface.connect = </path/to/conn/>"
-static ParseResult ParseShaderOutputProperty(std::set<std::string> &table, /* inout */
+static ParseResult ParseShaderOutputProperty(PropertyTable &table, /* inout */
   const std::string prop_name,
   const Property &prop,
   const std::string &name,
@@ -1300,7 +1470,7 @@ static ParseResult ParseShaderOutputProperty(std::set<std::string> &table, /* in
 
 // Allowed syntax:
 //   "token outputs:surface.connect = </path/to/conn/>"
-static ParseResult ParseShaderInputConnectionProperty(std::set<std::string> &table, /* inout */
+static ParseResult ParseShaderInputConnectionProperty(PropertyTable &table, /* inout */
   const std::string prop_name,
   const Property &prop,
   const std::string &name,
@@ -1373,23 +1543,23 @@ static ParseResult ParseShaderInputConnectionProperty(std::set<std::string> &tab
 
 // Rel with single targetPath(or empty)
 #define PARSE_SINGLE_TARGET_PATH_RELATION(__table, __prop, __propname, __target) \
-  if (prop.first == __propname) { \
-    if (__table.count(__propname)) { \
+  if (IS_PROPERTY_NAME(__prop, __propname)) { \
+    if (__table.count(__prop)) { \
        continue; \
     } \
-    if (!prop.second.is_relationship()) { \
+    if (!__prop.second.is_relationship()) { \
       PUSH_ERROR_AND_RETURN(fmt::format("Property `{}` must be a Relationship.", __propname)); \
     } \
-    const Relationship &rel = prop.second.get_relationship(); \
+    const Relationship &rel = __prop.second.get_relationship(); \
     if (rel.is_path()) { \
       __target = rel; \
-      table.insert(prop.first); \
+      __table.insert(__prop); \
       DCOUT("Added rel " << __propname); \
       continue; \
     } else if (rel.is_pathvector()) { \
       if (rel.targetPathVector.size() == 1) { \
         __target = rel; \
-        table.insert(prop.first); \
+        __table.insert(__prop); \
         DCOUT("Added rel " << __propname); \
         continue; \
       } \
@@ -1397,11 +1567,11 @@ static ParseResult ParseShaderInputConnectionProperty(std::set<std::string> &tab
     } else if (!rel.has_value()) { \
       /* define-only. accept  */ \
       __target = rel; \
-      table.insert(prop.first); \
+      __table.insert(__prop); \
       DCOUT("Added rel " << __propname); \
     } else if (rel.is_blocked()) { \
       __target = rel; \
-      table.insert(prop.first); \
+      __table.insert(__prop); \
       DCOUT("Added ValueBlocked rel " << __propname); \
     } else { \
       PUSH_ERROR_AND_RETURN(fmt::format("Internal error. Property `{}` is not a valid Relationship.", __propname)); \
@@ -1410,30 +1580,32 @@ static ParseResult ParseShaderInputConnectionProperty(std::set<std::string> &tab
 
 // Rel with targetPaths(single path or array of Paths)
 #define PARSE_TARGET_PATHS_RELATION(__table, __prop, __propname, __target) \
-  if (prop.first == __propname) { \
-    if (__table.count(__propname)) { \
+  if (IS_PROPERTY_NAME(__prop, __propname)) { \
+    if (__table.count(__prop)) { \
        continue; \
     } \
-    if (!prop.second.is_relationship()) { \
+    if (!__prop.second.is_relationship()) { \
       PUSH_ERROR_AND_RETURN(fmt::format("`{}` must be a Relationship", __propname)); \
     } \
-    const Relationship &rel = prop.second.get_relationship(); \
+    const Relationship &rel = __prop.second.get_relationship(); \
     __target = rel; \
-    table.insert(prop.first); \
+    __table.insert(__prop); \
     DCOUT("Added rel " << __propname); \
     continue; \
   }
 
 
 #define PARSE_SHADER_TERMINAL_ATTRIBUTE(__table, __prop, __name, __klass, __target) { \
-  ParseResult ret = ParseShaderOutputTerminalAttribute(__table, __prop.first, __prop.second, __name, __target); \
-  if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
-    DCOUT("Added shader terminal attribute: " << __name); \
-    continue; /* got it */\
-  } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
-    /* go next */ \
-  } else { \
-    PUSH_ERROR_AND_RETURN(fmt::format("Parsing shader output property `{}` failed. Error: {}", __name, ret.err)); \
+  if (IS_PROPERTY_NAME(__prop, __name)) { \
+    ParseResult ret = ParseShaderOutputTerminalAttribute(__table, __prop.first, __prop.second, __name, __target); \
+    if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
+      DCOUT("Added shader terminal attribute: " << __name); \
+      continue; /* got it */\
+    } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
+      /* go next */ \
+    } else { \
+      PUSH_ERROR_AND_RETURN(fmt::format("Parsing shader output property `{}` failed. Error: {}", __name, ret.err)); \
+    } \
   } \
 }
 
@@ -1452,14 +1624,16 @@ static ParseResult ParseShaderInputConnectionProperty(std::set<std::string> &tab
 #endif
 
 #define PARSE_SHADER_INPUT_CONNECTION_PROPERTY(__table, __prop, __name, __klass, __target) { \
-  ParseResult ret = ParseShaderInputConnectionProperty(__table, __prop.first, __prop.second, __name, __target); \
-  if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
-    DCOUT("Added shader input connection: " << __name); \
-    continue; /* got it */\
-  } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
-    /* go next */ \
-  } else { \
-    PUSH_ERROR_AND_RETURN(fmt::format("Parsing shader property `{}` failed. Error: {}", __name, ret.err)); \
+  if (IS_PROPERTY_NAME(__prop, __name)) { \
+    ParseResult ret = ParseShaderInputConnectionProperty(__table, __prop.first, __prop.second, __name, __target); \
+    if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
+      DCOUT("Added shader input connection: " << __name); \
+      continue; /* got it */\
+    } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
+      /* go next */ \
+    } else { \
+      PUSH_ERROR_AND_RETURN(fmt::format("Parsing shader property `{}` failed. Error: {}", __name, ret.err)); \
+    } \
   } \
 }
 
@@ -1511,35 +1685,41 @@ nonstd::expected<T, std::string> EnumHandler(
 } // namespace
 
 #define PARSE_TYPED_ATTRIBUTE(__table, __prop, __name, __klass, __target) { \
-  ParseResult ret = ParseTypedAttribute(__table, __prop.first, __prop.second, __name, __target); \
-  if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
-    continue; /* got it */\
-  } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
-    /* go next */ \
-  } else { \
-    PUSH_ERROR_AND_RETURN(fmt::format("Parsing attribute `{}` failed. Error: {}", __name, ret.err)); \
+  if (IS_PROPERTY_NAME(__prop, __name)) { \
+    ParseResult ret = ParseTypedAttribute(__table, __prop.first, __prop.second, __name, __target); \
+    if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
+      continue; /* got it */\
+    } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
+      /* go next */ \
+    } else { \
+      PUSH_ERROR_AND_RETURN(fmt::format("Parsing attribute `{}` failed. Error: {}", __name, ret.err)); \
+    } \
   } \
 }
 
 #define PARSE_TYPED_ATTRIBUTE_NOCONTINUE(__table, __prop, __name, __klass, __target) { \
-  ParseResult ret = ParseTypedAttribute(__table, __prop.first, __prop.second, __name, __target); \
-  if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
-    /* do nothing */ \
-  } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
-    /* go next */ \
-  } else { \
-    PUSH_ERROR_AND_RETURN(fmt::format("Parsing attribute `{}` failed. Error: {}", __name, ret.err)); \
+  if (IS_PROPERTY_NAME(__prop, __name)) { \
+    ParseResult ret = ParseTypedAttribute(__table, __prop.first, __prop.second, __name, __target); \
+    if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
+      /* do nothing */ \
+    } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
+      /* go next */ \
+    } else { \
+      PUSH_ERROR_AND_RETURN(fmt::format("Parsing attribute `{}` failed. Error: {}", __name, ret.err)); \
+    } \
   } \
 }
 
 #define PARSE_EXTENT_ATTRIBUTE(__table, __prop, __name, __klass, __target) { \
-  ParseResult ret = ParseExtentAttribute(__table, __prop.first, __prop.second, __name, __target); \
-  if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
-    continue; /* got it */\
-  } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
-    /* go next */ \
-  } else { \
-    PUSH_ERROR_AND_RETURN(fmt::format("Parsing attribute `extent` failed. Error: {}", ret.err)); \
+  if (IS_PROPERTY_NAME(__prop, __name)) { \
+    ParseResult ret = ParseExtentAttribute(__table, __prop.first, __prop.second, __name, __target); \
+    if (ret.code == ParseResult::ResultCode::Success || ret.code == ParseResult::ResultCode::AlreadyProcessed) { \
+      continue; /* got it */\
+    } else if (ret.code == ParseResult::ResultCode::Unmatched) { \
+      /* go next */ \
+    } else { \
+      PUSH_ERROR_AND_RETURN(fmt::format("Parsing attribute `extent` failed. Error: {}", ret.err)); \
+    } \
   } \
 }
 
@@ -1856,12 +2036,12 @@ bool ParseTimeSampledEnumProperty(
 #else
 #define PARSE_UNIFORM_ENUM_PROPERTY(__table, __prop, __name, __enum_ty, __enum_handler, __klass, \
                            __target, __strict_check) {                          \
-  if (__prop.first == __name) {                                              \
-    if (__table.count(__name)) { continue; } \
+  if (IS_PROPERTY_NAME(__prop, __name)) {                                              \
+    if (__table.count(__prop)) { continue; } \
     if ((__prop.second.value_type_name() == value::TypeTraits<value::token>::type_name()) && __prop.second.is_attribute() && __prop.second.is_empty()) { \
       PUSH_WARN("No value assigned to `" << __name << "` token attribute. Set default token value."); \
       __target.metas() = __prop.second.get_attribute().metas();                    \
-      __table.insert(__name);                                              \
+      __table.insert(__prop);                                              \
       continue; \
     } else { \
       const Attribute &attr = __prop.second.get_attribute();                           \
@@ -1870,7 +2050,7 @@ bool ParseTimeSampledEnumProperty(
         return false; \
       } \
       __target.metas() = attr.metas(); \
-      __table.insert(__name);                                              \
+      __table.insert(__prop);                                              \
       continue; \
     } \
   } \
@@ -1878,13 +2058,13 @@ bool ParseTimeSampledEnumProperty(
 
 #define PARSE_TIMESAMPLED_ENUM_PROPERTY(__table, __prop, __name, __enum_ty, __enum_handler, __klass, \
                            __target, __strict_check) {                          \
-  if (__prop.first == __name) {                                              \
-    if (__table.count(__name)) { continue; } \
+  if (IS_PROPERTY_NAME(__prop, __name)) {                                              \
+    if (__table.count(__prop)) { continue; } \
     if ((__prop.second.value_type_name() == value::TypeTraits<value::token>::type_name()) && __prop.second.is_attribute() && __prop.second.is_empty()) { \
       PUSH_WARN("No value assigned to `" << __name << "` token attribute. Set default token value."); \
       const Attribute &attr = __prop.second.get_attribute();                           \
       __target.metas() = attr.metas();                    \
-      __table.insert(__name);                                              \
+      __table.insert(__prop);                                              \
       continue; \
     } else { \
       const Attribute &attr = __prop.second.get_attribute();                           \
@@ -1893,7 +2073,7 @@ bool ParseTimeSampledEnumProperty(
         return false; \
       } \
       __target.metas() = attr.metas(); \
-     __table.insert(__name);                                              \
+     __table.insert(__prop);                                              \
      continue; \
     } \
   } \
@@ -1906,16 +2086,16 @@ bool ParseTimeSampledEnumProperty(
 // `PARSE_PROPERTY` and `PARSE_***_ENUM_PROPERTY`
 #define ADD_PROPERTY(__table, __prop, __klass, __dst) {        \
   /* Check if the property name is a predefined property */  \
-  if (!__table.count(__prop.first)) {                        \
+  if (!__table.count(__prop)) {                        \
     DCOUT("custom property added: name = " << __prop.first); \
     __dst[__prop.first] = __prop.second;                     \
-    __table.insert(__prop.first);                            \
+    __table.insert(__prop);                            \
   } \
  }
 
 // This code path should not be reached though.
 #define PARSE_PROPERTY_END_MAKE_ERROR(__table, __prop) {                     \
-  if (!__table.count(__prop.first)) {                              \
+  if (!__table.count(__prop)) {                              \
     PUSH_ERROR_AND_RETURN("Unsupported/unimplemented property: " + \
                           __prop.first);                           \
   } \
@@ -1923,14 +2103,14 @@ bool ParseTimeSampledEnumProperty(
 
 // This code path should not be reached though.
 #define PARSE_PROPERTY_END_MAKE_WARN(__table, __prop) { \
-  if (!__table.count(__prop.first)) { \
+  if (!__table.count(__prop)) { \
     PUSH_WARN("Unsupported/unimplemented property: " + __prop.first); \
    } \
  }
 
 bool ReconstructXformOpsFromProperties(
   const Specifier &spec,
-  std::set<std::string> &table, /* inout */
+  PropertyTable &table, /* inout */
   const std::map<std::string, Property> &properties,
   std::vector<XformOp> *xformOps,
   std::string *err)
@@ -1993,7 +2173,7 @@ bool ReconstructXformOpsFromProperties(
   // TODO: TimeSamples, Connection
   if (properties.count("xformOpOrder")) {
     // array of string
-    auto prop = properties.at("xformOpOrder");
+    const Property &prop = properties.at("xformOpOrder");
 
     if (prop.is_relationship()) {
       PUSH_ERROR_AND_RETURN("Relationship for `xformOpOrder` is not supported.");
@@ -2527,10 +2707,28 @@ bool ReconstructXformOpsFromProperties(
   return true;
 }
 
+bool ReconstructXformOpsFromProperties(
+  const Specifier &spec,
+  std::set<std::string> &table, /* inout */
+  const std::map<std::string, Property> &properties,
+  std::vector<XformOp> *xformOps,
+  std::string *err)
+{
+  PropertyTable ptable(properties);
+  for (const auto &name : table) {
+    ptable.insert(name);
+  }
+
+  bool ret = ReconstructXformOpsFromProperties(spec, ptable, properties, xformOps, err);
+  ptable.get_processed_names(&table);
+
+  return ret;
+}
+
 namespace {
 
 bool ReconstructMaterialBindingProperties(
-  std::set<std::string> &table, /* inout */
+  PropertyTable &table, /* inout */
   const std::map<std::string, Property> &properties,
   MaterialBinding *mb, /* inout */
   std::string *err)
@@ -2540,7 +2738,7 @@ bool ReconstructMaterialBindingProperties(
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_SINGLE_TARGET_PATH_RELATION(table, prop, kMaterialBinding, mb->materialBinding)
     PARSE_SINGLE_TARGET_PATH_RELATION(table, prop, kMaterialBindingPreview, mb->materialBindingPreview)
     PARSE_SINGLE_TARGET_PATH_RELATION(table, prop, kMaterialBindingPreview, mb->materialBindingFull)
@@ -2630,7 +2828,7 @@ bool ReconstructMaterialBindingProperties(
 }
 
 bool ReconstructCollectionProperties(
-  std::set<std::string> &table, /* inout */
+  PropertyTable &table, /* inout */
   const std::map<std::string, Property> &properties,
   Collection *coll, /* inout */
   std::string *warn,
@@ -2654,7 +2852,7 @@ bool ReconstructCollectionProperties(
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     if (startsWith(prop.first, kCollectionPrefix)) {
       if (table.count(prop.first)) {
          continue;
@@ -2723,7 +2921,7 @@ bool ReconstructCollectionProperties(
 // xformOps and built-in props
 bool ReconstructGPrimProperties(
   const Specifier &spec,
-  std::set<std::string> &table, /* inout */
+  PropertyTable &table, /* inout */
   const std::map<std::string, Property> &properties,
   GPrim *gprim, /* inout */
   std::string *warn,
@@ -2745,7 +2943,7 @@ bool ReconstructGPrimProperties(
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_SINGLE_TARGET_PATH_RELATION(table, prop, kProxyPrim, gprim->proxyPrim)
     PARSE_TYPED_ATTRIBUTE(table, prop, "doubleSided", GPrim, gprim->doubleSided)
     PARSE_TIMESAMPLED_ENUM_PROPERTY(table, prop, kVisibility, Visibility, VisibilityEnumHandler, GPrim,
@@ -2776,12 +2974,12 @@ bool ReconstructPrim<Xform>(
   (void)options;
   (void)references;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, xform, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     ADD_PROPERTY(table, prop, Xform, xform->props)
     PARSE_PROPERTY_END_MAKE_WARN(table, prop)
   }
@@ -2805,8 +3003,8 @@ bool ReconstructPrim<Model>(
   (void)err;
   (void)options;
 
-  std::set<std::string> table;
-  for (const auto &prop : properties) {
+  PropertyTable table(properties);
+  for (const auto &prop : table) {
     ADD_PROPERTY(table, prop, Model, model->props)
     PARSE_PROPERTY_END_MAKE_WARN(table, prop)
   }
@@ -2832,8 +3030,8 @@ bool ReconstructPrim<Scope>(
   (void)options;
 
   DCOUT("Scope");
-  std::set<std::string> table;
-  for (const auto &prop : properties) {
+  PropertyTable table(properties);
+  for (const auto &prop : table) {
     PARSE_TIMESAMPLED_ENUM_PROPERTY(table, prop, kVisibility, Visibility, VisibilityEnumHandler, Scope,
                    scope->visibility, options.strict_allowedToken_check)
     ADD_PROPERTY(table, prop, Scope, scope->props)
@@ -2856,7 +3054,7 @@ bool ReconstructPrim<SkelRoot>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!prim::ReconstructXformOpsFromProperties(spec, table, properties, &root->xformOps, err)) {
     return false;
   }
@@ -2866,7 +3064,7 @@ bool ReconstructPrim<SkelRoot>(
   // No specific properties for SkelRoot(AFAIK)
 
   // custom props only
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TIMESAMPLED_ENUM_PROPERTY(table, prop, kVisibility, Visibility, VisibilityEnumHandler, SkelRoot,
                    root->visibility, options.strict_allowedToken_check)
     PARSE_UNIFORM_ENUM_PROPERTY(table, prop, kPurpose, Purpose, PurposeEnumHandler, SkelRoot,
@@ -2893,12 +3091,12 @@ bool ReconstructPrim<Skeleton>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!prim::ReconstructXformOpsFromProperties(spec, table, properties, &skel->xformOps, err)) {
     return false;
   }
 
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
 
     // SkelBindingAPI
     if (prop.first == kSkelAnimationSource) {
@@ -2986,8 +3184,8 @@ bool ReconstructPrim<SkelAnimation>(
   (void)warn;
   (void)references;
   (void)options;
-  std::set<std::string> table;
-  for (auto &prop : properties) {
+  PropertyTable table(properties);
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "joints", SkelAnimation, skelanim->joints)
     PARSE_TYPED_ATTRIBUTE(table, prop, "translations", SkelAnimation, skelanim->translations)
     PARSE_TYPED_ATTRIBUTE(table, prop, "rotations", SkelAnimation, skelanim->rotations)
@@ -3021,8 +3219,8 @@ bool ReconstructPrim<BlendShape>(
   constexpr auto kNormalOffsets = "normalOffsets";
   constexpr auto kPointIndices = "pointIndices";
 
-  std::set<std::string> table;
-  for (auto &prop : properties) {
+  PropertyTable table(properties);
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, kOffsets, BlendShape, bs->offsets)
     PARSE_TYPED_ATTRIBUTE(table, prop, kNormalOffsets, BlendShape, bs->normalOffsets)
     PARSE_TYPED_ATTRIBUTE(table, prop, kPointIndices, BlendShape, bs->pointIndices)
@@ -3058,7 +3256,7 @@ bool ReconstructPrim(
   (void)references;
   (void)properties;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, gprim, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
@@ -3115,12 +3313,12 @@ bool ReconstructPrim(
     return EnumHandler<GeomBasisCurves::Wrap>("wrap", tok, enums);
   };
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, curves, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "curveVertexCounts", GeomBasisCurves,
                          curves->curveVertexCounts)
     PARSE_TYPED_ATTRIBUTE(table, prop, "points", GeomBasisCurves, curves->points)
@@ -3158,12 +3356,12 @@ bool ReconstructPrim(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, curves, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "curveVertexCounts", GeomNurbsCurves,
                          curves->curveVertexCounts)
     PARSE_TYPED_ATTRIBUTE(table, prop, "points", GeomNurbsCurves, curves->points)
@@ -3202,13 +3400,13 @@ bool ReconstructPrim<SphereLight>(
   (void)references;
 
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
 
   if (!prim::ReconstructXformOpsFromProperties(spec, table, properties, &light->xformOps, err)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     // PARSE_PROPERTY(prop, "inputs:colorTemperature", light->colorTemperature)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:color", SphereLight, light->color)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:radius", SphereLight, light->radius)
@@ -3239,13 +3437,13 @@ bool ReconstructPrim<RectLight>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
 
   if (!prim::ReconstructXformOpsFromProperties(spec, table, properties, &light->xformOps, err)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     // PARSE_PROPERTY(prop, "inputs:colorTemperature", light->colorTemperature)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:texture:file", UsdUVTexture, light->file)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:color", RectLight, light->color)
@@ -3278,13 +3476,13 @@ bool ReconstructPrim<DiskLight>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
 
   if (!prim::ReconstructXformOpsFromProperties(spec, table, properties, &light->xformOps, err)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     // PARSE_PROPERTY(prop, "inputs:colorTemperature", light->colorTemperature)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:radius", DiskLight, light->radius)
     PARSE_EXTENT_ATTRIBUTE(table, prop, kExtent, DiskLight, light->extent)
@@ -3312,13 +3510,13 @@ bool ReconstructPrim<CylinderLight>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
 
   if (!prim::ReconstructXformOpsFromProperties(spec, table, properties, &light->xformOps, err)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     // PARSE_PROPERTY(prop, "inputs:colorTemperature", light->colorTemperature)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:length", CylinderLight, light->length)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:radius", CylinderLight, light->radius)
@@ -3347,13 +3545,13 @@ bool ReconstructPrim<DistantLight>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
 
   if (!prim::ReconstructXformOpsFromProperties(spec, table, properties, &light->xformOps, err)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     // PARSE_PROPERTY(prop, "inputs:colorTemperature", light->colorTemperature)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:angle", DistantLight, light->angle)
     PARSE_UNIFORM_ENUM_PROPERTY(table, prop, kPurpose, Purpose, PurposeEnumHandler, DistantLight,
@@ -3380,13 +3578,13 @@ bool ReconstructPrim<DomeLight>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
 
   if (!prim::ReconstructXformOpsFromProperties(spec, table, properties, &light->xformOps, err)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "guideRadius", DomeLight, light->guideRadius)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:diffuse", DomeLight, light->diffuse)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:specular", DomeLight,
@@ -3424,12 +3622,12 @@ bool ReconstructPrim<GeomSphere>(
 
   DCOUT("Reconstruct Sphere.");
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, sphere, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "radius", GeomSphere, sphere->radius)
     ADD_PROPERTY(table, prop, GeomSphere, sphere->props)
     PARSE_PROPERTY_END_MAKE_ERROR(table, prop)
@@ -3454,12 +3652,12 @@ bool ReconstructPrim<GeomPoints>(
 
   DCOUT("Reconstruct Points.");
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, points, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     DCOUT("prop: " << prop.first);
     PARSE_TYPED_ATTRIBUTE(table, prop, "points", GeomPoints, points->points)
     PARSE_TYPED_ATTRIBUTE(table, prop, "normals", GeomPoints, points->normals)
@@ -3488,12 +3686,12 @@ bool ReconstructPrim<GeomCone>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, cone, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     DCOUT("prop: " << prop.first);
     PARSE_TYPED_ATTRIBUTE(table, prop, "radius", GeomCone, cone->radius)
     PARSE_TYPED_ATTRIBUTE(table, prop, "height", GeomCone, cone->height)
@@ -3519,12 +3717,12 @@ bool ReconstructPrim<GeomCylinder>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, cylinder, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     DCOUT("prop: " << prop.first);
     PARSE_TYPED_ATTRIBUTE(table, prop, "radius", GeomCylinder,
                          cylinder->radius)
@@ -3552,12 +3750,12 @@ bool ReconstructPrim<GeomCapsule>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, capsule, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "radius", GeomCapsule, capsule->radius)
     PARSE_TYPED_ATTRIBUTE(table, prop, "height", GeomCapsule, capsule->height)
     PARSE_UNIFORM_ENUM_PROPERTY(table, prop, "axis", Axis, AxisEnumHandler, GeomCapsule, capsule->axis, options.strict_allowedToken_check)
@@ -3585,12 +3783,12 @@ bool ReconstructPrim<GeomCube>(
   //
   // pxrUSD says... "If you author size you must also author extent."
   //
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, cube, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     DCOUT("prop: " << prop.first);
     PARSE_TYPED_ATTRIBUTE(table, prop, "size", GeomCube, cube->size)
     ADD_PROPERTY(table, prop, GeomCube, cube->props)
@@ -3675,12 +3873,12 @@ bool ReconstructPrim<GeomMesh>(
                                                     enums);
   };
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, mesh, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     DCOUT("GeomMesh prop: " << prop.first);
     PARSE_SINGLE_TARGET_PATH_RELATION(table, prop, kSkelSkeleton, mesh->skeleton)
     PARSE_TARGET_PATHS_RELATION(table, prop, kSkelBlendShapeTargets, mesh->blendShapeTargets)
@@ -3813,12 +4011,12 @@ bool ReconstructPrim<GeomCamera>(
         quote(tok) + " is invalid token for `stereoRole` propety");
   };
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, camera, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "focalLength", GeomCamera, camera->focalLength)
     PARSE_TYPED_ATTRIBUTE(table, prop, "focusDistance", GeomCamera,
                    camera->focusDistance)
@@ -3877,7 +4075,7 @@ bool ReconstructPrim<GeomSubset>(
                                                     enums);
   };
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
 
   if (!prim::ReconstructMaterialBindingProperties(table, properties, subset, err)) {
     return false;
@@ -3888,7 +4086,7 @@ bool ReconstructPrim<GeomSubset>(
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "familyName", GeomSubset, subset->familyName)
     PARSE_TYPED_ATTRIBUTE(table, prop, "indices", GeomSubset, subset->indices)
     PARSE_UNIFORM_ENUM_PROPERTY(table, prop, "elementType", GeomSubset::ElementType, ElementTypeHandler, GeomSubset, subset->elementType, options.strict_allowedToken_check)
@@ -3915,12 +4113,12 @@ bool ReconstructPrim<PointInstancer>(
 
   DCOUT("Reconstruct PointInstancer.");
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   if (!ReconstructGPrimProperties(spec, table, properties, instancer, warn, err, options.strict_allowedToken_check)) {
     return false;
   }
 
-  for (const auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TARGET_PATHS_RELATION(table, prop, "prototypes", instancer->prototypes)
     PARSE_TYPED_ATTRIBUTE(table, prop, "protoIndices", PointInstancer, instancer->protoIndices)
     PARSE_TYPED_ATTRIBUTE(table, prop, "ids", PointInstancer, instancer->ids)
@@ -3959,11 +4157,11 @@ bool ReconstructShader<ShaderNode>(
   // TODO: references
   (void)references;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
 
   // Add everything to props.
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     ADD_PROPERTY(table, prop, ShaderNode, node->props)
     PARSE_PROPERTY_END_MAKE_WARN(table, prop)
   }
@@ -3985,9 +4183,9 @@ bool ReconstructShader<UsdPreviewSurface>(
   (void)references;
   (void)options;
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:diffuseColor", UsdPreviewSurface,
                          surface->diffuseColor)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:emissiveColor", UsdPreviewSurface,
@@ -4010,7 +4208,7 @@ bool ReconstructShader<UsdPreviewSurface>(
                          surface->ior)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:normal", UsdPreviewSurface,
                          surface->normal)
-    PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:dispacement", UsdPreviewSurface,
+    PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:displacement", UsdPreviewSurface,
                          surface->displacement)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:occlusion", UsdPreviewSurface,
                          surface->occlusion)
@@ -4069,10 +4267,10 @@ bool ReconstructShader<UsdUVTexture>(
         "inputs:wrap*", tok, enums);
   };
 
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
 
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     DCOUT("prop.name = " << prop.first);
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:file", UsdUVTexture, texture->file)
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:st", UsdUVTexture,
@@ -4117,9 +4315,9 @@ bool ReconstructShader<UsdPrimvarReader_int>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_int,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4162,9 +4360,9 @@ bool ReconstructShader<UsdPrimvarReader_float>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_float,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4217,9 +4415,9 @@ bool ReconstructShader<UsdPrimvarReader_float2>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     DCOUT("Primreader_float2 prop = " << prop.first);
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
       // Support older spec: `token` for varname
@@ -4274,9 +4472,9 @@ bool ReconstructShader<UsdPrimvarReader_float3>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_float3,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4330,10 +4528,10 @@ bool ReconstructShader<UsdPrimvarReader_float4>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
 
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_float4,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4386,10 +4584,10 @@ bool ReconstructShader<UsdPrimvarReader_string>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
 
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_string,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4442,10 +4640,10 @@ bool ReconstructShader<UsdPrimvarReader_vector>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
 
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_vector,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4498,10 +4696,10 @@ bool ReconstructShader<UsdPrimvarReader_normal>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
 
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_normal,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4554,10 +4752,10 @@ bool ReconstructShader<UsdPrimvarReader_point>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
 
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_point,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4610,10 +4808,10 @@ bool ReconstructShader<UsdPrimvarReader_matrix>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
 
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:fallback", UsdPrimvarReader_matrix,
                    preader->fallback)
     if ((prop.first == kInputsVarname) && !table.count(kInputsVarname)) {
@@ -4666,9 +4864,9 @@ bool ReconstructShader<UsdTransform2d>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
   table.insert("info:id"); // `info:id` is already parsed in ReconstructPrim<Shader>
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     DCOUT("prop = " << prop.first);
     PARSE_TYPED_ATTRIBUTE(table, prop, "inputs:in", UsdTransform2d,
                    transform->in)
@@ -4874,12 +5072,12 @@ bool ReconstructPrim<Material>(
   (void)spec;
   (void)references;
   (void)options;
-  std::set<std::string> table;
+  PropertyTable table(properties);
 
   // TODO: special treatment for properties with 'inputs' and 'outputs' namespace.
 
   // For `Material`, `outputs` are terminal attribute and treated as input attribute with connection(Should be "token output:surface.connect = </path/to/shader>").
-  for (auto &prop : properties) {
+  for (const auto &prop : table) {
     PARSE_SHADER_INPUT_CONNECTION_PROPERTY(table, prop, "outputs:surface",
                                   Material, material->surface)
     PARSE_SHADER_INPUT_CONNECTION_PROPERTY(table, prop, "outputs:displacement",
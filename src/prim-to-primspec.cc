@@ -0,0 +1,906 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2023 - Present, Light Transport Entertainment Inc.
+//
+// Convert concrete Prim to PrimSpec.
+//
+// Property names and value types follow the ones parsed in
+// prim-reconstruct.cc, so that Prim -> PrimSpec -> Prim roundtrips.
+//
+#include "prim-to-primspec.hh"
+
+#include <type_traits>
+
+#include "pprinter.hh"
+#include "prim-types.hh"
+#include "stage.hh"
+#include "usdGeom.hh"
+#include "usdLux.hh"
+#include "usdShade.hh"
+#include "usdSkel.hh"
+#include "value-types.hh"
+
+#include "common-macros.inc"
+
+// For PUSH_ERROR_AND_RETURN
+#define PushError(s) \
+  if (err) {         \
+    (*err) += s;     \
+  }
+
+namespace tinyusdz {
+namespace prim {
+
+namespace {
+
+constexpr auto kMaterialBinding = "material:binding";
+constexpr auto kMaterialBindingCollection = "material:binding:collection";
+constexpr auto kMaterialBindingPreview = "material:binding:preview";
+constexpr auto kMaterialBindingFull = "material:binding:full";
+constexpr auto kXformOpOrder = "xformOpOrder";
+
+template <typename T>
+struct AnimatableTraits {
+  using value_type = T;
+  static constexpr bool animatable = false;
+};
+
+template <typename T>
+struct AnimatableTraits<Animatable<T>> {
+  using value_type = T;
+  static constexpr bool animatable = true;
+};
+
+// Attribute value type. Enum is stored as `token`.
+template <typename T, bool is_enum = std::is_enum<T>::value>
+struct AttrValue {
+  static std::string type_name() { return value::TypeTraits<T>::type_name(); }
+  static value::Value to_value(const T &v) { return value::Value(v); }
+};
+
+template <typename T>
+struct AttrValue<T, true> {
+  static std::string type_name() { return value::kToken; }
+  static value::Value to_value(const T &v) {
+    return value::Value(value::token(to_string(v)));
+  }
+};
+
+// Extent is `float3[2]` in USD.
+template <>
+struct AttrValue<Extent, false> {
+  static std::string type_name() {
+    return value::TypeTraits<std::vector<value::float3>>::type_name();
+  }
+  static value::Value to_value(const Extent &v) {
+    std::vector<value::float3> a{v.lower, v.upper};
+    return value::Value(a);
+  }
+};
+
+template <typename T>
+value::TimeSamples ToTypelessTimeSamples(const TypedTimeSamples<T> &ts) {
+  const std::vector<double> &times = ts.get_times();
+  const std::vector<T> &values = ts.get_values();
+
+  value::TimeSamples dst;
+
+  for (size_t i = 0; i < times.size(); i++) {
+    if (ts.is_blocked(i)) {
+      dst.add_blocked_sample(times[i], value::ValueBlock());
+    } else {
+      dst.add_sample(times[i], AttrValue<T>::to_value(values[i]));
+    }
+  }
+
+  return dst;
+}
+
+template <typename T>
+void SetAttrValue(const T &v, Attribute *attr) {
+  primvar::PrimVar var;
+  var.set_value(AttrValue<T>::to_value(v));
+  attr->set_var(std::move(var));
+}
+
+template <typename T>
+void SetAttrValue(const Animatable<T> &v, Attribute *attr) {
+  primvar::PrimVar var;
+
+  T a;
+  if (v.get_default(&a)) {
+    var.set_value(AttrValue<T>::to_value(a));
+  }
+
+  if (v.has_timesamples()) {
+    var.set_timesamples(ToTypelessTimeSamples(v.get_timesamples()));
+  }
+
+  attr->set_var(std::move(var));
+
+  // Set after `set_var()` since ValueBlock is stored in PrimVar.
+  if (v.is_blocked()) {
+    attr->set_blocked(true);
+  }
+}
+
+template <typename T>
+Attribute MakeAttribute() {
+  Attribute attr;
+  attr.set_type_name(
+      AttrValue<typename AnimatableTraits<T>::value_type>::type_name());
+  attr.variability() = AnimatableTraits<T>::animatable ? Variability::Varying
+                                                       : Variability::Uniform;
+  return attr;
+}
+
+template <typename T>
+void AddAttribute(const std::string &name, const TypedAttribute<T> &input,
+                  PropertyMap *props) {
+  if (!input.authored()) {
+    return;
+  }
+
+  Attribute attr = MakeAttribute<T>();
+
+  if (input.has_value()) {
+    SetAttrValue(input.get_value().value(), &attr);
+  }
+
+  if (input.is_blocked()) {
+    attr.set_blocked(true);
+  }
+
+  if (input.has_connections()) {
+    attr.set_connections(input.get_connections());
+  }
+
+  attr.metas() = input.metas();
+
+  (*props)[name] = Property(std::move(attr), /* custom */ false);
+}
+
+template <typename T>
+void AddAttribute(const std::string &name,
+                  const TypedAttributeWithFallback<T> &input,
+                  PropertyMap *props) {
+  if (!input.authored()) {
+    return;
+  }
+
+  Attribute attr = MakeAttribute<T>();
+
+  // Do not write the fallback value for connection-only attribute.
+  if (input.has_authored_value()) {
+    SetAttrValue(input.get_value(), &attr);
+  }
+
+  if (input.is_blocked()) {
+    attr.set_blocked(true);
+  }
+
+  if (input.has_connections()) {
+    attr.set_connections(input.get_connections());
+  }
+
+  attr.metas() = input.metas();
+
+  (*props)[name] = Property(std::move(attr), /* custom */ false);
+}
+
+// Terminal(output) attribute: type info only.
+template <typename T>
+void AddAttribute(const std::string &name,
+                  const TypedTerminalAttribute<T> &input, PropertyMap *props) {
+  if (!input.authored()) {
+    return;
+  }
+
+  Property p = Property::MakeEmptyAttrib(
+      input.has_actual_type() ? input.get_actual_type_name()
+                              : input.type_name(),
+      /* custom */ false);
+  p.attribute().metas() = input.metas();
+
+  (*props)[name] = p;
+}
+
+// e.g. `token outputs:surface.connect = </path/to/shader.outputs:surface>`
+template <typename T>
+void AddAttribute(const std::string &name, const TypedConnection<T> &input,
+                  PropertyMap *props) {
+  if (!input.authored()) {
+    return;
+  }
+
+  Attribute attr;
+  attr.set_type_name(input.type_name());
+  attr.variability() = Variability::Varying;
+
+  if (input.has_value()) {
+    attr.set_connections(input.get_connections());
+  }
+
+  if (input.is_blocked()) {
+    attr.set_blocked(true);
+  }
+
+  attr.metas() = input.metas();
+
+  (*props)[name] = Property(std::move(attr), /* custom */ false);
+}
+
+// Attribute which is not a member of concrete Prim(e.g. `xformOpOrder`)
+template <typename T>
+void AddUniformAttribute(const std::string &name, const T &v,
+                         PropertyMap *props) {
+  Attribute attr = MakeAttribute<T>();
+  SetAttrValue(v, &attr);
+
+  (*props)[name] = Property(std::move(attr), /* custom */ false);
+}
+
+void AddRelationship(const std::string &name,
+                     const nonstd::optional<Relationship> &rel,
+                     PropertyMap *props) {
+  if (rel) {
+    (*props)[name] = Property(rel.value(), /* custom */ false);
+  }
+}
+
+void AddRelationship(const std::string &name, const RelationshipProperty &rel,
+                     PropertyMap *props) {
+  if (rel.authored()) {
+    (*props)[name] = Property(rel.relationship(), /* custom */ false);
+  }
+}
+
+// Custom properties. Properties of the schema have priority.
+void AddProperties(const PropertyMap &src, PropertyMap *props) {
+  for (const auto &it : src) {
+    if (!props->count(it.first)) {
+      (*props)[it.first] = it.second;
+    }
+  }
+}
+
+void AddXformOps(const Xformable &xformable, PropertyMap *props) {
+  if (xformable.xformOps.empty()) {
+    return;
+  }
+
+  for (const auto &op : xformable.xformOps) {
+    if (op.op_type == XformOp::OpType::ResetXformStack) {
+      continue;
+    }
+
+    std::string name = to_string(op.op_type);
+    if (!op.suffix.empty()) {
+      name += ":" + op.suffix;
+    }
+
+    // `!invert!` op may refer to the same attribute.
+    if (props->count(name)) {
+      continue;
+    }
+
+    Attribute attr;
+    primvar::PrimVar var = op.get_var();
+    attr.set_var(std::move(var));
+    if (op.is_blocked()) {
+      attr.set_blocked(true);
+    }
+    attr.variability() = Variability::Varying;
+
+    (*props)[name] = Property(std::move(attr), /* custom */ false);
+  }
+
+  AddUniformAttribute(kXformOpOrder, xformable.xformOpOrder(), props);
+}
+
+void AddMaterialBindings(const MaterialBinding &mb, PropertyMap *props) {
+  AddRelationship(kMaterialBinding, mb.materialBinding, props);
+  AddRelationship(kMaterialBindingPreview, mb.materialBindingPreview, props);
+  AddRelationship(kMaterialBindingFull, mb.materialBindingFull, props);
+
+  // material:binding:PURPOSE
+  for (const auto &it : mb.materialBindingMap()) {
+    if (it.first.empty()) {
+      continue;
+    }
+    (*props)[kMaterialBinding + std::string(":") + it.first] =
+        Property(it.second, /* custom */ false);
+  }
+
+  // material:binding:collection[:PURPOSE]:NAME
+  // key = NAME, ordered_dict key = PURPOSE
+  for (const auto &coll : mb.materialBindingCollectionMap()) {
+    for (size_t i = 0; i < coll.second.size(); i++) {
+      const std::string &purpose = coll.second.keys()[i];
+
+      const Relationship *rel{nullptr};
+      if (!coll.second.at(i, &rel)) {
+        continue;
+      }
+
+      std::string name = kMaterialBindingCollection;
+      if (!purpose.empty()) {
+        name += ":" + purpose;
+      }
+      if (!coll.first.empty()) {
+        name += ":" + coll.first;
+      }
+
+      (*props)[name] = Property(*rel, /* custom */ false);
+    }
+  }
+}
+
+void AddCollections(const Collection &coll, PropertyMap *props) {
+  const auto &instances = coll.instances();
+
+  for (size_t i = 0; i < instances.size(); i++) {
+    const std::string &name = instances.keys()[i];
+
+    const CollectionInstance *instance{nullptr};
+    if (!instances.at(i, &instance)) {
+      continue;
+    }
+
+    std::string prefix = "collection";
+    if (!name.empty()) {
+      prefix += ":" + name;
+    }
+
+    AddAttribute(prefix + ":expansionRule", instance->expansionRule, props);
+    AddAttribute(prefix + ":includeRoot", instance->includeRoot, props);
+    AddRelationship(prefix + ":includes", instance->includes, props);
+    AddRelationship(prefix + ":excludes", instance->excludes, props);
+  }
+}
+
+void AddGPrimProperties(const GPrim &gprim, PropertyMap *props) {
+  AddAttribute("doubleSided", gprim.doubleSided, props);
+  AddAttribute("orientation", gprim.orientation, props);
+  AddAttribute("purpose", gprim.purpose, props);
+  AddAttribute("extent", gprim.extent, props);
+  AddAttribute("visibility", gprim.visibility, props);
+  AddRelationship("proxyPrim", gprim.proxyPrim, props);
+
+  AddMaterialBindings(gprim, props);
+  AddCollections(gprim, props);
+  AddXformOps(gprim, props);
+
+  AddProperties(gprim.props, props);
+}
+
+template <typename T>
+void AddLightProperties(const T &light, PropertyMap *props) {
+  AddAttribute("inputs:color", light.color, props);
+  AddAttribute("inputs:colorTemperature", light.colorTemperature, props);
+  AddAttribute("inputs:diffuse", light.diffuse, props);
+  AddAttribute("inputs:enableColorTemperature", light.enableColorTemperature,
+               props);
+  AddAttribute("inputs:exposure", light.exposure, props);
+  AddAttribute("inputs:intensity", light.intensity, props);
+  AddAttribute("inputs:normalize", light.normalize, props);
+  AddAttribute("inputs:specular", light.specular, props);
+
+  AddAttribute("visibility", light.visibility, props);
+  AddAttribute("purpose", light.purpose, props);
+
+  AddCollections(light, props);
+  AddXformOps(light, props);
+
+  AddProperties(light.props, props);
+}
+
+template <typename T>
+void AddPrimvarReaderProperties(const UsdPrimvarReader<T> &reader,
+                                PropertyMap *props) {
+  AddAttribute("inputs:fallback", reader.fallback, props);
+  AddAttribute("inputs:varname", reader.varname, props);
+  AddAttribute("outputs:result", reader.result, props);
+
+  AddProperties(reader.props, props);
+}
+
+///
+/// Concrete Prim -> properties
+///
+
+void ToProperties(const Xform &xform, PropertyMap *props) {
+  AddGPrimProperties(xform, props);
+}
+
+void ToProperties(const GPrim &gprim, PropertyMap *props) {
+  AddGPrimProperties(gprim, props);
+}
+
+void ToProperties(const Model &model, PropertyMap *props) {
+  AddProperties(model.props, props);
+}
+
+void ToProperties(const Scope &scope, PropertyMap *props) {
+  AddAttribute("visibility", scope.visibility, props);
+  AddProperties(scope.props, props);
+}
+
+void ToProperties(const GeomMesh &mesh, PropertyMap *props) {
+  AddAttribute("points", mesh.points, props);
+  AddAttribute("normals", mesh.normals, props);
+  AddAttribute("velocities", mesh.velocities, props);
+  AddAttribute("faceVertexCounts", mesh.faceVertexCounts, props);
+  AddAttribute("faceVertexIndices", mesh.faceVertexIndices, props);
+
+  AddAttribute("cornerIndices", mesh.cornerIndices, props);
+  AddAttribute("cornerSharpnesses", mesh.cornerSharpnesses, props);
+  AddAttribute("creaseIndices", mesh.creaseIndices, props);
+  AddAttribute("creaseLengths", mesh.creaseLengths, props);
+  AddAttribute("creaseSharpnesses", mesh.creaseSharpnesses, props);
+  AddAttribute("holeIndices", mesh.holeIndices, props);
+  AddAttribute("interpolateBoundary", mesh.interpolateBoundary, props);
+  AddAttribute("subdivisionScheme", mesh.subdivisionScheme, props);
+  AddAttribute("faceVaryingLinearInterpolation",
+               mesh.faceVaryingLinearInterpolation, props);
+
+  AddRelationship("skel:skeleton", mesh.skeleton, props);
+  AddAttribute("skel:blendShapes", mesh.blendShapes, props);
+  AddRelationship("skel:blendShapeTargets", mesh.blendShapeTargets, props);
+
+  for (const auto &it : mesh.subsetFamilyTypeMap) {
+    AddUniformAttribute("subsetFamily:" + it.first.str() + ":familyType",
+                        it.second, props);
+  }
+
+  AddGPrimProperties(mesh, props);
+}
+
+void ToProperties(const GeomSubset &subset, PropertyMap *props) {
+  AddAttribute("elementType", subset.elementType, props);
+  AddAttribute("familyName", subset.familyName, props);
+  AddAttribute("indices", subset.indices, props);
+
+  AddMaterialBindings(subset, props);
+  AddCollections(subset, props);
+
+  AddProperties(subset.props, props);
+}
+
+void ToProperties(const GeomCamera &camera, PropertyMap *props) {
+  AddAttribute("clippingPlanes", camera.clippingPlanes, props);
+  AddAttribute("clippingRange", camera.clippingRange, props);
+  AddAttribute("exposure", camera.exposure, props);
+  AddAttribute("focalLength", camera.focalLength, props);
+  AddAttribute("focusDistance", camera.focusDistance, props);
+  AddAttribute("horizontalAperture", camera.horizontalAperture, props);
+  AddAttribute("horizontalApertureOffset", camera.horizontalApertureOffset,
+               props);
+  AddAttribute("verticalAperture", camera.verticalAperture, props);
+  AddAttribute("verticalApertureOffset", camera.verticalApertureOffset,
+               props);
+  AddAttribute("fStop", camera.fStop, props);
+  AddAttribute("projection", camera.projection, props);
+  AddAttribute("stereoRole", camera.stereoRole, props);
+  AddAttribute("shutter:open", camera.shutterOpen, props);
+  AddAttribute("shutter:close", camera.shutterClose, props);
+
+  AddGPrimProperties(camera, props);
+}
+
+void ToProperties(const GeomSphere &sphere, PropertyMap *props) {
+  AddAttribute("radius", sphere.radius, props);
+  AddGPrimProperties(sphere, props);
+}
+
+void ToProperties(const GeomCube &cube, PropertyMap *props) {
+  AddAttribute("size", cube.size, props);
+  AddGPrimProperties(cube, props);
+}
+
+void ToProperties(const GeomCone &cone, PropertyMap *props) {
+  AddAttribute("radius", cone.radius, props);
+  AddAttribute("height", cone.height, props);
+  AddAttribute("axis", cone.axis, props);
+  AddGPrimProperties(cone, props);
+}
+
+void ToProperties(const GeomCylinder &cylinder, PropertyMap *props) {
+  AddAttribute("radius", cylinder.radius, props);
+  AddAttribute("height", cylinder.height, props);
+  AddAttribute("axis", cylinder.axis, props);
+  AddGPrimProperties(cylinder, props);
+}
+
+void ToProperties(const GeomCapsule &capsule, PropertyMap *props) {
+  AddAttribute("radius", capsule.radius, props);
+  AddAttribute("height", capsule.height, props);
+  AddAttribute("axis", capsule.axis, props);
+  AddGPrimProperties(capsule, props);
+}
+
+void ToProperties(const GeomPoints &points, PropertyMap *props) {
+  AddAttribute("points", points.points, props);
+  AddAttribute("normals", points.normals, props);
+  AddAttribute("widths", points.widths, props);
+  AddAttribute("ids", points.ids, props);
+  AddAttribute("velocities", points.velocities, props);
+  AddAttribute("accelerations", points.accelerations, props);
+  AddGPrimProperties(points, props);
+}
+
+void ToProperties(const GeomBasisCurves &curves, PropertyMap *props) {
+  AddAttribute("type", curves.type, props);
+  AddAttribute("basis", curves.basis, props);
+  AddAttribute("wrap", curves.wrap, props);
+  AddAttribute("points", curves.points, props);
+  AddAttribute("normals", curves.normals, props);
+  AddAttribute("widths", curves.widths, props);
+  AddAttribute("velocities", curves.velocities, props);
+  AddAttribute("accelerations", curves.accelerations, props);
+  AddAttribute("curveVertexCounts", curves.curveVertexCounts, props);
+  AddGPrimProperties(curves, props);
+}
+
+void ToProperties(const GeomNurbsCurves &curves, PropertyMap *props) {
+  AddAttribute("points", curves.points, props);
+  AddAttribute("normals", curves.normals, props);
+  AddAttribute("widths", curves.widths, props);
+  AddAttribute("velocities", curves.velocities, props);
+  AddAttribute("accelerations", curves.accelerations, props);
+  AddAttribute("curveVertexCounts", curves.curveVertexCounts, props);
+  AddAttribute("order", curves.order, props);
+  AddAttribute("knots", curves.knots, props);
+  AddAttribute("ranges", curves.ranges, props);
+  AddAttribute("pointWeights", curves.pointWeights, props);
+  AddGPrimProperties(curves, props);
+}
+
+void ToProperties(const PointInstancer &instancer, PropertyMap *props) {
+  AddRelationship("prototypes", instancer.prototypes, props);
+  AddAttribute("protoIndices", instancer.protoIndices, props);
+  AddAttribute("ids", instancer.ids, props);
+  AddAttribute("invisibleIds", instancer.invisibleIds, props);
+  AddAttribute("positions", instancer.positions, props);
+  AddAttribute("orientations", instancer.orientations, props);
+  AddAttribute("scales", instancer.scales, props);
+  AddAttribute("velocities", instancer.velocities, props);
+  AddAttribute("accelerations", instancer.accelerations, props);
+  AddAttribute("angularVelocities", instancer.angularVelocities, props);
+  AddGPrimProperties(instancer, props);
+}
+
+void ToProperties(const SphereLight &light, PropertyMap *props) {
+  AddAttribute("inputs:radius", light.radius, props);
+  AddAttribute("extent", light.extent, props);
+  AddLightProperties(light, props);
+}
+
+void ToProperties(const DiskLight &light, PropertyMap *props) {
+  AddAttribute("inputs:radius", light.radius, props);
+  AddAttribute("extent", light.extent, props);
+  AddLightProperties(light, props);
+}
+
+void ToProperties(const CylinderLight &light, PropertyMap *props) {
+  AddAttribute("inputs:length", light.length, props);
+  AddAttribute("inputs:radius", light.radius, props);
+  AddAttribute("extent", light.extent, props);
+  AddLightProperties(light, props);
+}
+
+void ToProperties(const RectLight &light, PropertyMap *props) {
+  AddAttribute("inputs:texture:file", light.file, props);
+  AddAttribute("inputs:width", light.width, props);
+  AddAttribute("inputs:height", light.height, props);
+  AddAttribute("extent", light.extent, props);
+  AddLightProperties(light, props);
+}
+
+void ToProperties(const DistantLight &light, PropertyMap *props) {
+  AddAttribute("inputs:angle", light.angle, props);
+  AddLightProperties(light, props);
+}
+
+void ToProperties(const DomeLight &light, PropertyMap *props) {
+  AddAttribute("inputs:guideRadius", light.guideRadius, props);
+  AddAttribute("inputs:texture:file", light.file, props);
+  AddAttribute("inputs:texture:format", light.textureFormat, props);
+  AddLightProperties(light, props);
+}
+
+void ToProperties(const PortalLight &light, PropertyMap *props) {
+  AddLightProperties(light, props);
+}
+
+void ToProperties(const SkelRoot &root, PropertyMap *props) {
+  AddAttribute("extent", root.extent, props);
+  AddAttribute("purpose", root.purpose, props);
+  AddAttribute("visibility", root.visibility, props);
+  AddRelationship("proxyPrim", root.proxyPrim, props);
+  AddXformOps(root, props);
+  AddProperties(root.props, props);
+}
+
+void ToProperties(const Skeleton &skel, PropertyMap *props) {
+  AddAttribute("bindTransforms", skel.bindTransforms, props);
+  AddAttribute("jointNames", skel.jointNames, props);
+  AddAttribute("joints", skel.joints, props);
+  AddAttribute("restTransforms", skel.restTransforms, props);
+  AddRelationship("skel:animationSource", skel.animationSource, props);
+  AddRelationship("proxyPrim", skel.proxyPrim, props);
+  AddAttribute("extent", skel.extent, props);
+  AddAttribute("purpose", skel.purpose, props);
+  AddAttribute("visibility", skel.visibility, props);
+  AddXformOps(skel, props);
+  AddProperties(skel.props, props);
+}
+
+void ToProperties(const SkelAnimation &anim, PropertyMap *props) {
+  AddAttribute("blendShapes", anim.blendShapes, props);
+  AddAttribute("blendShapeWeights", anim.blendShapeWeights, props);
+  AddAttribute("joints", anim.joints, props);
+  AddAttribute("rotations", anim.rotations, props);
+  AddAttribute("scales", anim.scales, props);
+  AddAttribute("translations", anim.translations, props);
+  AddProperties(anim.props, props);
+}
+
+void ToProperties(const BlendShape &bs, PropertyMap *props) {
+  AddAttribute("offsets", bs.offsets, props);
+  AddAttribute("normalOffsets", bs.normalOffsets, props);
+  AddAttribute("pointIndices", bs.pointIndices, props);
+  AddProperties(bs.props, props);
+}
+
+void ToProperties(const Material &material, PropertyMap *props) {
+  AddAttribute("outputs:surface", material.surface, props);
+  AddAttribute("outputs:displacement", material.displacement, props);
+  AddAttribute("outputs:volume", material.volume, props);
+  AddAttribute("purpose", material.purpose, props);
+  AddProperties(material.props, props);
+}
+
+void ToProperties(const NodeGraph &graph, PropertyMap *props) {
+  AddProperties(graph.props, props);
+}
+
+void ToProperties(const UsdPreviewSurface &surface, PropertyMap *props) {
+  AddAttribute("inputs:diffuseColor", surface.diffuseColor, props);
+  AddAttribute("inputs:emissiveColor", surface.emissiveColor, props);
+  AddAttribute("inputs:useSpecularWorkflow", surface.useSpecularWorkflow,
+               props);
+  AddAttribute("inputs:specularColor", surface.specularColor, props);
+  AddAttribute("inputs:metallic", surface.metallic, props);
+  AddAttribute("inputs:clearcoat", surface.clearcoat, props);
+  AddAttribute("inputs:clearcoatRoughness", surface.clearcoatRoughness,
+               props);
+  AddAttribute("inputs:roughness", surface.roughness, props);
+  AddAttribute("inputs:opacity", surface.opacity, props);
+  AddAttribute("inputs:opacityThreshold", surface.opacityThreshold, props);
+  AddAttribute("inputs:ior", surface.ior, props);
+  AddAttribute("inputs:normal", surface.normal, props);
+  AddAttribute("inputs:displacement", surface.displacement, props);
+  AddAttribute("inputs:occlusion", surface.occlusion, props);
+  AddAttribute("outputs:surface", surface.outputsSurface, props);
+  AddAttribute("outputs:displacement", surface.outputsDisplacement, props);
+  AddProperties(surface.props, props);
+}
+
+void ToProperties(const UsdUVTexture &texture, PropertyMap *props) {
+  AddAttribute("inputs:file", texture.file, props);
+  AddAttribute("inputs:st", texture.st, props);
+  AddAttribute("inputs:wrapS", texture.wrapS, props);
+  AddAttribute("inputs:wrapT", texture.wrapT, props);
+  AddAttribute("inputs:fallback", texture.fallback, props);
+  AddAttribute("inputs:sourceColorSpace", texture.sourceColorSpace, props);
+  AddAttribute("inputs:scale", texture.scale, props);
+  AddAttribute("inputs:bias", texture.bias, props);
+  AddAttribute("outputs:r", texture.outputsR, props);
+  AddAttribute("outputs:g", texture.outputsG, props);
+  AddAttribute("outputs:b", texture.outputsB, props);
+  AddAttribute("outputs:a", texture.outputsA, props);
+  AddAttribute("outputs:rgb", texture.outputsRGB, props);
+  AddProperties(texture.props, props);
+}
+
+void ToProperties(const UsdTransform2d &xform, PropertyMap *props) {
+  AddAttribute("inputs:in", xform.in, props);
+  AddAttribute("inputs:rotation", xform.rotation, props);
+  AddAttribute("inputs:scale", xform.scale, props);
+  AddAttribute("inputs:translation", xform.translation, props);
+  AddAttribute("outputs:result", xform.result, props);
+  AddProperties(xform.props, props);
+}
+
+void ToProperties(const ShaderNode &node, PropertyMap *props) {
+  AddProperties(node.props, props);
+}
+
+bool ToProperties(const Shader &shader, PropertyMap *props, std::string *err) {
+  if (shader.info_id.size()) {
+    AddUniformAttribute(kShaderInfoId, value::token(shader.info_id), props);
+  }
+
+#define CONVERT_SHADER_NODE(__ty)                  \
+  if (const auto *node = shader.value.as<__ty>()) { \
+    ToProperties(*node, props);                    \
+  } else
+
+#define CONVERT_PRIMVAR_READER(__ty)               \
+  if (const auto *node = shader.value.as<__ty>()) { \
+    AddPrimvarReaderProperties(*node, props);      \
+  } else
+
+  CONVERT_SHADER_NODE(UsdPreviewSurface)
+  CONVERT_SHADER_NODE(UsdUVTexture)
+  CONVERT_SHADER_NODE(UsdTransform2d)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_int)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_float)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_float2)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_float3)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_float4)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_string)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_normal)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_vector)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_point)
+  CONVERT_PRIMVAR_READER(UsdPrimvarReader_matrix)
+  CONVERT_SHADER_NODE(ShaderNode) {
+    PUSH_ERROR_AND_RETURN("Unsupported shader node type: "
+                          << shader.value.type_name());
+  }
+
+#undef CONVERT_SHADER_NODE
+#undef CONVERT_PRIMVAR_READER
+
+  AddProperties(shader.props, props);
+
+  return true;
+}
+
+// Fill typeName, specifier and properties.
+bool ToPrimSpecProperties(const Prim &prim, PrimSpec *ps, std::string *err) {
+  PropertyMap *props = &ps->props();
+
+  if (const auto *model = prim.as<Model>()) {
+    // Generic or unknown Prim type.
+    ps->typeName() = model->prim_type_name;
+    ps->specifier() = model->spec;
+    ToProperties(*model, props);
+    return true;
+  }
+
+  ps->typeName() = prim.type_name();
+
+  if (const auto *shader = prim.as<Shader>()) {
+    ps->specifier() = shader->spec;
+    return ToProperties(*shader, props, err);
+  }
+
+#define CONVERT_PRIM(__ty)                  \
+  if (const auto *typed = prim.as<__ty>()) { \
+    ps->specifier() = typed->spec;          \
+    ToProperties(*typed, props);            \
+  } else
+
+  CONVERT_PRIM(Xform)
+  CONVERT_PRIM(GPrim)
+  CONVERT_PRIM(Scope)
+  CONVERT_PRIM(GeomMesh)
+  CONVERT_PRIM(GeomSubset)
+  CONVERT_PRIM(GeomCamera)
+  CONVERT_PRIM(GeomSphere)
+  CONVERT_PRIM(GeomCube)
+  CONVERT_PRIM(GeomCone)
+  CONVERT_PRIM(GeomCylinder)
+  CONVERT_PRIM(GeomCapsule)
+  CONVERT_PRIM(GeomPoints)
+  CONVERT_PRIM(GeomBasisCurves)
+  CONVERT_PRIM(GeomNurbsCurves)
+  CONVERT_PRIM(PointInstancer)
+  CONVERT_PRIM(SphereLight)
+  CONVERT_PRIM(DiskLight)
+  CONVERT_PRIM(CylinderLight)
+  CONVERT_PRIM(RectLight)
+  CONVERT_PRIM(DistantLight)
+  CONVERT_PRIM(DomeLight)
+  CONVERT_PRIM(PortalLight)
+  CONVERT_PRIM(SkelRoot)
+  CONVERT_PRIM(Skeleton)
+  CONVERT_PRIM(SkelAnimation)
+  CONVERT_PRIM(BlendShape)
+  CONVERT_PRIM(Material)
+  CONVERT_PRIM(NodeGraph) {
+    PUSH_ERROR_AND_RETURN("Unsupported Prim type: " << prim.type_name()
+                                                    << " elementName: "
+                                                    << prim.element_name());
+  }
+
+#undef CONVERT_PRIM
+
+  return true;
+}
+
+}  // namespace
+
+bool PrimToPrimSpec(const Prim &prim, PrimSpec *ps, std::string *warn,
+                    std::string *err) {
+  if (!ps) {
+    PUSH_ERROR_AND_RETURN("`ps` argument is nullptr.");
+  }
+
+  PrimSpec dst;
+  dst.name() = prim.element_name();
+  dst.metas() = prim.metas();
+
+  if (!ToPrimSpecProperties(prim, &dst, err)) {
+    return false;
+  }
+
+  // Specifier is usually stored in the concrete Prim object.
+  if (prim.specifier() != Specifier::Invalid) {
+    dst.specifier() = prim.specifier();
+  }
+
+  for (const auto &child : prim.children()) {
+    PrimSpec child_ps;
+    if (!PrimToPrimSpec(child, &child_ps, warn, err)) {
+      return false;
+    }
+    dst.children().emplace_back(std::move(child_ps));
+  }
+
+  for (const auto &vs : prim.variantSets()) {
+    VariantSetSpec vss;
+    vss.name = vs.first;
+
+    for (const auto &variant : vs.second.variantSet) {
+      PrimSpec vps;
+      vps.name() = variant.first;
+      vps.metas() = variant.second.metas();
+      vps.props() = variant.second.properties();
+
+      for (const auto &child : variant.second.primChildren()) {
+        PrimSpec child_ps;
+        if (!PrimToPrimSpec(child, &child_ps, warn, err)) {
+          return false;
+        }
+        vps.children().emplace_back(std::move(child_ps));
+      }
+
+      vss.variantSet[variant.first] = std::move(vps);
+    }
+
+    dst.variantSets()[vs.first] = std::move(vss);
+  }
+
+  (*ps) = std::move(dst);
+
+  return true;
+}
+
+bool StageToLayer(const Stage &stage, Layer *layer, std::string *warn,
+                  std::string *err) {
+  if (!layer) {
+    PUSH_ERROR_AND_RETURN("`layer` argument is nullptr.");
+  }
+
+  layer->clear_primspecs();
+  layer->metas() = stage.metas();
+
+  std::vector<value::token> primChildren;
+  for (const auto &root : stage.root_prims()) {
+    PrimSpec ps;
+    if (!PrimToPrimSpec(root, &ps, warn, err)) {
+      return false;
+    }
+
+    primChildren.push_back(value::token(ps.name()));
+    layer->primspecs()[ps.name()] = std::move(ps);
+  }
+  layer->metas().primChildren = primChildren;
+
+  return true;
+}
+
+}  // namespace prim
+}  // namespace tinyusdz
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2023 - Present, Light Transport Entertainment Inc.
+//
+// Convert concrete Prim(e.g. Xform, GeomMesh) to PrimSpec.
+// Inverse of prim-reconstruct.
+//
+#pragma once
+
+#include <string>
+
+#include "prim-types.hh"
+
+namespace tinyusdz {
+
+class Stage;
+
+namespace prim {
+
+///
+/// Convert concrete Prim(including its child Prims and variantSets) to
+/// PrimSpec.
+/// Only authored properties are emitted, so that `ReconstructPrim` of the
+/// output PrimSpec gives the equivalent Prim.
+///
+/// @return false when the Prim contains unsupported Prim type. `err` is filled.
+///
+bool PrimToPrimSpec(const Prim &prim, PrimSpec *ps, std::string *warn,
+                    std::string *err);
+
+///
+/// Convert Stage(root Prims and Stage metadatum) to Layer.
+///
+bool StageToLayer(const Stage &stage, Layer *layer, std::string *warn,
+                  std::string *err);
+
+}  // namespace prim
+}  // namespace tinyusdz
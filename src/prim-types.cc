@@ -3,7 +3,13 @@
 #include <algorithm>
 #include <cstdio>
 #include <limits>
+#include <memory>
 #include <numeric>
+#include <unordered_map>
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+#include <mutex>
+#endif
 //
 #include "prim-types.hh"
 #include "str-util.hh"
@@ -62,20 +68,6 @@ nonstd::optional<Orientation> OrientationFromString(const std::string &v) {
   return nonstd::nullopt;
 }
 
-bool operator==(const Path &lhs, const Path &rhs) {
-  if (!lhs.is_valid()) {
-    return false;
-  }
-
-  if (!rhs.is_valid()) {
-    return false;
-  }
-
-  // Currently simply compare string.
-  // FIXME: Better Path identity check.
-  return (lhs.full_path_name() == rhs.full_path_name());
-}
-
 bool ConvertTokenAttributeToStringAttribute(
     const TypedAttribute<Animatable<value::token>> &inp,
     TypedAttribute<Animatable<std::string>> &out) {
@@ -99,8 +91,12 @@ bool ConvertTokenAttributeToStringAttribute(
         } else if (toks.is_timesamples()) {
           auto tok_ts = toks.get_timesamples();
   
-          for (auto &item : tok_ts.get_samples()) {
-            strs.add_sample(item.t, item.value.str());
+          for (size_t i = 0; i < tok_ts.size(); i++) {
+            if (tok_ts.is_blocked(i)) {
+              strs.add_blocked_sample(tok_ts.get_times()[i]);
+            } else {
+              strs.add_sample(tok_ts.get_times()[i], tok_ts.get_values()[i].str());
+            }
           }
         } else if (toks.is_blocked()) {
           // TODO
@@ -119,6 +115,260 @@ bool ConvertTokenAttributeToStringAttribute(
 // -- Path
 //
 
+namespace {
+
+// Element name of the Path: Property name for property path, otherwise the
+// last Prim name(or variant selection such like `{variant=green}`).
+std::string ComputePathElementName(const std::string &prim,
+                                   const std::string &prop) {
+  if (prop.size()) {
+    return prop;
+  }
+
+  size_t e = prim.find_last_not_of('/');
+  if (e == std::string::npos) {
+    // "" or "/"
+    return std::string();
+  }
+
+  size_t s = prim.find_last_of('/', e);
+  s = (s == std::string::npos) ? 0 : s + 1;
+
+  std::string elem = prim.substr(s, e - s + 1);
+
+  // `bora{variant=green}` -> `{variant=green}`
+  size_t v = elem.find_first_of('{');
+  if ((v != std::string::npos) && (v > 0) && (elem.back() == '}')) {
+    return elem.substr(v);
+  }
+
+  return elem;
+}
+
+constexpr size_t kPathShardBits = 6;
+constexpr size_t kNumPathShards = size_t(1) << kPathShardBits;
+
+///
+/// Global table of interned PathNode.
+///
+/// The table is split into shards selected by the hash of the full path, so
+/// that interning Paths from multiple threads does not serialize on a single
+/// lock. Nodes are reference counted and removed from the table when the last
+/// reference is released.
+///
+class PathTable {
+ public:
+  static PathTable &instance() {
+    // Intentionally leaked so that Paths in static objects are valid until
+    // the program exits.
+    static PathTable *table = new PathTable();
+    return *table;
+  }
+
+  const PathNode *empty() const { return &_empty; }
+
+  // Returned node is retained.
+  const PathNode *find_or_create(const std::string &prim,
+                                 const std::string &prop) {
+    if (prim.empty() && prop.empty()) {
+      return &_empty;
+    }
+
+    std::string full_path = prim;
+    if (prop.size()) {
+      full_path += "." + prop;
+    }
+
+    size_t hash = std::hash<std::string>()(full_path);
+    Shard &shard = _shards[shard_index(hash)];
+
+    {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+      std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+      if (const PathNode *node = shard.find_and_retain(full_path, prim, prop)) {
+        return node;
+      }
+    }
+
+    // Create the parent node(same rule with the string based
+    // `get_parent_path()`) before locking the shard of this node, so that at
+    // most one shard lock is held at a time.
+    const PathNode *parent = &_empty;
+    if (prop.size()) {
+      parent = find_or_create(prim, std::string());
+    } else if (!((prim.size() == 1) && (prim[0] == '/'))) {
+      size_t n = prim.find_last_of('/');
+      if (n == 0) {
+        parent = find_or_create("/", std::string());
+      } else if (n != std::string::npos) {
+        parent = find_or_create(prim.substr(0, n), std::string());
+      }
+    }
+
+    const PathNode *ret{nullptr};
+    {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+      std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+      // Another thread may have created the node in the meantime.
+      ret = shard.find_and_retain(full_path, prim, prop);
+      if (!ret) {
+        PathNode *node = new PathNode();
+        node->parent = parent;  // takes the reference of `parent`
+        node->prim_part = prim;
+        node->prop_part = prop;
+        node->full_path = full_path;
+        node->element = ComputePathElementName(prim, prop);
+        node->hash = hash;
+        node->refcount.store(1, std::memory_order_relaxed);
+
+        shard.nodes[full_path].push_back(node);
+        return node;
+      }
+    }
+
+    release(parent);
+    return ret;
+  }
+
+  // Returned node is retained.
+  const PathNode *find_or_create_child(const PathNode *parent,
+                                       const std::string &elem,
+                                       bool is_property) {
+    if (is_property) {
+      return find_or_create(parent->prim_part, elem);
+    } else if ((parent->prim_part.size() == 1) &&
+               (parent->prim_part[0] == '/')) {
+      return find_or_create(parent->prim_part + elem, std::string());
+    } else if (is_variantElementName(elem)) {
+      return find_or_create(parent->prim_part + elem, std::string());
+    }
+
+    return find_or_create(parent->prim_part + '/' + elem, std::string());
+  }
+
+  void release(const PathNode *node) {
+    while (node && !node->immortal) {
+      // Fast path: Not the last reference.
+      uint32_t count = node->refcount.load(std::memory_order_relaxed);
+      while (count > 1) {
+        if (node->refcount.compare_exchange_weak(count, count - 1,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+          return;
+        }
+      }
+
+      // Possibly the last reference. Decrement under the shard lock so that
+      // `find_and_retain()` never sees the node being freed.
+      Shard &shard = _shards[shard_index(node->hash)];
+      {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+        std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+        if (node->refcount.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+          return;
+        }
+        shard.erase(node);
+      }
+
+      // Release the parent after unlocking the shard, since the parent may
+      // live in the same shard.
+      const PathNode *parent = node->parent;
+      delete node;
+      node = parent;
+    }
+  }
+
+  size_t size() {
+    size_t n = 0;
+    for (Shard &shard : _shards) {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+      std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+      for (const auto &it : shard.nodes) {
+        n += it.second.size();
+      }
+    }
+    return n;
+  }
+
+ private:
+  struct Shard {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+    std::mutex mutex;
+#endif
+    // key = full path string
+    // Paths whose prim part contains '.'(e.g. "./bora") may share the full
+    // path string with property paths, so each part is also compared.
+    std::unordered_map<std::string, std::vector<const PathNode *>> nodes;
+
+    const PathNode *find_and_retain(const std::string &full_path,
+                                    const std::string &prim,
+                                    const std::string &prop) {
+      auto it = nodes.find(full_path);
+      if (it == nodes.end()) {
+        return nullptr;
+      }
+
+      for (const PathNode *node : it->second) {
+        if ((node->prim_part == prim) && (node->prop_part == prop)) {
+          node->refcount.fetch_add(1, std::memory_order_relaxed);
+          return node;
+        }
+      }
+
+      return nullptr;
+    }
+
+    void erase(const PathNode *node) {
+      auto it = nodes.find(node->full_path);
+      if (it == nodes.end()) {
+        return;
+      }
+
+      std::vector<const PathNode *> &v = it->second;
+      v.erase(std::remove(v.begin(), v.end(), node), v.end());
+      if (v.empty()) {
+        nodes.erase(it);
+      }
+    }
+  };
+
+  PathTable() {
+    _empty.hash = std::hash<std::string>()(std::string());
+    _empty.immortal = true;
+  }
+
+  static size_t shard_index(size_t hash) {
+    return (hash >> 3) & (kNumPathShards - 1);
+  }
+
+  PathNode _empty;
+  std::array<Shard, kNumPathShards> _shards;
+};
+
+}  // namespace
+
+const PathNode *Path::empty_node() { return PathTable::instance().empty(); }
+
+const PathNode *Path::intern(const std::string &prim,
+                             const std::string &prop) {
+  return PathTable::instance().find_or_create(prim, prop);
+}
+
+const PathNode *Path::intern_child(const PathNode *parent,
+                                   const std::string &elem, bool is_property) {
+  return PathTable::instance().find_or_create_child(parent, elem, is_property);
+}
+
+void Path::release_node(const PathNode *node) {
+  PathTable::instance().release(node);
+}
+
+size_t Path::num_interned_nodes() { return PathTable::instance().size(); }
+
 Path::Path(const std::string &p, const std::string &prop) {
   //
   // For absolute path, starts with '/' and no other '/' exists.
@@ -133,8 +383,6 @@ Path::Path(const std::string &p, const std::string &prop) {
   auto slash_fun = [](const char c) { return c == '/'; };
   auto dot_fun = [](const char c) { return c == '.'; };
 
-  std::vector<std::string> prims = split(p, "/");
-
   // TODO: More checks('{', '[', ...)
 
   if (prop.size()) {
@@ -159,18 +407,7 @@ Path::Path(const std::string &p, const std::string &prop) {
 
     if (ndots == 0) {
       // absolute prim.
-      _prim_part = p;
-
-      if (prop.size()) {
-        _prop_part = prop;
-        _element = prop;
-      } else {
-        if (prims.size()) {
-          _element = prims[prims.size() - 1];
-        } else {
-          _element = p;
-        }
-      }
+      set_node(intern(p, prop));
       _valid = true;
     } else if (ndots == 1) {
       // prim_part contains property name.
@@ -193,17 +430,9 @@ Path::Path(const std::string &p, const std::string &prop) {
         return;
       }
 
-      if (loc <= 0) {
-        // this should not happen though.
-        _valid = false;
-      }
-
       // split
-      std::string prop_name = p.substr(size_t(loc));
-
-      _prop_part = prop_name.erase(0, 1);  // remove '.'
-      _prim_part = p.substr(0, size_t(loc));
-      _element = _prop_part;  // elementName is property path
+      // (remove '.' from the prop part)
+      set_node(intern(p.substr(0, size_t(loc)), p.substr(size_t(loc) + 1)));
 
       _valid = true;
 
@@ -216,31 +445,8 @@ Path::Path(const std::string &p, const std::string &prop) {
     // maybe relative(e.g. "./xform", "../xform")
     // FIXME: Support relative path fully
 
-#if 0
-    auto nslashes = std::count_if(p.begin(), p.end(), slash_fun);
-    if (nslashes > 0) {
-      _valid = false;
-      return;
-    }
-
-    _prop_part = p;
-    _prop_part = _prop_part.erase(0, 1);
+    set_node(intern(p, prop));
     _valid = true;
-#else
-    _prim_part = p;
-    if (prop.size()) {
-      _prop_part = prop;
-      _element = prop;
-    } else {
-      if (prims.size()) {
-        _element = prims[prims.size() - 1];
-      } else {
-        _element = p;
-      }
-    }
-    _valid = true;
-
-#endif
 
   } else {
     // prim.prop
@@ -248,10 +454,7 @@ Path::Path(const std::string &p, const std::string &prop) {
     auto ndots = std::count_if(p.begin(), p.end(), dot_fun);
     if (ndots == 0) {
       // relative prim.
-      _prim_part = p;
-      if (prop.size()) {
-        _prop_part = prop;
-      }
+      set_node(intern(p, prop));
       _valid = true;
     } else if (ndots == 1) {
       if (p.size() < 3) {
@@ -267,11 +470,6 @@ Path::Path(const std::string &p, const std::string &prop) {
         return;
       }
 
-      if (loc <= 0) {
-        // this should not happen though.
-        _valid = false;
-      }
-
       // split
       std::string prop_name = p.substr(size_t(loc));
 
@@ -281,8 +479,8 @@ Path::Path(const std::string &p, const std::string &prop) {
         return;
       }
 
-      _prim_part = p.substr(0, size_t(loc));
-      _prop_part = prop_name.erase(0, 1);  // remove '.'
+      set_node(intern(p.substr(0, size_t(loc)),
+                      prop_name.erase(0, 1)));  // remove '.'
 
       _valid = true;
 
@@ -293,6 +491,31 @@ Path::Path(const std::string &p, const std::string &prop) {
   }
 }
 
+std::string Path::variant_part() const {
+  std::array<std::string, 2> variant;
+  if (tokenize_variantElement(element_name(), &variant)) {
+    return "{" + variant[0] + "=" + variant[1] + "}";
+  }
+
+  return "{=}";
+}
+
+Path &Path::make_relative() {
+  if (is_absolute_path() && (prim_part().size() > 1)) {
+    // Remove first '/'
+    set_node(intern(prim_part().substr(1), prop_part()));
+  }
+  return *this;
+}
+
+Path Path::prim_path() const {
+  Path p = (*this);
+  if (prop_part().size()) {
+    p.set_node(intern(prim_part(), std::string()));
+  }
+  return p;
+}
+
 Path Path::append_property(const std::string &elem) {
   Path &p = (*this);
 
@@ -319,8 +542,7 @@ Path Path::append_property(const std::string &elem) {
     return p;
   } else {
     // TODO: Validate property path.
-    p._prop_part = elem;
-    p._element = elem;
+    p.set_node(intern_child(p._node, elem, /* is_property */ true));
 
     return p;
   }
@@ -541,16 +763,12 @@ Path Path::append_element(const std::string &elem) {
 
   // {variant=value}
   if (is_variantElementName(elem)) {
-    std::array<std::string, 2> variant;
-    if (tokenize_variantElement(elem, &variant)) {
-      _variant_part = variant[0];
-      _variant_selection_part = variant[0];
-      _prim_part += elem;
-      _element = elem;
-      return p;
+    if (p.prop_part().size()) {
+      p.set_node(intern(p.prim_part() + elem, p.prop_part()));
     } else {
-      p._valid = false;
+      p.set_node(intern_child(p._node, elem, /* is_property */ false));
     }
+    return p;
   }
 
   if (elem[0] == '[') {
@@ -564,16 +782,13 @@ Path Path::append_element(const std::string &elem) {
     return p;
   } else {
     // std::cout << "elem " << elem << "\n";
-    if ((p._prim_part.size() == 1) && (p._prim_part[0] == '/')) {
-      p._prim_part += elem;
-    } else {
+    if (p.prop_part().size()) {
       // TODO: Validate element name.
-      p._prim_part += '/' + elem;
+      p.set_node(intern(p.prim_part() + '/' + elem, p.prop_part()));
+    } else {
+      p.set_node(intern_child(p._node, elem, /* is_property */ false));
     }
 
-    // Also store raw element name
-    p._element = elem;
-
     return p;
   }
 }
@@ -583,28 +798,17 @@ Path Path::get_parent_path() const {
     return Path();
   }
 
-  if (is_root_path()) {
-    Path p("", "");
-    return p;
-  }
-
-  if (is_prim_property_path()) {
-    // return prim part
-    return Path(prim_part(), "");
-  }
-
-  size_t n = _prim_part.find_last_of('/');
-  if (n == std::string::npos) {
-    // relative path(e.g. "bora") or propery only path(e.g. ".myval").
-    return Path();
-  }
-
-  if (n == 0) {
-    // return root
-    return Path("/", "");
-  }
+  // Parent node is computed when the node is interned:
+  //
+  // - / -> empty(invalid Path)
+  // - /bora -> /
+  // - /bora/dora.prop -> /bora/dora
+  // - dora -> empty(invalid Path)
+  Path p;
+  p.set_node(retain(_node->parent));
+  p._valid = !_node->parent->prim_part.empty();
 
-  return Path(_prim_part.substr(0, n), "");
+  return p;
 }
 
 Path Path::get_parent_prim_path() const {
@@ -612,39 +816,11 @@ Path Path::get_parent_prim_path() const {
     return Path();
   }
 
-  if (is_root_prim()) {
+  if (is_root_prim() || is_root_path()) {
     return *this;
   }
 
-  if (is_prim_property_path()) {
-    // return prim part
-    return Path(prim_part(), "");
-  }
-
-  size_t n = _prim_part.find_last_of('/');
-  if (n == std::string::npos) {
-    // this should never happen though.
-    return Path();
-  }
-
-  if (n == 0) {
-    // return root
-    return Path("/", "");
-  }
-
-  return Path(_prim_part.substr(0, n), "");
-}
-
-const std::string &Path::element_name() const {
-  if (_element.empty()) {
-    // Get last item.
-    std::vector<std::string> tokenized_prim_names = split(prim_part(), "/");
-    if (tokenized_prim_names.size()) {
-      _element = tokenized_prim_names[size_t(tokenized_prim_names.size() - 1)];
-    }
-  }
-
-  return _element;
+  return get_parent_path();
 }
 
 nonstd::optional<Kind> KindFromString(const std::string &str) {
@@ -1046,7 +1222,7 @@ bool Prim::add_child(Prim &&rhs, const bool rename_prim_name,
                      std::string *err) {
 #if defined(TINYUSDZ_ENABLE_THREAD)
   // TODO: Only take a lock when dirty.
-  std::lock_guard<std::mutex> lock(_mutex);
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
 #endif
 
   std::string elementName = rhs.element_name();
@@ -1149,6 +1325,7 @@ bool Prim::add_child(Prim &&rhs, const bool rename_prim_name,
   _childrenNameSet.insert(elementName);
   _children.emplace_back(std::move(rhs));
   _child_dirty = true;
+  _committed = false;
 
   return true;
 }
@@ -1157,7 +1334,7 @@ bool Prim::replace_child(const std::string &child_prim_name, Prim &&rhs,
                          std::string *err) {
 #if defined(TINYUSDZ_ENABLE_THREAD)
   // TODO: Only take a lock when dirty.
-  std::lock_guard<std::mutex> lock(_mutex);
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
 #endif
 
   if (child_prim_name.empty()) {
@@ -1233,15 +1410,23 @@ bool Prim::replace_child(const std::string &child_prim_name, Prim &&rhs,
   }
 
   _child_dirty = true;
+  _committed = false;
 
   return true;
 }
 
 const std::vector<int64_t> &Prim::get_child_indices_from_primChildren(
     bool force_update, bool *indices_is_valid) const {
+  if (_committed && !force_update) {
+    // Cache is built in `commit()`. No lock required.
+    if (indices_is_valid) {
+      (*indices_is_valid) = _primChildrenIndicesIsValid;
+    }
+    return _primChildrenIndices;
+  }
+
 #if defined(TINYUSDZ_ENABLE_THREAD)
-  // TODO: Only take a lock when dirty.
-  std::lock_guard<std::mutex> lock(_mutex);
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
 #endif
 
   if (!force_update && (_primChildrenIndices.size() == _children.size()) &&
@@ -1335,7 +1520,23 @@ class EmptyStaticMeta {
 
 PrimMeta *EmptyStaticMeta::s_meta = nullptr;
 
+void Prim::commit() {
+  for (auto &child : _children) {
+    child.commit();
+  }
+
+  _committed = false;
+  _child_dirty = true;
+  get_child_indices_from_primChildren(/* force_update */ false);
+
+  _committed = true;
+}
+
 PrimMeta &Prim::metas() {
+  // `primChildren` may be modified.
+  _child_dirty = true;
+  _committed = false;
+
   PrimMeta *p = GetPrimMeta(_data);
   if (p) {
     return *p;
@@ -2144,9 +2345,18 @@ bool Layer::find_primspec_at(const Path &path, const PrimSpec **ps,
     PUSH_ERROR_AND_RETURN(fmt::format("Path is not absolute path: {}", path.full_path_name()));
   }
 
+  if (_committed) {
+    // All PrimSpecs are cached in `commit()`. Lock-free lookup.
+    auto ret = _primspec_path_cache.find(path.prim_part());
+    if (ret != _primspec_path_cache.end()) {
+      (*ps) = ret->second;
+      return true;
+    }
+    return false;
+  }
+
 #if defined(TINYUSDZ_ENABLE_THREAD)
-  // TODO: Only take a lock when dirty.
-  std::lock_guard<std::mutex> lock(_mutex);
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
 #endif
 
   if (_dirty) {
@@ -2160,7 +2370,8 @@ bool Layer::find_primspec_at(const Path &path, const PrimSpec **ps,
     auto ret = _primspec_path_cache.find(path.prim_part());
     if (ret != _primspec_path_cache.end()) {
       DCOUT("Found cache.");
-      return ret->second;
+      (*ps) = ret->second;
+      return true;
     }
   }
 
@@ -2180,7 +2391,56 @@ bool Layer::find_primspec_at(const Path &path, const PrimSpec **ps,
   return false;
 }
 
+namespace {
+
+void BuildPrimSpecPathCacheRec(
+    const PrimSpec &primspec, const std::string &parent_path, uint32_t depth,
+    std::map<std::string, const PrimSpec *> *cache) {
+  if (depth > (1024 * 1024 * 128)) {
+    // Too deep.
+    return;
+  }
+
+  // Use the same path construction as GetPrimSpecAtPathRec.
+  const std::string abs_path = parent_path + "/" + primspec.name();
+  cache->emplace(abs_path, &primspec);
+
+  for (const auto &child : primspec.children()) {
+    BuildPrimSpecPathCacheRec(child, abs_path, depth + 1, cache);
+  }
+}
+
+}  // namespace
+
+void Layer::commit() {
+  _committed = false;
+
+  _primspec_path_cache.clear();
+  for (const auto &item : _prim_specs) {
+    BuildPrimSpecPathCacheRec(item.second, /* parent_path */ "",
+                              /* depth */ 0, &_primspec_path_cache);
+  }
+  _dirty = false;
+
+  check_unresolved_references();
+  check_unresolved_payload();
+  check_unresolved_variant();
+  check_unresolved_inherits();
+  check_unresolved_specializes();
+  check_over_primspec();
+
+  _committed = true;
+}
+
 bool Layer::check_unresolved_references(const uint32_t max_depth) const {
+  if (_committed) {
+    return _has_unresolved_references;
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
   bool ret = false;
 
   for (const auto &item : _prim_specs) {
@@ -2195,6 +2455,14 @@ bool Layer::check_unresolved_references(const uint32_t max_depth) const {
 }
 
 bool Layer::check_unresolved_payload(const uint32_t max_depth) const {
+  if (_committed) {
+    return _has_unresolved_payload;
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
   bool ret = false;
 
   for (const auto &item : _prim_specs) {
@@ -2209,6 +2477,14 @@ bool Layer::check_unresolved_payload(const uint32_t max_depth) const {
 }
 
 bool Layer::check_unresolved_variant(const uint32_t max_depth) const {
+  if (_committed) {
+    return _has_unresolved_variant;
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
   bool ret = false;
 
   for (const auto &item : _prim_specs) {
@@ -2223,6 +2499,14 @@ bool Layer::check_unresolved_variant(const uint32_t max_depth) const {
 }
 
 bool Layer::check_unresolved_inherits(const uint32_t max_depth) const {
+  if (_committed) {
+    return _has_unresolved_inherits;
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
   bool ret = false;
 
   for (const auto &item : _prim_specs) {
@@ -2237,6 +2521,14 @@ bool Layer::check_unresolved_inherits(const uint32_t max_depth) const {
 }
 
 bool Layer::check_unresolved_specializes(const uint32_t max_depth) const {
+  if (_committed) {
+    return _has_unresolved_specializes;
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
   bool ret = false;
 
   for (const auto &item : _prim_specs) {
@@ -2251,6 +2543,14 @@ bool Layer::check_unresolved_specializes(const uint32_t max_depth) const {
 }
 
 bool Layer::check_over_primspec(const uint32_t max_depth) const {
+  if (_committed) {
+    return _has_over_primspec;
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
   bool ret = false;
 
   for (const auto &item : _prim_specs) {
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -25,6 +26,7 @@
 #if defined(TINYUSDZ_ENABLE_THREAD)
 #include <mutex>
 #include <thread>
+#include "thread-util.hh"
 #endif
 
 //
@@ -310,13 +312,35 @@ enum class Variability {
 // Use ValidatePrimPath() in path-util.hh
 bool ValidatePrimElementName(const std::string &tok);
 
+///
+/// Interned Path node. Similar to SdfPathNode.
+///
+/// Nodes are hash-consed in a global(sharded) table: each pair of prim part
+/// and prop part is represented by exactly one live node, so the address of
+/// the node identifies a Path. Nodes are immutable once created.
+/// Nodes are reference counted by Path(and by child nodes through `parent`),
+/// and are removed from the table and freed when the last reference is gone.
+///
+struct PathNode {
+  const PathNode *parent{nullptr};  // Node of `Path::get_parent_path()`.
+  std::string prim_part;
+  std::string prop_part;
+  std::string full_path;  // prim_part + "." + prop_part
+  std::string element;    // Element name
+  size_t hash{0};
+  mutable std::atomic<uint32_t> refcount{0};
+  bool immortal{false};  // true for the empty node. Not reference counted.
+};
+
 ///
 /// Simlar to SdfPath.
 /// NOTE: We are doging refactoring of Path class, so the following comment may
 /// not be correct.
 ///
-/// We don't need the performance for USDZ, so use naiive implementation
-/// to represent Path.
+/// Path is a handle to the interned PathNode, so copy, comparison, hash,
+/// get_parent_path() and Append*() do not touch strings(other than the
+/// element name to append). String accessors(e.g. `prim_part()`) return the
+/// strings stored in the node.
 /// Path is something like Unix path, delimited by `/`, ':' and '.'
 /// Square brackets('<', '>' is not included)
 ///
@@ -357,8 +381,6 @@ class Path {
 
   static Path make_root_path() {
     Path p = Path("/", "");
-    // elementPath is empty for root.
-    p._element = "";
     p._valid = true;
     return p;
   }
@@ -379,42 +401,56 @@ class Path {
   // Path(const std::string &prim, const std::string &prop)
   //    : prim_part(prim), prop_part(prop) {}
 
-  Path(const Path &rhs) = default;
+  Path(const Path &rhs)
+      : _node(retain(rhs._node)),
+        _path_type(rhs._path_type),
+        _valid(rhs._valid) {}
 
-  Path &operator=(const Path &rhs) {
-    this->_valid = rhs._valid;
+  Path(Path &&rhs) noexcept
+      : _node(rhs._node), _path_type(rhs._path_type), _valid(rhs._valid) {
+    rhs._node = empty_node();
+    rhs._valid = false;
+  }
 
-    this->_prim_part = rhs._prim_part;
-    this->_prop_part = rhs._prop_part;
-    this->_element = rhs._element;
+  ~Path() { release(_node); }
 
-    return (*this);
+  Path &operator=(const Path &rhs) {
+    set_node(retain(rhs._node));
+    _path_type = rhs._path_type;
+    _valid = rhs._valid;
+    return *this;
+  }
+
+  Path &operator=(Path &&rhs) noexcept {
+    // `rhs` releases our old node.
+    std::swap(_node, rhs._node);
+    _path_type = rhs._path_type;
+    _valid = rhs._valid;
+    return *this;
   }
 
   std::string full_path_name() const {
-    std::string s;
     if (!_valid) {
-      s += "#INVALID#";
+      return "#INVALID#" + _node->full_path;
     }
 
-    s += _prim_part;
-    if (_prop_part.empty()) {
-      return s;
-    }
+    return _node->full_path;
+  }
 
-    s += "." + _prop_part;
+  const std::string &prim_part() const { return _node->prim_part; }
+  const std::string &prop_part() const { return _node->prop_part; }
 
-    return s;
-  }
+  // e.g. `{variantColor=green}`
+  std::string variant_part() const;
 
-  const std::string &prim_part() const { return _prim_part; }
-  const std::string &prop_part() const { return _prop_part; }
+  // Precomputed hash of the Path. O(1)
+  size_t hash() const { return _node->hash; }
 
-  const std::string &variant_part() const {
-    _variant_part_str =
-        "{" + _variant_part + "=" + _variant_selection_part + "}";
-    return _variant_part_str;
-  }
+  // Interned node of the Path.
+  const PathNode *node() const { return _node; }
+
+  // The number of live interned nodes(for debugging and tests).
+  static size_t num_interned_nodes();
 
   void set_path_type(const PathType ty) { _path_type = ty; }
 
@@ -435,11 +471,11 @@ class Path {
     }
 
     // TODO: RelationalAttribute
-    if (_prim_part.empty()) {
+    if (prim_part().empty()) {
       return false;
     }
 
-    if (_prop_part.size()) {
+    if (prop_part().size()) {
       return true;
     }
 
@@ -448,11 +484,11 @@ class Path {
 
   // Is Prim path?
   bool is_prim_path() const {
-    if (_prop_part.size()) {
+    if (prop_part().size()) {
       return false;
     }
 
-    if (_prim_part.size()) {
+    if (prim_part().size()) {
       return true;
     }
 
@@ -462,10 +498,10 @@ class Path {
   // Is Prim's property path?
   // True when both PrimPart and PropPart are not empty.
   bool is_prim_property_path() const {
-    if (_prim_part.empty()) {
+    if (prim_part().empty()) {
       return false;
     }
-    if (_prop_part.size()) {
+    if (prop_part().size()) {
       return true;
     }
     return false;
@@ -473,8 +509,8 @@ class Path {
 
   bool is_valid() const { return _valid; }
 
-  bool is_empty() {
-    return (_prim_part.empty() && _variant_part.empty() && _prop_part.empty());
+  bool is_empty() const {
+    return (prim_part().empty() && prop_part().empty());
   }
 
   // static Path RelativePath() { return Path("."); }
@@ -495,7 +531,17 @@ class Path {
 
   // Get element name(the last element of Path. i.e. Prim's name, Property's
   // name)
-  const std::string &element_name() const;
+  const std::string &element_name() const { return _node->element; }
+
+  ///
+  /// Get Prim part of the Path(property part is stripped).
+  ///
+  /// example:
+  ///
+  /// - /bora/dora.prop -> /bora/dora
+  /// - /bora/dora -> /bora/dora
+  ///
+  Path prim_path() const;
 
   ///
   /// Split a path to the root(common ancestor) and its siblings
@@ -566,7 +612,8 @@ class Path {
       return false;
     }
 
-    if ((_prim_part.size() == 1) && (_prim_part[0] == '/')) {
+    const std::string &prim = prim_part();
+    if ((prim.size() == 1) && (prim[0] == '/')) {
       return true;
     }
 
@@ -585,9 +632,10 @@ class Path {
       return false;
     }
 
-    if ((_prim_part.size() > 1) && (_prim_part[0] == '/')) {
+    const std::string &prim = prim_part();
+    if ((prim.size() > 1) && (prim[0] == '/')) {
       // no other '/' except for the fist one
-      if (_prim_part.find_last_of('/') == 0) {
+      if (prim.find_last_of('/') == 0) {
         return true;
       }
     }
@@ -596,7 +644,8 @@ class Path {
   }
 
   bool is_absolute_path() const {
-    if (_prim_part.size() && _prim_part[0] == '/') {
+    const std::string &prim = prim_part();
+    if (prim.size() && prim[0] == '/') {
       return true;
     }
 
@@ -604,7 +653,7 @@ class Path {
   }
 
   bool is_relative_path() const {
-    if (_prim_part.size()) {
+    if (prim_part().size()) {
       return !is_absolute_path();
     }
 
@@ -626,13 +675,7 @@ class Path {
 #endif
 
   // Strip '/'
-  Path &make_relative() {
-    if (is_absolute_path() && (_prim_part.size() > 1)) {
-      // Remove first '/'
-      _prim_part.erase(0, 1);
-    }
-    return *this;
-  }
+  Path &make_relative();
 
   const Path make_relative(Path &&rhs) {
     (*this) = std::move(rhs);
@@ -650,7 +693,7 @@ class Path {
   // To sort paths lexicographically.
   // TODO: consider abs and relative path correctly
   bool operator<(const Path &rhs) const {
-    if (full_path_name() == rhs.full_path_name()) {
+    if ((_node == rhs._node) && (_valid == rhs._valid)) {
       return false;
     }
 
@@ -662,13 +705,45 @@ class Path {
   }
 
  private:
-  std::string _prim_part;     // e.g. /Model/MyMesh, MySphere
-  std::string _prop_part;     // e.g. visibility (`.` is not included)
-  std::string _variant_part;  // e.g. `variantColor` for {variantColor=green}
-  std::string _variant_selection_part;  // e.g. `green` for {variantColor=green}
-                                        // . Could be empty({variantColor=}).
-  mutable std::string _variant_part_str;  // str buffer for variant_part()
-  mutable std::string _element;           // Element name
+  static const PathNode *empty_node();
+
+  // Find or create the node for given prim part and prop part.
+  // Returned node is retained.
+  static const PathNode *intern(const std::string &prim,
+                                const std::string &prop);
+
+  // Find or create the child node of `parent`. Returned node is retained.
+  static const PathNode *intern_child(const PathNode *parent,
+                                      const std::string &elem,
+                                      bool is_property);
+
+  static const PathNode *retain(const PathNode *node) {
+    if (!node->immortal) {
+      node->refcount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+  }
+
+  static void release(const PathNode *node) {
+    if (!node->immortal) {
+      release_node(node);
+    }
+  }
+
+  // Drop the reference and free the node(and its unreferenced parents) when
+  // it was the last one.
+  static void release_node(const PathNode *node);
+
+  // Replace the node with `node`(already retained).
+  void set_node(const PathNode *node) {
+    const PathNode *old = _node;
+    _node = node;
+    release(old);
+  }
+
+  // e.g. prim part: /Model/MyMesh, MySphere
+  //      prop part: visibility (`.` is not included)
+  const PathNode *_node{empty_node()};
 
   nonstd::optional<PathType> _path_type;  // Currently optional.
 
@@ -716,7 +791,26 @@ class TokenizedPath {
 };
 #endif
 
-bool operator==(const Path &lhs, const Path &rhs);
+// Compare the interned node. O(1)
+// Returns false when either Path is invalid.
+inline bool operator==(const Path &lhs, const Path &rhs) {
+  if (!lhs.is_valid() || !rhs.is_valid()) {
+    return false;
+  }
+
+  return lhs.node() == rhs.node();
+}
+
+// Hasher and key comparator to use Path as a key of unordered containers.
+struct PathHasher {
+  size_t operator()(const Path &path) const { return path.hash(); }
+};
+
+struct PathKeyEqual {
+  bool operator()(const Path &lhs, const Path &rhs) const {
+    return (lhs.node() == rhs.node()) && (lhs.is_valid() == rhs.is_valid());
+  }
+};
 
 // variants in Prim Meta.
 //
@@ -1134,7 +1228,9 @@ using PropMetas = AttrMetas;
 // 1: (2.0, true)
 // 2: (3.0, false)
 //
-
+// Samples are stored in columnar(SoA) layout: sorted `times` array,
+// contiguous `values` array and `blocked` bitset.
+//
 template <typename T>
 struct TypedTimeSamples {
  public:
@@ -1144,15 +1240,53 @@ struct TypedTimeSamples {
     bool blocked{false};
   };
 
-  bool empty() const { return _samples.empty(); }
+  bool empty() const { return _times.empty(); }
 
+  void clear() {
+    _times.clear();
+    _values.clear();
+    _blocked.clear();
+    _dirty = false;
+  }
+
+  ///
+  /// Sort samples by time when samples were added out of order. Read methods
+  /// call this, so the first read after an out-of-order `add_sample` sorts
+  /// the samples. Call it before sharing TimeSamples among reader threads.
+  ///
   void update() const {
-    std::sort(_samples.begin(), _samples.end(),
-              [](const Sample &a, const Sample &b) { return a.t < b.t; });
+    if (!_dirty) {
+      return;
+    }
+
+    // Stable, so samples at the same time keep the insertion order.
+    std::vector<size_t> order(_times.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return _times[a] < _times[b];
+    });
+
+    std::vector<double> times(_times.size());
+    std::vector<T> values(_values.size());
+    std::vector<bool> blocked(_blocked.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      times[i] = _times[order[i]];
+      values[i] = std::move(_values[order[i]]);
+      blocked[i] = _blocked[order[i]];
+    }
 
+    _times = std::move(times);
+    _values = std::move(values);
+    _blocked = std::move(blocked);
     _dirty = false;
+  }
 
-    return;
+  void reserve(size_t n) {
+    _times.reserve(n);
+    _values.reserve(n);
+    _blocked.reserve(n);
   }
 
   // Get value at specified time.
@@ -1160,10 +1294,14 @@ struct TypedTimeSamples {
   //
   // Return `Held` value even when TimeSampleInterpolationType is
   // Linear. Returns nullopt when specified time is out-of-range.
+  //
+  // `cursor` is an optional hint for sequential lookup. See
+  // value::TimeSampleCursor.
   template<typename V = T, std::enable_if_t<!value::LerpTraits<V>::supported(), std::nullptr_t> = nullptr>
   bool get(T *dst, double t = value::TimeCode::Default(),
            value::TimeSampleInterpolationType interp =
-               value::TimeSampleInterpolationType::Linear) const {
+               value::TimeSampleInterpolationType::Linear,
+           value::TimeSampleCursor *cursor = nullptr) const {
 
     (void)interp;
 
@@ -1175,40 +1313,21 @@ struct TypedTimeSamples {
       return false;
     }
 
-    if (_dirty) {
-      update();
-    }
+    update();
 
     if (value::TimeCode(t).is_default()) {
       // FIXME: Use the first item for now.
       // TODO: Handle bloked
-      (*dst) = _samples[0].value;
+      (*dst) = _values[0];
       return true;
     } else {
 
-      if (_samples.size() == 1) {
-        (*dst) = _samples[0].value;
+      if (_times.size() == 1) {
+        (*dst) = _values[0];
         return true;
       }
 
-      // Held = nerarest preceding value for a gien time.
-      // example:
-      // input = 0.0: 100, 1.0: 200
-      //
-      // t -1.0 => 100(time 0.0)
-      // t 0.0 => 100(time 0.0)
-      // t 0.1 => 100(time 0.0)
-      // t 0.9 => 100(time 0.0)
-      // t 1.0 => 200(time 1.0)
-      //
-      // This can be achieved by using upper_bound, and subtract 1 from the found position.
-      auto it = std::upper_bound(
-        _samples.begin(), _samples.end(), t,
-        [](double tval, const Sample &a) { return tval < a.t; });
-
-      const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
-
-      (*dst) = it_minus_1->value;
+      (*dst) = _values[value::FindHeldTimeSampleIndex(_times, t, cursor)];
       return true;
     }
 
@@ -1218,10 +1337,14 @@ struct TypedTimeSamples {
   // Get value at specified time.
   // Return linearly interpolated value when TimeSampleInterpolationType is
   // Linear. Returns nullopt when specified time is out-of-range.
+  //
+  // `cursor` is an optional hint for sequential lookup. See
+  // value::TimeSampleCursor.
   template<typename V = T, std::enable_if_t<value::LerpTraits<V>::supported(), std::nullptr_t> = nullptr>
   bool get(T *dst, double t = value::TimeCode::Default(),
            value::TimeSampleInterpolationType interp =
-               value::TimeSampleInterpolationType::Linear) const {
+               value::TimeSampleInterpolationType::Linear,
+           value::TimeSampleCursor *cursor = nullptr) const {
     if (!dst) {
       return false;
     }
@@ -1230,81 +1353,36 @@ struct TypedTimeSamples {
       return false;
     }
 
-    if (_dirty) {
-      update();
-    }
+    update();
 
     if (value::TimeCode(t).is_default()) {
       // FIXME: Use the first item for now.
       // TODO: Handle bloked
-      (*dst) = _samples[0].value;
+      (*dst) = _values[0];
       return true;
     } else {
 
-      if (_samples.size() == 1) {
-        (*dst) = _samples[0].value;
+      if (_times.size() == 1) {
+        (*dst) = _values[0];
         return true;
       }
 
-      auto it = std::lower_bound(
-        _samples.begin(), _samples.end(), t,
-        [](const Sample &a, double tval) { return a.t < tval; });
-
       if (interp == value::TimeSampleInterpolationType::Linear) {
 
-        // MS STL does not allow seek vector iterator before begin
-        // Issue #110
-        const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
-
-        size_t idx0 = size_t((std::max)(
-            int64_t(0),
-            (std::min)(int64_t(_samples.size() - 1),
-                     int64_t(std::distance(_samples.begin(), it_minus_1)))));
-        size_t idx1 =
-            size_t((std::max)(int64_t(0), (std::min)(int64_t(_samples.size() - 1),
-                                                 int64_t(idx0) + 1)));
-
-        double tl = _samples[idx0].t;
-        double tu = _samples[idx1].t;
-
-        double dt = (t - tl);
-        if (std::fabs(tu - tl) < std::numeric_limits<double>::epsilon()) {
-          // slope is zero.
-          dt = 0.0;
-        } else {
-          dt /= (tu - tl);
-        }
-
-        // Just in case.
-        dt = (std::max)(0.0, (std::min)(1.0, dt));
-
-        const value::Value &pv0 = _samples[idx0].value;
-        const value::Value &pv1 = _samples[idx1].value;
-
-        if (pv0.type_id() != pv1.type_id()) {
-          // Type mismatch.
-          return false;
-        }
-
-        // To concrete type
-        const T *p0 = pv0.as<T>();
-        const T *p1 = pv1.as<T>();
+        size_t idx0, idx1;
+        double dt;
+        value::FindLerpTimeSampleIndices(_times, t, &idx0, &idx1, &dt, cursor);
 
-        if (!p0 || !p1) {
-          return false;
+        if (dt <= 0.0) {
+          (*dst) = _values[idx0];
+          return true;
         }
 
-        const T p = lerp(*p0, *p1, dt);
-
-        (*dst) = std::move(p);
+        // Lerp directly on the typed array.
+        (*dst) = lerp(_values[idx0], _values[idx1], dt);
         return true;
       } else {
-        if (it == _samples.end()) {
-          // ???
-          return false;
-        }
-
-        (*dst) = it->value;
+        (*dst) = _values[value::FindHeldTimeSampleIndex(_times, t, cursor)];
         return true;
       }
     }
@@ -1313,109 +1391,167 @@ struct TypedTimeSamples {
   }
 
   void add_sample(const Sample &s) {
-    _samples.push_back(s);
-    _dirty = true;
+    add_sample_impl(s.t, s.value, s.blocked);
   }
 
   void add_sample(const double t, const T &v) {
-    Sample s;
-    s.t = t;
-    s.value = v;
-    _samples.emplace_back(s);
-    _dirty = true;
+    add_sample_impl(t, v, false);
   }
 
   void add_blocked_sample(const double t) {
-    Sample s;
-    s.t = t;
-    s.blocked = true;
-    _samples.emplace_back(s);
-    _dirty = true;
+    add_sample_impl(t, T(), true);
   }
 
   bool has_sample_at(const double t) const {
-    if (_dirty) {
-      update();
-    }
 
-    const auto it = std::find_if(_samples.begin(), _samples.end(), [&t](const Sample &s) {
-      return tinyusdz::math::is_close(t, s.t);
+    const auto it = std::find_if(_times.begin(), _times.end(), [&t](double st) {
+      return tinyusdz::math::is_close(t, st);
     });
 
-    return (it != _samples.end());
+    return (it != _times.end());
   }
 
-  bool get_sample_at(const double t, Sample **dst) {
-    if (!dst) {
+  // Overwrite the value of the sample at time `t`.
+  // Returns false when no sample exists at `t`.
+  bool set_sample_at(const double t, const T &v) {
+    update();
+
+    const auto it = std::find_if(_times.begin(), _times.end(), [&t](double st) {
+      return math::is_close(t, st);
+    });
+
+    if (it == _times.end()) {
       return false;
     }
 
-    if (_dirty) {
-      update();
-    }
+    size_t idx = size_t(std::distance(_times.begin(), it));
+    _values[idx] = v;
+    _blocked[idx] = false;
+    return true;
+  }
 
-    const auto it = std::find_if(_samples.begin(), _samples.end(), [&t](const Sample &sample) {
-      return math::is_close(t, sample.t);
-    });
+  // Sorted time array.
+  const std::vector<double> &get_times() const {
+    update();
+    return _times;
+  }
 
-    if (it != _samples.end()) {
-      (*dst) = &(*it); 
+  // Values in the order of `get_times()`. The value of blocked sample is
+  // default-constructed.
+  const std::vector<T> &get_values() const {
+    update();
+    return _values;
+  }
+
+  bool is_blocked(size_t idx) const {
+    if (idx >= _blocked.size()) {
+      return false;
     }
-    return false;
+
+    update();
+
+    return _blocked[idx];
   }
 
-  const std::vector<Sample> &get_samples() const {
-    if (_dirty) {
-      update();
+  nonstd::optional<Sample> get_sample(size_t idx) const {
+    if (idx >= _times.size()) {
+      return nonstd::nullopt;
     }
 
-    return _samples;
+    update();
+
+    Sample s;
+    s.t = _times[idx];
+    s.value = _values[idx];
+    s.blocked = _blocked[idx];
+    return s;
   }
 
-  std::vector<Sample> &samples() {
-    if (_dirty) {
-      update();
+  ///
+  /// Get values at multiple times.
+  /// Faster than calling `get` for each time when `times` is sorted, since the
+  /// lookup reuses the last bracket.
+  ///
+  bool get_many(const std::vector<double> &times, std::vector<T> *dst,
+                value::TimeSampleInterpolationType interp =
+                    value::TimeSampleInterpolationType::Linear) const {
+    if (!dst) {
+      return false;
+    }
+
+    dst->resize(times.size());
+
+    value::TimeSampleCursor cursor;
+    for (size_t i = 0; i < times.size(); i++) {
+      T v;
+      if (!get(&v, times[i], interp, &cursor)) {
+        return false;
+      }
+      (*dst)[i] = std::move(v);
     }
 
-    return _samples;
+    return true;
   }
 
   // From typeless timesamples.
   bool from_timesamples(const value::TimeSamples &ts) {
-    std::vector<Sample> buf;
+    std::vector<double> times;
+    std::vector<T> values;
+    std::vector<bool> blocked;
+
+    times.reserve(ts.size());
+    values.reserve(ts.size());
+    blocked.reserve(ts.size());
+
     for (size_t i = 0; i < ts.size(); i++) {
-      if (ts.get_samples()[i].value.type_id() != value::TypeTraits<T>::type_id()) {
+      if (ts.is_blocked(i)) {
+        times.push_back(ts.get_times()[i]);
+        values.emplace_back();
+        blocked.push_back(true);
+        continue;
+      }
+
+      auto v = ts.get_value(i);
+      if (!v || (v.value().type_id() != value::TypeTraits<T>::type_id())) {
         return false;
       }
-      Sample s;
-      s.t = ts.get_samples()[i].t;
-      s.blocked = ts.get_samples()[i].blocked;
-      if (const auto pv = ts.get_samples()[i].value.as<T>()) {
-        s.value = (*pv);
+
+      if (const auto pv = v.value().as<T>()) {
+        times.push_back(ts.get_times()[i]);
+        values.push_back(*pv);
+        blocked.push_back(false);
       } else {
         return false;
       }
-
-      buf.push_back(s);
     }
 
-
-    _samples = std::move(buf);
-    _dirty = true;
+    _times = std::move(times);
+    _values = std::move(values);
+    _blocked = std::move(blocked);
+    _dirty = false;
 
     return true;
   }
 
   size_t size() const {
-    if (_dirty) {
-      update();
-    }
-    return _samples.size();
+    return _times.size();
   }
 
  private:
-  // Need to be sorted when looking up the value.
-  mutable std::vector<Sample> _samples;
+  void add_sample_impl(const double t, const T &v, bool blocked) {
+    // Append, and sort at the first read(See `update()`).
+    if (!_times.empty() && (t < _times.back())) {
+      _dirty = true;
+    }
+    _times.push_back(t);
+    _values.push_back(v);
+    _blocked.push_back(blocked);
+  }
+
+  // Sorted by time unless `_dirty` is set.
+  mutable std::vector<double> _times;
+  mutable std::vector<T> _values;
+  mutable std::vector<bool> _blocked;  // bitset
   mutable bool _dirty{false};
 };
 
@@ -1450,9 +1586,13 @@ struct Animatable {
   ///
   /// Get value at specific time.
   ///
+  /// `cursor` is an optional hint for sequential lookup of timeSamples. See
+  /// value::TimeSampleCursor.
+  ///
   bool get(double t, T *v,
            const value::TimeSampleInterpolationType tinerp =
-               value::TimeSampleInterpolationType::Linear) const {
+               value::TimeSampleInterpolationType::Linear,
+           value::TimeSampleCursor *cursor = nullptr) const {
     if (!v) {
       return false;
     }
@@ -1469,7 +1609,7 @@ struct Animatable {
     }
 
     if (has_timesamples()) {
-      return _ts.get(v, t, tinerp);
+      return _ts.get(v, t, tinerp, cursor);
     }
     
     if (has_default()) {
@@ -1510,6 +1650,8 @@ struct Animatable {
   // Add None(ValueBlock) sample to timesamples
   void add_blocked_sample(const double t) { _ts.add_blocked_sample(t); }
 
+  void reserve_timesamples(size_t n) { _ts.reserve(n); }
+
   // Scalar
   void set(const T &v) {
     _value = v;
@@ -1542,7 +1684,7 @@ struct Animatable {
   }
 
   void clear_timesamples() {
-    _ts.samples().clear();
+    _ts.clear();
   }
 
   bool has_value() const {
@@ -1577,6 +1719,52 @@ struct Animatable {
   TypedTimeSamples<T> _ts;
 };
 
+///
+/// Typed attribute value whose decoding is deferred until the first access(See
+/// `USDLoadOptions::defer_value_loading`). The decoded value is cached and
+/// shared among copies of the attribute.
+///
+template <typename T>
+class DeferredTypedValue {
+ public:
+  using LoadFunction = std::function<bool(T *value)>;
+
+  explicit DeferredTypedValue(LoadFunction &&fn) : _fn(std::move(fn)) {}
+
+  DeferredTypedValue(const DeferredTypedValue &) = delete;
+  DeferredTypedValue &operator=(const DeferredTypedValue &) = delete;
+
+  ///
+  /// Decode the value at the first call.
+  /// @return nullptr when decoding failed.
+  ///
+  const T *get() const {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+    std::lock_guard<std::mutex> lock(_mutex);
+#endif
+    if (!_loaded) {
+      T v;
+      if (_fn && _fn(&v)) {
+        _value = std::move(v);
+      }
+      // Release the input data referenced by the load function.
+      _fn = nullptr;
+      _loaded = true;
+    }
+
+    return _value ? &_value.value() : nullptr;
+  }
+
+ private:
+  mutable LoadFunction _fn;
+  mutable bool _loaded{false};
+  mutable nonstd::optional<T> _value;
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  mutable std::mutex _mutex;
+#endif
+};
+
 ///
 /// Tyeped Attribute without fallback(default) value.
 /// For attribute with `uniform` qualifier or TimeSamples, or have
@@ -1605,21 +1793,49 @@ class TypedAttribute {
 
   TypedAttribute &operator=(const T &value) {
     _attrib = value;
+    _deferred.reset();
 
     return (*this);
   }
 
   // 'default' value or timeSampled value(when T = Animatable)
-  void set_value(const T &v) { _attrib = v; }
-  bool has_value() const { return _attrib.has_value(); }
+  void set_value(const T &v) {
+    _attrib = v;
+    _deferred.reset();
+  }
+  bool has_value() const { return _attrib.has_value() || _deferred; }
+
+  ///
+  /// Set the value which is decoded at the first `get_value()`.
+  ///
+  void set_deferred_value(std::shared_ptr<const DeferredTypedValue<T>> dv) {
+    _attrib.reset();
+    _deferred = std::move(dv);
+  }
+
+  bool has_deferred_value() const { return _deferred != nullptr; }
 
   const nonstd::optional<T> get_value() const {
+    if (_deferred) {
+      if (const T *pv = _deferred->get()) {
+        return *pv;
+      }
+      return nonstd::nullopt;
+    }
     return _attrib;
   }
 
   bool get_value(T *dst) const {
     if (!dst) return false;
 
+    if (_deferred) {
+      if (const T *pv = _deferred->get()) {
+        (*dst) = *pv;
+        return true;
+      }
+      return false;
+    }
+
     if (_attrib) {
       (*dst) = _attrib.value();
       return true;
@@ -1675,7 +1891,7 @@ class TypedAttribute {
       return false;
     }
 
-    if (_attrib.has_value()) {
+    if (has_value()) {
       return false;
     }
 
@@ -1688,7 +1904,7 @@ class TypedAttribute {
 
   // The attribute authroed?
   bool authored() const {
-    if (_attrib) {
+    if (has_value()) {
       return true;
     }
 
@@ -1710,6 +1926,7 @@ class TypedAttribute {
 
   void clear_value() {
     _attrib.reset();
+    _deferred.reset();
     _value_empty = true;
   }
 
@@ -1721,6 +1938,7 @@ class TypedAttribute {
   bool _value_empty{false};  // applies `_attrib`
   std::vector<Path> _paths;
   nonstd::optional<T> _attrib;
+  std::shared_ptr<const DeferredTypedValue<T>> _deferred;
   bool _blocked{false};
 };
 
@@ -1793,6 +2011,7 @@ class TypedAttributeWithFallback {
 
   TypedAttributeWithFallback &operator=(const T &value) {
     _attrib = value;
+    _deferred.reset();
 
     // fallback Value should be already set with `AttribWithFallback(const T&
     // fallback)` constructor.
@@ -1825,7 +2044,21 @@ class TypedAttributeWithFallback {
   //   }
   // }
 
-  void set_value(const T &v) { _attrib = v; }
+  void set_value(const T &v) {
+    _attrib = v;
+    _deferred.reset();
+  }
+
+  ///
+  /// Set the value which is decoded at the first `get_value()`. The fallback
+  /// value is returned when decoding failed.
+  ///
+  void set_deferred_value(std::shared_ptr<const DeferredTypedValue<T>> dv) {
+    _attrib.reset();
+    _deferred = std::move(dv);
+  }
+
+  bool has_deferred_value() const { return _deferred != nullptr; }
 
   void set_value_empty() { _empty = true; }
 
@@ -1846,7 +2079,7 @@ class TypedAttributeWithFallback {
       return true;
     }
 
-    if (_attrib) {
+    if (has_authored_value()) {
       return false;
     }
 
@@ -1862,12 +2095,22 @@ class TypedAttributeWithFallback {
   }
 
   const T &get_value() const {
+    if (_deferred) {
+      if (const T *pv = _deferred->get()) {
+        return *pv;
+      }
+      return _fallback;
+    }
     if (_attrib) {
       return _attrib.value();
     }
     return _fallback;
   }
 
+  // true when the value is explicitly assigned(i.e. `get_value()` does not
+  // return the fallback value)
+  bool has_authored_value() const { return _attrib.has_value() || _deferred; }
+
   bool is_blocked() const { return _blocked; }
 
   // for `uniform` attribute only
@@ -1900,7 +2143,7 @@ class TypedAttributeWithFallback {
     if (_empty) {  // authored with empty value.
       return true;
     }
-    if (_attrib) {
+    if (has_authored_value()) {
       return true;
     }
     if (_paths.size()) {
@@ -1919,6 +2162,7 @@ class TypedAttributeWithFallback {
   AttrMeta _metas;
   std::vector<Path> _paths;
   nonstd::optional<T> _attrib;
+  std::shared_ptr<const DeferredTypedValue<T>> _deferred;
   bool _empty{false};
   T _fallback;
   bool _blocked{false};  // for `uniform` attribute.
@@ -3669,7 +3913,11 @@ class Prim {
   //}
 
   // TODO: Deprecate this API to disallow direct modification of children.
-  std::vector<Prim> &children() { return _children; }
+  std::vector<Prim> &children() {
+    _child_dirty = true;
+    _committed = false;
+    return _children;
+  }
 
   const std::vector<Prim> &children() const { return _children; }
 
@@ -3771,7 +4019,17 @@ class Prim {
   /// valid.
   ///
   const std::vector<int64_t> &get_child_indices_from_primChildren(
-      bool force_update = true, bool *indices_is_valid = nullptr) const;
+      bool force_update = false, bool *indices_is_valid = nullptr) const;
+
+  ///
+  /// Build caches(e.g. child indices) of this Prim and its descendants.
+  /// After `commit`, const methods of the Prim tree do not modify the Prim and
+  /// can be called from multiple threads without a lock, until the Prim is
+  /// modified through non-const methods.
+  ///
+  void commit();
+
+  bool is_committed() const { return _committed; }
 
   // TODO: Add API to get parent Prim directly?
   // (Currently we need to traverse parent Prim using Stage)
@@ -3804,6 +4062,7 @@ class Prim {
                          // unique elementName in `add_child`
 
   mutable bool _child_dirty{false};
+  bool _committed{false};  // true when caches are built by `commit()`.
   mutable bool _primChildrenIndicesIsValid{
       false};  // true when indices in _primChildrenIndices are not -1, unique,
                // and index value are within [0, children().size()), and also
@@ -3821,7 +4080,7 @@ class Prim {
   std::map<std::string, VariantSet> _variantSets;
 
 #if defined(TINYUSDZ_ENABLE_THREAD)
-  mutable std::mutex _mutex;
+  mutable thread_util::CopyableMutex _mutex;
 #endif
 };
 
@@ -4240,7 +4499,10 @@ class Layer {
 
   void set_name(const std::string name) { _name = name; }
 
-  void clear_primspecs() { _prim_specs.clear(); }
+  void clear_primspecs() {
+    _prim_specs.clear();
+    mark_dirty();
+  }
 
   // Check if `primname` exists in root Prims?
   bool has_primspec(const std::string &primname) const {
@@ -4268,6 +4530,7 @@ class Layer {
     }
 
     _prim_specs.emplace(name, ps);
+    mark_dirty();
 
     return true;
   }
@@ -4293,6 +4556,7 @@ class Layer {
     }
 
     _prim_specs.emplace(name, std::move(ps));
+    mark_dirty();
 
     return true;
   }
@@ -4318,6 +4582,7 @@ class Layer {
     }
 
     _prim_specs.at(name) = ps;
+    mark_dirty();
 
     return true;
   }
@@ -4343,6 +4608,7 @@ class Layer {
     }
 
     _prim_specs.at(name) = std::move(ps);
+    mark_dirty();
 
     return true;
   }
@@ -4351,7 +4617,11 @@ class Layer {
     return _prim_specs;
   }
 
-  std::unordered_map<std::string, PrimSpec> &primspecs() { return _prim_specs; }
+  // PrimSpecs may be modified through the returned reference.
+  std::unordered_map<std::string, PrimSpec> &primspecs() {
+    mark_dirty();
+    return _prim_specs;
+  }
 
   const LayerMetas &metas() const { return _metas; }
   LayerMetas &metas() { return _metas; }
@@ -4441,6 +4711,18 @@ class Layer {
   ///
   bool find_primspec_at(const Path &path, const PrimSpec **ps, std::string *err) const;
 
+  ///
+  /// Build the PrimSpec path cache and compute all composition flags(
+  /// `check_unresolved_references`, `check_over_primspec`, ...).
+  ///
+  /// After `commit`, const methods of Layer do not modify the Layer and can be
+  /// called from multiple threads without a lock, until the Layer is modified
+  /// through non-const methods(e.g. `primspecs()`, `add_primspec()`).
+  ///
+  void commit();
+
+  bool is_committed() const { return _committed; }
+
 
   ///
   /// Set state for AssetResolution in the subsequent composition operation.
@@ -4468,6 +4750,11 @@ class Layer {
   }
 
  private:
+  void mark_dirty() {
+    _dirty = true;
+    _committed = false;
+  }
+
   std::string _name;  // layer name ~= USD filename
 
   // key = prim name
@@ -4475,13 +4762,14 @@ class Layer {
   LayerMetas _metas;
 
 #if defined(TINYUSDZ_ENABLE_THREAD)
-  mutable std::mutex _mutex;
+  mutable thread_util::CopyableMutex _mutex;
 #endif
 
   // Cached primspec path.
   // key : prim_part string (e.g. "/path/bora")
   mutable std::map<std::string, const PrimSpec *> _primspec_path_cache;
   mutable bool _dirty{true};
+  bool _committed{false};  // true when caches are built by `commit()`.
 
   // Cached flags for composition.
   // true by default even PrimSpec tree does not contain any `references`, `payload`, etc.
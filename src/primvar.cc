@@ -20,90 +20,95 @@
 namespace tinyusdz {
 namespace primvar {
 
-bool PrimVar::get_interpolated_value(const double t, const value::TimeSampleInterpolationType tinterp, value::Value *dst) const {
-
-  if (is_blocked()) {
-    return false;
+DeferredValue::DeferredValue(const std::string &type_name, bool is_timesamples,
+                             LoadFunction &&fn)
+    : _type_name(type_name),
+      _is_timesamples(is_timesamples),
+      _fn(std::move(fn)) {
+  if (!_type_name.empty()) {
+    _type_id = value::GetTypeId(_type_name);
   }
+}
 
-  if (value::TimeCode(t).is_default()) {
-    if (has_default()) {
-      (*dst) = _value;
-      return true;
-    }
+std::string DeferredValue::type_name() const {
+  if (!_type_name.empty()) {
+    return _type_name;
   }
 
-  if (has_timesamples()) {
-    const std::vector<value::TimeSamples::Sample> &samples = _ts.get_samples();
-
-    if (samples.empty()) {
-      // ???
-      return false;
-    }
-
-    if (value::TimeCode(t).is_default())  {
-      // FIXME: Use the first item for now.
-      if (samples[0].blocked) {
-        return false;
-      }
-
-      (*dst) = samples[0].value;
-      return true;
-    } else {
+  return _is_timesamples ? timesamples().type_name() : value().type_name();
+}
 
-      if (tinterp == value::TimeSampleInterpolationType::Held || !value::IsLerpSupportedType(_value.type_id())) {
+uint32_t DeferredValue::type_id() const {
+  if (!_type_name.empty()) {
+    return _type_id;
+  }
 
-        auto it = std::upper_bound(
-          samples.begin(), samples.end(), t,
-          [](double tval, const value::TimeSamples::Sample &a) { return tval < a.t; });
+  return _is_timesamples ? timesamples().type_id() : value().type_id();
+}
 
-        const auto it_minus_1 = (it == samples.begin()) ? samples.begin() : (it - 1);
+bool DeferredValue::is_loaded() const {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<std::mutex> lock(_mutex);
+#endif
+  return _loaded;
+}
 
-        (*dst) = it_minus_1->value;
-        return true;
+void DeferredValue::load() const {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<std::mutex> lock(_mutex);
+#endif
 
-      } else { // Lerp 
+  if (_loaded) {
+    return;
+  }
 
-        // TODO: Unify code in prim-types.hh
-        auto it = std::lower_bound(
-            samples.begin(), samples.end(), t,
-            [](const value::TimeSamples::Sample &a, double tval) { return a.t < tval; });
+  if (_fn) {
+    if (!_fn(&_value, &_ts, &_err)) {
+      _value = nullptr;
+      _ts.clear();
+    }
+    // Release resources(e.g. keep-alive handle of the input data) held by
+    // the load function.
+    _fn = nullptr;
+  }
 
-        const auto it_minus_1 = (it == samples.begin()) ? samples.begin() : (it - 1);
+  _loaded = true;
+}
 
-        size_t idx0 = size_t(std::max(
-            int64_t(0),
-            std::min(int64_t(samples.size() - 1),
-                     int64_t(std::distance(samples.begin(), it_minus_1)))));
-        size_t idx1 =
-            size_t(std::max(int64_t(0), std::min(int64_t(samples.size() - 1),
-                                                 int64_t(idx0) + 1)));
+const value::Value &DeferredValue::value() const {
+  load();
+  return _value;
+}
 
-        double tl = samples[idx0].t;
-        double tu = samples[idx1].t;
+const value::TimeSamples &DeferredValue::timesamples() const {
+  load();
+  return _ts;
+}
 
-        double dt = (t - tl);
-        if (std::fabs(tu - tl) < std::numeric_limits<double>::epsilon()) {
-          // slope is zero.
-          dt = 0.0;
-        } else {
-          dt /= (tu - tl);
-        }
+std::string DeferredValue::error() const {
+  load();
+  return _err;
+}
 
-        // Just in case.
-        dt = std::max(0.0, std::min(1.0, dt));
+bool PrimVar::get_interpolated_value(const double t, const value::TimeSampleInterpolationType tinterp, value::Value *dst) const {
 
-        const value::Value &p0 = samples[idx0].value;
-        const value::Value &p1 = samples[idx1].value;
+  if (is_blocked()) {
+    return false;
+  }
 
-        bool ret = value::Lerp(p0, p1, dt, dst);
-        return ret;
-      }
+  if (value::TimeCode(t).is_default()) {
+    if (has_default()) {
+      (*dst) = value_raw();
+      return true;
     }
   }
 
+  if (has_timesamples()) {
+    return ts_raw().get_interpolated_value(t, tinterp, dst);
+  }
+
   if (has_default()) {
-    (*dst) = _value;
+    (*dst) = value_raw();
     return true;
   }
 
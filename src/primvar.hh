@@ -19,6 +19,11 @@
 #include <type_traits>
 #include <vector>
 #include <cmath>
+#include <string>
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+#include <mutex>
+#endif
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -37,16 +42,87 @@
 namespace tinyusdz {
 namespace primvar {
 
+///
+/// Value whose decoding is deferred until the first access(e.g. array or
+/// TimeSamples value of an Attribute in memory-mapped USDC file).
+///
+/// The type of the value is known without decoding. The decoded value is
+/// cached, so the load function is called at most once(thread-safe when
+/// TinyUSDZ is built with `TINYUSDZ_ENABLE_THREAD`).
+///
+class DeferredValue {
+ public:
+  ///
+  /// Decode the value. Store the result to `value`(default value) or
+  /// `ts`(TimeSamples).
+  ///
+  using LoadFunction = std::function<bool(
+      value::Value *value, value::TimeSamples *ts, std::string *err)>;
+
+  ///
+  /// `type_name` : Type name of the value when it is known without decoding
+  /// (e.g. from the Attribute's `typeName` or the Crate ValueRep). When
+  /// empty, the value is decoded to get its type.
+  ///
+  DeferredValue(const std::string &type_name, bool is_timesamples,
+                LoadFunction &&fn);
+
+  DeferredValue(const DeferredValue &) = delete;
+  DeferredValue &operator=(const DeferredValue &) = delete;
+
+  std::string type_name() const;
+  uint32_t type_id() const;
+
+  bool is_timesamples() const { return _is_timesamples; }
+
+  bool is_loaded() const;
+
+  ///
+  /// Get the value. The value is decoded at the first call.
+  /// Returns null value(or empty TimeSamples) when decoding failed. Use
+  /// `error()` to get the reason.
+  ///
+  const value::Value &value() const;
+  const value::TimeSamples &timesamples() const;
+
+  std::string error() const;
+
+ private:
+  void load() const;
+
+  std::string _type_name;
+  uint32_t _type_id{value::TYPE_ID_INVALID};
+  bool _is_timesamples{false};
+  mutable LoadFunction _fn;
+
+  mutable bool _loaded{false};
+  mutable value::Value _value{nullptr};
+  mutable value::TimeSamples _ts;
+  mutable std::string _err;
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  mutable std::mutex _mutex;
+#endif
+};
+
 struct PrimVar {
   value::Value _value{nullptr}; // For scalar(default) value
   bool _blocked{false}; // ValueBlocked.
   value::TimeSamples _ts; // For TimeSamples value.
 
+  // Deferred default value and TimeSamples. Decoded when the value is
+  // accessed. Shared among copies of this PrimVar.
+  std::shared_ptr<const DeferredValue> _deferred_value;
+  std::shared_ptr<const DeferredValue> _deferred_ts;
+
   bool has_value() const {
     // ValueBlock is treated as having a value.
     if (_blocked) {
       return true;
     }
+    if (_deferred_value) {
+      return true;
+    }
     return (_value.type_id() != value::TypeId::TYPE_ID_INVALID) && (_value.type_id() != value::TypeId::TYPE_ID_NULL);
   }
 
@@ -55,25 +131,46 @@ struct PrimVar {
   }
 
   bool has_timesamples() const {
+    if (_deferred_ts) {
+      return true;
+    }
     return _ts.size() > 0;
   }
 
   bool is_scalar() const {
-    return has_value() && _ts.empty();
+    return has_value() && !has_timesamples();
   }
 
   bool is_timesamples() const {
-    return !has_value() && _ts.size();
+    return !has_value() && has_timesamples();
   }
 
   bool is_blocked() const {
     // Fist check if stored value is ValueBlock, then return _blocked.
-    if (_value.type_id() == value::TYPE_ID_VALUEBLOCK) {
+    // (Deferred value is never a ValueBlock)
+    if (!_deferred_value && (_value.type_id() == value::TYPE_ID_VALUEBLOCK)) {
       return true;
     }
     return _blocked;
   }
 
+  ///
+  /// Set the default value or TimeSamples whose decoding is deferred.
+  /// Any value previously set is cleared.
+  ///
+  void set_deferred_value(std::shared_ptr<const DeferredValue> dv) {
+    if (dv && dv->is_timesamples()) {
+      _ts.clear();
+      _deferred_ts = std::move(dv);
+    } else {
+      _value = nullptr;
+      _deferred_value = std::move(dv);
+    }
+  }
+
+  bool has_deferred_value() const { return _deferred_value != nullptr; }
+  bool has_deferred_timesamples() const { return _deferred_ts != nullptr; }
+
   void set_blocked(bool onoff) {
     // fast path
     _blocked = onoff;
@@ -81,7 +178,8 @@ struct PrimVar {
 
   bool is_valid() const {
     if (has_timesamples()) {
-      if ((_ts.type_id() == value::TypeId::TYPE_ID_INVALID) || (_ts.type_id() == value::TypeId::TYPE_ID_NULL)) {
+      uint32_t ts_tyid = _deferred_ts ? _deferred_ts->type_id() : _ts.type_id();
+      if ((ts_tyid == value::TypeId::TYPE_ID_INVALID) || (ts_tyid == value::TypeId::TYPE_ID_NULL)) {
         return false;
       }
 
@@ -96,10 +194,16 @@ struct PrimVar {
 
   std::string type_name() const {
     if (has_default()) {
+      if (_deferred_value && !_blocked) {
+        return _deferred_value->type_name();
+      }
       return _value.type_name();
     }
       
     if (has_timesamples()) {
+      if (_deferred_ts) {
+        return _deferred_ts->type_name();
+      }
       return _ts.type_name();
     }
 
@@ -112,10 +216,16 @@ struct PrimVar {
     }
 
     if (has_default()) {
+      if (_deferred_value && !_blocked) {
+        return _deferred_value->type_id();
+      }
       return _value.type_id();
     }
 
     if (has_timesamples()) {
+      if (_deferred_ts) {
+        return _deferred_ts->type_id();
+      }
       return _ts.type_id();
     }
 
@@ -139,7 +249,7 @@ struct PrimVar {
       return nonstd::nullopt;
     }
 
-    return _value.get_value<T>();
+    return value_raw().get_value<T>();
   }
 
   template <class T>
@@ -153,18 +263,15 @@ struct PrimVar {
       return nonstd::nullopt;
     }
 
-    if (idx >= _ts.size()) {
+    if (idx >= ts_raw().size()) {
       return nonstd::nullopt;
     }
 
-    return _ts.get_time(idx);
+    return ts_raw().get_time(idx);
   }
 
   nonstd::optional<value::TimeSamples::Sample> get_timesample(size_t idx) const {
-    if (idx < _ts.get_samples().size()) {
-      return _ts.get_samples()[idx];
-    }
-    return nonstd::nullopt;
+    return ts_raw().get_sample(idx);
   }
 
   // Type-safe way to get concrete value for timesampled variable.
@@ -176,7 +283,7 @@ struct PrimVar {
       return nonstd::nullopt;
     }
 
-    nonstd::optional<value::Value> pv = _ts.get_value(idx);
+    nonstd::optional<value::Value> pv = ts_raw().get_value(idx);
     if (!pv) {
       return nonstd::nullopt;
     }
@@ -191,11 +298,12 @@ struct PrimVar {
       return nonstd::nullopt;
     }
 
-    if (idx >= _ts.get_samples().size()) {
+    const value::TimeSamples &ts = ts_raw();
+    if (idx >= ts.size()) {
       return nonstd::nullopt;
     }
 
-    return _ts.get_samples()[idx].blocked;
+    return ts.is_blocked(idx);
   }
 
   // For Scalar only
@@ -207,37 +315,42 @@ struct PrimVar {
       return nullptr;
     }
 
-    return _value.as<T>();
+    return value_raw().as<T>();
   }
 
   template <class T>
   void set_value(const T &v) {
+    _deferred_value.reset();
     _value = v;
   }
 
   void clear_value() {
+    _deferred_value.reset();
     _value = nullptr;
   }
 
   void set_timesamples(const value::TimeSamples &v) {
+    _deferred_ts.reset();
     _ts = v;
   }
 
   void set_timesamples(value::TimeSamples &&v) {
+    _deferred_ts.reset();
     _ts = std::move(v);
   }
 
   void clear_timesamples() {
+    _deferred_ts.reset();
     _ts.clear();
   }
 
   template <typename T>
   void set_timesample(double t, const T &v) {
-    _ts.add_sample(t, v);
+    ts_raw().add_sample(t, v);
   }
 
   void set_timesample(double t, value::Value &v) {
-    _ts.add_sample(t, v);
+    ts_raw().add_sample(t, v);
   }
 
 
@@ -298,13 +411,13 @@ struct PrimVar {
         return true;
       }
 
-      if (_ts.empty()) {
+      if (!has_timesamples()) {
         return false;
       }
     }
 
     if (has_timesamples()) {
-      return _ts.get(v, t, tinterp);
+      return ts_raw().get(v, t, tinterp);
     }
 
     if (has_default()) {
@@ -319,24 +432,42 @@ struct PrimVar {
 
   size_t num_timesamples() const {
     if (has_timesamples()) {
-      return _ts.size();
+      return ts_raw().size();
     }
     return 0;
   }
 
+  // Deferred value is decoded(and cached in DeferredValue) when accessed
+  // through const methods.
   const value::TimeSamples &ts_raw() const {
+    if (_deferred_ts) {
+      return _deferred_ts->timesamples();
+    }
     return _ts;
   }
   
+  // Non-const access copies the deferred value into this PrimVar, so that it
+  // can be modified.
   value::Value &value_raw() {
+    if (_deferred_value) {
+      _value = _deferred_value->value();
+      _deferred_value.reset();
+    }
     return _value;
   }
 
   const value::Value &value_raw() const {
+    if (_deferred_value) {
+      return _deferred_value->value();
+    }
     return _value;
   }
   
   value::TimeSamples &ts_raw() {
+    if (_deferred_ts) {
+      _ts = _deferred_ts->timesamples();
+      _deferred_ts.reset();
+    }
     return _ts;
   }
 };
@@ -46,7 +46,7 @@ namespace tinyusdz {
 namespace {
 
 nonstd::optional<const Prim *> GetPrimAtPathRec(const Prim *parent,
-                                                const std::string &parent_path,
+                                                const Path &parent_path,
                                                 const Path &path,
                                                 const uint32_t depth) {
 
@@ -54,22 +54,12 @@ nonstd::optional<const Prim *> GetPrimAtPathRec(const Prim *parent,
     return nonstd::nullopt;
   }
 
-  std::string abs_path;
-  // if (auto pv = GetPrimElementName(parent->data())) {
-  {
-    std::string elementName = parent->element_path().prim_part();
-    // DCOUT(pprint::Indent(depth) << "Prim elementName = " << elementName);
-    // DCOUT(pprint::Indent(depth) << "Given Path = " << path);
-    //  fully absolute path
-    abs_path = parent_path + "/" + elementName;
-    // DCOUT(pprint::Indent(depth) << "abs_path = " << abs_path);
-    // DCOUT(pprint::Indent(depth)
-    //       << "queriying path = " << path.full_path_name());
-    if (abs_path == path.full_path_name()) {
-      // DCOUT(pprint::Indent(depth)
-      //       << "Got it! Found Prim at Path = " << abs_path);
-      return parent;
-    }
+  // fully absolute path
+  // Path is interned, so the comparison is O(1)
+  const Path abs_path =
+      parent_path.AppendPrim(parent->element_path().prim_part());
+  if (abs_path == path) {
+    return parent;
   }
 
   // DCOUT(pprint::Indent(depth)
@@ -91,6 +81,32 @@ nonstd::optional<const Prim *> GetPrimAtPathRec(const Prim *parent,
 // -- Stage
 //
 
+Stage::Stage(const Stage &rhs) { (*this) = rhs; }
+
+Stage &Stage::operator=(const Stage &rhs) {
+  if (this == &rhs) {
+    return (*this);
+  }
+
+  _root_nodes = rhs._root_nodes;
+  _root_node_nameSet = rhs._root_node_nameSet;
+  name = rhs.name;
+  default_root_node = rhs.default_root_node;
+  stage_metas = rhs.stage_metas;
+  _err = rhs._err;
+  _warn = rhs._warn;
+  _prim_id_allocator = rhs._prim_id_allocator;
+
+  // Cached Prim pointers refer to the Prims of `rhs`.
+  _prim_path_cache.clear();
+  _prim_id_cache.clear();
+  _dirty = true;
+  _prim_id_dirty = true;
+  _committed = false;
+
+  return (*this);
+}
+
 nonstd::expected<const Prim *, std::string> Stage::GetPrimAtPath(
     const Path &path) const {
   DCOUT("GetPrimAtPath : " << path.prim_part() << "(input path: " << path
@@ -113,6 +129,23 @@ nonstd::expected<const Prim *, std::string> Stage::GetPrimAtPath(
         "Path is not absolute. Non-absolute Path is TODO.\n");
   }
 
+  if (_committed) {
+    // All Prims are cached in `commit()`. Lock-free lookup.
+    auto ret = _prim_path_cache.find(path.prim_path());
+    if (ret != _prim_path_cache.end()) {
+      return ret->second;
+    }
+
+    return nonstd::make_unexpected("Cannot find path <" +
+                                   path.full_path_name() + "> in the Stage.\n");
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  // `_prim_path_cache` is updated in this const method, so take a lock for
+  // concurrent readers(e.g. parallel mesh conversion in Tydra).
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
   if (_dirty) {
     DCOUT("clear cache.");
     // Clear cache.
@@ -121,7 +154,7 @@ nonstd::expected<const Prim *, std::string> Stage::GetPrimAtPath(
     _dirty = false;
   } else {
     // First find from a cache.
-    auto ret = _prim_path_cache.find(path.prim_part());
+    auto ret = _prim_path_cache.find(path.prim_path());
     if (ret != _prim_path_cache.end()) {
       DCOUT("Found cache.");
       return ret->second;
@@ -132,10 +165,11 @@ nonstd::expected<const Prim *, std::string> Stage::GetPrimAtPath(
   // Brute-force search.
   for (const auto &parent : _root_nodes) {
     if (auto pv =
-            GetPrimAtPathRec(&parent, /* root */ "", path, /* depth */ 0)) {
+            GetPrimAtPathRec(&parent, Path::make_root_path(), path,
+                             /* depth */ 0)) {
       // Add to cache.
       // Assume pointer address does not change unless dirty state.
-      _prim_path_cache[path.prim_part()] = pv.value();
+      _prim_path_cache[path.prim_path()] = pv.value();
       return pv.value();
     }
   }
@@ -219,6 +253,20 @@ bool Stage::find_prim_by_prim_id(const uint64_t prim_id, const Prim *&prim,
     return false;
   }
 
+  if (_committed) {
+    // All Prims are cached in `commit()`. Lock-free lookup.
+    auto ret = _prim_id_cache.find(prim_id);
+    if (ret != _prim_id_cache.end()) {
+      prim = ret->second;
+      return true;
+    }
+    return false;
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
+#endif
+
   if (_prim_id_dirty) {
     DCOUT("clear prim_id cache.");
     // Clear cache.
@@ -288,7 +336,7 @@ nonstd::expected<const Prim *, std::string> Stage::GetPrimFromRelativePath(
   DCOUT("abs path = " << abs_path);
 
   // Brute-force search from Stage root.
-  if (auto pv = GetPrimAtPathRec(&root, /* root */"", abs_path, /* depth */0)) {
+  if (auto pv = GetPrimAtPathRec(&root, Path::make_root_path(), abs_path, /* depth */0)) {
     return pv.value();
   }
 
@@ -604,6 +652,51 @@ bool Stage::compute_absolute_prim_path_and_assign_prim_id(
   return true;
 }
 
+namespace {
+
+void BuildPrimCacheRec(
+    const Prim &prim, const Path &parent_path,
+    std::unordered_map<Path, const Prim *, PathHasher, PathKeyEqual>
+        *path_cache,
+    std::map<uint64_t, const Prim *> *id_cache) {
+  // Use the same path construction as GetPrimAtPathRec.
+  const Path abs_path = parent_path.AppendPrim(prim.element_name());
+
+  // Keep the first one when Prims with the same path exist, as done in the
+  // brute-force search.
+  path_cache->emplace(abs_path, &prim);
+  if (prim.prim_id() > 0) {
+    id_cache->emplace(uint64_t(prim.prim_id()), &prim);
+  }
+
+  for (const auto &child : prim.children()) {
+    BuildPrimCacheRec(child, abs_path, path_cache, id_cache);
+  }
+}
+
+}  // namespace
+
+bool Stage::commit() {
+  // Currently we always allocate Prim ID.
+  if (!compute_absolute_prim_path_and_assign_prim_id(true)) {
+    return false;
+  }
+
+  _prim_path_cache.clear();
+  _prim_id_cache.clear();
+  for (Prim &root : _root_nodes) {
+    root.commit();
+    BuildPrimCacheRec(root, Path::make_root_path(), &_prim_path_cache,
+                      &_prim_id_cache);
+  }
+
+  _dirty = false;
+  _prim_id_dirty = false;
+  _committed = true;
+
+  return true;
+}
+
 bool Stage::compute_absolute_prim_path() {
   Path rootPath("/", "");
   for (Prim &root : root_prims()) {
@@ -621,7 +714,7 @@ bool Stage::add_root_prim(Prim &&prim, bool rename_prim_name) {
 
 #if defined(TINYUSDZ_ENABLE_THREAD)
   // TODO: Only take a lock when dirty.
-  std::lock_guard<std::mutex> lock(_mutex);
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
 #endif
 
 
@@ -682,6 +775,7 @@ bool Stage::add_root_prim(Prim &&prim, bool rename_prim_name) {
   _root_nodes.emplace_back(std::move(prim));
 
   _dirty = true;
+  _committed = false;
 
   return true;
 
@@ -692,7 +786,7 @@ bool Stage::replace_root_prim(const std::string &prim_name, Prim &&prim) {
 
 #if defined(TINYUSDZ_ENABLE_THREAD)
   // TODO: Only take a lock when dirty.
-  std::lock_guard<std::mutex> lock(_mutex);
+  std::lock_guard<thread_util::CopyableMutex> lock(_mutex);
 #endif
 
   if (prim_name.empty()) {
@@ -747,6 +841,7 @@ bool Stage::replace_root_prim(const std::string &prim_name, Prim &&prim) {
   }
 
   _dirty = true;
+  _committed = false;
 
   return true;
 }
@@ -21,6 +21,17 @@ class PrimRange;
 // Similar to UsdStage, but much more something like a Scene(scene graph)
 class Stage {
  public:
+  Stage() = default;
+
+  // Caches hold pointers to Prims of the source Stage, so the copy is not
+  // committed and its caches are rebuilt on demand(or by `commit()`).
+  Stage(const Stage &rhs);
+  Stage &operator=(const Stage &rhs);
+
+  // Moving keeps Prim addresses(and the caches) valid.
+  Stage(Stage &&rhs) = default;
+  Stage &operator=(Stage &&rhs) = default;
+
   // pxrUSD compat API ----------------------------------------
   static Stage CreateInMemory() { return Stage(); }
 
@@ -128,7 +139,13 @@ class Stage {
   /// @return Array of Root Prims.
   /// TODO: Deprecate non-const `root_prims()` API and use `add_root_prim()` instead.
   ///
-  std::vector<Prim> &root_prims() { return _root_nodes; }
+  std::vector<Prim> &root_prims() {
+    // Prims may be modified through the returned reference.
+    _dirty = true;
+    _prim_id_dirty = true;
+    _committed = false;
+    return _root_nodes;
+  }
 
   ///
   /// Add Prim to root.
@@ -214,10 +231,25 @@ class Stage {
   ///
   /// @brief Commit Stage state.
   ///
-  bool commit() {
-    // Currently we always allocate Prim ID.
-    return compute_absolute_prim_path_and_assign_prim_id(true);
-  }
+  /// Compute absolute Prim paths, assign Prim ids and build all lookup
+  /// caches(Prim path, Prim id, child indices of each Prim).
+  ///
+  /// After `commit`, const methods of Stage(e.g. `GetPrimAtPath`,
+  /// `find_prim_by_prim_id`) do not modify the Stage and can be called from
+  /// multiple threads without a lock. Any modification through non-const
+  /// methods(e.g. `root_prims()`, `add_root_prim()`) invalidates the
+  /// committed state, and const methods fall back to lazily building the
+  /// cache(with a lock when TINYUSDZ_ENABLE_THREAD is defined).
+  ///
+  /// NOTE: Cached Prim pointers are not valid in a copy of the Stage. Call
+  /// `commit` again on the copied Stage.
+  ///
+  bool commit();
+
+  ///
+  /// @return true when the Stage is committed and not modified afterwards.
+  ///
+  bool is_committed() const { return _committed; }
 
   ///
   /// Compute absolute Prim path for Prims in this Stage.
@@ -245,7 +277,7 @@ class Stage {
  private:
 
 #if defined(TINYUSDZ_ENABLE_THREAD)
-  mutable std::mutex _mutex;
+  mutable thread_util::CopyableMutex _mutex;
 #endif
 
 #if 0 // Deprecated. remove.
@@ -296,8 +328,9 @@ class Stage {
   mutable std::string _warn;
 
   // Cached prim path.
-  // key : prim_part string (e.g. "/path/bora")
-  mutable std::map<std::string, const Prim *> _prim_path_cache;
+  // key : Prim path(property part is stripped. e.g. "/path/bora")
+  mutable std::unordered_map<Path, const Prim *, PathHasher, PathKeyEqual>
+      _prim_path_cache;
 
   // Cached prim_id -> Prim lookup
   // key : prim_id
@@ -308,6 +341,8 @@ class Stage {
   mutable bool _prim_id_dirty{true}; // True when Prim Id assignent changed(TODO: Unify with `_dirty` flag)
 
   mutable HandleAllocator<uint64_t> _prim_id_allocator;
+
+  bool _committed{false}; // True when all caches are built by `commit()`.
 };
 
 inline std::string to_string(const Stage &stage, bool relative_path = false) {
@@ -31,10 +31,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Simple byte stream reader. Consider endianness when reading 2, 4, 8 bytes data.
 //
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace tinyusdz {
 
@@ -108,36 +111,67 @@ static inline void swap8(int64_t *val) {
 ///
 class StreamReader {
  public:
+  ///
+  /// Read function for chunked mode.
+  /// Read up to `n` bytes at byte offset `offset` of the data into `dst`.
+  /// Returns the number of bytes read(0 = end of data or read error).
+  ///
+  using ReadFunction =
+      std::function<uint64_t(uint64_t offset, uint64_t n, uint8_t *dst)>;
+
   explicit StreamReader(const uint8_t *binary, const uint64_t length,
                         const bool swap_endian)
-      : binary_(binary), length_(length), swap_endian_(swap_endian), idx_(0) {
+      : binary_(binary), length_(length), total_length_(length), swap_endian_(swap_endian), idx_(0) {
+    (void)pad_;
+  }
+
+  ///
+  /// Chunked mode. `length` bytes of data are read through `fn` into a window
+  /// of about `chunk_size` + `history_size` bytes, so the whole data does not
+  /// need to be in memory.
+  /// Seeking backward is possible for `history_size` bytes before the
+  /// position where the window was last refilled.
+  /// `data()` returns the address of the current window in this mode.
+  ///
+  explicit StreamReader(ReadFunction &&fn, const uint64_t length,
+                        const uint64_t chunk_size, const uint64_t history_size,
+                        const bool swap_endian)
+      : binary_(nullptr), length_(0), total_length_(length), swap_endian_(swap_endian), idx_(0) {
     (void)pad_;
+    chunk_.reset(new ChunkSource());
+    chunk_->read_fn = std::move(fn);
+    chunk_->chunk_size = (std::max)(uint64_t(1), chunk_size);
+    chunk_->history_size = history_size;
   }
 
+  bool is_chunked() const { return chunk_ != nullptr; }
+
   bool seek_set(const uint64_t offset) const {
-    if (offset > length_) {
+    if (offset > total_length_) {
       return false;
     }
 
-    idx_ = offset;
+    if ((offset < base_) || (offset > (base_ + length_))) {
+      return fill_at(offset, 0);
+    }
+
+    idx_ = offset - base_;
     return true;
   }
 
   bool seek_from_current(const int64_t offset) const {
-    if ((int64_t(idx_) + offset) < 0) {
+    if ((int64_t(base_ + idx_) + offset) < 0) {
       return false;
     }
 
-    if (uint64_t((int64_t(idx_) + offset)) > length_) {
-      return false;
-    }
-
-    idx_ = uint64_t(int64_t(idx_) + offset);
-    return true;
+    return seek_set(uint64_t(int64_t(base_ + idx_) + offset));
   }
 
   uint64_t read(const uint64_t n, const uint64_t dst_len, uint8_t *dst) const {
     uint64_t len = n;
+    if ((idx_ + len) > length_) {
+      fill(len);
+    }
     if ((idx_ + len) > length_) {
       len = length_ - uint64_t(idx_);
     }
@@ -160,7 +194,7 @@ class StreamReader {
   }
 
   bool read1(uint8_t *ret) const {
-    if ((idx_ + 1) > length_) {
+    if (((idx_ + 1) > length_) && !fill(1)) {
       return false;
     }
 
@@ -173,7 +207,7 @@ class StreamReader {
   }
 
   bool read_bool(bool *ret) const {
-    if ((idx_ + 1) > length_) {
+    if (((idx_ + 1) > length_) && !fill(1)) {
       return false;
     }
 
@@ -186,7 +220,7 @@ class StreamReader {
   }
 
   bool read1(char *ret) const {
-    if ((idx_ + 1) > length_) {
+    if (((idx_ + 1) > length_) && !fill(1)) {
       return false;
     }
 
@@ -199,7 +233,7 @@ class StreamReader {
   }
 
   bool read2(unsigned short *ret) const {
-    if ((idx_ + 2) > length_) {
+    if (((idx_ + 2) > length_) && !fill(2)) {
       return false;
     }
 
@@ -217,7 +251,7 @@ class StreamReader {
   }
 
   bool read4(uint32_t *ret) const {
-    if ((idx_ + 4) > length_) {
+    if (((idx_ + 4) > length_) && !fill(4)) {
       return false;
     }
 
@@ -235,7 +269,7 @@ class StreamReader {
   }
 
   bool read4(int *ret) const {
-    if ((idx_ + 4) > length_) {
+    if (((idx_ + 4) > length_) && !fill(4)) {
       return false;
     }
 
@@ -253,7 +287,7 @@ class StreamReader {
   }
 
   bool read8(uint64_t *ret) const {
-    if ((idx_ + 8) > length_) {
+    if (((idx_ + 8) > length_) && !fill(8)) {
       return false;
     }
 
@@ -271,7 +305,7 @@ class StreamReader {
   }
 
   bool read8(int64_t *ret) const {
-    if ((idx_ + 8) > length_) {
+    if (((idx_ + 8) > length_) && !fill(8)) {
       return false;
     }
 
@@ -347,11 +381,11 @@ class StreamReader {
   }
 #endif
 
-  uint64_t tell() const { return uint64_t(idx_); }
-  bool eof() const { return idx_ >= length_; }
+  uint64_t tell() const { return base_ + uint64_t(idx_); }
+  bool eof() const { return (base_ + idx_) >= total_length_; }
 
   bool is_nullchar() const {
-    if (idx_ < length_) {
+    if ((idx_ < length_) || fill(1)) {
       return binary_[idx_] == '\0';
     }
 
@@ -361,16 +395,94 @@ class StreamReader {
 
   const uint8_t *data() const { return binary_; }
 
+  ///
+  /// Address of the current read position. `avail` receives the number of
+  /// bytes accessible from it without refill(chunked mode).
+  /// Valid until the next read/seek.
+  ///
+  const uint8_t *current(uint64_t *avail) const {
+    (*avail) = length_ - idx_;
+    return binary_ + idx_;
+  }
+
   bool swap_endian() const { return swap_endian_; }
 
-  uint64_t size() const { return length_; }
+  uint64_t size() const { return total_length_; }
 
  private:
-  const uint8_t *binary_;
-  const uint64_t length_;
+  struct ChunkSource {
+    ReadFunction read_fn;
+    uint64_t chunk_size{0};
+    uint64_t history_size{0};
+    std::vector<uint8_t> window;
+  };
+
+  // Chunked mode: Make `n` bytes from the current position available.
+  bool fill(uint64_t n) const {
+    if (!chunk_) {
+      return false;
+    }
+    return fill_at(base_ + idx_, n);
+  }
+
+  // Chunked mode: Move the window so that it contains [pos, pos + n) and
+  // set the read position to `pos`.
+  bool fill_at(uint64_t pos, uint64_t n) const {
+    if (!chunk_ || (pos < base_) || (pos > total_length_)) {
+      return false;
+    }
+
+    // Retain up to `history_size` bytes before `pos` for seeking backward.
+    uint64_t end = base_ + length_;
+    uint64_t new_base = pos;
+    if (pos <= end) {
+      new_base = (std::max)(base_, (pos > chunk_->history_size)
+                                       ? (pos - chunk_->history_size)
+                                       : uint64_t(0));
+    } else {
+      end = pos;  // Seek forward. Discard the window.
+    }
+
+    uint64_t retained = end - new_base;
+    uint64_t target = (std::min)(
+        total_length_ - new_base,
+        (pos - new_base) + (std::max)(n, chunk_->chunk_size));
+
+    std::vector<uint8_t> &w = chunk_->window;
+    if (retained > 0) {
+      memmove(w.data(), w.data() + (new_base - base_), size_t(retained));
+    }
+    if (w.size() < target) {
+      w.resize(size_t(target));
+    }
+
+    base_ = new_base;
+    length_ = retained;
+    while (length_ < target) {
+      uint64_t nread = chunk_->read_fn(base_ + length_, target - length_,
+                                       w.data() + length_);
+      if (nread == 0) {
+        break;
+      }
+      length_ += (std::min)(nread, target - length_);
+    }
+
+    binary_ = w.data();
+    idx_ = pos - base_;
+
+    return (idx_ + n) <= length_;
+  }
+
+  mutable const uint8_t *binary_;
+  mutable uint64_t length_;  // # of bytes accessible from `binary_`.
+  uint64_t total_length_;
   bool swap_endian_;
   char pad_[7];
   mutable uint64_t idx_;
+
+  // Chunked mode. Absolute offset of `binary_`(always 0 for non-chunked mode)
+  mutable uint64_t base_{0};
+  std::unique_ptr<ChunkSource> chunk_;
 };
 
 } // namespace tinyusdz
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+//
+// Simple threading utilities used by the loaders and Tydra.
+//
+// Threads are only spawned when TinyUSDZ is compiled with
+// `TINYUSDZ_ENABLE_THREAD`. Otherwise(or for WASI build) every function in
+// this file runs the given task serially on the calling thread, so callers do
+// not need to add their own `#if` guards.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+#include <mutex>
+#endif
+
+#if defined(TINYUSDZ_ENABLE_THREAD) && !defined(__wasi__)
+#include <thread>
+#define TINYUSDZ_THREAD_UTIL_USE_THREAD
+#endif
+
+namespace tinyusdz {
+namespace thread_util {
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+///
+/// std::mutex wrapper which can be a member of copyable classes(e.g. Stage,
+/// Layer). Copy or move creates a new(unlocked) mutex, and the lock state is
+/// never transferred.
+///
+class CopyableMutex {
+ public:
+  CopyableMutex() = default;
+  CopyableMutex(const CopyableMutex &) {}
+  CopyableMutex &operator=(const CopyableMutex &) { return *this; }
+
+  void lock() { _m.lock(); }
+  bool try_lock() { return _m.try_lock(); }
+  void unlock() { _m.unlock(); }
+
+ private:
+  std::mutex _m;
+};
+#endif
+
+///
+/// Returns true when threads can actually be spawned in this build.
+///
+inline bool IsThreadingAvailable() {
+#if defined(TINYUSDZ_THREAD_UTIL_USE_THREAD)
+  return true;
+#else
+  return false;
+#endif
+}
+
+///
+/// Resolve the number of threads to use.
+/// `num_threads` <= 0 : Use the number of hardware threads.
+/// Result is clamped to [1, 1024], and always 1 when threading is not
+/// available.
+///
+inline int GetNumThreads(int num_threads) {
+#if defined(TINYUSDZ_THREAD_UTIL_USE_THREAD)
+  if (num_threads <= 0) {
+    num_threads = (std::max)(1, int(std::thread::hardware_concurrency()));
+  }
+  return (std::min)(1024, num_threads);
+#else
+  (void)num_threads;
+  return 1;
+#endif
+}
+
+///
+/// Run `fn(i)` for i in [begin, end) using up to `num_threads` threads.
+/// Work items are dispatched dynamically(atomic counter) so tasks with uneven
+/// cost are balanced.
+///
+/// `fn` must be thread-safe with respect to different `i`.
+///
+template <typename Func>
+void ParallelFor(size_t begin, size_t end, int num_threads, Func &&fn) {
+  if (end <= begin) {
+    return;
+  }
+
+  const size_t n = end - begin;
+
+#if defined(TINYUSDZ_THREAD_UTIL_USE_THREAD)
+  size_t nthreads = size_t(GetNumThreads(num_threads));
+  nthreads = (std::min)(nthreads, n);
+
+  if (nthreads > 1) {
+    std::atomic<size_t> counter(begin);
+    std::vector<std::thread> workers;
+    workers.reserve(nthreads);
+
+    for (size_t t = 0; t < nthreads; t++) {
+      workers.emplace_back([&]() {
+        size_t i = 0;
+        while ((i = counter++) < end) {
+          fn(i);
+        }
+      });
+    }
+
+    for (auto &w : workers) {
+      w.join();
+    }
+    return;
+  }
+#else
+  (void)num_threads;
+#endif
+
+  for (size_t i = 0; i < n; i++) {
+    fn(begin + i);
+  }
+}
+
+///
+/// The number of chunks `ParallelForChunked` will use for `n` items.
+/// Use this to allocate per-chunk buffers before calling it.
+///
+inline size_t GetNumChunks(size_t n, int num_threads, size_t min_chunk_size) {
+  if (n == 0) {
+    return 0;
+  }
+  min_chunk_size = (std::max)(size_t(1), min_chunk_size);
+
+  size_t nchunks = size_t(GetNumThreads(num_threads));
+  nchunks = (std::min)(nchunks, (n + min_chunk_size - 1) / min_chunk_size);
+  return (std::max)(size_t(1), nchunks);
+}
+
+///
+/// Run `fn(chunk_begin, chunk_end, chunk_id)` over [begin, end) split into
+/// contiguous chunks of about `min_chunk_size` items or more.
+/// The chunk id passed to `fn` is in [0, return value) and can be used to
+/// index per-chunk buffers(e.g. accumulators).
+///
+/// Returns the number of chunks.
+///
+template <typename Func>
+size_t ParallelForChunked(size_t begin, size_t end, int num_threads,
+                          size_t min_chunk_size, Func &&fn) {
+  if (end <= begin) {
+    return 0;
+  }
+
+  const size_t n = end - begin;
+  const size_t nchunks = GetNumChunks(n, num_threads, min_chunk_size);
+
+  // nchunks <= n, so every chunk has at least one item.
+  ParallelFor(0, nchunks, int(nchunks), [&](size_t c) {
+    size_t s = begin + (c * n) / nchunks;
+    size_t e = begin + ((c + 1) * n) / nchunks;
+    fn(s, e, c);
+  });
+
+  return nchunks;
+}
+
+///
+/// Run a task in a background thread.
+/// `Join()`(or destructor) waits for the completion of the task.
+/// Without thread support, the task runs synchronously in `Start()`.
+///
+class BackgroundTask {
+ public:
+  BackgroundTask() = default;
+  BackgroundTask(const BackgroundTask &) = delete;
+  BackgroundTask &operator=(const BackgroundTask &) = delete;
+
+  ~BackgroundTask() { Join(); }
+
+  template <typename Func>
+  void Start(Func &&fn) {
+    Join();
+#if defined(TINYUSDZ_THREAD_UTIL_USE_THREAD)
+    _thread = std::thread(std::forward<Func>(fn));
+#else
+    fn();
+#endif
+  }
+
+  void Join() {
+#if defined(TINYUSDZ_THREAD_UTIL_USE_THREAD)
+    if (_thread.joinable()) {
+      _thread.join();
+    }
+#endif
+  }
+
+ private:
+#if defined(TINYUSDZ_THREAD_UTIL_USE_THREAD)
+  std::thread _thread;
+#endif
+};
+
+}  // namespace thread_util
+}  // namespace tinyusdz
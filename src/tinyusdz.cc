@@ -9,6 +9,7 @@
 #include <chrono>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <sstream>
 
 #include "usdLux.hh"
@@ -78,10 +79,13 @@ namespace tinyusdz {
   }
 //#define PushWarn(s) if (warn) { (*warn) += s; }
 
-bool LoadUSDCFromMemory(const uint8_t *addr, const size_t length,
+namespace {
+
+bool LoadUSDCFromMemoryImpl(const uint8_t *addr, const size_t length,
                         const std::string &filename, Stage *stage,
                         std::string *warn, std::string *err,
-                        const USDLoadOptions &options) {
+                        const USDLoadOptions &options,
+                        std::shared_ptr<const void> data_holder) {
   if (stage == nullptr) {
     if (err) {
       (*err) = "null pointer for `stage` argument.\n";
@@ -120,12 +124,20 @@ bool LoadUSDCFromMemory(const uint8_t *addr, const size_t length,
     return false;
   }
 
+  // Deferred values are decoded from `addr` directly, so the input memory must
+  // be owned by `data_holder`(or `options.input_data_holder`).
+  if (!data_holder) {
+    data_holder = options.input_data_holder;
+  }
+
   StreamReader sr(addr, length, swap_endian);
 
   usdc::USDCReaderConfig config;
   config.numThreads = options.num_threads;
   config.strict_allowedToken_check = options.strict_allowedToken_check;
+  config.defer_value_loading = options.defer_value_loading;
   usdc::USDCReader reader(&sr, config);
+  reader.set_input_data_holder(data_holder);
 
   if (!reader.ReadUSDC()) {
     if (warn) {
@@ -171,6 +183,16 @@ bool LoadUSDCFromMemory(const uint8_t *addr, const size_t length,
   return true;
 }
 
+}  // namespace
+
+bool LoadUSDCFromMemory(const uint8_t *addr, const size_t length,
+                        const std::string &filename, Stage *stage,
+                        std::string *warn, std::string *err,
+                        const USDLoadOptions &options) {
+  return LoadUSDCFromMemoryImpl(addr, length, filename, stage, warn, err,
+                                options, /* data_holder */nullptr);
+}
+
 bool LoadUSDCFromFile(const std::string &_filename, Stage *stage,
                       std::string *warn, std::string *err,
                       const USDLoadOptions &options) {
@@ -195,6 +217,18 @@ bool LoadUSDCFromFile(const std::string &_filename, Stage *stage,
       }
     }
 
+    if (options.defer_value_loading) {
+      // Unmap the file when all deferred values are decoded(or released).
+      std::shared_ptr<const void> holder(
+          handle.addr, [handle](const void *) {
+            std::string _err;
+            io::UnmapFile(handle, &_err);
+          });
+
+      return LoadUSDCFromMemoryImpl(handle.addr, size_t(handle.size), filepath,
+                                    stage, warn, err, options, holder);
+    }
+
     bool ret = LoadUSDCFromMemory(handle.addr, size_t(handle.size), filepath, stage, warn,
                               err, options);
 
@@ -235,6 +269,12 @@ bool LoadUSDCFromFile(const std::string &_filename, Stage *stage,
       return false;
     }
 
+    if (options.defer_value_loading) {
+      auto buf = std::make_shared<std::vector<uint8_t>>(std::move(data));
+      return LoadUSDCFromMemoryImpl(buf->data(), buf->size(), filepath, stage,
+                                    warn, err, options, buf);
+    }
+
     return LoadUSDCFromMemory(data.data(), data.size(), filepath, stage, warn,
                               err, options);
   }
@@ -704,29 +744,18 @@ bool LoadUSDZFromFile(const std::wstring &_filename, Stage *stage,
 }
 #endif
 
-bool LoadUSDAFromMemory(const uint8_t *addr, const size_t length,
-                        const std::string &base_dir, Stage *stage,
-                        std::string *warn, std::string *err,
-                        const USDLoadOptions &options) {
-  if (addr == nullptr) {
-    if (err) {
-      (*err) = "null pointer for `addr` argument.\n";
-    }
-    return false;
-  }
-
-  if (stage == nullptr) {
-    if (err) {
-      (*err) = "null pointer for `stage` argument.\n";
-    }
-    return false;
-  }
+namespace {
 
-  tinyusdz::StreamReader sr(addr, length, /* swap endian */ false);
+// Parse USDA from StreamReader(in-memory or chunked).
+bool LoadUSDAFromStreamReader(StreamReader &sr, const std::string &base_dir,
+                              Stage *stage, std::string *warn,
+                              std::string *err,
+                              const USDLoadOptions &options) {
   tinyusdz::usda::USDAReader reader(&sr);
 
   tinyusdz::usda::USDAReaderConfig config;
   config.strict_allowedToken_check = options.strict_allowedToken_check;
+  config.num_threads = options.num_threads;
   config.allow_unknown_apiSchema = !options.strict_apiSchema_check;
   reader.set_reader_config(config);
 
@@ -765,12 +794,73 @@ bool LoadUSDAFromMemory(const uint8_t *addr, const size_t length,
   return true;
 }
 
+// Parse USDA file in chunks of `options.usda_stream_chunk_size` bytes.
+bool LoadUSDAFromFileChunked(const std::string &filepath,
+                             const std::string &base_dir, Stage *stage,
+                             std::string *warn, std::string *err,
+                             const USDLoadOptions &options) {
+  // Bytes retained before the refill position so that the parser can
+  // backtrack(look ahead then rewind).
+  constexpr uint64_t kMinHistorySize = 1024ull * 1024ull;
+
+  std::shared_ptr<io::FileReader> file(new io::FileReader());
+  if (!file->open(filepath, err)) {
+    return false;
+  }
+
+  uint64_t chunk_size = options.usda_stream_chunk_size;
+  StreamReader sr(
+      [file](uint64_t offset, uint64_t n, uint8_t *dst) {
+        return file->read(offset, n, dst);
+      },
+      file->size(), chunk_size, (std::max)(kMinHistorySize, chunk_size),
+      /* swap endian */ false);
+
+  return LoadUSDAFromStreamReader(sr, base_dir, stage, warn, err, options);
+}
+
+}  // namespace
+
+bool LoadUSDAFromMemory(const uint8_t *addr, const size_t length,
+                        const std::string &base_dir, Stage *stage,
+                        std::string *warn, std::string *err,
+                        const USDLoadOptions &options) {
+  if (addr == nullptr) {
+    if (err) {
+      (*err) = "null pointer for `addr` argument.\n";
+    }
+    return false;
+  }
+
+  if (stage == nullptr) {
+    if (err) {
+      (*err) = "null pointer for `stage` argument.\n";
+    }
+    return false;
+  }
+
+  tinyusdz::StreamReader sr(addr, length, /* swap endian */ false);
+  return LoadUSDAFromStreamReader(sr, base_dir, stage, warn, err, options);
+}
+
 bool LoadUSDAFromFile(const std::string &_filename, Stage *stage,
                       std::string *warn, std::string *err,
                       const USDLoadOptions &options) {
   std::string filepath = io::ExpandFilePath(_filename, /* userdata */ nullptr);
   std::string base_dir = io::GetBaseDir(_filename);
 
+  if (options.usda_stream_chunk_size > 0) {
+    if (stage == nullptr) {
+      if (err) {
+        (*err) = "null pointer for `stage` argument.\n";
+      }
+      return false;
+    }
+
+    return LoadUSDAFromFileChunked(filepath, base_dir, stage, warn, err,
+                                   options);
+  }
+
   if (io::IsMMapSupported()) {
     io::MMapFileHandle handle;
     
@@ -827,6 +917,16 @@ bool LoadUSDFromFile(const std::string &_filename, Stage *stage,
   std::string filepath = io::ExpandFilePath(_filename, /* userdata */ nullptr);
   std::string base_dir = io::GetBaseDir(_filename);
 
+  if (options.usda_stream_chunk_size > 0) {
+    // Detect USDA from the file header, so that whole file content is not
+    // read.
+    std::vector<uint8_t> header;
+    if (io::ReadFileHeader(&header, /* err */ nullptr, filepath) &&
+        IsUSDA(header.data(), header.size())) {
+      return LoadUSDAFromFile(_filename, stage, warn, err, options);
+    }
+  }
+
   if (io::IsMMapSupported()) {
     io::MMapFileHandle handle;
     
@@ -946,18 +1046,71 @@ bool ReadUSDZAssetInfoFromMemory(const uint8_t *addr, const size_t length, const
 bool ReadUSDZAssetInfoFromFile(const std::string &_filename, USDZAsset *asset,
   std::string *warn, std::string *err, size_t max_memory_limit_in_mb) {
 
+  if (!asset) {
+    return false;
+  }
+
   std::string filepath = io::ExpandFilePath(_filename, /* userdata */ nullptr);
-  std::string base_dir = io::GetBaseDir(_filename);
 
-  std::vector<uint8_t> data;
   size_t max_bytes = 1024ull * 1024ull * max_memory_limit_in_mb;
+
+  if (io::IsMMapSupported()) {
+    io::MMapFileHandle handle;
+
+    {
+      std::string _err;
+      if (!io::MMapFile(filepath, &handle, /* writable */false, &_err)) {
+        if (err) {
+          (*err) += _err + "\n";
+        }
+        return false;
+      }
+
+      if (_err.size()) {
+        if (warn) {
+          (*warn) += _err + "\n";
+        }
+      }
+    }
+
+    // Unmap the file when USDZAsset and all assets viewing it are released.
+    std::shared_ptr<const void> holder(handle.addr, [handle](const void *) {
+      std::string _err;
+      io::UnmapFile(handle, &_err);
+    });
+
+    if (size_t(handle.size) > max_bytes) {
+      if (err) {
+        (*err) += "USDZ file size exceeds the limit : \"" + filepath + "\"\n";
+      }
+      return false;
+    }
+
+    if (!ReadUSDZAssetInfoFromMemory(handle.addr, size_t(handle.size), /* asset_on_memory */true, asset, warn, err)) {
+      return false;
+    }
+
+    asset->data_holder = holder;
+    return true;
+  }
+
+  std::vector<uint8_t> data;
   if (!io::ReadWholeFile(&data, err, filepath, max_bytes,
                          /* userdata */ nullptr)) {
     return false;
   }
 
-  return ReadUSDZAssetInfoFromMemory(data.data(), data.size(), /* asset_on_memory */false, asset, warn, err);
+  // Parse in place, then move the content to USDZAsset(no copy).
+  if (!ReadUSDZAssetInfoFromMemory(data.data(), data.size(), /* asset_on_memory */true, asset, warn, err)) {
+    return false;
+  }
+
+  asset->data = std::move(data);
+  asset->addr = nullptr;
+  asset->size = 0;
+  asset->data_holder.reset();
 
+  return true;
 }
 
 //
@@ -1139,7 +1292,9 @@ bool LoadUSDCLayerFromMemory(const uint8_t *addr, const size_t length,
   config.numThreads = options.num_threads;
   config.strict_allowedToken_check = options.strict_allowedToken_check;
   config.allow_unknown_apiSchemas = !options.strict_apiSchema_check;
+  config.defer_value_loading = options.defer_value_loading;
   usdc::USDCReader reader(&sr, config);
+  reader.set_input_data_holder(options.input_data_holder);
 
   if (!reader.ReadUSDC()) {
     if (warn) {
@@ -1218,6 +1373,7 @@ bool LoadUSDALayerFromMemory(const uint8_t *addr, const size_t length,
 
   tinyusdz::usda::USDAReaderConfig config;
   config.strict_allowedToken_check = options.strict_allowedToken_check;
+  config.num_threads = options.num_threads;
   reader.set_reader_config(config);
 
   uint32_t load_states = static_cast<uint32_t>(tinyusdz::LoadState::Toplevel);
@@ -1371,7 +1527,9 @@ bool LoadLayerFromAsset(AssetResolutionResolver &resolver, const std::string &re
     PUSH_ERROR_AND_RETURN(fmt::format("Failed to open asset `{}`.", resolved_asset_name));
   }
 
-  return LoadLayerFromMemory(asset.data(), asset.size(), resolved_asset_name, layer, warn, err,
+  // Use const access so that the asset viewing the USDZ is not copied.
+  const Asset &casset = asset;
+  return LoadLayerFromMemory(casset.data(), casset.size(), resolved_asset_name, layer, warn, err,
                            options);
 }
 
@@ -1523,19 +1681,68 @@ int USDZReadAsset(const char *resolved_asset_name, uint64_t req_bytes, uint8_t *
     return -2;
   }
 
-  if (byte_range.first + sz > passet->data.size()) {
+  if (byte_range.first + sz > passet->usdz_size()) {
     if (err) {
       (*err) += "Invalid USDZAsset size: " + std::string(resolved_asset_name) + "\n";
     }
     return -2;
   }
 
-  memcpy(out_buf, passet->data.data() + byte_range.first, sz);
+  memcpy(out_buf, passet->usdz_data() + byte_range.first, sz);
   (*nbytes) = sz;
 
   return 0;
 }
 
+int USDZViewAsset(const char *resolved_asset_name, const uint8_t **addr, uint64_t *nbytes, std::shared_ptr<const void> *keep_alive, std::string *err, void *userdata) {
+  if (!userdata) {
+    if (err) {
+      (*err) += "`userdata` must be non-null.\n";
+    }
+    return -1;
+  }
+
+  if (!resolved_asset_name) {
+    if (err) {
+      (*err) += "`resolved_asset_name` must be non-null.\n";
+    }
+    return -2;
+  }
+
+  if (!addr || !nbytes || !keep_alive) {
+    if (err) {
+      (*err) += "`addr`, `nbytes` and `keep_alive` must be non-null.\n";
+    }
+    return -2;
+  }
+
+  const USDZAsset *passet = reinterpret_cast<const USDZAsset *>(userdata);
+
+  if (!passet->asset_map.count(resolved_asset_name)) {
+    if (err) {
+      (*err) += "resolved_asset_name `" + std::string(resolved_asset_name) + "` not found in USDZAsset.\n";
+    }
+    return -1;
+  }
+
+  std::pair<size_t, size_t> byte_range = passet->asset_map.at(resolved_asset_name);
+
+  if ((byte_range.first >= byte_range.second) || (byte_range.second > passet->usdz_size())) {
+    if (err) {
+      (*err) += "Invalid USDZAsset byte range.\n";
+    }
+    return -2;
+  }
+
+  // Assets in USDZ are stored without compression, so the asset can be
+  // accessed directly.
+  (*addr) = passet->usdz_data() + byte_range.first;
+  (*nbytes) = byte_range.second - byte_range.first;
+  (*keep_alive) = passet->data_holder;
+
+  return 0;
+}
+
 bool SetupUSDZAssetResolution(
   AssetResolutionResolver &resolver,
   const USDZAsset *pusdzAsset)
@@ -1559,6 +1766,7 @@ bool SetupUSDZAssetResolution(
   handler.size_fun = USDZSizeAsset;
   handler.read_fun = USDZReadAsset;
   handler.write_fun = nullptr;
+  handler.view_fun = USDZViewAsset;
   handler.userdata = reinterpret_cast<void *>(const_cast<USDZAsset *>(pusdzAsset));
 
   resolver.register_asset_resolution_handler("png", handler);
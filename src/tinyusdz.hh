@@ -10,6 +10,7 @@
 #include <cstring>
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -111,6 +112,33 @@ struct USDLoadOptions {
   /// apiSchema
   ///
   bool strict_apiSchema_check{false}; // Make parse error when unknown apiSchema
+
+  ///
+  /// USDC: Defer decoding of array and timeSamples attribute values(including
+  /// schema attributes of typed Prims, e.g. GeomMesh.points) until they are
+  /// accessed. Input data is kept alive while loaded attributes reference it.
+  /// For `LoadUSDCFromFile`, the memory-mapped file(or the file content) is
+  /// kept. For in-memory input, `input_data_holder` must be set, since the
+  /// input memory is not copied. Otherwise values are decoded at load time.
+  /// Default is false.
+  ///
+  bool defer_value_loading{false};
+
+  ///
+  /// Object which owns the input memory given to `Load***FromMemory`(e.g.
+  /// `std::shared_ptr<std::vector<uint8_t>>`). Used by `defer_value_loading`
+  /// to keep the input memory alive without copying it.
+  ///
+  std::shared_ptr<const void> input_data_holder;
+
+  ///
+  /// USDA: Parse the file in chunks of this byte size instead of reading(or
+  /// memory-mapping) whole file content, so the memory for the input is
+  /// bounded(about chunk size + 1MB history for backtracking of the parser).
+  /// Only effective for `LoadUSDAFromFile` and `LoadUSDFromFile`.
+  /// 0 = disabled(default).
+  ///
+  uint64_t usda_stream_chunk_size{0};
   
   ///
   /// User-defined fileformat hander.
@@ -226,17 +254,32 @@ struct USDZAsset
   std::vector<uint8_t> data; // USDZ itself
   const uint8_t *addr{nullptr};
   size_t size{0}; // in bytes.
+
+  // Optional. Owns the memory at `addr`(e.g. file mapping). Assets opened
+  // through `SetupUSDZAssetResolution` share it, so they stay valid after
+  // this USDZAsset is destroyed.
+  std::shared_ptr<const void> data_holder;
   
   bool is_mmaped() const {
-    return !data.empty();
+    return data.empty() && (addr != nullptr);
+  }
+
+  // Pointer to USDZ data.
+  const uint8_t *usdz_data() const {
+    return is_mmaped() ? addr : data.data();
+  }
+
+  size_t usdz_size() const {
+    return is_mmaped() ? size : data.size();
   }
 };
 
 ///
 /// Read USDZ(zip) asset info from a file.
 ///
-/// Whole file content(USDZ) is copied into USDZAsset::data.
-/// If you want to save memory to load USDZ with assets, first read USDZ conent into memory(or Use io-util.hh::MMapFile() to mmap file), then use `ReadUSDZAssetInfoFromMemory with `assert_on_memory` true.
+/// The file is memory-mapped when mmap is supported on the platform(the
+/// mapping is owned by `USDZAsset::data_holder`). Otherwise whole file
+/// content(USDZ) is read into USDZAsset::data.
 ///
 /// @param[in] filename USDZ filename(UTF-8)
 /// @param[out] asset USDZ asset info.
@@ -282,6 +325,7 @@ bool SetupUSDZAssetResolution(
 int USDZResolveAsset(const char *asset_name, const std::vector<std::string> &search_paths, std::string *resolved_asset_name, std::string *err, void *userdata);
 int USDZSizeAsset(const char *resolved_asset_name, uint64_t *nbytes, std::string *err, void *userdata);
 int USDZReadAsset(const char *resolved_asset_name, uint64_t req_bytes, uint8_t *out_buf, uint64_t *nbytes, std::string *err, void *userdata);
+int USDZViewAsset(const char *resolved_asset_name, const uint8_t **addr, uint64_t *nbytes, std::shared_ptr<const void> *keep_alive, std::string *err, void *userdata);
 
 ///
 /// Load USDC(binary) from a file.
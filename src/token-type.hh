@@ -7,10 +7,15 @@
 //
 // `token` is primarily used for a short-length string.
 //
-// Unlike pxrUSD, `Token` class does not acquire a lock by default. This means
-// there is a potential hash collision for the hash value of `Token` string, but
-// TinyUSDZ does not require token(string) hashes are unique inside of TinyUSDZ
-// library. If you need pxrUSD-like behavior of `Token` class(i.e, you want a
+// By default, `Token` string is interned to the global TokenStorage, so `Token`
+// is a pointer to the interned string with cached hash value, and comparison
+// of `Token`s is O(1)(pointer comparison).
+// Looking up an existing token does not acquire a lock. A lock(per shard of
+// the table) is acquired only when a new string is inserted, so `Token` can be
+// constructed among threads(e.g. parallel loaders).
+// Interned strings are never freed.
+//
+// If you need pxrUSD-like behavior of `Token` class(i.e, you want a
 // token hash with no collision), you can compile TinyUSDZ with
 // TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE.
 // (Also you need to include foonathan/string_id c++ files(Please see <tinyusdz>/CMakeLists.txt) to your project)
@@ -45,6 +50,7 @@
 #endif
 
 #else  // TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
+#include <cstring>
 #include <functional>
 #endif  // TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
 
@@ -143,49 +149,77 @@ struct TokenKeyEqual {
 
 #else  // TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
 
+// Interned token string.
+struct TokenEntry {
+  std::string str;
+  size_t hash{0};
+};
+
+///
+/// Global interning table for `Token`(implemented in value-types.cc).
+///
+/// - Sharded by the hash of the string.
+/// - Append-only. Entries are never removed, so the pointer to `TokenEntry` is
+///   valid until the program exits.
+/// - Lookup is lock-free. Inserting a new string locks its shard only.
+/// - Schema tokens(e.g. `faceVarying`, `catmullClark`) are inserted at the
+///   first use of the table.
+///
+class TokenStorage {
+ public:
+  // Returns nullptr for empty string.
+  static const TokenEntry *intern(const char *str, size_t len);
+
+  // The number of interned strings.
+  static size_t size();
+};
+
 class Token {
  public:
   Token() {}
 
-  explicit Token(const std::string &str) { str_ = str; }
-
-  explicit Token(const char *str) { str_ = str; }
+  explicit Token(const std::string &str)
+      : entry_(TokenStorage::intern(str.c_str(), str.size())) {}
 
-  const std::string &str() const { return str_; }
+  explicit Token(const char *str)
+      : entry_(str ? TokenStorage::intern(str, strlen(str)) : nullptr) {}
 
-  bool valid() const {
-    if (str().empty()) {
-      return false;
+  const std::string &str() const {
+    if (!entry_) {
+      return empty_str();
     }
-
-    return true;
+    return entry_->str;
   }
 
-  // No string hash for TinyUSDZ
-#if 0
-  uint64_t hash() const {
-    if (!str_) {
+  size_t hash() const {
+    if (!entry_) {
       return 0;
     }
-
-    // Assume non-zero hash value for non-empty string.
-    return str_.value().hash_code();
+    return entry_->hash;
   }
-#endif
+
+  // Interned string. nullptr for empty token.
+  const TokenEntry *entry() const { return entry_; }
+
+  bool valid() const { return entry_ != nullptr; }
 
  private:
-  std::string str_;
+  static const std::string &empty_str() {
+    static const std::string s_empty;
+    return s_empty;
+  }
+
+  const TokenEntry *entry_{nullptr};
 };
 
 struct TokenHasher {
-  inline size_t operator()(const Token &tok) const {
-    return std::hash<std::string>()(tok.str());
-  }
+  inline size_t operator()(const Token &tok) const { return tok.hash(); }
 };
 
 struct TokenKeyEqual {
   bool operator()(const Token &lhs, const Token &rhs) const {
-    return lhs.str() == rhs.str();
+    // Token is interned, so comparing the pointer is enough.
+    return lhs.entry() == rhs.entry();
   }
 };
 
@@ -0,0 +1,910 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+//
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "mesh-buffer.hh"
+#include "common-macros.inc"
+#include "tiny-format.hh"
+#include "value-types.hh"
+
+namespace tinyusdz {
+namespace tydra {
+
+#define PushWarn(msg) { \
+  if (warn) { \
+    (*warn) += msg + "\n"; \
+  } \
+}
+
+#define PushError(msg) { \
+  if (err) { \
+    (*err) += msg + "\n"; \
+  } \
+}
+
+namespace {
+
+// FIFO cache simulation. Returns the number of cache misses of a triangle.
+class FIFOCache {
+ public:
+  FIFOCache(size_t vertex_count, uint32_t cache_size)
+      : _timestamps(vertex_count, 0),
+        _cache_size(cache_size),
+        _time(cache_size + 1) {}
+
+  uint32_t update(const uint32_t *tri) {
+    uint32_t misses = 0;
+    for (size_t k = 0; k < 3; k++) {
+      if ((_time - _timestamps[tri[k]]) > _cache_size) {
+        _timestamps[tri[k]] = _time;
+        _time++;
+        misses++;
+      }
+    }
+    return misses;
+  }
+
+  void reset() { _time += _cache_size + 1; }
+
+ private:
+  std::vector<uint32_t> _timestamps;
+  uint32_t _cache_size;
+  uint32_t _time;
+};
+
+inline int16_t ToSnorm16(float x) {
+  x = (std::min)(1.0f, (std::max)(-1.0f, x));
+  return int16_t(std::lround(x * 32767.0f));
+}
+
+inline uint16_t ToUnorm16(float x) {
+  x = (std::min)(1.0f, (std::max)(0.0f, x));
+  return uint16_t(std::lround(x * 65535.0f));
+}
+
+enum class AttribEncoding {
+  Copy,
+  Snorm16Normal,   // float3 -> snorm16x4(w = 0)
+  Snorm16Tangent,  // float3 -> snorm16x4(w = handedness)
+  HalfTexcoord,    // float2 -> half2
+  Unorm16Texcoord  // float2 -> unorm16x2
+};
+
+struct SrcAttrib {
+  std::string name;
+  const uint8_t *data{nullptr};
+  size_t src_stride{0};  // Byte stride of source data
+  size_t src_size{0};    // Byte size of an item in source data
+
+  AttribEncoding encoding{AttribEncoding::Copy};
+  VertexAttributeFormat format{VertexAttributeFormat::Vec3};
+  uint32_t elementSize{1};
+  bool normalized{false};
+
+  size_t size() const {
+    if (encoding == AttribEncoding::Copy) {
+      return src_size;
+    }
+    return VertexAttributeFormatSize(format) * elementSize;
+  }
+};
+
+inline vec3 ReadVec3(const uint8_t *p) {
+  vec3 v;
+  memcpy(&v, p, sizeof(vec3));
+  return v;
+}
+
+//
+// Encode vertex item `v` of `attr` into `dst`.
+// `normals`/`binormals` are used to compute the handedness of tangent.
+//
+void EncodeAttrib(const SrcAttrib &attr, size_t v, const SrcAttrib *normals,
+                  const SrcAttrib *binormals, uint8_t *dst) {
+  const uint8_t *src = attr.data + v * attr.src_stride;
+
+  switch (attr.encoding) {
+    case AttribEncoding::Copy: {
+      memcpy(dst, src, attr.src_size);
+      break;
+    }
+    case AttribEncoding::Snorm16Normal: {
+      vec3 n = ReadVec3(src);
+      int16_t q[4] = {ToSnorm16(n[0]), ToSnorm16(n[1]), ToSnorm16(n[2]), 0};
+      memcpy(dst, q, sizeof(q));
+      break;
+    }
+    case AttribEncoding::Snorm16Tangent: {
+      vec3 t = ReadVec3(src);
+      float w = 1.0f;
+      if (normals && binormals) {
+        vec3 n = ReadVec3(normals->data + v * normals->src_stride);
+        vec3 b = ReadVec3(binormals->data + v * binormals->src_stride);
+        // dot(cross(n, t), b)
+        float d = (n[1] * t[2] - n[2] * t[1]) * b[0] +
+                  (n[2] * t[0] - n[0] * t[2]) * b[1] +
+                  (n[0] * t[1] - n[1] * t[0]) * b[2];
+        w = (d < 0.0f) ? -1.0f : 1.0f;
+      }
+      int16_t q[4] = {ToSnorm16(t[0]), ToSnorm16(t[1]), ToSnorm16(t[2]),
+                      ToSnorm16(w)};
+      memcpy(dst, q, sizeof(q));
+      break;
+    }
+    case AttribEncoding::HalfTexcoord: {
+      vec2 uv;
+      memcpy(&uv, src, sizeof(vec2));
+      value::half q[2] = {value::float_to_half_full(uv[0]),
+                          value::float_to_half_full(uv[1])};
+      memcpy(dst, q, sizeof(q));
+      break;
+    }
+    case AttribEncoding::Unorm16Texcoord: {
+      vec2 uv;
+      memcpy(&uv, src, sizeof(vec2));
+      uint16_t q[2] = {ToUnorm16(uv[0]), ToUnorm16(uv[1])};
+      memcpy(dst, q, sizeof(q));
+      break;
+    }
+  }
+}
+
+ComponentType ToComponentType(VertexAttributeFormat f) {
+  switch (f) {
+    case VertexAttributeFormat::Bool:
+    case VertexAttributeFormat::Byte:
+    case VertexAttributeFormat::Byte2:
+    case VertexAttributeFormat::Byte3:
+    case VertexAttributeFormat::Byte4:
+      return ComponentType::UInt8;
+    case VertexAttributeFormat::Char:
+    case VertexAttributeFormat::Char2:
+    case VertexAttributeFormat::Char3:
+    case VertexAttributeFormat::Char4:
+      return ComponentType::Int8;
+    case VertexAttributeFormat::Short:
+    case VertexAttributeFormat::Short2:
+    case VertexAttributeFormat::Short3:
+    case VertexAttributeFormat::Short4:
+      return ComponentType::Int16;
+    case VertexAttributeFormat::Ushort:
+    case VertexAttributeFormat::Ushort2:
+    case VertexAttributeFormat::Ushort3:
+    case VertexAttributeFormat::Ushort4:
+      return ComponentType::UInt16;
+    case VertexAttributeFormat::Half:
+    case VertexAttributeFormat::Half2:
+    case VertexAttributeFormat::Half3:
+    case VertexAttributeFormat::Half4:
+      return ComponentType::Half;
+    case VertexAttributeFormat::Int:
+    case VertexAttributeFormat::Ivec2:
+    case VertexAttributeFormat::Ivec3:
+    case VertexAttributeFormat::Ivec4:
+      return ComponentType::Int32;
+    case VertexAttributeFormat::Uint:
+    case VertexAttributeFormat::Uvec2:
+    case VertexAttributeFormat::Uvec3:
+    case VertexAttributeFormat::Uvec4:
+      return ComponentType::UInt32;
+    case VertexAttributeFormat::Double:
+    case VertexAttributeFormat::Dvec2:
+    case VertexAttributeFormat::Dvec3:
+    case VertexAttributeFormat::Dvec4:
+    case VertexAttributeFormat::Dmat2:
+    case VertexAttributeFormat::Dmat3:
+    case VertexAttributeFormat::Dmat4:
+      return ComponentType::Double;
+    case VertexAttributeFormat::Float:
+    case VertexAttributeFormat::Vec2:
+    case VertexAttributeFormat::Vec3:
+    case VertexAttributeFormat::Vec4:
+    case VertexAttributeFormat::Mat2:
+    case VertexAttributeFormat::Mat3:
+    case VertexAttributeFormat::Mat4:
+      return ComponentType::Float;
+  }
+
+  return ComponentType::UInt8;
+}
+
+inline size_t AlignUp4(size_t n) { return (n + 3) & ~size_t(3); }
+
+}  // namespace
+
+float ComputeACMR(const std::vector<uint32_t> &indices, size_t vertex_count,
+                  uint32_t cache_size) {
+  size_t ntris = indices.size() / 3;
+  if (ntris == 0) {
+    return 0.0f;
+  }
+
+  FIFOCache cache(vertex_count, cache_size);
+
+  size_t misses = 0;
+  for (size_t t = 0; t < ntris; t++) {
+    misses += cache.update(&indices[3 * t]);
+  }
+
+  return float(misses) / float(ntris);
+}
+
+void OptimizeVertexCache(const std::vector<uint32_t> &indices,
+                         size_t vertex_count, uint32_t cache_size,
+                         std::vector<uint32_t> *out_indices) {
+  const size_t ntris = indices.size() / 3;
+
+  out_indices->clear();
+  out_indices->reserve(ntris * 3);
+
+  // Vertex -> triangles adjacency(CSR).
+  std::vector<uint32_t> adj_offsets(vertex_count + 1, 0);
+  for (size_t i = 0; i < ntris * 3; i++) {
+    adj_offsets[indices[i] + 1]++;
+  }
+  for (size_t v = 0; v < vertex_count; v++) {
+    adj_offsets[v + 1] += adj_offsets[v];
+  }
+  std::vector<uint32_t> adj_tris(ntris * 3);
+  {
+    std::vector<uint32_t> cursor(adj_offsets.begin(), adj_offsets.end() - 1);
+    for (size_t i = 0; i < ntris * 3; i++) {
+      adj_tris[cursor[indices[i]]++] = uint32_t(i / 3);
+    }
+  }
+
+  // # of non-emitted triangles which use the vertex.
+  std::vector<uint32_t> live(vertex_count);
+  for (size_t v = 0; v < vertex_count; v++) {
+    live[v] = adj_offsets[v + 1] - adj_offsets[v];
+  }
+
+  std::vector<uint32_t> cache_time(vertex_count, 0);
+  std::vector<bool> emitted(ntris, false);
+  std::vector<uint32_t> dead_end;
+  std::vector<uint32_t> candidates;
+
+  const uint32_t k = cache_size;
+  uint32_t s = k + 1;  // timestamp
+  size_t cursor = 0;
+
+  auto SkipDeadEnd = [&]() -> int64_t {
+    while (!dead_end.empty()) {
+      uint32_t d = dead_end.back();
+      dead_end.pop_back();
+      if (live[d] > 0) {
+        return int64_t(d);
+      }
+    }
+    while (cursor < vertex_count) {
+      if (live[cursor] > 0) {
+        return int64_t(cursor);
+      }
+      cursor++;
+    }
+    return -1;
+  };
+
+  int64_t f = SkipDeadEnd();
+  while (f >= 0) {
+    candidates.clear();
+
+    for (uint32_t a = adj_offsets[size_t(f)]; a < adj_offsets[size_t(f) + 1];
+         a++) {
+      uint32_t t = adj_tris[a];
+      if (emitted[t]) {
+        continue;
+      }
+      for (size_t j = 0; j < 3; j++) {
+        uint32_t v = indices[3 * t + j];
+        out_indices->push_back(v);
+        dead_end.push_back(v);
+        candidates.push_back(v);
+        live[v]--;
+        if ((s - cache_time[v]) > k) {
+          cache_time[v] = s;
+          s++;
+        }
+      }
+      emitted[t] = true;
+    }
+
+    // Select the next fanning vertex: the one which is in the cache and
+    // whose remaining triangles fit into the cache.
+    int64_t best = -1;
+    int64_t best_priority = -1;
+    for (uint32_t v : candidates) {
+      if (live[v] == 0) {
+        continue;
+      }
+      int64_t priority = 0;
+      if ((int64_t(s) - int64_t(cache_time[v]) + 2 * int64_t(live[v])) <=
+          int64_t(k)) {
+        priority = int64_t(s) - int64_t(cache_time[v]);
+      }
+      if (priority > best_priority) {
+        best = int64_t(v);
+        best_priority = priority;
+      }
+    }
+
+    f = (best >= 0) ? best : SkipDeadEnd();
+  }
+}
+
+void OptimizeOverdraw(const std::vector<uint32_t> &indices,
+                      const std::vector<vec3> &positions, uint32_t cache_size,
+                      float threshold, std::vector<uint32_t> *out_indices) {
+  const size_t ntris = indices.size() / 3;
+  const size_t vertex_count = positions.size();
+
+  // 1. Hard boundaries: triangles whose vertices all miss the cache.
+  std::vector<size_t> hard_clusters;
+  {
+    FIFOCache cache(vertex_count, cache_size);
+    for (size_t t = 0; t < ntris; t++) {
+      uint32_t misses = cache.update(&indices[3 * t]);
+      if ((t == 0) || (misses == 3)) {
+        hard_clusters.push_back(t);
+      }
+    }
+  }
+
+  // 2. Split clusters further as long as ACMR of the split clusters stay
+  // within `threshold` x ACMR of the hard cluster.
+  std::vector<size_t> clusters;
+  {
+    FIFOCache cache(vertex_count, cache_size);
+    for (size_t c = 0; c < hard_clusters.size(); c++) {
+      size_t start = hard_clusters[c];
+      size_t end =
+          ((c + 1) < hard_clusters.size()) ? hard_clusters[c + 1] : ntris;
+
+      cache.reset();
+      uint32_t cluster_misses = 0;
+      for (size_t t = start; t < end; t++) {
+        cluster_misses += cache.update(&indices[3 * t]);
+      }
+      float cluster_threshold =
+          threshold * (float(cluster_misses) / float(end - start));
+
+      size_t first = clusters.size();
+      clusters.push_back(start);
+
+      cache.reset();
+      uint32_t running_misses = 0;
+      uint32_t running_faces = 0;
+      for (size_t t = start; t < end; t++) {
+        running_misses += cache.update(&indices[3 * t]);
+        running_faces++;
+
+        if ((float(running_misses) / float(running_faces)) <=
+            cluster_threshold) {
+          clusters.push_back(t + 1);
+          cache.reset();
+          running_misses = 0;
+          running_faces = 0;
+        }
+      }
+
+      if (clusters.back() == end) {
+        clusters.pop_back();
+      } else if ((clusters.size() - first) > 1) {
+        // The last cluster may have high ACMR. Merge it with the previous one.
+        if ((float(running_misses) / float(running_faces)) >
+            cluster_threshold) {
+          clusters.pop_back();
+        }
+      }
+    }
+  }
+
+  // 3. Sort clusters by dot(cluster centroid - mesh centroid, cluster normal)
+  // in descending order.
+  vec3 mesh_centroid{0.0f, 0.0f, 0.0f};
+  {
+    double sum[3] = {0.0, 0.0, 0.0};
+    for (size_t v = 0; v < vertex_count; v++) {
+      sum[0] += double(positions[v][0]);
+      sum[1] += double(positions[v][1]);
+      sum[2] += double(positions[v][2]);
+    }
+    if (vertex_count) {
+      mesh_centroid = {float(sum[0] / double(vertex_count)),
+                       float(sum[1] / double(vertex_count)),
+                       float(sum[2] / double(vertex_count))};
+    }
+  }
+
+  std::vector<float> sort_keys(clusters.size(), 0.0f);
+  for (size_t c = 0; c < clusters.size(); c++) {
+    size_t start = clusters[c];
+    size_t end = ((c + 1) < clusters.size()) ? clusters[c + 1] : ntris;
+
+    float centroid[3] = {0.0f, 0.0f, 0.0f};
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+    float area_sum = 0.0f;
+
+    for (size_t t = start; t < end; t++) {
+      const vec3 &p0 = positions[indices[3 * t + 0]];
+      const vec3 &p1 = positions[indices[3 * t + 1]];
+      const vec3 &p2 = positions[indices[3 * t + 2]];
+
+      float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      float n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                    e1[2] * e2[0] - e1[0] * e2[2],
+                    e1[0] * e2[1] - e1[1] * e2[0]};
+      float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+      for (size_t j = 0; j < 3; j++) {
+        centroid[j] += (p0[j] + p1[j] + p2[j]) * (area / 3.0f);
+        normal[j] += n[j];
+      }
+      area_sum += area;
+    }
+
+    float nlen = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                           normal[2] * normal[2]);
+    if ((area_sum > 0.0f) && (nlen > 0.0f)) {
+      float d = 0.0f;
+      for (size_t j = 0; j < 3; j++) {
+        d += (centroid[j] / area_sum - mesh_centroid[j]) * (normal[j] / nlen);
+      }
+      sort_keys[c] = d;
+    }
+  }
+
+  std::vector<size_t> order(clusters.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return sort_keys[a] > sort_keys[b];
+  });
+
+  out_indices->clear();
+  out_indices->reserve(ntris * 3);
+  for (size_t c : order) {
+    size_t start = clusters[c];
+    size_t end = ((c + 1) < clusters.size()) ? clusters[c + 1] : ntris;
+    out_indices->insert(out_indices->end(), indices.begin() + long(3 * start),
+                        indices.begin() + long(3 * end));
+  }
+}
+
+bool BuildMeshBuffers(const RenderMesh &mesh, const MeshBufferConfig &config,
+                      std::vector<BufferData> &buffers, MeshBuffers *out,
+                      std::string *warn, std::string *err) {
+  if (!out) {
+    PushError(std::string("`out` is nullptr."));
+    return false;
+  }
+
+  const size_t vertex_count = mesh.points.size();
+  const std::vector<uint32_t> &fvIndices = mesh.faceVertexIndices();
+  const std::vector<uint32_t> &fvCounts = mesh.faceVertexCounts();
+
+  for (size_t i = 0; i < fvCounts.size(); i++) {
+    if (fvCounts[i] != 3) {
+      PushError(fmt::format("Mesh must be triangulated: {}", mesh.abs_path));
+      return false;
+    }
+  }
+
+  if ((fvIndices.size() % 3) != 0) {
+    PushError(fmt::format("Invalid faceVertexIndices.size {}: {}",
+                          fvIndices.size(), mesh.abs_path));
+    return false;
+  }
+
+  for (size_t i = 0; i < fvIndices.size(); i++) {
+    if (fvIndices[i] >= vertex_count) {
+      PushError(fmt::format("faceVertexIndex {} out-of-range: {}",
+                            fvIndices[i], mesh.abs_path));
+      return false;
+    }
+  }
+
+  const size_t ntris = fvIndices.size() / 3;
+
+  //
+  // 1. Collect vertex attributes.
+  //
+  std::vector<SrcAttrib> attribs;
+
+  {
+    SrcAttrib a;
+    a.name = "points";
+    a.data = reinterpret_cast<const uint8_t *>(mesh.points.data());
+    a.src_stride = sizeof(vec3);
+    a.src_size = sizeof(vec3);
+    a.format = VertexAttributeFormat::Vec3;
+    attribs.push_back(a);
+  }
+
+  // Returns false when the attribute is not a 'vertex' variability.
+  auto AddAttrib = [&](const std::string &name,
+                       const VertexAttribute &vattr) -> bool {
+    if (vattr.empty() || vattr.is_constant()) {
+      return true;
+    }
+    if (!vattr.is_vertex() || (vattr.vertex_count() != vertex_count)) {
+      PushError(fmt::format(
+          "`{}` attribute must be 'vertex' variability with {} items. Mesh "
+          "must be single-indexable(see MeshConverterConfig::"
+          "build_vertex_indices): {}",
+          name, vertex_count, mesh.abs_path));
+      return false;
+    }
+
+    SrcAttrib a;
+    a.name = name;
+    a.data = vattr.data.data();
+    a.src_stride = vattr.stride_bytes();
+    a.src_size = vattr.format_size() * vattr.element_size();
+    a.format = vattr.format;
+    a.elementSize = uint32_t(vattr.element_size());
+    attribs.push_back(a);
+    return true;
+  };
+
+  if (!AddAttrib("normals", mesh.normals)) {
+    return false;
+  }
+
+  {
+    std::vector<uint32_t> slots;
+    for (const auto &it : mesh.texcoords) {
+      slots.push_back(it.first);
+    }
+    std::sort(slots.begin(), slots.end());
+
+    for (uint32_t slot : slots) {
+      if (!AddAttrib("texcoord" + std::to_string(slot),
+                     mesh.texcoords.at(slot))) {
+        return false;
+      }
+    }
+  }
+
+  if (!AddAttrib("tangents", mesh.tangents)) {
+    return false;
+  }
+  if (!AddAttrib("binormals", mesh.binormals)) {
+    return false;
+  }
+  if (!AddAttrib("colors", mesh.vertex_colors)) {
+    return false;
+  }
+  if (!AddAttrib("opacities", mesh.vertex_opacities)) {
+    return false;
+  }
+
+  if (mesh.joint_and_weights.jointIndices.size()) {
+    const JointAndWeight &jw = mesh.joint_and_weights;
+    if (jw.elementSize < 1) {
+      PushError(fmt::format("Invalid skin elementSize: {}", mesh.abs_path));
+      return false;
+    }
+    size_t n = size_t(jw.elementSize) * vertex_count;
+    if ((jw.jointIndices.size() != n) || (jw.jointWeights.size() != n)) {
+      PushError(fmt::format(
+          "jointIndices/jointWeights size mismatch: {}", mesh.abs_path));
+      return false;
+    }
+
+    SrcAttrib ja;
+    ja.name = "jointIndices";
+    ja.data = reinterpret_cast<const uint8_t *>(jw.jointIndices.data());
+    ja.src_size = sizeof(int) * size_t(jw.elementSize);
+    ja.src_stride = ja.src_size;
+    ja.format = VertexAttributeFormat::Int;
+    ja.elementSize = uint32_t(jw.elementSize);
+    attribs.push_back(ja);
+
+    SrcAttrib wa;
+    wa.name = "jointWeights";
+    wa.data = reinterpret_cast<const uint8_t *>(jw.jointWeights.data());
+    wa.src_size = sizeof(float) * size_t(jw.elementSize);
+    wa.src_stride = wa.src_size;
+    wa.format = VertexAttributeFormat::Float;
+    wa.elementSize = uint32_t(jw.elementSize);
+    attribs.push_back(wa);
+  }
+
+  //
+  // 2. Setup quantization
+  //
+  const SrcAttrib *normals_attr{nullptr};
+  const SrcAttrib *binormals_attr{nullptr};
+  bool drop_binormals = false;
+
+  for (auto &a : attribs) {
+    if (a.name == "normals") {
+      normals_attr = &a;
+    } else if (a.name == "binormals") {
+      binormals_attr = &a;
+    }
+  }
+
+  for (auto &a : attribs) {
+    const bool is_vec3 =
+        (a.format == VertexAttributeFormat::Vec3) && (a.elementSize == 1);
+    const bool is_vec2 =
+        (a.format == VertexAttributeFormat::Vec2) && (a.elementSize == 1);
+
+    if ((a.name == "normals") && config.quantize_normals && is_vec3) {
+      a.encoding = AttribEncoding::Snorm16Normal;
+      a.format = VertexAttributeFormat::Short4;
+      a.normalized = true;
+    } else if ((a.name == "tangents") && config.quantize_tangents && is_vec3) {
+      a.encoding = AttribEncoding::Snorm16Tangent;
+      a.format = VertexAttributeFormat::Short4;
+      a.normalized = true;
+      drop_binormals = true;
+    } else if ((a.name.compare(0, 8, "texcoord") == 0) && is_vec2 &&
+               (config.texcoord_quantization != TexcoordQuantization::None)) {
+      bool use_unorm =
+          (config.texcoord_quantization == TexcoordQuantization::Unorm16);
+      if (use_unorm) {
+        for (size_t v = 0; v < vertex_count; v++) {
+          vec2 uv;
+          memcpy(&uv, a.data + v * a.src_stride, sizeof(vec2));
+          if (!((uv[0] >= 0.0f) && (uv[0] <= 1.0f) && (uv[1] >= 0.0f) &&
+                (uv[1] <= 1.0f))) {
+            PushWarn(fmt::format(
+                "`{}` is not in [0, 1]. Use half instead of unorm16: {}",
+                a.name, mesh.abs_path));
+            use_unorm = false;
+            break;
+          }
+        }
+      }
+
+      if (use_unorm) {
+        a.encoding = AttribEncoding::Unorm16Texcoord;
+        a.format = VertexAttributeFormat::Ushort2;
+        a.normalized = true;
+      } else {
+        a.encoding = AttribEncoding::HalfTexcoord;
+        a.format = VertexAttributeFormat::Half2;
+      }
+    }
+  }
+
+  //
+  // 3. Build index buffer: one range per material.
+  //
+  std::vector<MeshBufferPrimitive> primitives;
+  std::vector<std::vector<uint32_t>> primitive_tris;
+  {
+    std::vector<bool> assigned(ntris, false);
+    for (const auto &it : mesh.material_subsetMap) {
+      const MaterialSubset &subset = it.second;
+      std::vector<uint32_t> tris;
+      for (int f : subset.indices()) {
+        if ((f < 0) || (size_t(f) >= ntris)) {
+          PushError(fmt::format("Invalid face index {} in GeomSubset {}: {}",
+                                f, it.first, mesh.abs_path));
+          return false;
+        }
+        if (!assigned[size_t(f)]) {
+          assigned[size_t(f)] = true;
+          tris.push_back(uint32_t(f));
+        }
+      }
+      if (tris.empty()) {
+        continue;
+      }
+      MeshBufferPrimitive prim;
+      prim.material_id = subset.material_id;
+      prim.backface_material_id = subset.backface_material_id;
+      primitives.push_back(prim);
+      primitive_tris.emplace_back(std::move(tris));
+    }
+
+    std::vector<uint32_t> tris;
+    for (size_t t = 0; t < ntris; t++) {
+      if (!assigned[t]) {
+        tris.push_back(uint32_t(t));
+      }
+    }
+    if (tris.size()) {
+      MeshBufferPrimitive prim;
+      prim.material_id = mesh.material_id;
+      prim.backface_material_id = mesh.backface_material_id;
+      primitives.push_back(prim);
+      primitive_tris.emplace_back(std::move(tris));
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  indices.reserve(ntris * 3);
+  for (size_t p = 0; p < primitives.size(); p++) {
+    std::vector<uint32_t> prim_indices;
+    prim_indices.reserve(primitive_tris[p].size() * 3);
+    for (uint32_t t : primitive_tris[p]) {
+      prim_indices.push_back(fvIndices[3 * t + 0]);
+      prim_indices.push_back(fvIndices[3 * t + 1]);
+      prim_indices.push_back(fvIndices[3 * t + 2]);
+    }
+
+    if (config.optimize_vertex_cache && (config.vertex_cache_size > 0)) {
+      std::vector<uint32_t> tmp;
+      OptimizeVertexCache(prim_indices, vertex_count, config.vertex_cache_size,
+                          &tmp);
+      prim_indices.swap(tmp);
+
+      if (config.optimize_overdraw) {
+        OptimizeOverdraw(prim_indices, mesh.points, config.vertex_cache_size,
+                         config.overdraw_threshold, &tmp);
+        prim_indices.swap(tmp);
+      }
+    }
+
+    primitives[p].index_offset = indices.size();
+    primitives[p].index_count = prim_indices.size();
+    indices.insert(indices.end(), prim_indices.begin(), prim_indices.end());
+  }
+
+  //
+  // 4. Vertex fetch optimization: renumber vertices in the order of the first
+  // use. Unreferenced vertices are placed at the end.
+  //
+  std::vector<uint32_t> remap(vertex_count);  // new -> old
+  std::iota(remap.begin(), remap.end(), 0u);
+  if (config.optimize_vertex_fetch) {
+    std::vector<uint32_t> old_to_new(vertex_count, ~0u);
+    uint32_t next = 0;
+    for (uint32_t &idx : indices) {
+      if (old_to_new[idx] == ~0u) {
+        old_to_new[idx] = next;
+        remap[next] = idx;
+        next++;
+      }
+      idx = old_to_new[idx];
+    }
+    for (size_t v = 0; v < vertex_count; v++) {
+      if (old_to_new[v] == ~0u) {
+        remap[next] = uint32_t(v);
+        next++;
+      }
+    }
+  }
+
+  //
+  // 5. Emit vertex buffers.
+  //
+  MeshBuffers result;
+  result.vertex_count = vertex_count;
+
+  std::vector<const SrcAttrib *> emit_attribs;
+  for (const auto &a : attribs) {
+    if (drop_binormals && (a.name == "binormals")) {
+      continue;
+    }
+    emit_attribs.push_back(&a);
+  }
+
+  if (config.layout == VertexBufferLayout::Interleaved) {
+    size_t stride = 0;
+    std::vector<size_t> offsets;
+    for (const SrcAttrib *a : emit_attribs) {
+      offsets.push_back(stride);
+      stride += AlignUp4(a->size());
+    }
+
+    BufferData buf;
+    buf.componentType = ComponentType::UInt8;
+    buf.data.assign(stride * vertex_count, 0);
+
+    for (size_t v = 0; v < vertex_count; v++) {
+      uint8_t *dst = buf.data.data() + v * stride;
+      for (size_t i = 0; i < emit_attribs.size(); i++) {
+        EncodeAttrib(*emit_attribs[i], remap[v], normals_attr, binormals_attr,
+                     dst + offsets[i]);
+      }
+    }
+
+    int64_t buffer_id = int64_t(buffers.size());
+    buffers.emplace_back(std::move(buf));
+
+    for (size_t i = 0; i < emit_attribs.size(); i++) {
+      MeshBufferAttribute attr;
+      attr.name = emit_attribs[i]->name;
+      attr.format = emit_attribs[i]->format;
+      attr.elementSize = emit_attribs[i]->elementSize;
+      attr.normalized = emit_attribs[i]->normalized;
+      attr.buffer_id = buffer_id;
+      attr.offset = offsets[i];
+      attr.stride = stride;
+      result.attributes.push_back(attr);
+    }
+  } else {
+    for (const SrcAttrib *a : emit_attribs) {
+      size_t stride = a->size();
+
+      BufferData buf;
+      buf.componentType = ToComponentType(a->format);
+      buf.data.resize(stride * vertex_count);
+
+      for (size_t v = 0; v < vertex_count; v++) {
+        EncodeAttrib(*a, remap[v], normals_attr, binormals_attr,
+                     buf.data.data() + v * stride);
+      }
+
+      MeshBufferAttribute attr;
+      attr.name = a->name;
+      attr.format = a->format;
+      attr.elementSize = a->elementSize;
+      attr.normalized = a->normalized;
+      attr.buffer_id = int64_t(buffers.size());
+      attr.offset = 0;
+      attr.stride = stride;
+      result.attributes.push_back(attr);
+
+      buffers.emplace_back(std::move(buf));
+    }
+  }
+
+  //
+  // 6. Emit index buffer.
+  //
+  {
+    BufferData buf;
+    if (config.allow_16bit_indices && (vertex_count < 0xffff)) {
+      buf.componentType = ComponentType::UInt16;
+      buf.data.resize(indices.size() * sizeof(uint16_t));
+      for (size_t i = 0; i < indices.size(); i++) {
+        uint16_t idx = uint16_t(indices[i]);
+        memcpy(buf.data.data() + i * sizeof(uint16_t), &idx, sizeof(uint16_t));
+      }
+    } else {
+      buf.componentType = ComponentType::UInt32;
+      buf.data.resize(indices.size() * sizeof(uint32_t));
+      memcpy(buf.data.data(), indices.data(),
+             indices.size() * sizeof(uint32_t));
+    }
+
+    result.index_type = buf.componentType;
+    result.index_count = indices.size();
+    result.index_buffer_id = int64_t(buffers.size());
+    buffers.emplace_back(std::move(buf));
+  }
+
+  result.primitives = std::move(primitives);
+  result.vertex_remap = std::move(remap);
+
+  (*out) = std::move(result);
+
+  return true;
+}
+
+bool BuildMeshBuffers(RenderScene &scene, const MeshBufferConfig &config,
+                      std::vector<MeshBuffers> *out, std::string *warn,
+                      std::string *err) {
+  if (!out) {
+    PushError(std::string("`out` is nullptr."));
+    return false;
+  }
+
+  out->clear();
+  out->resize(scene.meshes.size());
+
+  for (size_t i = 0; i < scene.meshes.size(); i++) {
+    if (!BuildMeshBuffers(scene.meshes[i], config, scene.buffers, &(*out)[i],
+                          warn, err)) {
+      PushError(fmt::format("Failed to build mesh buffers for mesh[{}]({})",
+                            i, scene.meshes[i].abs_path));
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace tydra
+}  // namespace tinyusdz
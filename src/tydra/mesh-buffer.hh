@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+//
+// RenderMesh -> GPU-ready vertex/index buffers.
+//
+// - Interleaved or SoA(one buffer per attribute) vertex layout
+// - Optional quantization(snorm16 normals/tangents, half/unorm16 texcoords)
+// - 16bit indices when possible
+// - Vertex cache(Tipsify), overdraw and vertex fetch optimization
+//
+#pragma once
+
+#include "render-data.hh"
+
+namespace tinyusdz {
+namespace tydra {
+
+enum class VertexBufferLayout {
+  Interleaved,  // All vertex attributes in one buffer.
+  SoA,          // One buffer per vertex attribute.
+};
+
+enum class TexcoordQuantization {
+  None,     // float2
+  Half,     // half2
+  Unorm16,  // ushort2(normalized). Texcoords must be in [0, 1], otherwise
+            // falls back to Half.
+};
+
+struct MeshBufferConfig {
+  VertexBufferLayout layout{VertexBufferLayout::Interleaved};
+
+  // Store normals as snorm16x4(w = 0)
+  bool quantize_normals{false};
+
+  // Store tangents as snorm16x4 with handedness in w(glTF convention).
+  // binormals are not emitted(binormal = cross(normal, tangent.xyz) *
+  // tangent.w)
+  bool quantize_tangents{false};
+
+  TexcoordQuantization texcoord_quantization{TexcoordQuantization::None};
+
+  // Use 16bit indices when the number of vertices is less than 65535.
+  // (0xffff is reserved for primitive restart in WebGL2/Vulkan)
+  bool allow_16bit_indices{true};
+
+  // Reorder triangles for post-transform vertex cache(Tipsify).
+  bool optimize_vertex_cache{true};
+  uint32_t vertex_cache_size{16};
+
+  // Reorder clusters of triangles to reduce overdraw.
+  // Requires `optimize_vertex_cache`.
+  bool optimize_overdraw{false};
+
+  // Allowed ACMR(average cache miss ratio) degradation when splitting
+  // triangles into clusters for overdraw optimization. 1.05 = 5% worse.
+  float overdraw_threshold{1.05f};
+
+  // Reorder vertices in the order of the first use in the index buffer.
+  bool optimize_vertex_fetch{true};
+};
+
+struct MeshBufferAttribute {
+  // Attribute name: "points", "normals", "tangents", "binormals",
+  // "texcoord<slotId>", "colors", "opacities", "jointIndices", "jointWeights"
+  std::string name;
+  VertexAttributeFormat format{VertexAttributeFormat::Vec3};
+  uint32_t elementSize{1};
+  bool normalized{false};  // Integer format is normalized to [0, 1](unsigned)
+                           // or [-1, 1](signed)
+  int64_t buffer_id{-1};   // Index to RenderScene::buffers
+  size_t offset{0};        // Byte offset in the buffer
+  size_t stride{0};        // Byte stride
+};
+
+// Range of indices drawn with a material(glTF primitive).
+struct MeshBufferPrimitive {
+  int material_id{-1};
+  int backface_material_id{-1};
+  size_t index_offset{0};  // In the number of indices.
+  size_t index_count{0};
+};
+
+struct MeshBuffers {
+  size_t vertex_count{0};
+  std::vector<MeshBufferAttribute> attributes;
+
+  int64_t index_buffer_id{-1};  // Index to RenderScene::buffers
+  ComponentType index_type{ComponentType::UInt32};  // UInt16 or UInt32
+  size_t index_count{0};
+
+  // One primitive per GeomSubset(materialBind), plus one for the faces not
+  // in any GeomSubset.
+  std::vector<MeshBufferPrimitive> primitives;
+
+  // Output vertex index -> vertex(point) index in RenderMesh.
+  // Use it to remap other per-vertex data(e.g. BlendShape pointIndices).
+  std::vector<uint32_t> vertex_remap;
+};
+
+///
+/// Build GPU-ready vertex/index buffers of RenderMesh.
+///
+/// Mesh must be triangulated and single-indexable(i.e. converted with
+/// `MeshConverterConfig::triangulate` and `build_vertex_indices`).
+/// Constant attributes are not emitted.
+///
+/// @param[in] mesh RenderMesh
+/// @param[in] config Buffer layout and optimization settings
+/// @param[inout] buffers Vertex and index buffers are appended.
+/// @param[out] out Buffer layout of the mesh.
+/// @param[out] warn Warning message
+/// @param[out] err Error message
+///
+/// @return true upon success.
+///
+bool BuildMeshBuffers(const RenderMesh &mesh, const MeshBufferConfig &config,
+                      std::vector<BufferData> &buffers, MeshBuffers *out,
+                      std::string *warn, std::string *err);
+
+///
+/// Build GPU-ready vertex/index buffers of all meshes in RenderScene.
+/// Buffers are appended to `RenderScene::buffers`.
+///
+/// @param[out] out Buffer layout for each RenderScene::meshes
+///
+bool BuildMeshBuffers(RenderScene &scene, const MeshBufferConfig &config,
+                      std::vector<MeshBuffers> *out, std::string *warn,
+                      std::string *err);
+
+///
+/// Reorder triangles for post-transform vertex cache(Tipsify).
+/// Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex Locality
+/// and Reduced Overdraw", 2007.
+///
+void OptimizeVertexCache(const std::vector<uint32_t> &indices,
+                         size_t vertex_count, uint32_t cache_size,
+                         std::vector<uint32_t> *out_indices);
+
+///
+/// Reorder clusters of vertex cache optimized triangles, so that outer facing
+/// clusters are drawn first.
+///
+void OptimizeOverdraw(const std::vector<uint32_t> &indices,
+                      const std::vector<vec3> &positions, uint32_t cache_size,
+                      float threshold, std::vector<uint32_t> *out_indices);
+
+///
+/// Compute ACMR(average cache miss ratio per triangle) with FIFO cache.
+///
+float ComputeACMR(const std::vector<uint32_t> &indices, size_t vertex_count,
+                  uint32_t cache_size);
+
+}  // namespace tydra
+}  // namespace tinyusdz
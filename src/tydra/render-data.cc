@@ -36,6 +36,7 @@
 #include "pprinter.hh"
 #include "prim-types.hh"
 #include "str-util.hh"
+#include "thread-util.hh"
 #include "tiny-format.hh"
 #include "tinyusdz.hh"
 #include "usdGeom.hh"
@@ -1709,7 +1710,21 @@ bool TriangulatePolygon(
 }
 #endif
 
-#if 0  // not used atm.
+// vlength()/vnormalize() clamp short vectors(length < ~3e-4) to zero, which
+// loses normals/tangents of small triangles. Use unclamped versions for
+// normal/tangent frame computation.
+inline static float ExactLength(const vec3 &v) {
+  return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+inline static vec3 SafeNormalize(const vec3 &v) {
+  float len = ExactLength(v);
+  if ((len > 0.0f) && std::isfinite(len)) {
+    return vec3{v[0] / len, v[1] / len, v[2] / len};
+  }
+  return vec3{0.0f, 0.0f, 0.0f};
+}
+
 // Building an Orthonormal Basis, Revisited
 // http://jcgt.org/published/0006/01/01/
 static void GenerateBasis(const vec3 &n, vec3 *tangent,
@@ -1727,7 +1742,6 @@ static void GenerateBasis(const vec3 &n, vec3 *tangent,
     (*binormal) = vec3{b, 1.0f - n[1] * n[1] * a, -n[1]};
   }
 }
-#endif
 
 struct ComputeTangentPackedVertexData {
   // value::float3 position;
@@ -1745,21 +1759,9 @@ struct ComputeTangentPackedVertexData {
 
 struct ComputeTangentPackedVertexDataHasher {
   inline size_t operator()(const ComputeTangentPackedVertexData &v) const {
-    // Simple hasher using FNV1 32bit
-    // TODO: Use 64bit FNV1?
     // TODO: Use spatial hash or LSH(LocallySensitiveHash) for position value.
-    static constexpr uint32_t kFNV_Prime = 0x01000193;
-    static constexpr uint32_t kFNV_Offset_Basis = 0x811c9dc5;
-
-    const uint8_t *ptr = reinterpret_cast<const uint8_t *>(&v);
-    size_t n = sizeof(DefaultPackedVertexData);
-
-    uint32_t hash = kFNV_Offset_Basis;
-    for (size_t i = 0; i < n; i++) {
-      hash = (kFNV_Prime * hash) ^ (ptr[i]);
-    }
-
-    return size_t(hash);
+    return size_t(
+        HashPackedVertexBytes(&v, sizeof(ComputeTangentPackedVertexData)));
   }
 };
 
@@ -1818,44 +1820,49 @@ struct ComputeTangentVertexOutput {
 };
 
 ///
-/// Compute facevarying tangent and facevarying binormal.
+/// Compute tangent and binormal for each face-vertex(corner), then average
+/// them over corners which share the same point, normal and texcoord.
+///
+/// TangentFrameMode::Default
+///
+///   Reference:
+///   http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-13-normal-mapping
 ///
-/// Reference:
-/// http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-13-normal-mapping
+///   Tangent/binormal of the corner is computed from UV derivatives of its
+///   two adjacent edges, and averaged without weighting. The tangent is
+///   orthogonalized to the normal and flipped when the frame is
+///   left-handed.
 ///
-/// Implemented code uses two adjacent edge composed from three vertices v_{i},
-/// v_{i+1}, v_{i+2} for i < (N - 1) , where N is the number of vertices per
-/// facet.
+/// TangentFrameMode::MikkTSpaceLike
 ///
-/// This may produce unwanted tangent/binormal frame for ill-defined
-/// polygon(quad, pentagon, ...). Also, we assume input mesh has well-formed and
-/// has no or few vertices with similar property(position, uvs and normals)
+///   Follows the convention of MikkTSpace(http://www.mikktspace.com/), but
+///   is not a port of the reference implementation:
+///   the tangent of the corner is projected onto the tangent plane of the
+///   normal and weighted by the corner angle. Corners with mirrored UV
+///   (opposite orientation) are not averaged together.
+///   binormal = sign * cross(normal, tangent).
+///
+/// Each face vertex uses the triangle composed of its adjacent edges, so
+/// quad/polygon faces are assumed to be planar and convex.
 ///
 /// TODO:
-/// - [ ] Implement better getSimilarVertexIndex in the above opengl-tutorial to
-/// better average tangent/binormal.
-///   - Use kNN search(e.g. nanoflann https://github.com/jlblancoc/nanoflann ),
-///   or point-query by building BVH over the mesh points.
-///     - BVH builder candidate:
-///       - NanoRT https://github.com/lighttransport/nanort
-///       - bvh https://github.com/madmann91/bvh
-///   - Or we can quantize vertex attributes and compute locally sensitive
-///   hashsing? https://dl.acm.org/doi/10.1145/3188745.3188846
 /// - [ ] Support robusut computing tangent/binormal on arbitrary mesh.
 ///  - e.g. vector field calculation, use instance-mesh algorithm, etc...
 //   - Use half-edges to find adjacent face/vertex.
 ///
 ///
 /// @param[in] vertices Vertex points(`vertex` variability).
-/// @param[in] faceVertexCounts faceVertexCounts of the mesh.
+/// @param[in] faceVertexCounts faceVertexCounts of the mesh. Empty = all
+/// triangles.
 /// @param[in] faceVertexIndices faceVertexIndices of the mesh.
-/// @param[in] texcoords Primary texcoords.
-/// @param[in] normals normals.
-/// @param[in] is_facevarying_input false = texcoords and normals are 'vertex'
-/// variability. true = 'facevarying' variability.
+/// @param[in] texcoords Primary texcoords('facevarying' variability).
+/// @param[in] normals normals('facevarying' variability).
+/// @param[in] mode Tangent frame convention.
+/// @param[in] num_threads The number of threads.
 /// @param[out] tangents Computed tangents;
 /// @param[out] binormals Computed binormals;
-/// @param[out] out_vertex_indices Vertex indices.
+/// @param[out] out_vertex_indices Vertex indices(index to tangents/binormals
+/// for each face-vertex)
 /// @param[out] err Error message.
 ///
 static bool ComputeTangentsAndBinormals(
@@ -1863,7 +1870,7 @@ static bool ComputeTangentsAndBinormals(
     const std::vector<uint32_t> &faceVertexCounts,
     const std::vector<uint32_t> &faceVertexIndices,
     const std::vector<vec2> &texcoords, const std::vector<vec3> &normals,
-    bool is_facevarying_input,  // false: 'vertex' varying
+    const TangentFrameMode mode, const int num_threads,
     std::vector<vec3> *tangents, std::vector<vec3> *binormals,
     std::vector<uint32_t> *out_vertex_indices, std::string *err) {
   if (!tangents) {
@@ -1887,203 +1894,146 @@ static bool ComputeTangentsAndBinormals(
     PUSH_ERROR_AND_RETURN("faceVertexIndices.size < 3");
   }
 
-  if (texcoords.empty()) {
-    PUSH_ERROR_AND_RETURN("texcoords is empty");
-  }
+  const size_t num_fvs = faceVertexIndices.size();
 
-  if (normals.empty()) {
-    PUSH_ERROR_AND_RETURN("normals is empty");
+  if (texcoords.size() != num_fvs) {
+    PUSH_ERROR_AND_RETURN("Invalid texcoords.size.");
+  }
+  if (normals.size() != num_fvs) {
+    PUSH_ERROR_AND_RETURN("Invalid normals.size.");
   }
 
-  if (is_facevarying_input) {
-    if (vertices.size() != faceVertexIndices.size()) {
-      PUSH_ERROR_AND_RETURN("Invalid vertices.size.");
-    }
-    if (texcoords.size() != faceVertexIndices.size()) {
-      PUSH_ERROR_AND_RETURN("Invalid texcoords.size.");
-    }
-    if (normals.size() != faceVertexIndices.size()) {
-      PUSH_ERROR_AND_RETURN("Invalid normals.size.");
-    }
-  } else {
-    uint32_t max_vert_index =
-        *std::max_element(faceVertexIndices.begin(), faceVertexIndices.end());
-    if (max_vert_index >= vertices.size()) {
-      PUSH_ERROR_AND_RETURN("Invalid vertices.size.");
-    }
-    if (max_vert_index >= texcoords.size()) {
-      PUSH_ERROR_AND_RETURN("Invalid texcoords.size.");
-    }
-    if (max_vert_index >= normals.size()) {
-      PUSH_ERROR_AND_RETURN("Invalid normals.size.");
-    }
+  uint32_t max_vert_index =
+      *std::max_element(faceVertexIndices.begin(), faceVertexIndices.end());
+  if (max_vert_index >= vertices.size()) {
+    PUSH_ERROR_AND_RETURN(
+        "Invalid value in faceVertexIndices. some exceeds vertices.size()");
   }
 
-  bool hasFaceVertexCounts = true;
-  if (faceVertexCounts.size() == 0) {
+  //
+  // 0. Face offsets.
+  //
+  std::vector<size_t> faceOffsets;
+  if (faceVertexCounts.empty()) {
     // Assume all triangle faces.
-    if ((faceVertexIndices.size() % 3) != 0) {
+    if ((num_fvs % 3) != 0) {
       PUSH_ERROR_AND_RETURN(
           "Invalid faceVertexIndices. It must be all triangles: "
           "faceVertexIndices.size % 3 == 0");
     }
-    hasFaceVertexCounts = false;
-  }
-
-  // tn, bn = facevarying
-  std::vector<value::normal3f> tn(faceVertexIndices.size());
-  memset(&tn.at(0), 0, sizeof(value::normal3f) * tn.size());
-  std::vector<value::normal3f> bn(faceVertexIndices.size());
-  memset(&bn.at(0), 0, sizeof(value::normal3f) * bn.size());
-
-  //
-  // 1. Compute facevarying tangent/binormal for each faceVertex.
-  //
-  size_t faceVertexIndexOffset{0};
-  for (size_t i = 0; i < faceVertexCounts.size(); i++) {
-    size_t nv = hasFaceVertexCounts ? faceVertexCounts[i] : 3;
-
-    if ((faceVertexIndexOffset + nv) >= faceVertexIndices.size()) {
+    for (size_t i = 0; i <= num_fvs; i += 3) {
+      faceOffsets.push_back(i);
+    }
+  } else {
+    faceOffsets.resize(faceVertexCounts.size() + 1);
+    faceOffsets[0] = 0;
+    for (size_t i = 0; i < faceVertexCounts.size(); i++) {
+      if (faceVertexCounts[i] < 3) {
+        PUSH_ERROR_AND_RETURN("Degenerated facet found.");
+      }
+      faceOffsets[i + 1] = faceOffsets[i] + faceVertexCounts[i];
+    }
+    if (faceOffsets.back() != num_fvs) {
       // Invalid faceVertexIndices
       PUSH_ERROR_AND_RETURN("Invalid value in faceVertexOffset.");
     }
+  }
+  const size_t num_faces = faceOffsets.size() - 1;
 
-    if (nv < 3) {
-      PUSH_ERROR_AND_RETURN("Degenerated facet found.");
-    }
-
-    // Process each two-edges per facet.
-    //
-    // Example:
-    //
-    // fv3
-    //  o----------------o fv2
-    //   \              /
-    //    \            /
-    //     o----------o
-    //    fv0         fv1
-
-    // facet0:  fv0, fv1, fv2
-    // facet1:  fv1, fv2, fv3
-
-    for (size_t f = 0; f < nv - 2; f++) {
-      size_t fid0 = faceVertexIndexOffset + f;
-      size_t fid1 = faceVertexIndexOffset + f + 1;
-      size_t fid2 = faceVertexIndexOffset + f + 2;
-
-      uint32_t vf0 =
-          is_facevarying_input ? uint32_t(fid0) : faceVertexIndices[fid0];
-      uint32_t vf1 =
-          is_facevarying_input ? uint32_t(fid1) : faceVertexIndices[fid1];
-      uint32_t vf2 =
-          is_facevarying_input ? uint32_t(fid2) : faceVertexIndices[fid2];
-
-      if ((vf0 >= vertices.size()) || (vf1 >= vertices.size()) ||
-          (vf2 >= vertices.size())) {
-        // index out-of-range
-        PUSH_ERROR_AND_RETURN(
-            "Invalid value in faceVertexIndices. some exceeds vertices.size()");
-      }
-
-      vec3 v1 = vertices[vf0];
-      vec3 v2 = vertices[vf1];
-      vec3 v3 = vertices[vf2];
-
-      float v1x = v1[0];
-      float v1y = v1[1];
-      float v1z = v1[2];
-
-      float v2x = v2[0];
-      float v2y = v2[1];
-      float v2z = v2[2];
-
-      float v3x = v3[0];
-      float v3y = v3[1];
-      float v3z = v3[2];
-
-      float w1x = 0.0f;
-      float w1y = 0.0f;
-      float w2x = 0.0f;
-      float w2y = 0.0f;
-      float w3x = 0.0f;
-      float w3y = 0.0f;
-
-      if ((vf0 >= texcoords.size()) || (vf1 >= texcoords.size()) ||
-          (vf2 >= texcoords.size())) {
-        // index out-of-range
-        PUSH_ERROR_AND_RETURN("Invalid index. some exceeds texcoords.size()");
-      }
-
-      {
-        vec2 uv1 = texcoords[vf0];
-        vec2 uv2 = texcoords[vf1];
-        vec2 uv3 = texcoords[vf2];
-
-        w1x = uv1[0];
-        w1y = uv1[1];
-        w2x = uv2[0];
-        w2y = uv2[1];
-        w3x = uv3[0];
-        w3y = uv3[1];
-      }
-
-      float x1 = v2x - v1x;
-      float x2 = v3x - v1x;
-      float y1 = v2y - v1y;
-      float y2 = v3y - v1y;
-      float z1 = v2z - v1z;
-      float z2 = v3z - v1z;
-
-      float s1 = w2x - w1x;
-      float s2 = w3x - w1x;
-      float t1 = w2y - w1y;
-      float t2 = w3y - w1y;
-
-      float r = 1.0;
-
-      if (std::fabs(double(s1 * t2 - s2 * t1)) > 1.0e-20) {
-        r /= (s1 * t2 - s2 * t1);
-      }
-
-      vec3 tdir{(t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r,
-                (t2 * z1 - t1 * z2) * r};
-      vec3 bdir{(s1 * x2 - s2 * x1) * r, (s1 * y2 - s2 * y1) * r,
-                (s1 * z2 - s2 * z1) * r};
-
-      //
-      // NOTE: for quad or polygon mesh, this overwrites previous 2 facevarying
-      // points for each face.
-      //       And this would not be a good way to compute tangents for
-      //       quad/polygon.
-      //
-
-      tn[fid0][0] = tdir[0];
-      tn[fid0][1] = tdir[1];
-      tn[fid0][2] = tdir[2];
+  const bool mikktspace = (mode == TangentFrameMode::MikkTSpaceLike);
 
-      tn[fid1][0] = tdir[0];
-      tn[fid1][1] = tdir[1];
-      tn[fid1][2] = tdir[2];
+  //
+  // 1. Compute tangent/binormal for each faceVertex.
+  //
+  // Example:
+  //
+  // fv3
+  //  o----------------o fv2
+  //   \              /
+  //    \            /
+  //     o----------o
+  //    fv0         fv1
+  //
+  // fv1 uses the triangle (fv1, fv2, fv0)
+  //
+  std::vector<vec3> tn(num_fvs);
+  std::vector<vec3> bn(num_fvs);
+  std::vector<uint8_t> orients(num_fvs, 1);  // 1 = positive UV orientation
+
+  thread_util::ParallelForChunked(
+      0, num_faces, num_threads, 4096, [&](size_t fs, size_t fe, size_t) {
+        for (size_t face = fs; face < fe; face++) {
+          const size_t offset = faceOffsets[face];
+          const size_t nv = faceOffsets[face + 1] - offset;
+
+          for (size_t k = 0; k < nv; k++) {
+            const size_t fid0 = offset + k;
+            const size_t fid1 = offset + ((k + 1) % nv);
+            const size_t fid2 = offset + ((k + nv - 1) % nv);
+
+            const vec3 &v0 = vertices[faceVertexIndices[fid0]];
+            const vec3 &v1 = vertices[faceVertexIndices[fid1]];
+            const vec3 &v2 = vertices[faceVertexIndices[fid2]];
+
+            const vec2 &uv0 = texcoords[fid0];
+            const vec2 &uv1 = texcoords[fid1];
+            const vec2 &uv2 = texcoords[fid2];
+
+            vec3 e1 = v1 - v0;
+            vec3 e2 = v2 - v0;
+
+            float s1 = uv1[0] - uv0[0];
+            float s2 = uv2[0] - uv0[0];
+            float t1 = uv1[1] - uv0[1];
+            float t2 = uv2[1] - uv0[1];
+
+            // signed area of UV triangle x 2
+            float det = s1 * t2 - s2 * t1;
+
+            if (!mikktspace) {
+              float r = 1.0f;
+              if (std::fabs(double(det)) > 1.0e-20) {
+                r /= det;
+              }
 
-      tn[fid2][0] = tdir[0];
-      tn[fid2][1] = tdir[1];
-      tn[fid2][2] = tdir[2];
+              tn[fid0] = (e1 * t2 - e2 * t1) * r;
+              bn[fid0] = (e2 * s1 - e1 * s2) * r;
+              continue;
+            }
 
-      bn[fid0][0] = bdir[0];
-      bn[fid0][1] = bdir[1];
-      bn[fid0][2] = bdir[2];
+            orients[fid0] = (det < 0.0f) ? 0 : 1;
 
-      bn[fid1][0] = bdir[0];
-      bn[fid1][1] = bdir[1];
-      bn[fid1][2] = bdir[2];
+            const vec3 &n = normals[fid0];
 
-      bn[fid2][0] = bdir[0];
-      bn[fid2][1] = bdir[1];
-      bn[fid2][2] = bdir[2];
-    }
+            // Tangent projected onto the tangent plane. Its magnitude is not
+            // used, so scaling by 1/det is not required.
+            vec3 vOs = (e1 * t2 - e2 * t1);
+            if (det < 0.0f) {
+              vOs = vOs * -1.0f;
+            }
+            vOs = vOs - n * vdot(n, vOs);
+
+            // Corner angle on the tangent plane.
+            vec3 pe1 = e1 - n * vdot(n, e1);
+            vec3 pe2 = e2 - n * vdot(n, e2);
+
+            float weight = 0.0f;
+            float len_os = ExactLength(vOs);
+            float len1 = ExactLength(pe1);
+            float len2 = ExactLength(pe2);
+            if ((std::fabs(det) > std::numeric_limits<float>::min()) &&
+                (len_os > 0.0f) && (len1 > 0.0f) && (len2 > 0.0f)) {
+              float c = vdot(pe1, pe2) / (len1 * len2);
+              c = (std::min)(1.0f, (std::max)(-1.0f, c));
+              weight = std::acos(c);
+              vOs = vOs * (1.0f / len_os);
+            }
 
-    faceVertexIndexOffset += nv;
-  }
+            tn[fid0] = vOs * weight;
+            bn[fid0] = {0.0f, 0.0f, 0.0f};
+          }
+        }
+      });
 
   //
   // 2. Build indices(use same index for shared-vertex)
@@ -2093,21 +2043,9 @@ static bool ComputeTangentsAndBinormals(
     ComputeTangentVertexInput<ComputeTangentPackedVertexData> vertex_input;
     ComputeTangentVertexOutput<ComputeTangentPackedVertexData> vertex_output;
 
-    if (is_facevarying_input) {
-      // input position is still in 'vertex' variability.
-      for (size_t i = 0; i < faceVertexIndices.size(); i++) {
-        vertex_input.point_indices.push_back(faceVertexIndices[i]);
-      }
-      vertex_input.normals = normals;
-      vertex_input.uvs = texcoords;
-    } else {
-      // expand to facevarying.
-      for (size_t i = 0; i < faceVertexIndices.size(); i++) {
-        vertex_input.point_indices.push_back(faceVertexIndices[i]);
-        vertex_input.normals.push_back(normals[faceVertexIndices[i]]);
-        vertex_input.uvs.push_back(texcoords[faceVertexIndices[i]]);
-      }
-    }
+    vertex_input.point_indices = faceVertexIndices;
+    vertex_input.normals = normals;
+    vertex_input.uvs = texcoords;
 
     std::vector<uint32_t> vertex_point_indices;
 
@@ -2125,98 +2063,123 @@ static bool ComputeTangentsAndBinormals(
     // We only need indices. Discard vertex_output and vertrex_point_indices
   }
 
-  const uint32_t num_verts =
-      *std::max_element(vertex_indices.begin(), vertex_indices.end());
+  if (mikktspace) {
+    // Split vertices by UV orientation. Assign ids in the order of
+    // appearance.
+    size_t num_base =
+        size_t(*std::max_element(vertex_indices.begin(), vertex_indices.end())) +
+        1;
+    std::vector<uint32_t> remap(num_base * 2, ~0u);
+    uint32_t next = 0;
+    for (size_t i = 0; i < num_fvs; i++) {
+      uint32_t &id = remap[2 * size_t(vertex_indices[i]) + orients[i]];
+      if (id == ~0u) {
+        id = next++;
+      }
+      vertex_indices[i] = id;
+    }
+  }
+
+  const size_t num_verts =
+      size_t(*std::max_element(vertex_indices.begin(), vertex_indices.end())) +
+      1;
 
   //
-  // 3. normalize * orthogonalize;
+  // 3. Accumulate per vertex. Gather face-vertices of each vertex(in
+  // face-vertex order) so that the sum is identical regardless of the number
+  // of threads.
   //
-
-  // per-vertex tangents/binormals
-  std::vector<value::normal3f> v_tn;
-  v_tn.assign(num_verts, {0.0f, 0.0f, 0.0f});
-
-  std::vector<value::normal3f> v_bn;
-  v_bn.assign(num_verts, {0.0f, 0.0f, 0.0f});
-
-  for (size_t i = 0; i < vertex_indices.size(); i++) {
-    value::normal3f Tn = tn[vertex_indices[i]];
-    value::normal3f Bn = bn[vertex_indices[i]];
-
-    v_tn[vertex_indices[i]][0] += Tn[0];
-    v_tn[vertex_indices[i]][1] += Tn[1];
-    v_tn[vertex_indices[i]][2] += Tn[2];
-
-    v_bn[vertex_indices[i]][0] += Bn[0];
-    v_bn[vertex_indices[i]][1] += Bn[1];
-    v_bn[vertex_indices[i]][2] += Bn[2];
+  std::vector<uint32_t> adj_offsets(num_verts + 1, 0);
+  for (size_t i = 0; i < num_fvs; i++) {
+    adj_offsets[vertex_indices[i] + 1]++;
   }
-
-  for (size_t i = 0; i < size_t(num_verts); i++) {
-    if (vlength(v_tn[i]) > 0.0f) {
-      v_tn[i] = vnormalize(v_tn[i]);
-    }
-    if (vlength(v_bn[i]) > 0.0f) {
-      v_bn[i] = vnormalize(v_bn[i]);
+  for (size_t v = 0; v < num_verts; v++) {
+    adj_offsets[v + 1] += adj_offsets[v];
+  }
+  std::vector<uint32_t> adj_fvs(num_fvs);
+  {
+    std::vector<uint32_t> cursor(adj_offsets.begin(), adj_offsets.end() - 1);
+    for (size_t i = 0; i < num_fvs; i++) {
+      adj_fvs[cursor[vertex_indices[i]]++] = uint32_t(i);
     }
   }
 
   tangents->assign(num_verts, {0.0f, 0.0f, 0.0f});
   binormals->assign(num_verts, {0.0f, 0.0f, 0.0f});
 
-  for (size_t i = 0; i < vertex_indices.size(); i++) {
-    value::normal3f n;
+  //
+  // 4. normalize * orthogonalize;
+  //
+  thread_util::ParallelForChunked(
+      0, num_verts, num_threads, 4096, [&](size_t vs, size_t ve, size_t) {
+        for (size_t v = vs; v < ve; v++) {
+          const uint32_t first_fv = adj_fvs[adj_offsets[v]];
+
+          vec3 Tn{0.0f, 0.0f, 0.0f};
+          vec3 Bn{0.0f, 0.0f, 0.0f};
+          for (uint32_t a = adj_offsets[v]; a < adj_offsets[v + 1]; a++) {
+            Tn = Tn + tn[adj_fvs[a]];
+            Bn = Bn + bn[adj_fvs[a]];
+          }
 
-    // http://www.terathon.com/code/tangent.html
+          // All face-vertices of the vertex have the same normal.
+          const vec3 &n = normals[first_fv];
 
-    n[0] = normals[vertex_indices[i]][0];
-    n[1] = normals[vertex_indices[i]][1];
-    n[2] = normals[vertex_indices[i]][2];
+          if (mikktspace) {
+            Tn = Tn - n * vdot(n, Tn);
+            if (ExactLength(Tn) > 0.0f) {
+              Tn = SafeNormalize(Tn);
+            } else {
+              // Degenerated UV. Use an arbitrary tangent.
+              GenerateBasis(n, &Tn, &Bn);
+            }
 
-    value::normal3f Tn = v_tn[vertex_indices[i]];
-    value::normal3f Bn = v_bn[vertex_indices[i]];
+            float sign = orients[first_fv] ? 1.0f : -1.0f;
+            Bn = vcross(n, Tn) * sign;
 
-    // Gram-Schmidt orthogonalize
-    Tn = (Tn - n * vdot(n, Tn));
-    if (vlength(Tn) > 0.0f) {
-      Tn = vnormalize(Tn);
-    }
+          } else {
+            if (ExactLength(Tn) > 0.0f) {
+              Tn = SafeNormalize(Tn);
+            }
+            if (ExactLength(Bn) > 0.0f) {
+              Bn = SafeNormalize(Bn);
+            }
 
-    // Calculate handedness
-    if (vdot(vcross(n, Tn), Bn) < 0.0f) {
-      Tn = Tn * -1.0f;
-    }
+            // http://www.terathon.com/code/tangent.html
 
-    ((*tangents)[vertex_indices[i]])[0] = Tn[0];
-    ((*tangents)[vertex_indices[i]])[1] = Tn[1];
-    ((*tangents)[vertex_indices[i]])[2] = Tn[2];
+            // Gram-Schmidt orthogonalize
+            Tn = (Tn - n * vdot(n, Tn));
+            if (ExactLength(Tn) > 0.0f) {
+              Tn = SafeNormalize(Tn);
+            }
 
-    ((*binormals)[vertex_indices[i]])[0] = Bn[0];
-    ((*binormals)[vertex_indices[i]])[1] = Bn[1];
-    ((*binormals)[vertex_indices[i]])[2] = Bn[2];
-  }
+            // Calculate handedness
+            if (vdot(vcross(n, Tn), Bn) < 0.0f) {
+              Tn = Tn * -1.0f;
+            }
+          }
+
+          (*tangents)[v] = Tn;
+          (*binormals)[v] = Bn;
+        }
+      });
 
-  (*out_vertex_indices) = vertex_indices;
+  (*out_vertex_indices) = std::move(vertex_indices);
 
   return true;
 }
 
 //
-// Compute geometric normal in CCW(Counter Clock-Wise) manner
-// Also computes the area of the input triangle.
+// Compute area weighted geometric normal(= 0.5 * cross) in CCW(Counter
+// Clock-Wise) manner.
 //
-inline static value::float3 GeometricNormal(const value::float3 v0,
-                                            const value::float3 v1,
-                                            const value::float3 v2,
-                                            float &area) {
+inline static value::float3 AreaWeightedNormal(const value::float3 v0,
+                                               const value::float3 v1,
+                                               const value::float3 v2) {
   const value::float3 v10 = v1 - v0;
   const value::float3 v20 = v2 - v0;
 
-  value::float3 Nf = vcross(v10, v20);  // CCW
-  area = 0.5f * vlength(Nf);
-  Nf = vnormalize(Nf);
-
-  return Nf;
+  return 0.5f * vcross(v10, v20);  // CCW
 }
 
 //
@@ -2229,10 +2192,13 @@ inline static value::float3 GeometricNormal(const value::float3 v0,
 static bool ComputeNormals(const std::vector<vec3> &vertices,
                            const std::vector<uint32_t> &faceVertexCounts,
                            const std::vector<uint32_t> &faceVertexIndices,
+                           const int num_threads,
                            std::vector<vec3> &normals, std::string *err) {
-  normals.assign(vertices.size(), {0.0f, 0.0f, 0.0f});
-
-  size_t faceVertexIndexOffset{0};
+  //
+  // 1. Validate faces.
+  //
+  std::vector<size_t> faceOffsets(faceVertexCounts.size() + 1);
+  faceOffsets[0] = 0;
   for (size_t f = 0; f < faceVertexCounts.size(); f++) {
     size_t nv = faceVertexCounts[f];
 
@@ -2241,46 +2207,79 @@ static bool ComputeNormals(const std::vector<vec3> &vertices,
           fmt::format("Invalid face num {} at faceVertexCounts[{}]", nv, f));
     }
 
-    // For quad/polygon, first three vertices are used to compute face normal
-    // (Assume quad/polygon plane is co-planar)
-    uint32_t vidx0 = faceVertexIndices[faceVertexIndexOffset + 0];
-    uint32_t vidx1 = faceVertexIndices[faceVertexIndexOffset + 1];
-    uint32_t vidx2 = faceVertexIndices[faceVertexIndexOffset + 2];
+    faceOffsets[f + 1] = faceOffsets[f] + nv;
+  }
 
-    if (vidx0 >= vertices.size()) {
-      PUSH_ERROR_AND_RETURN(
-          fmt::format("vertexIndex0 {} exceeds vertices.size {}", vidx0, vertices.size()));
-    }
+  if (faceOffsets.back() > faceVertexIndices.size()) {
+    PUSH_ERROR_AND_RETURN(fmt::format(
+        "The sum of faceVertexCounts {} exceeds faceVertexIndices.size {}",
+        faceOffsets.back(), faceVertexIndices.size()));
+  }
 
-    if (vidx1 >= vertices.size()) {
-      PUSH_ERROR_AND_RETURN(
-          fmt::format("vertexIndex1 {} exceeds vertices.size {}", vidx1, vertices.size()));
+  const size_t num_fvs = faceOffsets.back();
+  for (size_t i = 0; i < num_fvs; i++) {
+    if (faceVertexIndices[i] >= vertices.size()) {
+      PUSH_ERROR_AND_RETURN(fmt::format(
+          "vertexIndex exceeds vertices.size {}", vertices.size()));
     }
+  }
 
-    if (vidx2 >= vertices.size()) {
-      PUSH_ERROR_AND_RETURN(
-          fmt::format("vertexIndex2 {} exceeds vertices.size {}", vidx2, vertices.size()));
-    }
+  //
+  // 2. Area weighted face normals.
+  //
+  const size_t num_faces = faceVertexCounts.size();
+  std::vector<vec3> faceNormals(num_faces);
+
+  thread_util::ParallelForChunked(
+      0, num_faces, num_threads, 4096, [&](size_t fs, size_t fe, size_t) {
+        for (size_t f = fs; f < fe; f++) {
+          // For quad/polygon, first three vertices are used to compute face
+          // normal (Assume quad/polygon plane is co-planar)
+          uint32_t vidx0 = faceVertexIndices[faceOffsets[f] + 0];
+          uint32_t vidx1 = faceVertexIndices[faceOffsets[f] + 1];
+          uint32_t vidx2 = faceVertexIndices[faceOffsets[f] + 2];
+
+          faceNormals[f] = AreaWeightedNormal(vertices[vidx0], vertices[vidx1],
+                                              vertices[vidx2]);
+        }
+      });
 
-    float area{0.0f};
-    value::float3 Nf = GeometricNormal(vertices[vidx0], vertices[vidx1],
-                                       vertices[vidx2], area);
+  //
+  // 3. Sum face normals for each vertex.
+  // Gather faces of each vertex(in face order) instead of scattering, so the
+  // sum is race-free and identical regardless of the number of threads.
+  //
+  std::vector<uint32_t> adj_offsets(vertices.size() + 1, 0);
+  for (size_t i = 0; i < num_fvs; i++) {
+    adj_offsets[faceVertexIndices[i] + 1]++;
+  }
+  for (size_t v = 0; v < vertices.size(); v++) {
+    adj_offsets[v + 1] += adj_offsets[v];
+  }
 
-    for (size_t v = 0; v < nv; v++) {
-      uint32_t vidx = faceVertexIndices[faceVertexIndexOffset + v];
-      if (vidx >= vertices.size()) {
-        PUSH_ERROR_AND_RETURN(fmt::format(
-            "vertexIndex exceeds vertices.size {}", vertices.size()));
+  std::vector<uint32_t> adj_faces(num_fvs);
+  {
+    std::vector<uint32_t> cursor(adj_offsets.begin(), adj_offsets.end() - 1);
+    for (size_t f = 0; f < num_faces; f++) {
+      for (size_t i = faceOffsets[f]; i < faceOffsets[f + 1]; i++) {
+        adj_faces[cursor[faceVertexIndices[i]]++] = uint32_t(f);
       }
-      normals[vidx] += area * Nf;
     }
-
-    faceVertexIndexOffset += nv;
   }
 
-  for (size_t v = 0; v < normals.size(); v++) {
-    normals[v] = vnormalize(normals[v]);
-  }
+  normals.assign(vertices.size(), {0.0f, 0.0f, 0.0f});
+
+  thread_util::ParallelForChunked(
+      0, vertices.size(), num_threads, 4096,
+      [&](size_t vs, size_t ve, size_t) {
+        for (size_t v = vs; v < ve; v++) {
+          vec3 n{0.0f, 0.0f, 0.0f};
+          for (uint32_t a = adj_offsets[v]; a < adj_offsets[v + 1]; a++) {
+            n += faceNormals[adj_faces[a]];
+          }
+          normals[v] = SafeNormalize(n);
+        }
+      });
 
   return true;
 }
@@ -2473,7 +2472,143 @@ bool RenderSceneConverter::ConvertVertexVariabilityImpl(
   return true;
 }
 
-bool RenderSceneConverter::BuildVertexIndicesImpl(RenderMesh &mesh) {
+namespace {
+
+// Grid cell for vertex welding. The cell is determined by point index and
+// texcoord0.
+struct WeldCell {
+  uint32_t point_index;
+  int32_t cx;
+  int32_t cy;
+};
+
+struct WeldCellHasher {
+  inline size_t operator()(const WeldCell &c) const {
+    return size_t(HashPackedVertexBytes(&c, sizeof(WeldCell)));
+  }
+};
+
+struct WeldCellEqual {
+  inline bool operator()(const WeldCell &lhs, const WeldCell &rhs) const {
+    return (lhs.point_index == rhs.point_index) && (lhs.cx == rhs.cx) &&
+           (lhs.cy == rhs.cy);
+  }
+};
+
+inline int32_t WeldCellCoord(float x, float inv_cell_size) {
+  double c = std::floor(double(x) * double(inv_cell_size));
+  // Also maps NaN to 0.
+  if (!(c > double((std::numeric_limits<int32_t>::min)()) + 1.0)) {
+    return (std::numeric_limits<int32_t>::min)() + 1;
+  }
+  if (c > double((std::numeric_limits<int32_t>::max)()) - 1.0) {
+    return (std::numeric_limits<int32_t>::max)() - 1;
+  }
+  return int32_t(c);
+}
+
+template <size_t N>
+inline bool NearlyEqual(const std::array<float, N> &a,
+                        const std::array<float, N> &b, const float eps) {
+  for (size_t i = 0; i < N; i++) {
+    if (!(std::fabs(a[i] - b[i]) <= eps)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsWeldable(const DefaultPackedVertexData &a,
+                const DefaultPackedVertexData &b,
+                const MeshConverterConfig &config) {
+  return (a.point_index == b.point_index) &&
+         NearlyEqual(a.uv0, b.uv0, config.weld_texcoord_eps) &&
+         NearlyEqual(a.uv1, b.uv1, config.weld_texcoord_eps) &&
+         NearlyEqual(a.normal, b.normal, config.weld_normal_eps) &&
+         NearlyEqual(a.tangent, b.tangent, config.weld_normal_eps) &&
+         NearlyEqual(a.binormal, b.binormal, config.weld_normal_eps) &&
+         NearlyEqual(a.color, b.color, config.weld_color_eps) &&
+         (std::fabs(a.opacity - b.opacity) <= config.weld_color_eps);
+}
+
+//
+// BuildIndices with vertex welding.
+// Vertices are bucketed into a grid hash keyed by point index and texcoord0
+// cell(cell size = weld_texcoord_eps), then matched against the vertices in
+// the neighboring 3x3 cells.
+//
+void WeldIndices(const DefaultVertexInput<DefaultPackedVertexData> &input,
+                 DefaultVertexOutput<DefaultPackedVertexData> &output,
+                 std::vector<uint32_t> &out_indices,
+                 std::vector<uint32_t> &out_point_indices,
+                 const MeshConverterConfig &config) {
+  const float cell_size =
+      (config.weld_texcoord_eps > 0.0f) ? config.weld_texcoord_eps : 1.0f;
+  const float inv_cell_size = 1.0f / cell_size;
+
+  // cell -> head of the vertex list in `next`.
+  std::unordered_map<WeldCell, uint32_t, WeldCellHasher, WeldCellEqual> cells;
+  cells.reserve(input.size());
+
+  std::vector<DefaultPackedVertexData> verts;  // welded vertices
+  std::vector<uint32_t> next;  // next vertex in the same cell(~0u = end)
+
+  out_indices.reserve(out_indices.size() + input.size());
+  out_point_indices.reserve(out_point_indices.size() + input.size());
+
+  const uint32_t index_offset = uint32_t(output.size());
+
+  for (size_t i = 0; i < input.size(); i++) {
+    DefaultPackedVertexData v;
+    input.get(i, v);
+
+    WeldCell cell;
+    cell.point_index = v.point_index;
+    cell.cx = WeldCellCoord(v.uv0[0], inv_cell_size);
+    cell.cy = WeldCellCoord(v.uv0[1], inv_cell_size);
+
+    uint32_t found_index = ~0u;
+    for (int32_t dy = -1; (dy <= 1) && (found_index == ~0u); dy++) {
+      for (int32_t dx = -1; (dx <= 1) && (found_index == ~0u); dx++) {
+        WeldCell ncell{cell.point_index, cell.cx + dx, cell.cy + dy};
+        auto it = cells.find(ncell);
+        if (it == cells.end()) {
+          continue;
+        }
+        for (uint32_t k = it->second; k != ~0u; k = next[k]) {
+          if (IsWeldable(verts[k], v, config)) {
+            found_index = k;
+            break;
+          }
+        }
+      }
+    }
+
+    if (found_index == ~0u) {
+      found_index = uint32_t(verts.size());
+      verts.push_back(v);
+
+      auto it = cells.find(cell);
+      if (it == cells.end()) {
+        next.push_back(~0u);
+        cells.emplace(cell, found_index);
+      } else {
+        next.push_back(it->second);
+        it->second = found_index;
+      }
+
+      output.push_back(v);
+    }
+
+    out_indices.push_back(index_offset + found_index);
+    out_point_indices.push_back(v.point_index);
+  }
+}
+
+}  // namespace
+
+bool RenderSceneConverter::BuildVertexIndicesImpl(
+    const MeshConverterConfig &config, RenderMesh &mesh) {
   //
   // - If mesh is triangulated, use triangulatedFaceVertexIndices, otherwise use
   // faceVertxIndices.
@@ -2590,7 +2725,7 @@ bool RenderSceneConverter::BuildVertexIndicesImpl(RenderMesh &mesh) {
           "Internal error. vertex_opacities must be 'facevarying' "
           "variability.");
     }
-    if (mesh.vertex_colors.vertex_count() != num_fvs) {
+    if (mesh.vertex_opacities.vertex_count() != num_fvs) {
       PUSH_ERROR_AND_RETURN(
           "Internal error. The number of vertex_opacity items does not match "
           "with the number of facevarying items.");
@@ -2647,11 +2782,17 @@ bool RenderSceneConverter::BuildVertexIndicesImpl(RenderMesh &mesh) {
   std::vector<uint32_t> out_point_indices;  // to reorder position data
   DefaultVertexOutput<DefaultPackedVertexData> vertex_output;
 
-  BuildIndices<DefaultVertexInput<DefaultPackedVertexData>,
-               DefaultVertexOutput<DefaultPackedVertexData>,
-               DefaultPackedVertexData, DefaultPackedVertexDataHasher,
-               DefaultPackedVertexDataEqual>(vertex_input, vertex_output,
-                                             out_indices, out_point_indices);
+  if (config.weld_vertices) {
+    WeldIndices(vertex_input, vertex_output, out_indices, out_point_indices,
+                config);
+  } else {
+    BuildIndices<DefaultVertexInput<DefaultPackedVertexData>,
+                 DefaultVertexOutput<DefaultPackedVertexData>,
+                 DefaultPackedVertexData, DefaultPackedVertexDataHasher,
+                 DefaultPackedVertexDataEqual>(
+        vertex_input, vertex_output, out_indices, out_point_indices,
+        config.use_flat_vertex_hash_table);
+  }
 
   if (out_indices.size() != out_point_indices.size()) {
     PUSH_ERROR_AND_RETURN(
@@ -3038,8 +3179,16 @@ bool RenderSceneConverter::ConvertMesh(
   // key:slotId, value:texcoord data
   std::unordered_map<uint32_t, VertexAttribute> uvAttrs;
 
+  // Materials are owned by the parent converter when converting meshes in
+  // parallel. Only consider materials visible at this point of mesh
+  // traversal so that the result matches the serial conversion.
+  const RenderSceneConverter &msrc =
+      _material_source ? *_material_source : *this;
+  const size_t num_materials =
+      (std::min)(msrc.materials.size(), _num_visible_materials);
+
   // We need Material info to get corresponding primvar name.
-  if (rmaterial_map.empty()) {
+  if (rmaterial_map.empty() || (_num_visible_materials == 0)) {
     // No material assigned to the Mesh, but we may still want texcoords solely(
     // assign material after the conversion)
     // So find a primvar whose name matches default texcoord name.
@@ -3064,11 +3213,11 @@ bool RenderSceneConverter::ConvertMesh(
          mit++) {
       int64_t rmaterial_id = int64_t(mit->first);
 
-      if ((rmaterial_id > -1) && (size_t(rmaterial_id) < materials.size())) {
-        const RenderMaterial &material = materials[size_t(rmaterial_id)];
+      if ((rmaterial_id > -1) && (size_t(rmaterial_id) < num_materials)) {
+        const RenderMaterial &material = msrc.materials[size_t(rmaterial_id)];
 
         StringAndIdMap uvname_map;
-        if (!ListUVNames(material, textures, uvname_map)) {
+        if (!ListUVNames(material, msrc.textures, uvname_map)) {
           DCOUT("Failed to list UV names");
           return false;
         }
@@ -3854,15 +4003,18 @@ bool RenderSceneConverter::ConvertMesh(
   //
   bool compute_normals =
       (env.mesh_config.compute_normals && dst.normals.empty());
+  // TODO: Support arbitrary slotID
   bool compute_tangents =
       (env.mesh_config.compute_tangents_and_binormals &&
-       (dst.binormals.empty() == 0 && dst.tangents.empty() == 0));
+       (dst.binormals.empty() && dst.tangents.empty()) &&
+       dst.texcoords.count(0) && !dst.texcoords[0].empty());
 
   if (compute_normals || (compute_tangents && dst.normals.empty())) {
     DCOUT("Compute normals");
     std::vector<vec3> normals;
     if (!ComputeNormals(dst.points, dst.faceVertexCounts(),
-                       dst.faceVertexIndices(), normals, &_err)) {
+                        dst.faceVertexIndices(), env.mesh_config.num_threads,
+                        normals, &_err)) {
       DCOUT("compute normals failed.");
       return false;
     }
@@ -3896,7 +4048,7 @@ bool RenderSceneConverter::ConvertMesh(
   if (env.mesh_config.build_vertex_indices && (!is_single_indexable)) {
     DCOUT("Build vertex indices");
 
-    if (!BuildVertexIndicesImpl(dst)) {
+    if (!BuildVertexIndicesImpl(env.mesh_config, dst)) {
       return false;
     }
 
@@ -3908,30 +4060,72 @@ bool RenderSceneConverter::ConvertMesh(
   //
   if (compute_tangents) {
     DCOUT("Compute tangents.");
-    std::vector<vec2> texcoords;
-    std::vector<vec3> normals;
 
-    // TODO: Support arbitrary slotID
-    if (!dst.texcoords.count(0)) {
-      PUSH_ERROR_AND_RETURN(
-          "texcoord is required to compute tangents/binormals.\n");
+    // Tangents are computed with 'facevarying' texcoords and normals.
+    auto ToFaceVaryingArray =
+        [&](const VertexAttribute &vattr, VertexAttributeFormat format,
+            std::vector<uint8_t> *out) -> nonstd::expected<bool, std::string> {
+      if ((vattr.format != format) || (vattr.elementSize != 1)) {
+        return nonstd::make_unexpected(fmt::format(
+            "Unsupported format {}(elementSize {}) for `{}` attribute.",
+            to_string(vattr.format), vattr.elementSize, vattr.name));
+      }
+      if (vattr.is_facevarying()) {
+        (*out) = vattr.get_data();
+      } else if (vattr.is_vertex()) {
+        auto result =
+            VertexToFaceVarying(vattr.get_data(), vattr.stride_bytes(),
+                                dst.faceVertexCounts(), dst.faceVertexIndices());
+        if (!result) {
+          return nonstd::make_unexpected(result.error());
+        }
+        (*out) = std::move(result.value());
+      } else {
+        return nonstd::make_unexpected(
+            fmt::format("Unsupported variability {} for `{}` attribute.",
+                        to_string(vattr.variability), vattr.name));
+      }
+      if (out->size() != dst.faceVertexIndices().size() *
+                             VertexAttributeFormatSize(format)) {
+        return nonstd::make_unexpected(fmt::format(
+            "Invalid data size of `{}` attribute.", vattr.name));
+      }
+      return true;
+    };
+
+    std::vector<uint8_t> texcoords_data;
+    std::vector<uint8_t> normals_data;
+    {
+      auto ret = ToFaceVaryingArray(dst.texcoords[0],
+                                    VertexAttributeFormat::Vec2,
+                                    &texcoords_data);
+      if (!ret) {
+        PUSH_ERROR_AND_RETURN(fmt::format(
+            "Failed to compute tangents/binormals: {}", ret.error()));
+      }
+      ret = ToFaceVaryingArray(dst.normals, VertexAttributeFormat::Vec3,
+                               &normals_data);
+      if (!ret) {
+        PUSH_ERROR_AND_RETURN(fmt::format(
+            "Failed to compute tangents/binormals: {}", ret.error()));
+      }
     }
 
-    texcoords.resize(dst.texcoords[0].vertex_count());
-    normals.resize(dst.normals.vertex_count());
+    std::vector<vec2> texcoords(texcoords_data.size() / sizeof(vec2));
+    std::vector<vec3> normals(normals_data.size() / sizeof(vec3));
 
-    memcpy(texcoords.data(), dst.texcoords[0].buffer(),
-           dst.texcoords[0].num_bytes());
-    memcpy(normals.data(), dst.normals.buffer(), dst.normals.num_bytes());
+    memcpy(texcoords.data(), texcoords_data.data(), texcoords_data.size());
+    memcpy(normals.data(), normals_data.data(), normals_data.size());
 
     std::vector<vec3> tangents;
     std::vector<vec3> binormals;
     std::vector<uint32_t> vertex_indices;
 
-    if (!ComputeTangentsAndBinormals(dst.points, dst.faceVertexCounts(),
-                                     dst.faceVertexIndices(), texcoords,
-                                     normals, !is_single_indexable, &tangents,
-                                     &binormals, &vertex_indices, &_err)) {
+    if (!ComputeTangentsAndBinormals(
+            dst.points, dst.faceVertexCounts(), dst.faceVertexIndices(),
+            texcoords, normals, env.mesh_config.tangent_frame_mode,
+            env.mesh_config.num_threads, &tangents, &binormals,
+            &vertex_indices, &_err)) {
       PUSH_ERROR_AND_RETURN("Failed to compute tangents/binormals.");
     }
 
@@ -3968,7 +4162,39 @@ bool RenderSceneConverter::ConvertMesh(
 
     // 2. Build single vertex indices if `build_vertex_indices` is true.
     if (env.mesh_config.build_vertex_indices) {
-      if (!BuildVertexIndicesImpl(dst)) {
+      // Other attributes may already be reordered to 'vertex' variability by
+      // the previous BuildVertexIndicesImpl. Make them 'facevarying' again.
+      auto VertexAttrToFaceVarying =
+          [&](VertexAttribute &vattr) -> nonstd::expected<bool, std::string> {
+        if (vattr.empty() || !vattr.is_vertex()) {
+          return true;
+        }
+        auto result =
+            VertexToFaceVarying(vattr.get_data(), vattr.stride_bytes(),
+                                dst.faceVertexCounts(), dst.faceVertexIndices());
+        if (!result) {
+          return nonstd::make_unexpected(result.error());
+        }
+        vattr.data = std::move(result.value());
+        vattr.variability = VertexVariability::FaceVarying;
+        return true;
+      };
+
+      std::vector<VertexAttribute *> vattrs{&dst.normals, &dst.vertex_colors,
+                                            &dst.vertex_opacities};
+      for (auto &it : dst.texcoords) {
+        vattrs.push_back(&it.second);
+      }
+      for (VertexAttribute *vattr : vattrs) {
+        auto ret = VertexAttrToFaceVarying(*vattr);
+        if (!ret) {
+          PUSH_ERROR_AND_RETURN(fmt::format(
+              "Convert vertex `{}` attribute to facevarying failed: {}",
+              vattr->name, ret.error()));
+        }
+      }
+
+      if (!BuildVertexIndicesImpl(env.mesh_config, dst)) {
         return false;
       }
       is_single_indexable = true;
@@ -4233,29 +4459,430 @@ nonstd::expected<bool, std::string> GetConnectedUVTexture(
 //
 // - UsdUVTexture -> UsdPrimvarReader
 // - UsdUVTexture -> UsdTransform2d -> UsdPrimvarReader
-bool RenderSceneConverter::ConvertUVTexture(const RenderSceneConverterEnv &env,
-                                            const Path &tex_abs_path,
-                                            const AssetInfo &assetInfo,
-                                            const UsdUVTexture &texture,
-                                            UVTexture *tex_out) {
-  DCOUT("ConvertUVTexture " << tex_abs_path);
+bool RenderSceneConverter::InferTextureImageColorSpaceImpl(
+    const RenderSceneConverterEnv &env, const value::AssetPath &assetPath,
+    const UsdUVTexture &texture, const bool tex_loaded,
+    TextureImage &texImage) {
+  // colorSpace.
+  // First look into `colorSpace` metadata of asset, then
+  // look into `inputs:sourceColorSpace' attribute.
+  // When both `colorSpace` metadata and `inputs:sourceColorSpace' attribute
+  // exists, `colorSpace` metadata supercedes.
+  // NOTE: `inputs:sourceColorSpace` attribute should be deprecated in favor of `colorSpace` metadata.
+  bool inferColorSpaceFailed = false;
+  if (texture.file.metas().has_colorSpace()) {
+    ColorSpace cs;
+    value::token cs_token = texture.file.metas().get_colorSpace();
+    if (InferColorSpace(cs_token, &cs)) {
+      texImage.usdColorSpace = cs;
+      DCOUT("Inferred colorSpace: " << to_string(cs));
+    } else {
+      inferColorSpaceFailed = true;
+    }
+  }
+
+  bool sourceColorSpaceSet = false;
+  if (inferColorSpaceFailed || !texture.file.metas().has_colorSpace()) {
+    if (texture.sourceColorSpace.authored()) {
+      UsdUVTexture::SourceColorSpace cs;
+      if (texture.sourceColorSpace.get_value().get(env.timecode, &cs)) {
+        if (cs == UsdUVTexture::SourceColorSpace::SRGB) {
+          texImage.usdColorSpace = tydra::ColorSpace::sRGB;
+          sourceColorSpaceSet = true;
+        } else if (cs == UsdUVTexture::SourceColorSpace::Raw) {
+          texImage.usdColorSpace = tydra::ColorSpace::Raw;
+          sourceColorSpaceSet = true;
+        } else if (cs == UsdUVTexture::SourceColorSpace::Auto) {
+
+          if (tex_loaded) {
+
+            // The spec says: https://openusd.org/release/spec_usdpreviewsurface.html
+            //
+            // auto : Check for gamma/color space metadata in the texture file itself; if metadata is indicative of sRGB, mark texture as sRGB . If no relevant metadata is found, mark texture as sRGB if it is either 8-bit and has 3 channels or if it is 8-bit and has 4 channels. Otherwise, do not mark texture as sRGB and use texture data as it was read from the texture.
+            //
+            if (((texImage.assetTexelComponentType == ComponentType::UInt8) ||
+                (texImage.assetTexelComponentType == ComponentType::Int8)) &&
+              ((texImage.channels == 3) || (texImage.channels ==4))) {
+              texImage.usdColorSpace = tydra::ColorSpace::sRGB;
+              sourceColorSpaceSet = true;
+            } else {
+              PUSH_WARN(fmt::format("Infer colorSpace failed for {}. Set to Raw for now. Results may be wrong.", assetPath.GetAssetPath()));
+              // At least 'not' sRGB. For now set to Raw.
 
-  if (!tex_out) {
-    PUSH_ERROR_AND_RETURN("tex_out arg is nullptr.");
+              texImage.usdColorSpace = tydra::ColorSpace::Raw;
+              sourceColorSpaceSet = true;
+            }
+          } else {
+            texImage.usdColorSpace = tydra::ColorSpace::Unknown;
+            sourceColorSpaceSet = true;
+          }
+        }
+      }
+    }
   }
-  std::string err;
-
-  UVTexture tex;
 
-  if (!texture.file.authored()) {
-    PUSH_ERROR_AND_RETURN(fmt::format("`asset:file` is not authored. Path = {}",
-                                      tex_abs_path.prim_part()));
+  if (!sourceColorSpaceSet && inferColorSpaceFailed) {
+    value::token cs_token = texture.file.metas().get_colorSpace();
+    PUSH_ERROR_AND_RETURN(
+        fmt::format("Invalid or unknown colorSpace metadataum: {}. Please "
+                    "report an issue to TinyUSDZ github repo.",
+                    cs_token.str()));
   }
 
-  value::AssetPath assetPath;
-  if (auto apath = texture.file.get_value()) {
-    if (!apath.value().get(env.timecode, &assetPath)) {
-      PUSH_ERROR_AND_RETURN(fmt::format(
+  return true;
+}
+
+bool RenderSceneConverter::BuildTextureImageImpl(
+    const RenderSceneConverterEnv &env, const value::AssetPath &assetPath,
+    TextureImage &texImage, BufferData &assetImageBuffer,
+    int64_t *texture_image_id) {
+  BufferData imageBuffer;
+
+  // Linearlization and widen texel bit depth if required.
+  if (env.material_config.linearize_color_space) {
+    // TODO: Support ACEScg and Lin_DisplayP3
+    DCOUT("linearlize colorspace.");
+    size_t width = size_t(texImage.width);
+    size_t height = size_t(texImage.height);
+    size_t channels = size_t(texImage.channels);
+
+    if (channels > 4) {
+      PUSH_ERROR_AND_RETURN(
+          fmt::format("TODO: Multiband color channels(5 or more) are not "
+                      "supported(yet)."));
+    }
+
+    if (assetImageBuffer.componentType == tydra::ComponentType::UInt8) {
+      if (texImage.usdColorSpace == tydra::ColorSpace::sRGB) {
+        if (env.material_config.preserve_texel_bitdepth) {
+          // u8 sRGB -> u8 Linear
+          imageBuffer.componentType = tydra::ComponentType::UInt8;
+
+          bool ret = srgb_8bit_to_linear_8bit(
+              assetImageBuffer.data, width, height, channels,
+              /* channel stride */ channels, &imageBuffer.data, &_err);
+          if (!ret) {
+            PUSH_ERROR_AND_RETURN(
+                "Failed to convert sRGB u8 image to Linear u8 image.");
+          }
+
+        } else {
+          DCOUT("u8 sRGB -> fp32 linear.");
+          // u8 sRGB -> fp32 Linear
+          imageBuffer.componentType = tydra::ComponentType::Float;
+
+          std::vector<float> buf;
+          bool ret = srgb_8bit_to_linear_f32(
+              assetImageBuffer.data, width, height, channels,
+              /* channel stride */ channels, &buf, &_err);
+          if (!ret) {
+            PUSH_ERROR_AND_RETURN(
+                "Failed to convert sRGB u8 image to Linear f32 image.");
+          }
+
+          DCOUT("sz = " << buf.size());
+          imageBuffer.data.resize(buf.size() * sizeof(float));
+          memcpy(imageBuffer.data.data(), buf.data(),
+                 sizeof(float) * buf.size());
+        }
+
+        texImage.colorSpace = tydra::ColorSpace::Lin_sRGB;
+
+      } else if (texImage.usdColorSpace == tydra::ColorSpace::Lin_sRGB) {
+        if (env.material_config.preserve_texel_bitdepth) {
+          // no op.
+          imageBuffer = std::move(assetImageBuffer);
+
+        } else {
+          // u8 -> fp32
+          imageBuffer.componentType = tydra::ComponentType::Float;
+
+          std::vector<float> buf;
+          bool ret = u8_to_f32_image(assetImageBuffer.data, width, height,
+                                     channels, &buf, &_err);
+          if (!ret) {
+            PUSH_ERROR_AND_RETURN("Failed to convert u8 image to f32 image.");
+          }
+
+          imageBuffer.data.resize(buf.size() * sizeof(float));
+          memcpy(imageBuffer.data.data(), buf.data(),
+                 sizeof(float) * buf.size());
+        }
+
+        texImage.colorSpace = tydra::ColorSpace::Lin_sRGB;
+
+      } else {
+        PUSH_ERROR(fmt::format("TODO: Color space {}",
+                               to_string(texImage.usdColorSpace)));
+      }
+
+    } else if (assetImageBuffer.componentType ==
+               tydra::ComponentType::Float) {
+      // ignore preserve_texel_bitdepth
+
+      if (texImage.usdColorSpace == tydra::ColorSpace::sRGB) {
+        // srgb f32 -> linear f32
+        std::vector<float> in_buf;
+        std::vector<float> out_buf;
+        in_buf.resize(assetImageBuffer.data.size() / sizeof(float));
+        memcpy(in_buf.data(), assetImageBuffer.data.data(),
+               in_buf.size() * sizeof(float));
+
+        out_buf.resize(assetImageBuffer.data.size() / sizeof(float));
+
+        // TODO: scale factor & bias
+        float scale_factor = 1.0f;
+        float bias = 0.0f;
+        float alpha_scale_factor = 1.0f;
+        float alpha_bias = 0.0f;
+
+        bool ret =
+            srgb_f32_to_linear_f32(in_buf, width, height, channels,
+                                   /* channel stride */ channels, &out_buf, scale_factor, bias, alpha_scale_factor, alpha_bias, &_err);
+
+        if (!ret) {
+          PUSH_ERROR_AND_RETURN(
+              "Failed to convert sRGB f32 image to Linear f32 image.");
+        }
+
+        imageBuffer.data.resize(assetImageBuffer.data.size());
+        memcpy(imageBuffer.data.data(), out_buf.data(),
+               imageBuffer.data.size());
+
+
+      } else if (texImage.usdColorSpace == tydra::ColorSpace::Lin_sRGB) {
+        // no op
+        imageBuffer = std::move(assetImageBuffer);
+
+      } else {
+        PUSH_ERROR(fmt::format("TODO: Color space {}",
+                               to_string(texImage.usdColorSpace)));
+      }
+
+    } else {
+      PUSH_ERROR(fmt::format("TODO: asset texture texel format {}",
+                             to_string(assetImageBuffer.componentType)));
+    }
+
+  } else {
+    // Same color space.
+    DCOUT("assetImageBuffer.sz = " << assetImageBuffer.data.size());
+
+    if (assetImageBuffer.componentType == tydra::ComponentType::UInt8) {
+      if (env.material_config.preserve_texel_bitdepth) {
+        // Do nothing.
+        imageBuffer = std::move(assetImageBuffer);
+
+      } else {
+        size_t width = size_t(texImage.width);
+        size_t height = size_t(texImage.height);
+        size_t channels = size_t(texImage.channels);
+
+        // u8 to f32, but no sRGB -> linear conversion(this would break
+        // UsdPreviewSurface's spec though)
+        PUSH_WARN(
+            "8bit sRGB texture is converted to fp32 sRGB texture(without "
+            "linearlization)");
+        std::vector<float> buf;
+        bool ret = u8_to_f32_image(assetImageBuffer.data, width, height,
+                                   channels, &buf, &_err);
+        if (!ret) {
+          PUSH_ERROR_AND_RETURN("Failed to convert u8 image to f32 image.");
+        }
+        imageBuffer.componentType = tydra::ComponentType::Float;
+
+        imageBuffer.data.resize(buf.size() * sizeof(float));
+        memcpy(imageBuffer.data.data(), buf.data(),
+               sizeof(float) * buf.size());
+      }
+
+      texImage.colorSpace = texImage.usdColorSpace;
+
+    } else if (assetImageBuffer.componentType ==
+               tydra::ComponentType::Float) {
+      // ignore preserve_texel_bitdepth
+
+      // f32 to f32, so no op
+      imageBuffer = std::move(assetImageBuffer);
+
+    } else {
+      PUSH_ERROR(fmt::format("TODO: asset texture texel format {}",
+                             to_string(assetImageBuffer.componentType)));
+    }
+  }
+
+  // Assign buffer id
+  texImage.buffer_id = int64_t(buffers.size());
+
+  // TODO: Share image data as much as possible.
+  // e.g. Texture A and B uses same image file, but texturing parameter is
+  // different.
+  buffers.emplace_back(imageBuffer);
+
+  (*texture_image_id) = int64_t(images.size());
+
+  images.emplace_back(texImage);
+
+  std::stringstream ss;
+  ss << "Loaded texture image " << assetPath.GetAssetPath()
+     << " : buffer_id " + std::to_string(texImage.buffer_id) << "\n";
+  ss << "  width x height x components " << texImage.width << " x "
+     << texImage.height << " x " << texImage.channels << "\n";
+  ss << "  colorSpace " << tinyusdz::tydra::to_string(texImage.colorSpace)
+     << "\n";
+  PushInfo(ss.str());
+
+  return true;
+}
+
+void RenderSceneConverter::DeferTextureImageLoad(
+    const RenderSceneConverterEnv &env, const value::AssetPath &assetPath,
+    const AssetInfo &assetInfo, const UsdUVTexture &texture) {
+  std::string resolvedPath =
+      env.asset_resolver.resolve(assetPath.GetAssetPath());
+  const std::string &key =
+      resolvedPath.empty() ? assetPath.GetAssetPath() : resolvedPath;
+
+  size_t job_id;
+  auto it = _texture_load_job_map.find(key);
+  if (it != _texture_load_job_map.end()) {
+    job_id = it->second;
+  } else {
+    job_id = _texture_load_jobs.size();
+
+    TextureLoadJob job;
+    job.assetPath = assetPath;
+    job.assetInfo = assetInfo;
+    _texture_load_jobs.emplace_back(std::move(job));
+    _texture_load_job_map[key] = job_id;
+  }
+
+  DeferredTextureImage item;
+  // UVTexture is appended to `textures` just after ConvertUVTexture().
+  item.texture_id = textures.size();
+  item.job_id = job_id;
+  item.assetPath = assetPath;
+  item.texture = &texture;
+  _deferred_texture_images.emplace_back(std::move(item));
+}
+
+bool RenderSceneConverter::ResolveDeferredTextureImages(
+    const RenderSceneConverterEnv &env) {
+  // The number of remaining references to each job, to move out decoded image
+  // data at the last reference.
+  std::vector<size_t> job_refcounts(_texture_load_jobs.size(), 0);
+  for (const auto &item : _deferred_texture_images) {
+    job_refcounts[item.job_id]++;
+  }
+
+  std::vector<bool> job_reported(_texture_load_jobs.size(), false);
+
+  // key: (job id, usdColorSpace), value: image id
+  std::map<std::pair<size_t, int>, int64_t> image_ids;
+
+  for (const auto &item : _deferred_texture_images) {
+    TextureLoadJob &job = _texture_load_jobs[item.job_id];
+    job_refcounts[item.job_id]--;
+
+    if (!job_reported[item.job_id]) {
+      job_reported[item.job_id] = true;
+
+      if (job.warn.size()) {
+        DCOUT("WARN: " << job.warn);
+        PushWarn(job.warn);
+      }
+
+      if (!job.loaded && !env.material_config.allow_texture_load_failure) {
+        PUSH_ERROR_AND_RETURN(
+            fmt::format("Failed to load texture image: `{}` err = {}",
+                        job.assetPath.GetAssetPath(), job.err));
+      }
+
+      if (job.err.size()) {
+        // report as warn.
+        PUSH_WARN(fmt::format(
+            "Failed to load texture image: `{}`. Skip loading. reason = {} ",
+            job.assetPath.GetAssetPath(), job.err));
+      }
+    }
+
+    if (item.texture_id >= textures.size()) {
+      PUSH_ERROR_AND_RETURN(
+          fmt::format("[Internal error] Invalid texture id {}: `{}`",
+                      item.texture_id, item.assetPath.GetAssetPath()));
+    }
+
+    TextureImage texImage = job.texImage;
+
+    // store unresolved asset path.
+    texImage.asset_identifier = item.assetPath.GetAssetPath();
+
+    if (!InferTextureImageColorSpaceImpl(env, item.assetPath, *item.texture,
+                                         job.loaded, texImage)) {
+      return false;
+    }
+
+    if (!job.loaded) {
+      continue;
+    }
+
+    std::pair<size_t, int> key(item.job_id, int(texImage.usdColorSpace));
+    auto it = image_ids.find(key);
+    if (it != image_ids.end()) {
+      textures[item.texture_id].texture_image_id = it->second;
+      continue;
+    }
+
+    BufferData assetImageBuffer;
+
+    // Texel data is treated as byte array
+    assetImageBuffer.componentType = ComponentType::UInt8;
+    if (job_refcounts[item.job_id] == 0) {
+      assetImageBuffer.data = std::move(job.imageData);
+    } else {
+      assetImageBuffer.data = job.imageData;
+    }
+
+    int64_t image_id{-1};
+    if (!BuildTextureImageImpl(env, item.assetPath, texImage,
+                               assetImageBuffer, &image_id)) {
+      return false;
+    }
+
+    textures[item.texture_id].texture_image_id = image_id;
+    image_ids[key] = image_id;
+  }
+
+  _texture_load_jobs.clear();
+  _texture_load_job_map.clear();
+  _deferred_texture_images.clear();
+
+  return true;
+}
+
+bool RenderSceneConverter::ConvertUVTexture(const RenderSceneConverterEnv &env,
+                                            const Path &tex_abs_path,
+                                            const AssetInfo &assetInfo,
+                                            const UsdUVTexture &texture,
+                                            UVTexture *tex_out) {
+  DCOUT("ConvertUVTexture " << tex_abs_path);
+
+  if (!tex_out) {
+    PUSH_ERROR_AND_RETURN("tex_out arg is nullptr.");
+  }
+  std::string err;
+
+  UVTexture tex;
+
+  if (!texture.file.authored()) {
+    PUSH_ERROR_AND_RETURN(fmt::format("`asset:file` is not authored. Path = {}",
+                                      tex_abs_path.prim_part()));
+  }
+
+  value::AssetPath assetPath;
+  if (auto apath = texture.file.get_value()) {
+    if (!apath.value().get(env.timecode, &assetPath)) {
+      PUSH_ERROR_AND_RETURN(fmt::format(
           "Failed to get `asset:file` value from Path {} at time {}",
           tex_abs_path.prim_part(), env.timecode));
     }
@@ -4266,7 +4893,11 @@ bool RenderSceneConverter::ConvertUVTexture(const RenderSceneConverterEnv &env,
   }
 
   // TextureImage and BufferData
-  {
+  if (env.scene_config.load_texture_assets && _defer_texture_loading) {
+    // Texture image is decoded later(in parallel) and `texture_image_id` is
+    // assigned in ResolveDeferredTextureImages().
+    DeferTextureImageLoad(env, assetPath, assetInfo, texture);
+  } else {
     TextureImage texImage;
     BufferData assetImageBuffer;
 
@@ -4316,268 +4947,16 @@ bool RenderSceneConverter::ConvertUVTexture(const RenderSceneConverterEnv &env,
           env.asset_resolver.resolve(assetPath.GetAssetPath());
     }
 
-    // colorSpace.
-    // First look into `colorSpace` metadata of asset, then
-    // look into `inputs:sourceColorSpace' attribute.
-    // When both `colorSpace` metadata and `inputs:sourceColorSpace' attribute
-    // exists, `colorSpace` metadata supercedes.
-    // NOTE: `inputs:sourceColorSpace` attribute should be deprecated in favor of `colorSpace` metadata.
-    bool inferColorSpaceFailed = false;
-    if (texture.file.metas().has_colorSpace()) {
-      ColorSpace cs;
-      value::token cs_token = texture.file.metas().get_colorSpace();
-      if (InferColorSpace(cs_token, &cs)) {
-        texImage.usdColorSpace = cs;
-        DCOUT("Inferred colorSpace: " << to_string(cs));
-      } else {
-        inferColorSpaceFailed = true;
-      }
-    }
-
-    bool sourceColorSpaceSet = false;
-    if (inferColorSpaceFailed || !texture.file.metas().has_colorSpace()) {
-      if (texture.sourceColorSpace.authored()) {
-        UsdUVTexture::SourceColorSpace cs;
-        if (texture.sourceColorSpace.get_value().get(env.timecode, &cs)) {
-          if (cs == UsdUVTexture::SourceColorSpace::SRGB) {
-            texImage.usdColorSpace = tydra::ColorSpace::sRGB;
-            sourceColorSpaceSet = true;
-          } else if (cs == UsdUVTexture::SourceColorSpace::Raw) {
-            texImage.usdColorSpace = tydra::ColorSpace::Raw;
-            sourceColorSpaceSet = true;
-          } else if (cs == UsdUVTexture::SourceColorSpace::Auto) {
-
-            if (tex_loaded) {
-
-              // The spec says: https://openusd.org/release/spec_usdpreviewsurface.html
-              //
-              // auto : Check for gamma/color space metadata in the texture file itself; if metadata is indicative of sRGB, mark texture as sRGB . If no relevant metadata is found, mark texture as sRGB if it is either 8-bit and has 3 channels or if it is 8-bit and has 4 channels. Otherwise, do not mark texture as sRGB and use texture data as it was read from the texture.
-              //
-              if (((texImage.assetTexelComponentType == ComponentType::UInt8) ||
-                  (texImage.assetTexelComponentType == ComponentType::Int8)) &&
-                ((texImage.channels == 3) || (texImage.channels ==4))) {
-                texImage.usdColorSpace = tydra::ColorSpace::sRGB;
-                sourceColorSpaceSet = true;
-              } else {
-                PUSH_WARN(fmt::format("Infer colorSpace failed for {}. Set to Raw for now. Results may be wrong.", assetPath.GetAssetPath()));
-                // At least 'not' sRGB. For now set to Raw.
-
-                texImage.usdColorSpace = tydra::ColorSpace::Raw;
-                sourceColorSpaceSet = true;
-              }
-            } else {
-              texImage.usdColorSpace = tydra::ColorSpace::Unknown;
-              sourceColorSpaceSet = true;
-            }
-          }
-        }
-      }
-    }
-
-    if (!sourceColorSpaceSet && inferColorSpaceFailed) {
-      value::token cs_token = texture.file.metas().get_colorSpace();
-      PUSH_ERROR_AND_RETURN(
-          fmt::format("Invalid or unknown colorSpace metadataum: {}. Please "
-                      "report an issue to TinyUSDZ github repo.",
-                      cs_token.str()));
+    if (!InferTextureImageColorSpaceImpl(env, assetPath, texture, tex_loaded,
+                                         texImage)) {
+      return false;
     }
 
     if (tex_loaded) {
-      BufferData imageBuffer;
-
-      // Linearlization and widen texel bit depth if required.
-      if (env.material_config.linearize_color_space) {
-        // TODO: Support ACEScg and Lin_DisplayP3
-        DCOUT("linearlize colorspace.");
-        size_t width = size_t(texImage.width);
-        size_t height = size_t(texImage.height);
-        size_t channels = size_t(texImage.channels);
-
-        if (channels > 4) {
-          PUSH_ERROR_AND_RETURN(
-              fmt::format("TODO: Multiband color channels(5 or more) are not "
-                          "supported(yet)."));
-        }
-
-        if (assetImageBuffer.componentType == tydra::ComponentType::UInt8) {
-          if (texImage.usdColorSpace == tydra::ColorSpace::sRGB) {
-            if (env.material_config.preserve_texel_bitdepth) {
-              // u8 sRGB -> u8 Linear
-              imageBuffer.componentType = tydra::ComponentType::UInt8;
-
-              bool ret = srgb_8bit_to_linear_8bit(
-                  assetImageBuffer.data, width, height, channels,
-                  /* channel stride */ channels, &imageBuffer.data, &_err);
-              if (!ret) {
-                PUSH_ERROR_AND_RETURN(
-                    "Failed to convert sRGB u8 image to Linear u8 image.");
-              }
-
-            } else {
-              DCOUT("u8 sRGB -> fp32 linear.");
-              // u8 sRGB -> fp32 Linear
-              imageBuffer.componentType = tydra::ComponentType::Float;
-
-              std::vector<float> buf;
-              bool ret = srgb_8bit_to_linear_f32(
-                  assetImageBuffer.data, width, height, channels,
-                  /* channel stride */ channels, &buf, &_err);
-              if (!ret) {
-                PUSH_ERROR_AND_RETURN(
-                    "Failed to convert sRGB u8 image to Linear f32 image.");
-              }
-
-              DCOUT("sz = " << buf.size());
-              imageBuffer.data.resize(buf.size() * sizeof(float));
-              memcpy(imageBuffer.data.data(), buf.data(),
-                     sizeof(float) * buf.size());
-            }
-
-            texImage.colorSpace = tydra::ColorSpace::Lin_sRGB;
-
-          } else if (texImage.usdColorSpace == tydra::ColorSpace::Lin_sRGB) {
-            if (env.material_config.preserve_texel_bitdepth) {
-              // no op.
-              imageBuffer = std::move(assetImageBuffer);
-
-            } else {
-              // u8 -> fp32
-              imageBuffer.componentType = tydra::ComponentType::Float;
-
-              std::vector<float> buf;
-              bool ret = u8_to_f32_image(assetImageBuffer.data, width, height,
-                                         channels, &buf, &_err);
-              if (!ret) {
-                PUSH_ERROR_AND_RETURN("Failed to convert u8 image to f32 image.");
-              }
-
-              imageBuffer.data.resize(buf.size() * sizeof(float));
-              memcpy(imageBuffer.data.data(), buf.data(),
-                     sizeof(float) * buf.size());
-            }
-
-            texImage.colorSpace = tydra::ColorSpace::Lin_sRGB;
-
-          } else {
-            PUSH_ERROR(fmt::format("TODO: Color space {}",
-                                   to_string(texImage.usdColorSpace)));
-          }
-
-        } else if (assetImageBuffer.componentType ==
-                   tydra::ComponentType::Float) {
-          // ignore preserve_texel_bitdepth
-
-          if (texImage.usdColorSpace == tydra::ColorSpace::sRGB) {
-            // srgb f32 -> linear f32
-            std::vector<float> in_buf;
-            std::vector<float> out_buf;
-            in_buf.resize(assetImageBuffer.data.size() / sizeof(float));
-            memcpy(in_buf.data(), assetImageBuffer.data.data(),
-                   in_buf.size() * sizeof(float));
-
-            out_buf.resize(assetImageBuffer.data.size() / sizeof(float));
-
-            // TODO: scale factor & bias
-            float scale_factor = 1.0f;
-            float bias = 0.0f;
-            float alpha_scale_factor = 1.0f;
-            float alpha_bias = 0.0f;
-
-            bool ret =
-                srgb_f32_to_linear_f32(in_buf, width, height, channels,
-                                       /* channel stride */ channels, &out_buf, scale_factor, bias, alpha_scale_factor, alpha_bias, &_err);
-
-            if (!ret) {
-              PUSH_ERROR_AND_RETURN(
-                  "Failed to convert sRGB f32 image to Linear f32 image.");
-            }
-
-            imageBuffer.data.resize(assetImageBuffer.data.size());
-            memcpy(imageBuffer.data.data(), out_buf.data(),
-                   imageBuffer.data.size());
-
-
-          } else if (texImage.usdColorSpace == tydra::ColorSpace::Lin_sRGB) {
-            // no op
-            imageBuffer = std::move(assetImageBuffer);
-
-          } else {
-            PUSH_ERROR(fmt::format("TODO: Color space {}",
-                                   to_string(texImage.usdColorSpace)));
-          }
-
-        } else {
-          PUSH_ERROR(fmt::format("TODO: asset texture texel format {}",
-                                 to_string(assetImageBuffer.componentType)));
-        }
-
-      } else {
-        // Same color space.
-        DCOUT("assetImageBuffer.sz = " << assetImageBuffer.data.size());
-
-        if (assetImageBuffer.componentType == tydra::ComponentType::UInt8) {
-          if (env.material_config.preserve_texel_bitdepth) {
-            // Do nothing.
-            imageBuffer = std::move(assetImageBuffer);
-
-          } else {
-            size_t width = size_t(texImage.width);
-            size_t height = size_t(texImage.height);
-            size_t channels = size_t(texImage.channels);
-
-            // u8 to f32, but no sRGB -> linear conversion(this would break
-            // UsdPreviewSurface's spec though)
-            PUSH_WARN(
-                "8bit sRGB texture is converted to fp32 sRGB texture(without "
-                "linearlization)");
-            std::vector<float> buf;
-            bool ret = u8_to_f32_image(assetImageBuffer.data, width, height,
-                                       channels, &buf, &_err);
-            if (!ret) {
-              PUSH_ERROR_AND_RETURN("Failed to convert u8 image to f32 image.");
-            }
-            imageBuffer.componentType = tydra::ComponentType::Float;
-
-            imageBuffer.data.resize(buf.size() * sizeof(float));
-            memcpy(imageBuffer.data.data(), buf.data(),
-                   sizeof(float) * buf.size());
-          }
-
-          texImage.colorSpace = texImage.usdColorSpace;
-
-        } else if (assetImageBuffer.componentType ==
-                   tydra::ComponentType::Float) {
-          // ignore preserve_texel_bitdepth
-
-          // f32 to f32, so no op
-          imageBuffer = std::move(assetImageBuffer);
-
-        } else {
-          PUSH_ERROR(fmt::format("TODO: asset texture texel format {}",
-                                 to_string(assetImageBuffer.componentType)));
-        }
+      if (!BuildTextureImageImpl(env, assetPath, texImage, assetImageBuffer,
+                                 &tex.texture_image_id)) {
+        return false;
       }
-
-      // Assign buffer id
-      texImage.buffer_id = int64_t(buffers.size());
-
-      // TODO: Share image data as much as possible.
-      // e.g. Texture A and B uses same image file, but texturing parameter is
-      // different.
-      buffers.emplace_back(imageBuffer);
-
-      tex.texture_image_id = int64_t(images.size());
-
-      images.emplace_back(texImage);
-
-      std::stringstream ss;
-      ss << "Loaded texture image " << assetPath.GetAssetPath()
-         << " : buffer_id " + std::to_string(texImage.buffer_id) << "\n";
-      ss << "  width x height x components " << texImage.width << " x "
-         << texImage.height << " x " << texImage.channels << "\n";
-      ss << "  colorSpace " << tinyusdz::tydra::to_string(texImage.colorSpace)
-         << "\n";
-      PushInfo(ss.str());
     }
   }
 
@@ -5053,11 +5432,69 @@ bool RenderSceneConverter::ConvertMaterial(const RenderSceneConverterEnv &env,
 
 namespace {
 
+// GeomMesh conversion deferred to the parallel mesh conversion phase.
+struct MeshConvertTask {
+  Path abs_path;
+  const GeomMesh *mesh{nullptr};
+  MaterialPath material_path;
+  std::map<std::string, MaterialPath> subset_material_path_map;
+  std::vector<const GeomSubset *> material_subsets;
+  std::vector<std::pair<std::string, const BlendShape *>> blendshapes;
+
+  // The number of materials converted before this mesh in traversal order.
+  size_t num_materials{0};
+
+  // Position in the converter's warning message at the time of the traversal.
+  size_t warn_pos{0};
+};
+
 struct MeshVisitorEnv {
   RenderSceneConverter *converter{nullptr};
   const RenderSceneConverterEnv *env{nullptr};
+
+  // When non-null, GeomMesh conversion is deferred and collected to `tasks`.
+  std::vector<MeshConvertTask> *tasks{nullptr};
+
+  // Converted GeomMesh with time-varying attributes(mesh id and arguments of
+  // ConvertMesh).
+  std::vector<std::pair<uint64_t, MeshConvertTask>> *time_varying_meshes{
+      nullptr};
 };
 
+template <typename T>
+bool HasTimeSamples(const TypedAttribute<Animatable<T>> &attr) {
+  const nonstd::optional<Animatable<T>> v = attr.get_value();
+  return v && v.value().has_timesamples();
+}
+
+// Check if GeomMesh has timeSampled attributes(including primvars).
+bool IsTimeVaryingMesh(const GeomMesh &mesh) {
+  if (HasTimeSamples(mesh.points) || HasTimeSamples(mesh.normals) ||
+      HasTimeSamples(mesh.faceVertexCounts) ||
+      HasTimeSamples(mesh.faceVertexIndices)) {
+    return true;
+  }
+
+  for (const auto &it : mesh.props) {
+    if (it.second.is_attribute() &&
+        it.second.get_attribute().has_timesamples()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Check if Prim has timeSampled xformOps.
+bool IsTimeVaryingXform(const Prim &prim) {
+  const Xformable *xformable{nullptr};
+  if (!CastToXformable(prim, &xformable) || !xformable) {
+    return false;
+  }
+
+  return xformable->has_timesampled_xformOps();
+}
+
 bool MeshVisitor(const tinyusdz::Path &abs_path, const tinyusdz::Prim &prim,
                  const int32_t level, void *userdata, std::string *err) {
   if (!userdata) {
@@ -5321,6 +5758,22 @@ bool MeshVisitor(const tinyusdz::Path &abs_path, const tinyusdz::Prim &prim,
       }
       DCOUT("# of blendshapes : " << blendshapes.size());
 
+      if (visitorEnv->tasks) {
+        MeshConvertTask task;
+        task.abs_path = abs_path;
+        task.mesh = pmesh;
+        task.material_path = material_path;
+        task.subset_material_path_map = std::move(subset_material_path_map);
+        task.material_subsets = std::move(material_subsets);
+        task.blendshapes = std::move(blendshapes);
+        task.num_materials = visitorEnv->converter->materials.size();
+        task.warn_pos = visitorEnv->converter->GetWarning().size();
+        visitorEnv->tasks->emplace_back(std::move(task));
+        return true;
+      }
+
+      const size_t num_materials = visitorEnv->converter->materials.size();
+
       RenderMesh rmesh;
 
       if (!visitorEnv->converter->ConvertMesh(
@@ -5346,6 +5799,18 @@ bool MeshVisitor(const tinyusdz::Path &abs_path, const tinyusdz::Prim &prim,
       visitorEnv->converter->meshMap.add(abs_path.full_path_name(), mesh_id);
 
       visitorEnv->converter->meshes.emplace_back(std::move(rmesh));
+
+      if (visitorEnv->time_varying_meshes && IsTimeVaryingMesh(*pmesh)) {
+        MeshConvertTask task;
+        task.abs_path = abs_path;
+        task.mesh = pmesh;
+        task.material_path = material_path;
+        task.subset_material_path_map = std::move(subset_material_path_map);
+        task.material_subsets = std::move(material_subsets);
+        task.blendshapes = std::move(blendshapes);
+        task.num_materials = num_materials;
+        visitorEnv->time_varying_meshes->emplace_back(mesh_id, std::move(task));
+      }
     }
   }
 
@@ -5443,21 +5908,24 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
       DCOUT("Convert ttranslations");
       const TypedTimeSamples<std::vector<value::float3>> &ts_txs = translations.get_timesamples();
 
-      if (ts_txs.get_samples().empty()) {
+      if (ts_txs.empty()) {
         PUSH_ERROR_AND_RETURN(fmt::format("`translations` timeSamples in SkelAnimation is empty : {}", abs_path));
       }
 
-      for (const auto &sample : ts_txs.get_samples()) {
-        if (!sample.blocked) {
+      for (size_t i = 0; i < ts_txs.size(); i++) {
+        if (!ts_txs.is_blocked(i)) {
+          const double sample_t = ts_txs.get_times()[i];
+          const std::vector<value::float3> &sample_value = ts_txs.get_values()[i];
+
           // length check
-          if (sample.value.size() != joints.size()) {
-            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} translations.size {} must be equal to joints.size {} : {}", sample.t, sample.value.size(), joints.size(), abs_path));
+          if (sample_value.size() != joints.size()) {
+            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} translations.size {} must be equal to joints.size {} : {}", sample_t, sample_value.size(), joints.size(), abs_path));
           }
 
-          for (size_t j = 0; j < sample.value.size(); j++) {
+          for (size_t j = 0; j < sample_value.size(); j++) {
             AnimationSample<value::float3> s;
-            s.t = float(sample.t);
-            s.value = sample.value[j];
+            s.t = float(sample_t);
+            s.value = sample_value[j];
 
             std::string jointName = jointIdMap.at(j);
             auto &it = channelMap[jointName][AnimationChannel::ChannelType::Translation];
@@ -5474,18 +5942,21 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
     if (rotations.has_timesamples()) {
       const TypedTimeSamples<std::vector<value::quatf>> &ts_rots = rotations.get_timesamples();
       DCOUT("Convert rotations");
-      for (const auto &sample : ts_rots.get_samples()) {
-        if (!sample.blocked) {
-          if (sample.value.size() != joints.size()) {
-            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} rotations.size {} must be equal to joints.size {} : {}", sample.t, sample.value.size(), joints.size(), abs_path));
+      for (size_t i = 0; i < ts_rots.size(); i++) {
+        if (!ts_rots.is_blocked(i)) {
+          const double sample_t = ts_rots.get_times()[i];
+          const std::vector<value::quatf> &sample_value = ts_rots.get_values()[i];
+
+          if (sample_value.size() != joints.size()) {
+            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} rotations.size {} must be equal to joints.size {} : {}", sample_t, sample_value.size(), joints.size(), abs_path));
           }
-          for (size_t j = 0; j < sample.value.size(); j++) {
+          for (size_t j = 0; j < sample_value.size(); j++) {
             AnimationSample<value::float4> s;
-            s.t = float(sample.t);
-            s.value[0] = sample.value[j][0];
-            s.value[1] = sample.value[j][1];
-            s.value[2] = sample.value[j][2];
-            s.value[3] = sample.value[j][3];
+            s.t = float(sample_t);
+            s.value[0] = sample_value[j][0];
+            s.value[1] = sample_value[j][1];
+            s.value[2] = sample_value[j][2];
+            s.value[3] = sample_value[j][3];
 
             std::string jointName = jointIdMap.at(j);
             auto &it = channelMap[jointName][AnimationChannel::ChannelType::Rotation];
@@ -5502,18 +5973,21 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
     if (scales.has_timesamples()) {
       const TypedTimeSamples<std::vector<value::half3>> &ts_scales = scales.get_timesamples();
       DCOUT("Convert scales");
-      for (const auto &sample : ts_scales.get_samples()) {
-        if (!sample.blocked) {
-          if (sample.value.size() != joints.size()) {
-            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} scales.size {} must be equal to joints.size {} : {}", sample.t, sample.value.size(), joints.size(), abs_path));
+      for (size_t i = 0; i < ts_scales.size(); i++) {
+        if (!ts_scales.is_blocked(i)) {
+          const double sample_t = ts_scales.get_times()[i];
+          const std::vector<value::half3> &sample_value = ts_scales.get_values()[i];
+
+          if (sample_value.size() != joints.size()) {
+            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} scales.size {} must be equal to joints.size {} : {}", sample_t, sample_value.size(), joints.size(), abs_path));
           }
 
-          for (size_t j = 0; j < sample.value.size(); j++) {
+          for (size_t j = 0; j < sample_value.size(); j++) {
             AnimationSample<value::float3> s;
-            s.t = float(sample.t);
-            s.value[0] = value::half_to_float(sample.value[j][0]);
-            s.value[1] = value::half_to_float(sample.value[j][1]);
-            s.value[2] = value::half_to_float(sample.value[j][2]);
+            s.t = float(sample_t);
+            s.value[0] = value::half_to_float(sample_value[j][0]);
+            s.value[1] = value::half_to_float(sample_value[j][1]);
+            s.value[2] = value::half_to_float(sample_value[j][2]);
 
             std::string jointName = jointIdMap.at(j);
             auto &it = channelMap[jointName][AnimationChannel::ChannelType::Scale];
@@ -5673,16 +6147,19 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
 
         const TypedTimeSamples<std::vector<float>> &ts_weights = weights.get_timesamples();
         DCOUT("Convert timeSampledd weights");
-        for (const auto &sample : ts_weights.get_samples()) {
-          if (!sample.blocked) {
-            if (sample.value.size() != blendShapes.size()) {
-              PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} blendShapeWeights.size {} must be equal to blendShapes.size {} : {}", sample.t, sample.value.size(), blendShapes.size(), abs_path));
+        for (size_t i = 0; i < ts_weights.size(); i++) {
+          if (!ts_weights.is_blocked(i)) {
+            const double sample_t = ts_weights.get_times()[i];
+            const std::vector<float> &sample_value = ts_weights.get_values()[i];
+
+            if (sample_value.size() != blendShapes.size()) {
+              PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} blendShapeWeights.size {} must be equal to blendShapes.size {} : {}", sample_t, sample_value.size(), blendShapes.size(), abs_path));
             }
 
-            for (size_t j = 0; j < sample.value.size(); j++) {
+            for (size_t j = 0; j < sample_value.size(); j++) {
               AnimationSample<float> s;
-              s.t = float(sample.t);
-              s.value = sample.value[j];
+              s.t = float(sample_t);
+              s.value = sample_value[j];
 
               const std::string &targetName = blendShapes[j].str();
               weightsMap[targetName].samples.push_back(s);
@@ -5738,6 +6215,10 @@ bool RenderSceneConverter::BuildNodeHierarchyImpl(
 
   const tinyusdz::Prim *prim = node.prim;
   if (prim) {
+    if (IsTimeVaryingXform(*prim)) {
+      _has_time_varying_xforms = true;
+    }
+
     rnode.prim_name = prim->element_name();
     rnode.abs_path = primPath;
     rnode.display_name = prim->metas().displayName.value_or("");
@@ -5873,7 +6354,8 @@ bool RenderSceneConverter::ConvertToRenderScene(
   //    Each Prim in Stage is converted to XformNode.
   //
   XformNode xform_node;
-  if (!BuildXformNodeFromStage(env.stage, &xform_node, env.timecode)) {
+  if (!BuildXformNodeFromStage(env.stage, &xform_node, env.timecode,
+                               env.tinterp)) {
     PUSH_ERROR_AND_RETURN("Failed to build Xform node hierarchy.\n");
   }
 
@@ -5886,16 +6368,182 @@ bool RenderSceneConverter::ConvertToRenderScene(
   //
   // Material conversion will be done in MeshVisitor.
   //
+  // When `num_texture_load_threads` != 1, texture image loads are queued in
+  // the traversal and run in background while converting meshes.
+  const bool deferred_texture_loading =
+      env.scene_config.load_texture_assets &&
+      (env.scene_config.num_texture_load_threads != 1) &&
+      thread_util::IsThreadingAvailable();
+
+  // When `num_threads` != 1, GeomMesh prims are collected in the traversal
+  // and converted in parallel after that.
+  const bool deferred_mesh_conversion =
+      ((env.scene_config.num_threads != 1) || deferred_texture_loading) &&
+      thread_util::IsThreadingAvailable();
+
+  std::vector<MeshConvertTask> mesh_tasks;
+  std::vector<std::pair<uint64_t, MeshConvertTask>> time_varying_meshes;
+
   MeshVisitorEnv menv;
   menv.env = &env;
   menv.converter = this;
+  menv.time_varying_meshes = &time_varying_meshes;
+  if (deferred_mesh_conversion) {
+    menv.tasks = &mesh_tasks;
+  }
 
+  _time_varying_meshes.clear();
+  _has_time_varying_xforms = false;
+
+  _texture_load_jobs.clear();
+  _texture_load_job_map.clear();
+  _deferred_texture_images.clear();
+
+  _defer_texture_loading = deferred_texture_loading;
   bool ret = tydra::VisitPrims(env.stage, MeshVisitor, &menv, &err);
+  _defer_texture_loading = false;
 
   if (!ret) {
     PUSH_ERROR_AND_RETURN(err);
   }
 
+  // Joined at the end of this scope at the latest.
+  thread_util::BackgroundTask texture_loader;
+  if (_texture_load_jobs.size()) {
+    texture_loader.Start([&env, this]() {
+      TextureImageLoaderFunction tex_loader_fun =
+          env.material_config.texture_image_loader_function;
+
+      if (!tex_loader_fun) {
+        tex_loader_fun = DefaultTextureImageLoaderFunction;
+      }
+
+      thread_util::ParallelFor(
+          0, _texture_load_jobs.size(),
+          env.scene_config.num_texture_load_threads, [&](size_t i) {
+            TextureLoadJob &job = _texture_load_jobs[i];
+            DCOUT("load texture : " << job.assetPath.GetAssetPath());
+            job.loaded = tex_loader_fun(
+                job.assetPath, job.assetInfo, env.asset_resolver,
+                &job.texImage, &job.imageData,
+                env.material_config.texture_image_loader_function_userdata,
+                &job.warn, &job.err);
+          });
+    });
+  }
+
+  if (deferred_mesh_conversion) {
+    struct MeshConvertResult {
+      RenderMesh mesh;
+      std::string warn;
+      std::string err;
+      bool ok{false};
+    };
+
+    std::vector<MeshConvertResult> results(mesh_tasks.size());
+
+    // Skinned mesh appends to `skeletons` and `animations`, and Skeleton prim
+    // can be shared among meshes, so convert it serially in traversal order.
+    std::vector<size_t> parallel_task_ids;
+    for (size_t i = 0; i < mesh_tasks.size(); i++) {
+      const MeshConvertTask &task = mesh_tasks[i];
+      if (!task.mesh->skeleton.has_value()) {
+        parallel_task_ids.push_back(i);
+        continue;
+      }
+
+      MeshConvertResult &result = results[i];
+      std::swap(_warn, result.warn);
+      std::swap(_err, result.err);
+      _num_visible_materials = task.num_materials;
+
+      result.ok = ConvertMesh(env, task.abs_path, *task.mesh,
+                              task.material_path, task.subset_material_path_map,
+                              materialMap, task.material_subsets,
+                              task.blendshapes, &result.mesh);
+
+      _num_visible_materials = (std::numeric_limits<size_t>::max)();
+      std::swap(_warn, result.warn);
+      std::swap(_err, result.err);
+    }
+
+    thread_util::ParallelFor(
+        0, parallel_task_ids.size(), env.scene_config.num_threads,
+        [&](size_t k) {
+          const MeshConvertTask &task = mesh_tasks[parallel_task_ids[k]];
+          MeshConvertResult &result = results[parallel_task_ids[k]];
+
+          RenderSceneConverter worker;
+          worker._material_source = this;
+          worker._num_visible_materials = task.num_materials;
+
+          result.ok = worker.ConvertMesh(
+              env, task.abs_path, *task.mesh, task.material_path,
+              task.subset_material_path_map, materialMap,
+              task.material_subsets, task.blendshapes, &result.mesh);
+
+          result.warn = std::move(worker._warn);
+          result.err = std::move(worker._err);
+        });
+
+    // Merge results in traversal order, so that mesh ids and messages are
+    // identical to the serial conversion.
+    std::string warn;
+    size_t warn_pos = 0;
+    for (size_t i = 0; i < mesh_tasks.size(); i++) {
+      const MeshConvertTask &task = mesh_tasks[i];
+      MeshConvertResult &result = results[i];
+
+      warn += _warn.substr(warn_pos, task.warn_pos - warn_pos);
+      warn_pos = task.warn_pos;
+      warn += result.warn;
+
+      if (!result.ok) {
+        _warn = std::move(warn);
+        _err += result.err;
+        err += fmt::format("Mesh conversion failed: {}",
+                           task.abs_path.full_path_name());
+        err += "\n" + _err + "\n";
+        PUSH_ERROR_AND_RETURN(err);
+      }
+
+      uint64_t mesh_id = uint64_t(meshes.size());
+      if (mesh_id >= size_t((std::numeric_limits<int32_t>::max)())) {
+        _warn = std::move(warn);
+        err += "Mesh index too large.\n";
+        PUSH_ERROR_AND_RETURN(err);
+      }
+      meshMap.add(task.abs_path.full_path_name(), mesh_id);
+
+      meshes.emplace_back(std::move(result.mesh));
+
+      if (IsTimeVaryingMesh(*task.mesh)) {
+        time_varying_meshes.emplace_back(mesh_id, task);
+      }
+    }
+    warn += _warn.substr(warn_pos);
+    _warn = std::move(warn);
+  }
+
+  texture_loader.Join();
+  if (!ResolveDeferredTextureImages(env)) {
+    return false;
+  }
+
+  for (auto &it : time_varying_meshes) {
+    TimeVaryingMesh tmesh;
+    tmesh.mesh_id = it.first;
+    tmesh.abs_path = it.second.abs_path;
+    tmesh.mesh = it.second.mesh;
+    tmesh.material_path = it.second.material_path;
+    tmesh.subset_material_path_map =
+        std::move(it.second.subset_material_path_map);
+    tmesh.material_subsets = std::move(it.second.material_subsets);
+    tmesh.blendshapes = std::move(it.second.blendshapes);
+    tmesh.num_materials = it.second.num_materials;
+    _time_varying_meshes.emplace_back(std::move(tmesh));
+  }
+
   //
   // 5. Build node hierarchy from XformNode and meshes, materials, skeletons,
   // etc.
@@ -5933,6 +6581,323 @@ bool RenderSceneConverter::ConvertToRenderScene(
   return true;
 }
 
+namespace {
+
+bool IsSameMatrix(const value::matrix4d &a, const value::matrix4d &b) {
+  return memcmp(&a.m[0][0], &b.m[0][0], sizeof(double) * 16) == 0;
+}
+
+// Update transform of Node and its children at `env.timecode`.
+// Node hierarchy is identical to Prim hierarchy(See BuildNodeHierarchyImpl).
+// Returns false when Node hierarchy does not match with Prim hierarchy.
+bool UpdateNodeTransformRec(const RenderSceneConverterEnv &env,
+                            const Prim &prim,
+                            const value::matrix4d &parent_matrix,
+                            const bool parent_changed, Node &node,
+                            std::vector<std::string> *dirty_nodes) {
+  bool local_changed = false;
+  if (IsTimeVaryingXform(prim)) {
+    bool resetXformStack{false};
+    value::matrix4d local_matrix =
+        GetLocalTransform(prim, &resetXformStack, env.timecode, env.tinterp);
+    if (!IsSameMatrix(local_matrix, node.local_matrix)) {
+      node.local_matrix = local_matrix;
+      local_changed = true;
+    }
+  }
+
+  bool changed = local_changed;
+  if (local_changed || parent_changed) {
+    // matrix is row-major, so local first
+    value::matrix4d global_matrix = node.has_resetXform
+                                        ? node.local_matrix
+                                        : node.local_matrix * parent_matrix;
+    if (!IsSameMatrix(global_matrix, node.global_matrix)) {
+      node.global_matrix = global_matrix;
+      changed = true;
+    }
+  }
+
+  if (changed && dirty_nodes) {
+    dirty_nodes->push_back(node.abs_path);
+  }
+
+  if (prim.children().size() != node.children.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < node.children.size(); i++) {
+    if (!UpdateNodeTransformRec(env, prim.children()[i], node.global_matrix,
+                                changed, node.children[i], dirty_nodes)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IsSameVertexLayout(const VertexAttribute &a, const VertexAttribute &b) {
+  return (a.format == b.format) && (a.elementSize == b.elementSize) &&
+         (a.stride == b.stride) && (a.variability == b.variability) &&
+         (a.data.size() == b.data.size()) && (a.indices == b.indices);
+}
+
+// Check if RenderMesh can be updated by copying vertex data.
+bool IsSameMeshLayout(const RenderMesh &a, const RenderMesh &b) {
+  if ((a.points.size() != b.points.size()) ||
+      (a.usdFaceVertexCounts != b.usdFaceVertexCounts) ||
+      (a.usdFaceVertexIndices != b.usdFaceVertexIndices) ||
+      (a.triangulatedFaceVertexCounts != b.triangulatedFaceVertexCounts) ||
+      (a.triangulatedFaceVertexIndices != b.triangulatedFaceVertexIndices)) {
+    return false;
+  }
+
+  if (!IsSameVertexLayout(a.normals, b.normals) ||
+      !IsSameVertexLayout(a.tangents, b.tangents) ||
+      !IsSameVertexLayout(a.binormals, b.binormals) ||
+      !IsSameVertexLayout(a.vertex_colors, b.vertex_colors) ||
+      !IsSameVertexLayout(a.vertex_opacities, b.vertex_opacities)) {
+    return false;
+  }
+
+  if (a.texcoords.size() != b.texcoords.size()) {
+    return false;
+  }
+  for (const auto &it : a.texcoords) {
+    auto bit = b.texcoords.find(it.first);
+    if ((bit == b.texcoords.end()) ||
+        !IsSameVertexLayout(it.second, bit->second)) {
+      return false;
+    }
+  }
+
+  if ((a.joint_and_weights.elementSize != b.joint_and_weights.elementSize) ||
+      (a.joint_and_weights.jointIndices != b.joint_and_weights.jointIndices) ||
+      (a.joint_and_weights.jointWeights != b.joint_and_weights.jointWeights)) {
+    return false;
+  }
+
+  return (a.material_id == b.material_id) &&
+         (a.backface_material_id == b.backface_material_id) &&
+         (a.skel_id == b.skel_id) && (a.doubleSided == b.doubleSided) &&
+         (a.is_rightHanded == b.is_rightHanded);
+}
+
+// Copy changed bytes of `src` to `dst`(same size) and report the range.
+// The range is aligned to `stride` bytes.
+void PatchBytes(const std::string &name, const uint8_t *src, uint8_t *dst,
+                const size_t nbytes, const size_t stride,
+                RenderMeshUpdate *update) {
+  size_t first = 0;
+  while ((first < nbytes) && (src[first] == dst[first])) {
+    first++;
+  }
+  if (first == nbytes) {
+    return;
+  }
+
+  size_t last = nbytes;
+  while (src[last - 1] == dst[last - 1]) {
+    last--;
+  }
+
+  if (stride > 1) {
+    first = (first / stride) * stride;
+    last = (std::min)(nbytes, ((last + stride - 1) / stride) * stride);
+  }
+
+  memcpy(dst + first, src + first, last - first);
+
+  DirtyRange range;
+  range.offset = first;
+  range.length = last - first;
+  update->dirty_ranges[name] = range;
+}
+
+void PatchVertexAttribute(const std::string &name, const VertexAttribute &src,
+                          VertexAttribute &dst, RenderMeshUpdate *update) {
+  PatchBytes(name, src.data.data(), dst.data.data(), dst.data.size(),
+             dst.stride_bytes(), update);
+}
+
+// Update `dst` with `src`(RenderMesh converted at another timecode).
+void PatchRenderMesh(RenderMesh &&src, RenderMesh &dst,
+                     RenderMeshUpdate *update) {
+  if (!IsSameMeshLayout(src, dst)) {
+    src.handle = dst.handle;
+    dst = std::move(src);
+    update->topology_changed = true;
+    return;
+  }
+
+  PatchBytes("points", reinterpret_cast<const uint8_t *>(src.points.data()),
+             reinterpret_cast<uint8_t *>(dst.points.data()),
+             dst.points.size() * sizeof(vec3), sizeof(vec3), update);
+  PatchVertexAttribute("normals", src.normals, dst.normals, update);
+  PatchVertexAttribute("tangents", src.tangents, dst.tangents, update);
+  PatchVertexAttribute("binormals", src.binormals, dst.binormals, update);
+  for (auto &it : dst.texcoords) {
+    PatchVertexAttribute("texcoord" + std::to_string(it.first),
+                         src.texcoords.at(it.first), it.second, update);
+  }
+  PatchVertexAttribute("colors", src.vertex_colors, dst.vertex_colors,
+                       update);
+  PatchVertexAttribute("opacities", src.vertex_opacities,
+                       dst.vertex_opacities, update);
+
+  PatchBytes("displayColor",
+             reinterpret_cast<const uint8_t *>(&src.displayColor),
+             reinterpret_cast<uint8_t *>(&dst.displayColor),
+             sizeof(value::color3f), sizeof(value::color3f), update);
+  PatchBytes("displayOpacity",
+             reinterpret_cast<const uint8_t *>(&src.displayOpacity),
+             reinterpret_cast<uint8_t *>(&dst.displayOpacity), sizeof(float),
+             sizeof(float), update);
+}
+
+}  // namespace
+
+bool RenderSceneConverter::UpdateRenderScene(
+    const RenderSceneConverterEnv &env, double t, RenderScene *scene,
+    RenderSceneUpdateInfo *update_info) {
+  if (!scene) {
+    PUSH_ERROR_AND_RETURN("nullptr for RenderScene argument.");
+  }
+
+  RenderSceneConverterEnv tenv(env);
+  tenv.timecode = t;
+
+  RenderSceneUpdateInfo info;
+
+  //
+  // 1. Update Node transforms.
+  //
+  if (_has_time_varying_xforms) {
+    const std::vector<Prim> &root_prims = env.stage.root_prims();
+    if (root_prims.size() != scene->nodes.size()) {
+      PUSH_ERROR_AND_RETURN(
+          "Node hierarchy does not match with Stage. Stage or RenderScene "
+          "was modified after the conversion?");
+    }
+
+    for (size_t i = 0; i < root_prims.size(); i++) {
+      if (!UpdateNodeTransformRec(tenv, root_prims[i],
+                                  value::matrix4d::identity(),
+                                  /* parent_changed */ false, scene->nodes[i],
+                                  &info.nodes)) {
+        PUSH_ERROR_AND_RETURN(
+            "Node hierarchy does not match with Stage. Stage or RenderScene "
+            "was modified after the conversion?");
+      }
+    }
+  }
+
+  //
+  // 2. Convert time-varying meshes again and patch RenderMesh.
+  //
+  if (_time_varying_meshes.size()) {
+    for (const auto &tmesh : _time_varying_meshes) {
+      if (tmesh.mesh_id >= scene->meshes.size()) {
+        PUSH_ERROR_AND_RETURN(
+            fmt::format("Mesh id {} out-of-range. RenderScene was modified "
+                        "after the conversion?",
+                        tmesh.mesh_id));
+      }
+    }
+
+    struct MeshConvertResult {
+      RenderMesh mesh;
+      std::string warn;
+      std::string err;
+      bool ok{false};
+    };
+
+    std::vector<MeshConvertResult> results(_time_varying_meshes.size());
+
+    // ConvertMesh looks up materials/textures/skeletons/animations in this
+    // converter.
+    std::swap(materials, scene->materials);
+    std::swap(textures, scene->textures);
+    std::swap(skeletons, scene->skeletons);
+    std::swap(animations, scene->animations);
+
+    // Skinned mesh is converted serially as done in ConvertToRenderScene.
+    std::vector<size_t> parallel_ids;
+    for (size_t i = 0; i < _time_varying_meshes.size(); i++) {
+      const TimeVaryingMesh &tmesh = _time_varying_meshes[i];
+      if (!tmesh.mesh->skeleton.has_value()) {
+        parallel_ids.push_back(i);
+        continue;
+      }
+
+      MeshConvertResult &result = results[i];
+      std::swap(_warn, result.warn);
+      std::swap(_err, result.err);
+      _num_visible_materials = tmesh.num_materials;
+
+      result.ok = ConvertMesh(tenv, tmesh.abs_path, *tmesh.mesh,
+                              tmesh.material_path,
+                              tmesh.subset_material_path_map, materialMap,
+                              tmesh.material_subsets, tmesh.blendshapes,
+                              &result.mesh);
+
+      _num_visible_materials = (std::numeric_limits<size_t>::max)();
+      std::swap(_warn, result.warn);
+      std::swap(_err, result.err);
+    }
+
+    thread_util::ParallelFor(
+        0, parallel_ids.size(), env.scene_config.num_threads, [&](size_t k) {
+          const TimeVaryingMesh &tmesh = _time_varying_meshes[parallel_ids[k]];
+          MeshConvertResult &result = results[parallel_ids[k]];
+
+          RenderSceneConverter worker;
+          worker._material_source = this;
+          worker._num_visible_materials = tmesh.num_materials;
+
+          result.ok = worker.ConvertMesh(
+              tenv, tmesh.abs_path, *tmesh.mesh, tmesh.material_path,
+              tmesh.subset_material_path_map, materialMap,
+              tmesh.material_subsets, tmesh.blendshapes, &result.mesh);
+
+          result.warn = std::move(worker._warn);
+          result.err = std::move(worker._err);
+        });
+
+    std::swap(materials, scene->materials);
+    std::swap(textures, scene->textures);
+    std::swap(skeletons, scene->skeletons);
+    std::swap(animations, scene->animations);
+
+    for (size_t i = 0; i < _time_varying_meshes.size(); i++) {
+      const TimeVaryingMesh &tmesh = _time_varying_meshes[i];
+      MeshConvertResult &result = results[i];
+
+      _warn += result.warn;
+      if (!result.ok) {
+        _err += result.err;
+        PUSH_ERROR_AND_RETURN(fmt::format("Mesh conversion failed: {}",
+                                          tmesh.abs_path.full_path_name()));
+      }
+
+      RenderMeshUpdate update;
+      update.mesh_id = int32_t(tmesh.mesh_id);
+      PatchRenderMesh(std::move(result.mesh),
+                      scene->meshes[size_t(tmesh.mesh_id)], &update);
+
+      if (update.topology_changed || update.dirty_ranges.size()) {
+        info.meshes.emplace_back(std::move(update));
+      }
+    }
+  }
+
+  if (update_info) {
+    (*update_info) = std::move(info);
+  }
+
+  return true;
+}
+
 bool RenderSceneConverter::ConvertSkeletonImpl(const RenderSceneConverterEnv &env, const tinyusdz::GeomMesh &mesh,
                        SkelHierarchy *out_skel, nonstd::optional<Animation> *out_anim) {
 
@@ -6075,7 +7040,9 @@ bool DefaultTextureImageLoaderFunction(
   DCOUT("Resolved asset path = " << resolvedPath);
 
   // TODO: user-defined image loader handler.
-  auto result = tinyusdz::image::LoadImageFromMemory(asset.data(), asset.size(),
+  // Use const access so that the asset viewing the USDZ is not copied.
+  const Asset &casset = asset;
+  auto result = tinyusdz::image::LoadImageFromMemory(casset.data(), casset.size(),
                                                      resolvedPath);
   if (!result) {
     if (err) {
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <limits>
 #include <unordered_map>
 
 #include "asset-resolution.hh"
@@ -1226,6 +1228,40 @@ class RenderScene {
 
 };
 
+///
+/// Byte range of updated data. Use it for partial GPU buffer upload.
+///
+struct DirtyRange {
+  size_t offset{0};  // in bytes
+  size_t length{0};  // in bytes
+};
+
+///
+/// Updated RenderMesh in `RenderSceneConverter::UpdateRenderScene`.
+///
+struct RenderMeshUpdate {
+  int32_t mesh_id{-1};  // Index to RenderScene::meshes
+
+  // true: RenderMesh is replaced since its topology or vertex layout(e.g. the
+  // number of vertices after `build_vertex_indices`) has changed.
+  // Re-upload the whole mesh data.
+  bool topology_changed{false};
+
+  // Updated byte range of each attribute data in RenderMesh.
+  // Not filled when `topology_changed` is true.
+  // key: "points", "normals", "tangents", "binormals", "texcoord<slotId>",
+  // "colors", "opacities", "displayColor", "displayOpacity"
+  std::map<std::string, DirtyRange> dirty_ranges;
+};
+
+struct RenderSceneUpdateInfo {
+  std::vector<RenderMeshUpdate> meshes;
+
+  // Absolute prim path of Nodes whose local_matrix or global_matrix has
+  // changed.
+  std::vector<std::string> nodes;
+};
+
 ///
 /// Texture image loader callback
 ///
@@ -1267,6 +1303,15 @@ bool DefaultTextureImageLoaderFunction(const value::AssetPath &assetPath,
 /// TODO: UDIM loder
 ///
 
+enum class TangentFrameMode {
+  Default,         // Average tangent/binormal from UV derivatives of faces.
+  MikkTSpaceLike,  // Follows MikkTSpace conventions(angle weighted, binormal =
+                   // sign * cross(normal, tangent)), but is not the reference
+                   // MikkTSpace implementation: vertex splitting and
+                   // degenerate-face handling differ, so the result may not
+                   // exactly match normal maps baked with MikkTSpace.
+};
+
 struct MeshConverterConfig {
   bool triangulate{true};
 
@@ -1322,7 +1367,24 @@ struct MeshConverterConfig {
   //
   // NOTE: Computing tangent frame for multi-texcoord is not supported.
   //
-  bool compute_tangents_and_binormals{true};
+  // Default false: tangents add two float3 attributes per vertex and may
+  // split vertices, so enable it only when tangent space is required.
+  //
+  bool compute_tangents_and_binormals{false};
+
+  // Tangent frame convention used in `compute_tangents_and_binormals`.
+  TangentFrameMode tangent_frame_mode{TangentFrameMode::Default};
+
+  //
+  // Number of threads used for computations inside a mesh(normals and
+  // tangents). Useful for a few large meshes.
+  // RenderSceneConverterConfig::num_threads is preferred for the scene with
+  // many meshes.
+  // 1 = serial(default). <= 0: Use the number of hardware threads.
+  // The result is identical to the serial computation.
+  // Requires TINYUSDZ_ENABLE_THREAD build.
+  //
+  int num_threads{1};
 
   //
   // Allowed relative error to check if vertex data is the same.
@@ -1330,6 +1392,31 @@ struct MeshConverterConfig {
   // ConvertMesh. Only effective to floating-point vertex data.
   //
   float facevarying_to_vertex_eps = std::numeric_limits<float>::epsilon();
+
+  //
+  // Use open-addressing hash table(PackedVertexIndexTable) to find identical
+  // vertices in `build_vertex_indices`.
+  // false: Use std::unordered_map(slower for large meshes).
+  // The result is identical.
+  //
+  bool use_flat_vertex_hash_table{true};
+
+  //
+  // Weld vertices in `build_vertex_indices`.
+  // Vertices which share the same point and whose attributes are within the
+  // tolerance below are merged into single vertex(attributes of the first
+  // vertex in face-vertex order are used).
+  // false: Merge bitwise-identical vertices only.
+  //
+  // Tolerances are absolute difference per component.
+  // - weld_normal_eps: normal, tangent and binormal
+  // - weld_texcoord_eps: texcoord0 and texcoord1
+  // - weld_color_eps: displayColor and displayOpacity
+  //
+  bool weld_vertices{false};
+  float weld_normal_eps{1e-3f};
+  float weld_texcoord_eps{1e-5f};
+  float weld_color_eps{1e-3f};
 };
 
 struct MaterialConverterConfig {
@@ -1395,6 +1482,26 @@ struct RenderSceneConverterConfig {
   // false: no actual texture file/asset access.
   // App/User must setup TextureImage manually after the conversion.
   bool load_texture_assets{true};
+
+  // Number of threads used for GeomMesh conversion(triangulation, vertex
+  // indices, normals and tangents).
+  // 1 = serial(default). <= 0: Use the number of hardware threads.
+  // The result is identical to the serial conversion.
+  // Requires TINYUSDZ_ENABLE_THREAD build. Otherwise conversion runs serially.
+  int num_threads{1};
+
+  // Number of threads used for texture image loading(asset read and decode).
+  // 1 = load each texture synchronously in material conversion(default).
+  // Otherwise texture loads are queued and deduplicated by resolved asset path,
+  // then decoded in background while GeomMesh conversion runs.
+  // <= 0: Use the number of hardware threads.
+  // TextureImage and its BufferData are shared among UVTextures which refer to
+  // the same asset with the same color space.
+  // `MaterialConverterConfig::texture_image_loader_function` must be
+  // thread-safe when this mode is enabled.
+  // Requires TINYUSDZ_ENABLE_THREAD build. Otherwise textures are loaded
+  // synchronously.
+  int num_texture_load_threads{1};
 };
 
 //
@@ -1405,7 +1512,7 @@ struct RenderSceneConverterConfig {
 // tangent and binormal is included in VertexData, considering the situation
 // that tangent and binormal is supplied through user-defined primvar.
 //
-// TODO: Use spatial hash for robust dedup(consider floating-point eps)
+// See MeshConverterConfig::weld_vertices for dedup with floating-point eps.
 // TODO: Polish interface to support arbitrary vertex configuration.
 //
 struct DefaultPackedVertexData {
@@ -1427,23 +1534,50 @@ struct DefaultPackedVertexData {
   }
 };
 
-struct DefaultPackedVertexDataHasher {
-  inline size_t operator()(const DefaultPackedVertexData &v) const {
-    // Simple hasher using FNV1 32bit
-    // TODO: Use 64bit FNV1?
-    // TODO: Use spatial hash or LSH(LocallySensitiveHash) for position value.
-    static constexpr uint32_t kFNV_Prime = 0x01000193;
-    static constexpr uint32_t kFNV_Offset_Basis = 0x811c9dc5;
+//
+// Word-wise hash of packed vertex data(xxh64/wyhash style mixing).
+// Processes 8 bytes per step instead of FNV1's byte-at-a-time loop.
+//
+inline uint64_t HashPackedVertexBytes(const void *data, size_t n) {
+  static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+  static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+
+  const uint8_t *ptr = reinterpret_cast<const uint8_t *>(data);
+
+  uint64_t h = kPrime1 ^ (uint64_t(n) * kPrime2);
+
+  size_t i = 0;
+  for (; (i + 8) <= n; i += 8) {
+    uint64_t w;
+    memcpy(&w, ptr + i, 8);
+    w *= kPrime2;
+    w = (w << 31) | (w >> 33);
+    h ^= w * kPrime1;
+    h = ((h << 27) | (h >> 37)) * kPrime1 + kPrime2;
+  }
 
-    const uint8_t *ptr = reinterpret_cast<const uint8_t *>(&v);
-    size_t n = sizeof(DefaultPackedVertexData);
+  if (i < n) {
+    uint64_t w{0};
+    memcpy(&w, ptr + i, n - i);
+    w *= kPrime2;
+    w = (w << 31) | (w >> 33);
+    h ^= w * kPrime1;
+  }
 
-    uint32_t hash = kFNV_Offset_Basis;
-    for (size_t i = 0; i < n; i++) {
-      hash = (kFNV_Prime * hash) ^ (ptr[i]);
-    }
+  // avalanche
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= 0x165667B19E3779F9ull;
+  h ^= h >> 32;
+
+  return h;
+}
 
-    return size_t(hash);
+struct DefaultPackedVertexDataHasher {
+  inline size_t operator()(const DefaultPackedVertexData &v) const {
+    // TODO: Use spatial hash or LSH(LocallySensitiveHash) for position value.
+    return size_t(HashPackedVertexBytes(&v, sizeof(DefaultPackedVertexData)));
   }
 };
 
@@ -1540,14 +1674,145 @@ struct DefaultVertexOutput {
   }
 };
 
+//
+// Open-addressing(linear probing) hash table which maps packed vertex data to
+// vertex index. Slots are flat arrays, so no per-entry allocation as in
+// std::unordered_map.
+// The table does not own vertex data. Each slot records the index of the
+// vertex in the caller's VertexInput, and the vertex is fetched from the
+// input only when the full 64bit hash matches.
+// Vertex index must be assigned sequentially from 0.
+//
+template <class VertexInput, class PackedVert, class PackedVertHasher,
+          class PackedVertEqual>
+class PackedVertexIndexTable {
+ public:
+  explicit PackedVertexIndexTable(const VertexInput &input) : _input(input) {}
+
+  ///
+  /// Reserve the table for `n` unique vertices.
+  ///
+  void reserve(size_t n) {
+    size_t cap = 16;
+    while (cap < (n + n / 2)) {
+      cap <<= 1;
+    }
+    if (cap > _slots.size()) {
+      rehash(cap);
+    }
+  }
+
+  size_t size() const { return _size; }
+
+  ///
+  /// Find the vertex index of `v`(= `input[input_index]`). When not found,
+  /// `v` is inserted with the vertex index `size()`.
+  ///
+  /// @return true when `v` already exists in the table.
+  ///
+  bool find_or_insert(size_t input_index, const PackedVert &v,
+                      uint32_t *index) {
+    if (((_size + 1) * 3) > (_slots.size() * 2)) {
+      rehash((std::max)(size_t(16), _slots.size() * 2));
+    }
+
+    // Widen before mixing so that this also works when size_t is 32bit.
+    const uint64_t hash = uint64_t(PackedVertHasher()(v));
+    const size_t mask = _slots.size() - 1;
+
+    size_t pos = size_t(hash) & mask;
+    while (_slots[pos].index != kEmpty) {
+      const Slot &slot = _slots[pos];
+      if (slot.hash == hash) {
+        PackedVert sv;
+        _input.get(slot.input_index, sv);
+        if (PackedVertEqual()(sv, v)) {
+          (*index) = slot.index;
+          return true;
+        }
+      }
+      pos = (pos + 1) & mask;
+    }
+
+    uint32_t new_index = uint32_t(_size);
+    _slots[pos].hash = hash;
+    _slots[pos].index = new_index;
+    _slots[pos].input_index = uint32_t(input_index);
+    _size++;
+
+    (*index) = new_index;
+    return false;
+  }
+
+ private:
+  static constexpr uint32_t kEmpty = ~0u;
+
+  struct Slot {
+    uint64_t hash{0};  // Full hash. Skips most of PackedVertEqual calls and
+                       // lets rehash() run without touching vertex data.
+    uint32_t index{kEmpty};
+    uint32_t input_index{0};  // Index of the vertex in VertexInput.
+  };
+
+  void rehash(size_t cap) {
+    std::vector<Slot> slots(cap);
+    const size_t mask = cap - 1;
+    for (const Slot &slot : _slots) {
+      if (slot.index == kEmpty) {
+        continue;
+      }
+      size_t pos = size_t(slot.hash) & mask;
+      while (slots[pos].index != kEmpty) {
+        pos = (pos + 1) & mask;
+      }
+      slots[pos] = slot;
+    }
+    _slots = std::move(slots);
+  }
+
+  const VertexInput &_input;
+  std::vector<Slot> _slots;
+  size_t _size{0};
+};
+
 //
 // out_vertex_indices_remap: corresponding vertexIndex in input.
+// use_flat_hash_table: Use PackedVertexIndexTable instead of
+// std::unordered_map. The result is identical.
 //
 template <class VertexInput, class VertexOutput, class PackedVert,
           class PackedVertHasher, class PackedVertEqual>
 void BuildIndices(const VertexInput &input, VertexOutput &output,
-                  std::vector<uint32_t> &out_indices, std::vector<uint32_t> &out_point_indices)
+                  std::vector<uint32_t> &out_indices, std::vector<uint32_t> &out_point_indices,
+                  bool use_flat_hash_table = true)
 {
+  out_indices.reserve(out_indices.size() + input.size());
+  out_point_indices.reserve(out_point_indices.size() + input.size());
+
+  if (use_flat_hash_table) {
+    PackedVertexIndexTable<VertexInput, PackedVert, PackedVertHasher,
+                           PackedVertEqual>
+        table(input);
+    table.reserve(input.size());
+
+    const uint32_t index_offset = uint32_t(output.size());
+
+    for (size_t i = 0; i < input.size(); i++) {
+      PackedVert v;
+      input.get(i, v);
+
+      uint32_t index{0};
+      bool found = table.find_or_insert(i, v, &index);
+      if (!found) {
+        output.push_back(v);
+      }
+      out_indices.push_back(index_offset + index);
+      out_point_indices.push_back(v.point_index);
+    }
+
+    return;
+  }
+
   // TODO: Use LSH(locally sensitive hashing) or BVH for kNN point query.
   std::unordered_map<PackedVert, uint32_t, PackedVertHasher, PackedVertEqual>
       vertexToIndexMap;
@@ -1622,6 +1887,34 @@ class RenderSceneConverter {
   ///
   bool ConvertToRenderScene(const RenderSceneConverterEnv &env, RenderScene *scene);
 
+  ///
+  /// Update RenderScene at timecode `t` incrementally.
+  ///
+  /// Only time-varying data found in the last `ConvertToRenderScene` are
+  /// re-evaluated and patched in place:
+  ///
+  /// - xformOps: Node::local_matrix and Node::global_matrix
+  /// - GeomMesh with timeSampled points, normals, topology or primvars:
+  ///   RenderMesh is converted again and its changed data are copied.
+  ///
+  /// Materials and textures are not updated. SkelAnimation and BlendShape
+  /// weights are already converted to `RenderScene::animations` with all
+  /// timeSamples, so they are not re-evaluated.
+  ///
+  /// `scene` must be the one converted by `ConvertToRenderScene` of this
+  /// converter, and Stage must not be modified after the conversion.
+  ///
+  /// @param[in] env Converter env. `env.timecode` is not used.
+  /// @param[in] t Timecode
+  /// @param[inout] scene RenderScene to update
+  /// @param[out] update_info Optional. Updated meshes and nodes.
+  ///
+  /// @return true upon success.
+  ///
+  bool UpdateRenderScene(const RenderSceneConverterEnv &env, double t,
+                         RenderScene *scene,
+                         RenderSceneUpdateInfo *update_info = nullptr);
+
   const std::string &GetInfo() const { return _info; }
   const std::string &GetWarning() const { return _warn; }
   const std::string &GetError() const { return _err; }
@@ -1809,9 +2102,50 @@ class RenderSceneConverter {
   ///
   /// Limitation: Currently we only supports texcoords up to two(primary(0) and secondary(1)).
   ///
+  /// @param[in] config Mesh converter config
   /// @param[inout] mesh
   ///
-  bool BuildVertexIndicesImpl(RenderMesh &mesh);
+  bool BuildVertexIndicesImpl(const MeshConverterConfig &config,
+                              RenderMesh &mesh);
+
+  ///
+  /// Determine the color space of texture image from UsdUVTexture's
+  /// `colorSpace` metadata or `inputs:sourceColorSpace` attribute.
+  ///
+  bool InferTextureImageColorSpaceImpl(const RenderSceneConverterEnv &env,
+                                       const value::AssetPath &assetPath,
+                                       const UsdUVTexture &texture,
+                                       const bool tex_loaded,
+                                       TextureImage &texImage);
+
+  ///
+  /// Convert texel data of the loaded texture image(linearization, widening
+  /// bit depth) and append it to `images` and `buffers`.
+  ///
+  /// @param[out] texture_image_id Index to `images`
+  ///
+  bool BuildTextureImageImpl(const RenderSceneConverterEnv &env,
+                             const value::AssetPath &assetPath,
+                             TextureImage &texImage,
+                             BufferData &assetImageBuffer,
+                             int64_t *texture_image_id);
+
+  ///
+  /// Queue the texture image load of UsdUVTexture. Loads are deduplicated by
+  /// resolved asset path.
+  /// The texture must be appended to `textures` just after this call.
+  ///
+  void DeferTextureImageLoad(const RenderSceneConverterEnv &env,
+                             const value::AssetPath &assetPath,
+                             const AssetInfo &assetInfo,
+                             const UsdUVTexture &texture);
+
+  ///
+  /// Build TextureImage and BufferData from the loaded texture images, and
+  /// assign `texture_image_id` of deferred UVTextures.
+  /// Must be called after all texture image loads finished.
+  ///
+  bool ResolveDeferredTextureImages(const RenderSceneConverterEnv &env);
 
   //
   // Get Skeleton assigned to the GeomMesh Prim and convert it to SkelHierarchy.
@@ -1833,6 +2167,57 @@ class RenderSceneConverter {
   std::string _info;
   std::string _err;
   std::string _warn;
+
+  // Worker converter for parallel mesh conversion reads converted
+  // materials/textures from `_material_source`(parent converter).
+  // Only materials whose id is less than `_num_visible_materials` are
+  // referenced in ConvertMesh, so that the result matches the serial
+  // conversion, where materials are converted along with mesh traversal.
+  const RenderSceneConverter *_material_source{nullptr};
+  size_t _num_visible_materials{(std::numeric_limits<size_t>::max)()};
+
+  // Deferred texture image loading.
+  // See RenderSceneConverterConfig::num_texture_load_threads
+  struct TextureLoadJob {
+    value::AssetPath assetPath;
+    AssetInfo assetInfo;
+
+    // Result of TextureImageLoaderFunction
+    bool loaded{false};
+    TextureImage texImage;
+    std::vector<uint8_t> imageData;
+    std::string warn;
+    std::string err;
+  };
+
+  struct DeferredTextureImage {
+    size_t texture_id{0};  // Index to `textures`
+    size_t job_id{0};      // Index to `_texture_load_jobs`
+    value::AssetPath assetPath;
+    const UsdUVTexture *texture{nullptr};
+  };
+
+  // GeomMesh with time-varying attributes. Converted again in
+  // UpdateRenderScene.
+  struct TimeVaryingMesh {
+    uint64_t mesh_id{0};  // Index to `meshes`
+    Path abs_path;
+    const GeomMesh *mesh{nullptr};
+    MaterialPath material_path;
+    std::map<std::string, MaterialPath> subset_material_path_map;
+    std::vector<const GeomSubset *> material_subsets;
+    std::vector<std::pair<std::string, const BlendShape *>> blendshapes;
+    size_t num_materials{0};  // See `_num_visible_materials`
+  };
+
+  std::vector<TimeVaryingMesh> _time_varying_meshes;
+  bool _has_time_varying_xforms{false};
+
+  bool _defer_texture_loading{false};
+  std::vector<TextureLoadJob> _texture_load_jobs;
+  std::unordered_map<std::string, size_t>
+      _texture_load_job_map;  // resolved asset path -> job id
+  std::vector<DeferredTextureImage> _deferred_texture_images;
 };
 
 // For debug
@@ -36,13 +36,18 @@ namespace {
 // Typed TimeSamples to typeless TimeSamples
 template <typename T>
 value::TimeSamples ToTypelessTimeSamples(const TypedTimeSamples<T> &ts) {
-  const std::vector<typename TypedTimeSamples<T>::Sample> &samples =
-      ts.get_samples();
+  const std::vector<double> &times = ts.get_times();
+  const std::vector<T> &values = ts.get_values();
 
   value::TimeSamples dst;
+  dst.reserve(times.size());
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    dst.add_sample(samples[i].t, samples[i].value);
+  for (size_t i = 0; i < times.size(); i++) {
+    if (ts.is_blocked(i)) {
+      dst.add_blocked_sample(times[i], value::ValueBlock());
+    } else {
+      dst.add_sample(times[i], values[i]);
+    }
   }
 
   return dst;
@@ -52,15 +57,19 @@ value::TimeSamples ToTypelessTimeSamples(const TypedTimeSamples<T> &ts) {
 template <typename T>
 value::TimeSamples EnumTimeSamplesToTypelessTimeSamples(
     const TypedTimeSamples<T> &ts) {
-  const std::vector<typename TypedTimeSamples<T>::Sample> &samples =
-      ts.get_samples();
+  const std::vector<double> &times = ts.get_times();
+  const std::vector<T> &values = ts.get_values();
 
   value::TimeSamples dst;
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    // to token
-    value::token tok(to_string(samples[i].value));
-    dst.add_sample(samples[i].t, tok);
+  for (size_t i = 0; i < times.size(); i++) {
+    if (ts.is_blocked(i)) {
+      dst.add_blocked_sample(times[i], value::ValueBlock());
+    } else {
+      // to token
+      value::token tok(to_string(values[i]));
+      dst.add_sample(times[i], tok);
+    }
   }
 
   return dst;
@@ -330,11 +330,8 @@ void GeomPrimvar::set_indices(const std::vector<int32_t> &indices, const double
   if (value::TimeCode(t).is_default()) {
     _indices = indices;
   } else {
-    TypedTimeSamples<std::vector<int32_t>>::Sample *psample{nullptr};
-    if (_ts_indices.get_sample_at(t, &psample)) {
-      // overwrite content
-      psample->value = indices;
-    } else {
+    // overwrite content if the sample exists at `t`.
+    if (!_ts_indices.set_sample_at(t, indices)) {
       _ts_indices.add_sample(t, indices);
     }
   }
@@ -501,9 +498,11 @@ bool GeomPrimvar::get_value(T *dest, std::string *err) const {
       return false;
     }
     
-    if (auto pv =ts.get_samples().at(0).value.as<T>()) {
-      (*dest) = (*pv);
-      return true;
+    if (auto pv = ts.get_value(0)) {
+      if (const T *p = pv.value().as<T>()) {
+        (*dest) = (*p);
+        return true;
+      }
     }
   }
 
@@ -663,8 +662,9 @@ bool GPrim::set_primvar(const GeomPrimvar &primvar,
     }
 
     if (primvar.has_timesampled_indices()) {
-      for (const auto &sample : primvar.get_timesampled_indices().get_samples()) {
-        var.set_timesample(sample.t, sample.value);
+      const auto &ts = primvar.get_timesampled_indices();
+      for (size_t i = 0; i < ts.size(); i++) {
+        var.set_timesample(ts.get_times()[i], ts.get_values()[i]);
       }
     }
 
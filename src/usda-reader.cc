@@ -67,6 +67,7 @@
 #include "primvar.hh"
 #include "str-util.hh"
 #include "stream-reader.hh"
+#include "thread-util.hh"
 #include "tinyusdz.hh"
 #include "usdObj.hh"
 #include "usdShade.hh"
@@ -290,7 +291,7 @@ class USDAReader::Impl {
   Stage _stage;
 
  public:
-  Impl(StreamReader *sr) { _parser.SetStream(sr); }
+  Impl(StreamReader *sr) : _sr(sr) { _parser.SetStream(sr); }
 
 #if 0 // TODO: Remove
   // Return the flag if the .usda is read from `references`
@@ -1166,6 +1167,27 @@ class USDAReader::Impl {
   ///
   bool Read(const uint32_t state_flags, bool as_primspec);
 
+  ///
+  /// Parse toplevel Prim blocks in parallel. Each worker thread parses a
+  /// contiguous group of toplevel blocks with its own Impl instance, then
+  /// prim nodes are merged in source order.
+  /// `parsed` is set false when the input cannot be split or a worker failed
+  /// (then nothing is parsed except for the header, and the caller should
+  /// parse the rest serially to get the same result/error as `Parse`).
+  /// `parser_warn` receives the parser warnings of the workers, in the same
+  /// order as `AsciiParser::GetWarning()` of the serial parsing(newest
+  /// first), without the warnings of the header.
+  ///
+  bool ReadParallel(const uint32_t state_flags,
+                    const ascii::AsciiParserOption &parser_option,
+                    bool as_primspec, int num_threads, bool *parsed,
+                    std::string *parser_warn);
+
+  // Append prim nodes parsed by `worker`.
+  void MergePrimNodes(Impl &worker);
+
+  void RegisterCallbacks(bool as_primspec);
+
   // std::vector<GPrim> GetGPrims() { return _gprims; }
 
   std::string GetDefaultPrimName() const { return _defaultPrim; }
@@ -1284,6 +1306,7 @@ class USDAReader::Impl {
   // Used for Ascii parser option
   USDAReaderConfig _config;
 
+  StreamReader *_sr{nullptr};
   ascii::AsciiParser _parser;
 
 };  // namespace usda
@@ -1630,16 +1653,7 @@ bool USDAReader::Impl::ReconstructPrim(
 /// -- Impl Read
 ///
 
-bool USDAReader::Impl::Read(const uint32_t state_flags, bool as_primspec) {
-
-  ///
-  /// Convert parser option.
-  ///
-  ascii::AsciiParserOption ascii_parser_option;
-  ascii_parser_option.allow_unknown_prim = _config.allow_unknown_prims;
-  ascii_parser_option.allow_unknown_apiSchema = _config.allow_unknown_apiSchema;
-  ascii_parser_option.strict_allowedToken_check = _config.strict_allowedToken_check;
-
+void USDAReader::Impl::RegisterCallbacks(bool as_primspec) {
   ///
   /// Setup callbacks.
   ///
@@ -1685,10 +1699,41 @@ bool USDAReader::Impl::Read(const uint32_t state_flags, bool as_primspec) {
   RegisterReconstructCallback<BlendShape>();
 
   _parser.set_primspec_mode(as_primspec);
+}
 
-  bool ret = _parser.Parse(state_flags, ascii_parser_option);
+bool USDAReader::Impl::Read(const uint32_t state_flags, bool as_primspec) {
 
-  std::string warn = _parser.GetWarning();
+  ///
+  /// Convert parser option.
+  ///
+  ascii::AsciiParserOption ascii_parser_option;
+  ascii_parser_option.allow_unknown_prim = _config.allow_unknown_prims;
+  ascii_parser_option.allow_unknown_apiSchema = _config.allow_unknown_apiSchema;
+  ascii_parser_option.strict_allowedToken_check = _config.strict_allowedToken_check;
+
+  RegisterCallbacks(as_primspec);
+
+  int num_threads = thread_util::GetNumThreads(_config.num_threads);
+
+  bool ret{false};
+  bool parsed{false};
+  std::string parallel_warn;
+  if ((num_threads > 1) && _sr && !_sr->is_chunked() &&
+      (_sr->size() >= _config.min_parallel_parse_bytes)) {
+    ret = ReadParallel(state_flags, ascii_parser_option, as_primspec,
+                       num_threads, &parsed, &parallel_warn);
+    if (ret && !parsed) {
+      // Could not split the input. Parse the rest serially.
+      ret = _parser.ParseToplevelBlocks(_parser.CurrLoc(), _sr->size(),
+                                        _parser.GetCursor().row, state_flags,
+                                        ascii_parser_option);
+    }
+  } else {
+    ret = _parser.Parse(state_flags, ascii_parser_option);
+  }
+
+  // Warnings of the header are the oldest ones.
+  std::string warn = parallel_warn + _parser.GetWarning();
   if (!warn.empty()) {
     PUSH_WARN("<USDAParser> " + warn);
   }
@@ -1701,6 +1746,137 @@ bool USDAReader::Impl::Read(const uint32_t state_flags, bool as_primspec) {
   return true;
 }
 
+bool USDAReader::Impl::ReadParallel(const uint32_t state_flags,
+                                    const ascii::AsciiParserOption &parser_option,
+                                    bool as_primspec, int num_threads,
+                                    bool *parsed, std::string *parser_warn) {
+  (*parsed) = false;
+
+  if (!_parser.ParseHeader(state_flags, parser_option)) {
+    return false;
+  }
+
+  std::vector<ascii::AsciiParser::BlockRange> ranges;
+  if (!_parser.ScanToplevelBlocks(&ranges) || (ranges.size() < 2)) {
+    return true;
+  }
+
+  // Group contiguous blocks by byte size. Use more groups than threads so
+  // that blocks with uneven size are balanced.
+  size_t num_groups = (std::min)(ranges.size(), size_t(num_threads) * 4);
+  uint64_t total_bytes = ranges.back().end - ranges.front().begin;
+
+  // group i = ranges[group_begin[i], group_begin[i + 1])
+  std::vector<size_t> group_begin;
+  group_begin.push_back(0);
+  for (size_t i = 1; i < ranges.size(); i++) {
+    uint64_t bytes = ranges[i].begin - ranges[group_begin.back()].begin;
+    if ((bytes * num_groups) >= total_bytes) {
+      group_begin.push_back(i);
+    }
+  }
+  group_begin.push_back(ranges.size());
+  num_groups = group_begin.size() - 1;
+  if (num_groups < 2) {
+    return true;
+  }
+
+  DCOUT("# of toplevel blocks = " << ranges.size()
+                                  << ", # of groups = " << num_groups);
+
+  std::vector<std::unique_ptr<StreamReader>> worker_srs(num_groups);
+  std::vector<std::unique_ptr<Impl>> workers(num_groups);
+  std::vector<uint8_t> results(num_groups, 0);
+
+  thread_util::ParallelFor(0, num_groups, num_threads, [&](size_t g) {
+    const auto &first = ranges[group_begin[g]];
+    const auto &last = ranges[group_begin[g + 1] - 1];
+
+    worker_srs[g].reset(new StreamReader(_sr->data(), _sr->size(),
+                                         _sr->swap_endian()));
+    workers[g].reset(new Impl(worker_srs[g].get()));
+
+    Impl &worker = *workers[g];
+    worker._config = _config;
+    worker.RegisterCallbacks(as_primspec);
+
+    results[g] = worker._parser.ParseToplevelBlocks(
+        first.begin, last.end, first.row, state_flags, parser_option);
+  });
+
+  for (size_t g = 0; g < num_groups; g++) {
+    if (!results[g]) {
+      // The input may be split at wrong locations(e.g. unusual quoting), or
+      // it has a syntax error. Discard results.
+      DCOUT("Parallel parsing failed at group " << g);
+      return true;
+    }
+  }
+
+  (*parsed) = true;
+
+  for (size_t g = 0; g < num_groups; g++) {
+    Impl &worker = *workers[g];
+
+    // Parser warnings are reported newest first.
+    (*parser_warn) = worker._parser.GetWarning() + (*parser_warn);
+    _warn += worker._warn;
+
+    MergePrimNodes(worker);
+  }
+
+  return true;
+}
+
+void USDAReader::Impl::MergePrimNodes(Impl &worker) {
+  // Prim indices are assigned in source order, so appending worker's nodes
+  // with offset gives the same indices as the serial parsing.
+  const size_t offset = _prim_nodes.size();
+
+  auto remap_variants = [offset](std::map<std::string, std::map<std::string, VariantNode>> &variantNodeMap) {
+    for (auto &vs : variantNodeMap) {
+      for (auto &v : vs.second) {
+        for (auto &idx : v.second.primChildren) {
+          idx += int64_t(offset);
+        }
+      }
+    }
+  };
+
+  for (auto &node : worker._prim_nodes) {
+    if (node.parent >= 0) {
+      node.parent += int64_t(offset);
+    }
+    for (auto &cidx : node.children) {
+      cidx += offset;
+    }
+    remap_variants(node.variantNodeMap);
+    _prim_nodes.emplace_back(std::move(node));
+  }
+
+  for (const auto &idx : worker._toplevel_prims) {
+    _toplevel_prims.push_back(idx + offset);
+  }
+
+  if (worker._primspec_nodes.size()) {
+    _primspec_nodes.resize(offset);
+    for (auto &node : worker._primspec_nodes) {
+      if (node.parent >= 0) {
+        node.parent += int64_t(offset);
+      }
+      for (auto &cidx : node.children) {
+        cidx += offset;
+      }
+      remap_variants(node.variantNodeMap);
+      _primspec_nodes.emplace_back(std::move(node));
+    }
+  }
+
+  for (const auto &idx : worker._toplevel_primspecs) {
+    _toplevel_primspecs.push_back(idx + offset);
+  }
+}
+
 //
 // --
 //
@@ -18,6 +18,14 @@ struct USDAReaderConfig {
   bool allow_unknown_shader{true};
   bool allow_unknown_apiSchema{true};
   bool strict_allowedToken_check{false};
+
+  ///
+  /// Parse toplevel Prim blocks in parallel when the input has multiple
+  /// toplevel Prims and its size is `min_parallel_parse_bytes` or larger.
+  /// -1 = use system's # of threads. Not effective for chunked StreamReader.
+  ///
+  int32_t num_threads{-1};
+  uint64_t min_parallel_parse_bytes{1024 * 1024};
 };
 
 ///
@@ -22,7 +22,9 @@
 
 #if !defined(TINYUSDZ_DISABLE_MODULE_USDC_READER)
 
+#include <map>
 #include <stack>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -218,6 +220,34 @@ static bool IsUnregisteredValueType(const std::string &typeName)
 
 }
 
+//
+// Cast the value to the type specified in `typeName`(e.g. `half3` ->
+// `float3`, `float3[]` -> `color3f[]`) when possible.
+//
+static void CastToTypeName(const std::string &reqTy, value::Value &v) {
+  std::string scalarTy = v.type_name();
+
+  if (reqTy.compare(scalarTy) == 0) {
+    return;
+  }
+
+  // Some inlined? value uses less accuracy type(e.g. `half3`) than
+  // typeName(e.g. `float3`) Use type specified in `typeName` as much as
+  // possible.
+  bool ret = value::UpcastType(reqTy, v);
+  if (ret) {
+    DCOUT(fmt::format("Upcast type from {} to {}.", scalarTy, reqTy));
+  }
+
+  // Optionally, cast to role type(in crate data, `typeName` uses role typename(e.g. `color3f`), whereas stored data uses base typename(e.g. VEC3F)
+  scalarTy = v.type_name();
+  if (value::RoleTypeCast(value::GetTypeId(reqTy), v)) {
+    DCOUT(fmt::format("Casted to Role type {} from type {}.", reqTy, scalarTy));
+  } else {
+    // Its ok.
+  }
+}
+
 class USDCReader::Impl {
  public:
   Impl(StreamReader *sr, const USDCReaderConfig &config) : _sr(sr) {
@@ -226,8 +256,7 @@ class USDCReader::Impl {
   }
 
   ~Impl() {
-    delete crate_reader;
-    crate_reader = nullptr;
+    crate_reader.reset();
   }
 
   void set_reader_config(const USDCReaderConfig &config) {
@@ -245,12 +274,24 @@ class USDCReader::Impl {
 #endif
   }
 
+  void set_input_data_holder(std::shared_ptr<const void> holder) {
+    _input_data_holder = std::move(holder);
+  }
+
   const USDCReaderConfig get_reader_config() const {
     return _config;
   }
 
   bool ReadUSDC();
 
+  ///
+  /// Create DeferredValue which unpacks `rep` on the first access.
+  /// `typeName` : `typeName` of the attribute(empty if unknown).
+  ///
+  std::shared_ptr<primvar::DeferredValue> CreateDeferredValue(
+      const crate::ValueRep &rep, const std::string &typeName,
+      bool is_timesamples);
+
   using PathIndexToSpecIndexMap = std::unordered_map<uint32_t, uint32_t>;
 
   ///
@@ -390,9 +431,27 @@ class USDCReader::Impl {
 
   bool AddVariantToPrimNode(int32_t prim_idx, const value::Value &variant);
 
-  crate::CrateReader *crate_reader{nullptr};
+  std::shared_ptr<crate::CrateReader> crate_reader;
 
   StreamReader *_sr = nullptr;
+
+  // Resources required to decode deferred values after loading.
+  // Shared by primvar::DeferredValue.
+  struct DeferredSource {
+    std::shared_ptr<const void> holder;  // Owns input data.
+    std::shared_ptr<StreamReader> sr;
+    std::shared_ptr<crate::CrateReader> crate_reader;
+  };
+
+  std::shared_ptr<const void> _input_data_holder;
+  std::shared_ptr<DeferredSource> _deferred_src;
+
+  // Attributes referring to the same payload share one DeferredValue, so the
+  // payload is decoded(and stored) only once.
+  // key = <ValueRep, typeName, is_timesamples>
+  std::map<std::tuple<uint64_t, std::string, bool>,
+           std::shared_ptr<primvar::DeferredValue>>
+      _deferred_values;
   std::string _err;
   std::string _warn;
 
@@ -935,6 +994,7 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
   Attribute attr;
 
   value::Value defaultValue;
+  nonstd::optional<crate::ValueRep> deferredDefault;
   Relationship rel;
 
   // for attribute
@@ -996,10 +1056,16 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
     } else if (fv.first == "default") {
       //propType = Property::Type::Attrib;
 
+      hasDefault = true;
+
+      if (fv.second.is_deferred()) {
+        deferredDefault = fv.second.deferred_rep();
+        continue;
+      }
+
       // Set scalar(non-timesampled) value
       // TODO: Easier CrateValue to Attribute.var conversion
       defaultValue = fv.second.get_raw();
-      hasDefault = true;
 
       // TODO: Handle UnregisteredValue in crate-reader.cc
       // UnregisteredValue is represented as string.
@@ -1022,7 +1088,11 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
 
       hasTimeSamples = true;
 
-      if (auto pv = fv.second.get_value<value::TimeSamples>()) {
+      if (fv.second.is_deferred()) {
+        var.set_deferred_value(CreateDeferredValue(fv.second.deferred_rep(),
+                                                   std::string(),
+                                                   /* timesamples */true));
+      } else if (auto pv = fv.second.get_value<value::TimeSamples>()) {
         var.set_timesamples(pv.value());
       } else {
         PUSH_ERROR_AND_RETURN_TAG(kTag,
@@ -1280,10 +1350,25 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
             kTag, "`unauthoredValuesIndex` must be type `int`, but got type `"
                       << fv.second.type_name() << "`");
       }
+    } else if (fv.first == "documentation") {
+      // String-only metadatum in USDA.
+      if (auto pv = fv.second.get_value<std::string>()) {
+        value::StringData s;
+        s.value = pv.value();
+        s.is_triple_quoted = hasNewline(s.value);
+        meta.stringData.push_back(s);
+      } else {
+        PUSH_ERROR_AND_RETURN_TAG(
+            kTag, "`documentation` must be type `string`, but got type `"
+                      << fv.second.type_name() << "`");
+      }
     } else {
-      // TODO: register unkown metadataum as custom metadata?
-      PUSH_WARN("TODO: " << fv.first);
-      DCOUT("TODO: " << fv.first);
+      // Store other metadatum as is.
+      MetaVariable mv;
+      mv.set_name(fv.first);
+      mv.get_raw_value() = fv.second.get_raw();
+      meta.meta[fv.first] = mv;
+      DCOUT("Other metadatum: " << fv.first);
     }
   }
   DCOUT("== End List of Fields");
@@ -1305,32 +1390,18 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
 
   // Do role type cast for default value.
   // (TODO: do role type cast for timeSamples?)
-  if (hasDefault) {
+  if (deferredDefault) {
+    // Decoded(and casted) when the value is accessed.
+    var.set_deferred_value(CreateDeferredValue(
+        deferredDefault.value(),
+        typeName ? typeName.value().str() : std::string(),
+        /* timesamples */false));
+  } else if (hasDefault) {
     if (typeName) {
       if (defaultValue.type_id() == value::TypeTraits<value::ValueBlock>::type_id()) {
         // nothing to do
       } else {
-        std::string reqTy = typeName.value().str();
-        std::string scalarTy = defaultValue.type_name();
-
-        if (reqTy.compare(scalarTy) != 0) {
-
-          // Some inlined? value uses less accuracy type(e.g. `half3`) than
-          // typeName(e.g. `float3`) Use type specified in `typeName` as much as
-          // possible.
-          bool ret = value::UpcastType(reqTy, defaultValue);
-          if (ret) {
-            DCOUT(fmt::format("Upcast type from {} to {}.", scalarTy, reqTy));
-          }
-
-          // Optionally, cast to role type(in crate data, `typeName` uses role typename(e.g. `color3f`), whereas stored data uses base typename(e.g. VEC3F)
-          scalarTy = defaultValue.type_name();
-          if (value::RoleTypeCast(value::GetTypeId(reqTy), defaultValue)) {
-            DCOUT(fmt::format("Casted to Role type {} from type {}.", reqTy, scalarTy));
-          } else {
-            // Its ok.
-          }
-        }
+        CastToTypeName(typeName.value().str(), defaultValue);
       }
     }
     var.set_value(defaultValue);
@@ -2246,8 +2317,12 @@ bool USDCReader::Impl::ParsePrimSpec(const crate::FieldValuePairVector &fvs,
         // store value as string type.
         primMeta.unregisteredMetas[fv.first] = quote((*ptv).str());
       } else {
-        DCOUT("PrimProp TODO: " << fv.first);
-        PUSH_WARN("PrimProp TODO: " << fv.first);
+        // Store other metadatum as is.
+        MetaVariable mv;
+        mv.set_name(fv.first);
+        mv.get_raw_value() = fv.second.get_raw();
+        primMeta.meta[fv.first] = mv;
+        DCOUT("Other Prim metadatum: " << fv.first);
       }
     }
   }
@@ -2795,9 +2870,10 @@ bool USDCReader::Impl::ReconstructPrimSpecNode(int parent, int current, int leve
 
   if ((spec.spec_type == SpecType::Attribute) ||
       (spec.spec_type == SpecType::Relationship)) {
-    if (_prim_table.count(parent)) {
+    if (_prim_table.count(parent) || _variantPrimSpecs.count(parent)) {
       // This node is a Properties node. These are processed in
-      // ReconstructPrim(), so nothing to do here.
+      // BuildPropertyMap() of the parent(Prim or Variant) node, so nothing to
+      // do here.
       return true;
     }
   }
@@ -2950,6 +3026,7 @@ bool USDCReader::Impl::ReconstructPrimSpecNode(int parent, int current, int leve
 #else
         primspec.typeName() = primTypeName;
         primspec.name() = prim_name;
+        primspec.specifier() = specifier.value();
 
         prim::PropertyMap props;
         if (!BuildPropertyMap(node.GetChildren(), psmap, &props)) {
@@ -3661,6 +3738,7 @@ bool USDCReader::Impl::ReconstructPrimSpecRecursively(
         vs.name = variantSetName;
       }
       vs.variantSet[variantName].metas() = vp.metas();
+      vs.variantSet[variantName].props() = vp.props();
       DCOUT("# of primChildren = " << vp.children().size());
       vs.variantSet[variantName].children() = std::move(vp.children());
 
@@ -3675,10 +3753,8 @@ bool USDCReader::Impl::ReconstructPrimSpecRecursively(
     if (_variantPrimSpecs.count(parent)) {
       // Add to variantPrim
       DCOUT("parent is variantPrim: " << parent);
-      if (!primspec) {
-        // FIXME: Validate current should be Prim.
-        PUSH_WARN("parent is variantPrim, but current is not Prim.");
-      } else {
+      // Property under variantPrim is already stored in its PrimSpec.
+      if (primspec) {
         DCOUT("Adding prim to child...");
         PrimSpec &vps = _variantPrimSpecs.at(parent);
         vps.children().emplace_back(std::move(primspec.value()));
@@ -3752,11 +3828,65 @@ bool USDCReader::Impl::ToLayer(Layer *layer) {
   return true;
 }
 
-bool USDCReader::Impl::ReadUSDC() {
-  if (crate_reader) {
-    delete crate_reader;
+std::shared_ptr<primvar::DeferredValue> USDCReader::Impl::CreateDeferredValue(
+    const crate::ValueRep &rep, const std::string &typeName,
+    bool is_timesamples) {
+  auto key = std::make_tuple(rep.GetData(), typeName, is_timesamples);
+  auto it = _deferred_values.find(key);
+  if (it != _deferred_values.end()) {
+    return it->second;
   }
 
+  std::shared_ptr<DeferredSource> src = _deferred_src;
+
+  primvar::DeferredValue::LoadFunction fn =
+      [src, rep, typeName, is_timesamples](value::Value *v,
+                                          value::TimeSamples *ts,
+                                          std::string *err) -> bool {
+    crate::CrateValue cv;
+    if (!src->crate_reader->UnpackDeferredValueRep(rep, &cv, err)) {
+      return false;
+    }
+
+    if (is_timesamples) {
+      if (auto pv = cv.get_value<value::TimeSamples>()) {
+        (*ts) = std::move(pv.value());
+      } else {
+        (*err) += "`timeSamples` is not TimeSamples data.\n";
+        return false;
+      }
+    } else {
+      (*v) = cv.get_raw();
+      if (!typeName.empty()) {
+        CastToTypeName(typeName, *v);
+      }
+    }
+    return true;
+  };
+
+  // Report the type of the value without decoding: the value is casted to
+  // `typeName` when it is a known type, otherwise the type is read from the
+  // ValueRep.
+  std::string tyname;
+  uint32_t tyid{value::TYPE_ID_INVALID};
+  if (!is_timesamples && value::TryGetTypeId(typeName)) {
+    tyname = typeName;
+  } else if (crate_reader->GetDeferredValueTypeId(rep, &tyid)) {
+    tyname = value::GetTypeName(tyid);
+  }
+
+  auto dv = std::make_shared<primvar::DeferredValue>(tyname, is_timesamples,
+                                                     std::move(fn));
+  _deferred_values.emplace(key, dv);
+
+  return dv;
+}
+
+bool USDCReader::Impl::ReadUSDC() {
+  crate_reader.reset();
+  _deferred_src.reset();
+  _deferred_values.clear();
+
   // TODO: Setup CrateReaderConfig.
   crate::CrateReaderConfig config;
 
@@ -3774,7 +3904,21 @@ bool USDCReader::Impl::ReadUSDC() {
     config.maxMemoryBudget = _config.kMaxAllowedMemoryInMB * 1024ull * 1024ull;
   }
 
-  crate_reader = new crate::CrateReader(_sr, config);
+  if (_config.defer_value_loading && _input_data_holder) {
+    // CrateReader and its StreamReader must outlive this reader, since
+    // deferred values are decoded on demand.
+    _deferred_src = std::make_shared<DeferredSource>();
+    _deferred_src->holder = _input_data_holder;
+    _deferred_src->sr = std::make_shared<StreamReader>(
+        _sr->data(), _sr->size(), _sr->swap_endian());
+
+    config.deferValueLoading = true;
+    crate_reader =
+        std::make_shared<crate::CrateReader>(_deferred_src->sr.get(), config);
+    _deferred_src->crate_reader = crate_reader;
+  } else {
+    crate_reader = std::make_shared<crate::CrateReader>(_sr, config);
+  }
 
   _warn.clear();
   _err.clear();
@@ -3791,39 +3935,9 @@ bool USDCReader::Impl::ReadUSDC() {
     return false;
   }
 
-  // Read known sections
-
-  if (!crate_reader->ReadTokens()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadStrings()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadFields()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadFieldSets()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadPaths()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadSpecs()) {
+  // Read known sections.
+  // Sections are decoded in parallel when numThreads > 1.
+  if (!crate_reader->ReadKnownSections()) {
     _warn = crate_reader->GetWarning();
     _err = crate_reader->GetError();
     return false;
@@ -3883,6 +3997,10 @@ std::string USDCReader::GetError() { return impl_->GetError(); }
 
 std::string USDCReader::GetWarning() { return impl_->GetWarning(); }
 
+void USDCReader::set_input_data_holder(std::shared_ptr<const void> holder) {
+  impl_->set_input_data_holder(std::move(holder));
+}
+
 bool USDCReader::ReadUSDC() { return impl_->ReadUSDC(); }
 
 }  // namespace usdc
@@ -3911,6 +4029,10 @@ const USDCReaderConfig USDCReader::get_reader_config() const {
   return USDCReaderConfig();
 }
 
+void USDCReader::set_input_data_holder(std::shared_ptr<const void> holder) {
+  (void)holder;
+}
+
 bool USDCReader::ReconstructStage(Stage *stage) {
   (void)scene;
   DCOUT("Reconstruct Stage.");
@@ -4,6 +4,8 @@
 //
 #pragma once
 
+#include <memory>
+
 #include "stream-reader.hh"
 #include "tinyusdz.hh"
 
@@ -27,6 +29,11 @@ struct USDCReaderConfig {
   bool allow_unknown_apiSchemas = true;
 
   bool strict_allowedToken_check = false;
+
+  // Defer decoding of array and TimeSamples attribute values until they are
+  // accessed(See primvar::DeferredValue). Only effective when the input
+  // data is kept alive with `USDCReader::set_input_data_holder`.
+  bool defer_value_loading = false;
 };
 
 class USDCReader {
@@ -38,6 +45,13 @@ class USDCReader {
   void set_reader_config(const USDCReaderConfig &config);
   const USDCReaderConfig get_reader_config() const;
 
+  ///
+  /// Set the object which owns the memory of StreamReader(e.g. memory-mapped
+  /// file). Attributes loaded with `defer_value_loading` share it until all
+  /// of their deferred values are decoded.
+  ///
+  void set_input_data_holder(std::shared_ptr<const void> holder);
+
   bool ReadUSDC();
 
   bool ReconstructStage(Stage *stage);
@@ -34,13 +34,23 @@
 #endif
 
 
-#include <fstream>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <sstream>
+#include <unordered_map>
 
 #include "crate-format.hh"
+#include "crate-writer.hh"
+#include "integerCoding.h"
 #include "io-util.hh"
 #include "lz4-compression.hh"
+#include "pprinter.hh"
+#include "prim-to-primspec.hh"
 #include "token-type.hh"
 
 #include "common-macros.inc"
@@ -50,7 +60,7 @@ namespace usdc {
 
 namespace {
 
-constexpr size_t kSectionNameMaxLength = 15;
+constexpr auto kTag = "[USDC Writer]";
 
 #ifdef _WIN32
 std::wstring UTF8ToWchar(const std::string &str) {
@@ -61,430 +71,2223 @@ std::wstring UTF8ToWchar(const std::string &str) {
                       int(wstr.size()));
   return wstr;
 }
-
-#if 0
-std::string WcharToUTF8(const std::wstring &wstr) {
-  int str_size = WideCharToMultiByte(CP_UTF8, 0, wstr.data(), int(wstr.size()),
-                                     nullptr, 0, nullptr, nullptr);
-  std::string str(size_t(str_size), 0);
-  WideCharToMultiByte(CP_UTF8, 0, wstr.data(), int(wstr.size()), &str[0],
-                      int(str.size()), nullptr, nullptr);
-  return str;
-}
 #endif
-#endif
-
-struct Section {
-  Section() { memset(this, 0, sizeof(*this)); }
-  Section(char const *name, int64_t start, int64_t size);
-  char name[kSectionNameMaxLength + 1];
-  int64_t start, size;  // byte offset to section info and its data size
-};
 
 //
-// TOC = list of sections.
-//
-struct TableOfContents {
-  // Section const *GetSection(SectionName) const;
-  // int64_t GetMinimumSectionStart() const;
-  std::vector<Section> sections;
-};
-
-//struct Field {
-//  // FIXME(syoyo): Do we need 4 bytes padding as done in pxrUSD?
-//  // uint32_t padding_;
+// Helper functions to append POD data to a byte buffer.
 //
-//  crate::TokenIndex token_index;
-//  crate::ValueRep value_rep;
-//};
-
-#if 0
-// For unordered_map
-
-// https://stackoverflow.com/questions/8513911/how-to-create-a-good-hash-combine-with-64-bit-output-inspired-by-boosthash-co
-// From CityHash code.
-template <class T>
-inline void hash_combine(std::size_t &seed, const T &v) {
-#ifdef __wasi__  // 32bit platform
-  // Use boost version.
-  std::hash<T> hasher;
-  seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-#else
-  std::hash<T> hasher;
-  const uint64_t kMul = 0x9ddfea08eb382d69ULL;
-  std::size_t a = (hasher(v) ^ seed) * kMul;
-  a ^= (a >> 47);
-  std::size_t b = (seed ^ a) * kMul;
-  b ^= (b >> 47);
-  seed = b * kMul;
-#endif
+template <typename T>
+void Append(std::vector<uint8_t> &dst, const T &v) {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be POD type.");
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(&v);
+  dst.insert(dst.end(), p, p + sizeof(T));
 }
 
-struct PathHasher {
-  size_t operator()(const Path &path) const {
-    size_t seed = std::hash<std::string>()(path.GetPrimPart());
-    hash_combine(seed, std::hash<std::string>()(path.GetPropPart()));
-    hash_combine(seed, std::hash<std::string>()(path.GetLocalPart()));
-    hash_combine(seed, std::hash<bool>()(path.IsValid()));
-
-    return seed;
-  }
-};
-
-struct PathKeyEqual {
-  bool operator()(const Path &lhs, const Path &rhs) const {
-    bool ret = lhs.GetPrimPart() == rhs.GetPrimPart();
-    ret &= lhs.GetPropPart() == rhs.GetPropPart();
-    ret &= lhs.GetLocalPart() == rhs.GetLocalPart();
-    ret &= lhs.IsValid() == rhs.IsValid();
-
-    return ret;
-  }
-};
-
-struct FieldHasher {
-  size_t operator()(const Field &field) const {
-    size_t seed = std::hash<uint32_t>()(field.token_index.value);
-    hash_combine(seed, std::hash<uint64_t>()(field.value_rep.GetData()));
-
-    return seed;
-  }
-};
-
-struct FieldKeyEqual {
-  bool operator()(const Field &lhs, const Field &rhs) const {
-    bool ret = lhs.token_index == rhs.token_index;
-    ret &= lhs.value_rep == rhs.value_rep;
-
-    return ret;
-  }
-};
-
-struct FieldSetHasher {
-  size_t operator()(const std::vector<crate::FieldIndex> &fieldset) const {
-    if (fieldset.empty()) {
-      return 0;
-    }
-
-    size_t seed = std::hash<uint32_t>()(fieldset[0].value);
-    for (size_t i = 1; i < fieldset.size(); i++) {
-      hash_combine(seed, std::hash<uint32_t>()(fieldset[i].value));
-    }
-
-    return seed;
+void Append(std::vector<uint8_t> &dst, const void *data, size_t n) {
+  if (n == 0) {
+    return;
   }
-};
-#endif
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(data);
+  dst.insert(dst.end(), p, p + n);
+}
 
 class Packer {
  public:
-  crate::TokenIndex AddToken(const Token &token);
+  Packer() {
+    // pxrUSD always stores this token at the beginning of the token table.
+    AddToken(value::token(";-)"));
+  }
+
+  crate::TokenIndex AddToken(const value::token &token);
   crate::StringIndex AddString(const std::string &str);
-  crate::PathIndex AddPath(const Path &path);
   crate::FieldIndex AddField(const crate::Field &field);
   crate::FieldSetIndex AddFieldSet(
       const std::vector<crate::FieldIndex> &field_indices);
 
-  const std::vector<Token> &GetTokens() const { return tokens_; }
+  const std::vector<value::token> &GetTokens() const { return tokens_; }
+  const std::vector<crate::TokenIndex> &GetStrings() const { return strings_; }
+  const std::vector<crate::Field> &GetFields() const { return fields_; }
+  const std::vector<crate::FieldIndex> &GetFieldSets() const {
+    return fieldsets_;
+  }
 
  private:
-  std::unordered_map<Token, crate::TokenIndex, TokenHasher, TokenKeyEqual>
+  std::unordered_map<value::token, crate::TokenIndex, TokenHasher,
+                     TokenKeyEqual>
       token_to_index_map;
   std::unordered_map<std::string, crate::StringIndex> string_to_index_map;
-  std::unordered_map<Path, crate::PathIndex, crate::PathHasher, crate::PathKeyEqual>
-      path_to_index_map;
-  std::unordered_map<crate::Field, crate::FieldIndex, crate::FieldHasher, crate::FieldKeyEqual>
+  std::unordered_map<crate::Field, crate::FieldIndex, crate::FieldHasher,
+                     crate::FieldKeyEqual>
       field_to_index_map;
   std::unordered_map<std::vector<crate::FieldIndex>, crate::FieldSetIndex,
                      crate::FieldSetHasher>
       fieldset_to_index_map;
 
-  std::vector<Token> tokens_;
-  std::vector<std::string> strings_;
-  std::vector<Path> paths_;
+  std::vector<value::token> tokens_;
+  std::vector<crate::TokenIndex> strings_;  // string is stored as a token.
   std::vector<crate::Field> fields_;
   std::vector<crate::FieldIndex>
       fieldsets_;  // flattened 1D array of FieldSets. Each span is terminated
                    // by Index()(= ~0)
 };
 
-#if 0 // not used atm.
-crate::TokenIndex Packer::AddToken(const Token &token) {
-  if (token_to_index_map.count(token)) {
-    return token_to_index_map[token];
+crate::TokenIndex Packer::AddToken(const value::token &token) {
+  auto it = token_to_index_map.find(token);
+  if (it != token_to_index_map.end()) {
+    return it->second;
   }
 
   // index = size of umap
-  token_to_index_map[token] = crate::TokenIndex(uint32_t(tokens_.size()));
+  crate::TokenIndex idx(uint32_t(tokens_.size()));
+  token_to_index_map.emplace(token, idx);
   tokens_.emplace_back(token);
 
-  return token_to_index_map[token];
+  return idx;
+}
+
+crate::StringIndex Packer::AddString(const std::string &str) {
+  auto it = string_to_index_map.find(str);
+  if (it != string_to_index_map.end()) {
+    return it->second;
+  }
+
+  // index = size of umap
+  crate::StringIndex idx(uint32_t(strings_.size()));
+  string_to_index_map.emplace(str, idx);
+  strings_.emplace_back(AddToken(value::token(str)));
+
+  return idx;
+}
+
+crate::FieldIndex Packer::AddField(const crate::Field &field) {
+  auto it = field_to_index_map.find(field);
+  if (it != field_to_index_map.end()) {
+    return it->second;
+  }
+
+  // index = size of umap
+  crate::FieldIndex idx(uint32_t(fields_.size()));
+  field_to_index_map.emplace(field, idx);
+  fields_.emplace_back(field);
+
+  return idx;
+}
+
+crate::FieldSetIndex Packer::AddFieldSet(
+    const std::vector<crate::FieldIndex> &fieldset) {
+  auto it = fieldset_to_index_map.find(fieldset);
+  if (it != fieldset_to_index_map.end()) {
+    return it->second;
+  }
+
+  // index = start index of FieldSet span.
+  crate::FieldSetIndex idx(uint32_t(fieldsets_.size()));
+  fieldset_to_index_map.emplace(fieldset, idx);
+
+  fieldsets_.insert(fieldsets_.end(), fieldset.begin(), fieldset.end());
+  fieldsets_.push_back(crate::FieldIndex());  // terminator(~0)
+
+  return idx;
 }
 
-crate::StringIndex Packer::AddString(const std::string &str) {
-  if (string_to_index_map.count(str)) {
-    return string_to_index_map[str];
+//
+// Writes Layer(PrimSpec tree) as Crate binary.
+//
+// File layout:
+//
+//  - Header(88 bytes. TOC offset is written at the end)
+//  - Value data(out-of-line values referenced from ValueRep)
+//  - Sections(TOKENS, STRINGS, FIELDS, FIELDSETS, PATHS, SPECS)
+//  - TOC
+//
+class Writer {
+ public:
+  Writer(const Layer &layer) : layer_(layer) {}
+
+  const std::string &GetError() const { return err_; }
+  const std::string &GetWarning() const { return warn_; }
+
+  void PushError(const std::string &s) { err_ += s; }
+
+  void PushWarn(const std::string &s) { warn_ += s; }
+
+  bool Write() {
+    buf_.clear();
+    buf_.resize(kHeaderSize, 0);  // placeholder
+
+    if (!CollectPaths()) {
+      PUSH_ERROR("Failed to build Path tree.");
+      return false;
+    }
+
+    if (!BuildSpecs()) {
+      PUSH_ERROR("Failed to build Specs.");
+      return false;
+    }
+
+    //
+    //  - Tokens
+    //  - Strings
+    //  - Fields
+    //  - FieldSets
+    //  - Paths
+    //  - Specs
+    //  - TOC
+    //
+
+    if (!WriteTokens()) {
+      PUSH_ERROR("Failed to write Tokens.");
+      return false;
+    }
+
+    if (!WriteStrings()) {
+      PUSH_ERROR("Failed to write Strings.");
+      return false;
+    }
+
+    if (!WriteFields()) {
+      PUSH_ERROR("Failed to write Fields.");
+      return false;
+    }
+
+    if (!WriteFieldSets()) {
+      PUSH_ERROR("Failed to write FieldSets.");
+      return false;
+    }
+
+    if (!WritePaths()) {
+      PUSH_ERROR("Failed to write Paths.");
+      return false;
+    }
+
+    if (!WriteSpecs()) {
+      PUSH_ERROR("Failed to write Specs.");
+      return false;
+    }
+
+    // TODO(syoyo): Add feature to support writing unknown section(custom user
+    // data)
+
+    const uint64_t toc_offset = uint64_t(buf_.size());
+    if (!WriteTOC()) {
+      PUSH_ERROR("Failed to write TOC.");
+      return false;
+    }
+
+    if (!WriteHeader(toc_offset)) {
+      PUSH_ERROR("Failed to write Header.");
+      return false;
+    }
+
+    return true;
+  }
+
+  // Get serialized USDC binary data
+  bool GetOutput(std::vector<uint8_t> *output) {
+    if (!err_.empty()) {
+      return false;
+    }
+
+    if (!output) {
+      return false;
+    }
+
+    (*output) = std::move(buf_);
+    buf_.clear();
+
+    return true;
+  }
+
+ private:
+  Writer() = delete;
+  Writer(const Writer &) = delete;
+
+  static constexpr size_t kHeaderSize = 88;
+
+  // Node of Path tree. Path index is assigned in depth-first order.
+  struct PathNode {
+    crate::TokenIndex element;  // Element name
+    bool is_property{false};
+    std::vector<size_t> children;  // node indices
+    uint32_t path_index{0};
+  };
+
+  // Spec to write.
+  struct SpecItem {
+    size_t node;
+    SpecType spec_type;
+    const PrimSpec *prim{nullptr};
+    const Property *prop{nullptr};
+    const VariantSetSpec *variant_set{nullptr};
+    std::string prop_name;
+    crate::FieldSetIndex fieldset;
+  };
+
+  bool WriteHeader(uint64_t toc_offset) {
+    char magic[8];
+    magic[0] = 'P';
+    magic[1] = 'X';
+    magic[2] = 'R';
+    magic[3] = '-';
+    magic[4] = 'U';
+    magic[5] = 'S';
+    magic[6] = 'D';
+    magic[7] = 'C';
+
+    uint8_t version[8];  // Only first 3 bytes are used.
+    memset(version, 0, 8);
+    version[0] = 0;
+    version[1] = 8;
+    version[2] = 0;
+
+    std::array<uint8_t, kHeaderSize> header;
+    memset(&header, 0, kHeaderSize);
+
+    memcpy(&header[0], magic, 8);
+    memcpy(&header[8], version, 8);
+    memcpy(&header[16], &toc_offset, 8);
+
+    if (buf_.size() < kHeaderSize) {
+      return false;
+    }
+
+    memcpy(buf_.data(), &header[0], kHeaderSize);
+
+    return true;
+  }
+
+  //
+  // Path tree
+  //
+
+  bool AddPathNode(const Path &path, size_t *node_id) {
+    if (path.prim_part().empty() && path.prop_part().empty()) {
+      // e.g. Reference without prim path.
+      has_empty_path_ = true;
+      (*node_id) = kEmptyPathNode;
+      return true;
+    }
+
+    if (!path.is_absolute_path()) {
+      PUSH_ERROR_AND_RETURN_TAG(
+          kTag, "Relative Path is not supported in USDC writer: "
+                    << path.full_path_name());
+    }
+
+    const std::string &prim_part = path.prim_part();
+
+    size_t prim_node{0};  // root
+    if (prim_part != "/") {
+      auto it = path_to_node_.find(prim_part);
+      if (it != path_to_node_.end()) {
+        prim_node = it->second;
+      } else {
+        // Variant selection element(e.g. `{shapeVariant=Capsule}` in
+        // `/bora{shapeVariant=Capsule}`) is a child node of the owner Prim.
+        size_t loc;
+        std::string element;
+        if (prim_part.back() == '}') {
+          loc = prim_part.find_last_of('{');
+          if ((loc == std::string::npos) || (loc == 0) ||
+              (prim_part[loc - 1] == '/')) {
+            PUSH_ERROR_AND_RETURN_TAG(kTag,
+                                      "Invalid variant Path: " << prim_part);
+          }
+          element = prim_part.substr(loc);
+        } else {
+          loc = prim_part.find_last_of('/');
+          if ((loc == std::string::npos) || (loc == (prim_part.size() - 1))) {
+            PUSH_ERROR_AND_RETURN_TAG(kTag, "Invalid Prim path: " << prim_part);
+          }
+          element = prim_part.substr(loc + 1);
+        }
+
+        size_t parent_node{0};
+        if (loc > 0) {
+          if (!AddPathNode(Path(prim_part.substr(0, loc), ""), &parent_node)) {
+            return false;
+          }
+        }
+
+        prim_node = NewPathNode(parent_node, element, /* property */ false);
+        path_to_node_[prim_part] = prim_node;
+      }
+    }
+
+    if (path.prop_part().empty()) {
+      (*node_id) = prim_node;
+      return true;
+    }
+
+    const std::string key = path.full_path_name();
+    auto it = path_to_node_.find(key);
+    if (it != path_to_node_.end()) {
+      (*node_id) = it->second;
+      return true;
+    }
+
+    size_t prop_node =
+        NewPathNode(prim_node, path.prop_part(), /* property */ true);
+    path_to_node_[key] = prop_node;
+
+    (*node_id) = prop_node;
+    return true;
+  }
+
+  size_t NewPathNode(size_t parent, const std::string &element,
+                     bool is_property) {
+    size_t id = path_nodes_.size();
+    PathNode node;
+    node.element = packer_.AddToken(value::token(element));
+    node.is_property = is_property;
+    path_nodes_.emplace_back(std::move(node));
+    path_nodes_[parent].children.push_back(id);
+    return id;
+  }
+
+  bool AddPathNodes(const std::vector<Path> &paths) {
+    for (const auto &p : paths) {
+      size_t id;
+      if (!AddPathNode(p, &id)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Ordered names of root PrimSpecs.
+  std::vector<std::string> GetRootPrimNames() const {
+    const auto &primspecs = layer_.primspecs();
+
+    std::vector<std::string> names;
+
+    const auto &primChildren = layer_.metas().primChildren;
+    if (primChildren.size() == primspecs.size()) {
+      bool ok = true;
+      for (const auto &tok : primChildren) {
+        if (!primspecs.count(tok.str())) {
+          ok = false;
+          break;
+        }
+      }
+      if (ok) {
+        for (const auto &tok : primChildren) {
+          names.push_back(tok.str());
+        }
+        return names;
+      }
+    }
+
+    for (const auto &it : primspecs) {
+      names.push_back(it.first);
+    }
+    std::sort(names.begin(), names.end());
+
+    return names;
+  }
+
+  // Ordered names of properties in PrimSpec.
+  static std::vector<std::string> GetPropertyNames(const PrimSpec &ps) {
+    std::vector<std::string> names;
+
+    const auto &props = ps.props();
+    const auto &properties = ps.metas().properties;
+    if (properties.size() == props.size()) {
+      bool ok = true;
+      for (const auto &tok : properties) {
+        if (!props.count(tok.str())) {
+          ok = false;
+          break;
+        }
+      }
+      if (ok) {
+        for (const auto &tok : properties) {
+          names.push_back(tok.str());
+        }
+        return names;
+      }
+    }
+
+    for (const auto &it : props) {
+      names.push_back(it.first);
+    }
+
+    return names;
+  }
+
+  // Ordered names of variantSets in PrimSpec.
+  static std::vector<std::string> GetVariantSetNames(const PrimSpec &ps) {
+    std::vector<std::string> names;
+
+    const auto &variantSets = ps.variantSets();
+    if (ps.metas().variantSetChildren) {
+      const auto &children = ps.metas().variantSetChildren.value();
+      if (children.size() == variantSets.size()) {
+        bool ok = true;
+        for (const auto &tok : children) {
+          if (!variantSets.count(tok.str())) {
+            ok = false;
+            break;
+          }
+        }
+        if (ok) {
+          for (const auto &tok : children) {
+            names.push_back(tok.str());
+          }
+          return names;
+        }
+      }
+    }
+
+    for (const auto &it : variantSets) {
+      names.push_back(it.first);
+    }
+
+    return names;
+  }
+
+  bool CollectPrimSpecPaths(const std::string &parent_path, const PrimSpec &ps,
+                            uint32_t depth) {
+    return CollectSpecPaths(parent_path + ps.name(), ps, SpecType::Prim,
+                            depth);
+  }
+
+  // Collect Paths of Prim or Variant(`spec_path` is `/prim{set=variant}`)
+  // and its variantSets, properties and child Prims.
+  bool CollectSpecPaths(const std::string &spec_path, const PrimSpec &ps,
+                        SpecType spec_type, uint32_t depth) {
+    if (depth > (1024 * 1024 * 128)) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "PrimSpec tree too deep.");
+    }
+
+    size_t prim_node;
+    if (!AddPathNode(Path(spec_path, ""), &prim_node)) {
+      return false;
+    }
+
+    SpecItem prim_spec;
+    prim_spec.node = prim_node;
+    prim_spec.spec_type = spec_type;
+    prim_spec.prim = &ps;
+    specs_.emplace_back(std::move(prim_spec));
+
+    // variantSet: `/prim{set=}`, variant: `/prim{set=variant}`
+    for (const auto &vs_name : GetVariantSetNames(ps)) {
+      const VariantSetSpec &vs = ps.variantSets().at(vs_name);
+
+      size_t vs_node;
+      if (!AddPathNode(Path(spec_path + "{" + vs_name + "=}", ""), &vs_node)) {
+        return false;
+      }
+
+      SpecItem vs_spec;
+      vs_spec.node = vs_node;
+      vs_spec.spec_type = SpecType::VariantSet;
+      vs_spec.variant_set = &vs;
+      specs_.emplace_back(std::move(vs_spec));
+
+      for (const auto &variant : vs.variantSet) {
+        if (!CollectSpecPaths(
+                spec_path + "{" + vs_name + "=" + variant.first + "}",
+                variant.second, SpecType::Variant, depth + 1)) {
+          return false;
+        }
+      }
+    }
+
+    for (const auto &prop_name : GetPropertyNames(ps)) {
+      const Property &prop = ps.props().at(prop_name);
+
+      size_t prop_node;
+      if (!AddPathNode(Path(spec_path, prop_name), &prop_node)) {
+        return false;
+      }
+
+      SpecItem prop_spec;
+      prop_spec.node = prop_node;
+      prop_spec.spec_type = prop.is_relationship() ? SpecType::Relationship
+                                                   : SpecType::Attribute;
+      prop_spec.prop = &prop;
+      prop_spec.prop_name = prop_name;
+      specs_.emplace_back(std::move(prop_spec));
+    }
+
+    for (const auto &child : ps.children()) {
+      if (!CollectPrimSpecPaths(spec_path + "/", child, depth + 1)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // Register Paths referenced from the Spec(e.g. connection, relationship
+  // target, inherits). This is done after all Spec Paths are registered so
+  // that the order of children in Path tree follows the order of Specs.
+  bool CollectReferencedPaths(const SpecItem &spec) {
+    if (spec.prim) {
+      const PrimMeta &metas = spec.prim->metas();
+      if (metas.inherits) {
+        if (!AddPathNodes(metas.inherits.value().second)) {
+          return false;
+        }
+      }
+      if (metas.specializes) {
+        if (!AddPathNodes(metas.specializes.value().second)) {
+          return false;
+        }
+      }
+      if (metas.inheritPaths) {
+        if (!AddPathNodes(metas.inheritPaths.value().second)) {
+          return false;
+        }
+      }
+      if (metas.references) {
+        for (const auto &ref : metas.references.value().second) {
+          size_t id;
+          if (!AddPathNode(ref.prim_path, &id)) {
+            return false;
+          }
+        }
+      }
+      if (metas.payload) {
+        for (const auto &pl : metas.payload.value().second) {
+          size_t id;
+          if (!AddPathNode(pl.prim_path, &id)) {
+            return false;
+          }
+        }
+      }
+    } else if (spec.prop) {
+      const Property &prop = *spec.prop;
+      if (prop.is_relationship()) {
+        const Relationship &rel = prop.get_relationship();
+        if (rel.is_path()) {
+          if (!AddPathNodes({rel.targetPath})) {
+            return false;
+          }
+        } else if (rel.is_pathvector()) {
+          if (!AddPathNodes(rel.targetPathVector)) {
+            return false;
+          }
+        }
+      } else {
+        if (!AddPathNodes(prop.get_attribute().connections())) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  // Assign Path index in depth-first order and build jump table.
+  void AssignPathIndices() {
+    path_order_.clear();
+
+    // Use explicit stack to avoid deep recursion.
+    std::vector<size_t> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+      size_t id = stack.back();
+      stack.pop_back();
+
+      path_nodes_[id].path_index = uint32_t(path_order_.size());
+      path_order_.push_back(id);
+
+      const auto &children = path_nodes_[id].children;
+      for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        stack.push_back(*it);
+      }
+    }
+
+    empty_path_index_ = uint32_t(path_nodes_.size());
+  }
+
+  bool CollectPaths() {
+    path_nodes_.clear();
+    path_to_node_.clear();
+    specs_.clear();
+
+    // root node
+    PathNode root;
+    root.element = crate::TokenIndex(0);
+    path_nodes_.emplace_back(std::move(root));
+
+    SpecItem root_spec;
+    root_spec.node = 0;
+    root_spec.spec_type = SpecType::PseudoRoot;
+    specs_.emplace_back(std::move(root_spec));
+
+    for (const auto &name : GetRootPrimNames()) {
+      if (!CollectPrimSpecPaths("/", layer_.primspecs().at(name), 0)) {
+        return false;
+      }
+    }
+
+    for (const auto &spec : specs_) {
+      if (!CollectReferencedPaths(spec)) {
+        return false;
+      }
+    }
+
+    AssignPathIndices();
+
+    return true;
+  }
+
+  bool GetPathIndex(const Path &path, crate::PathIndex *idx) {
+    size_t id;
+    if (!AddPathNode(path, &id)) {
+      return false;
+    }
+
+    if (id == kEmptyPathNode) {
+      (*idx) = crate::PathIndex(empty_path_index_);
+      return true;
+    }
+
+    if (id >= path_order_.size()) {
+      // Should not happen. All paths must be collected in CollectPaths().
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Path `" << path.full_path_name()
+                                               << "` is not registered.");
+    }
+
+    (*idx) = crate::PathIndex(path_nodes_[id].path_index);
+    return true;
+  }
+
+  //
+  // Value data
+  //
+
+  // Append value data to the file and return its offset.
+  // Identical value data are deduplicated.
+  uint64_t AddValueData(const std::vector<uint8_t> &data) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (uint8_t c : data) {
+      hash ^= c;
+      hash *= 1099511628211ull;
+    }
+
+    auto range = value_data_map_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      const uint64_t offset = it->second;
+      if (((offset + data.size()) <= buf_.size()) &&
+          (memcmp(buf_.data() + offset, data.data(), data.size()) == 0)) {
+        return offset;
+      }
+    }
+
+    const uint64_t offset = uint64_t(buf_.size());
+    Append(buf_, data.data(), data.size());
+    value_data_map_.emplace(hash, offset);
+
+    return offset;
+  }
+
+  void AddOutOfLine(crate::CrateDataTypeId ty, bool is_array,
+                    const std::vector<uint8_t> &data, crate::ValueRep *rep) {
+    (*rep) = crate::ValueRep(int32_t(ty), /* inlined */ false, is_array,
+                             AddValueData(data));
+  }
+
+  template <typename T>
+  void PackRaw(crate::CrateDataTypeId ty, const T &v, crate::ValueRep *rep) {
+    std::vector<uint8_t> data;
+    Append(data, v);
+    AddOutOfLine(ty, /* array */ false, data, rep);
+  }
+
+  template <typename T>
+  void PackInlineOrRaw(crate::CrateDataTypeId ty, const T &v,
+                       crate::ValueRep *rep) {
+    if (auto d = crate::TryEncodeInline(v)) {
+      (*rep) = crate::ValueRep(int32_t(ty), /* inlined */ true,
+                               /* array */ false, d.value());
+      return;
+    }
+    PackRaw(ty, v, rep);
+  }
+
+  template <typename T>
+  void PackArrayRaw(crate::CrateDataTypeId ty, const std::vector<T> &v,
+                    crate::ValueRep *rep) {
+    if (v.empty()) {
+      (*rep) = crate::ValueRep(int32_t(ty), false, /* array */ true, 0);
+      return;
+    }
+
+    std::vector<uint8_t> data;
+    Append(data, uint64_t(v.size()));
+    Append(data, v.data(), sizeof(T) * v.size());
+    AddOutOfLine(ty, /* array */ true, data, rep);
+  }
+
+  // Append compressed integers(u64 comp_size + data).
+  template <typename T, typename Compressor>
+  bool AppendCompressedIntData(std::vector<uint8_t> &data,
+                               const std::vector<T> &v) {
+    std::vector<char> comp(Compressor::GetCompressedBufferSize(v.size()));
+    std::string err;
+    size_t comp_size =
+        Compressor::CompressToBuffer(v.data(), v.size(), comp.data(), &err);
+    if (!err.empty() || (comp_size == 0) || (comp_size > comp.size())) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to compress integer array. "
+                                          << err);
+    }
+
+    Append(data, uint64_t(comp_size));
+    Append(data, comp.data(), comp_size);
+    return true;
+  }
+
+  // int, uint, int64, uint64
+  template <typename T, typename Compressor>
+  bool PackIntArray(crate::CrateDataTypeId ty, const std::vector<T> &v,
+                    crate::ValueRep *rep) {
+    if (v.size() < crate::kMinCompressedArraySize) {
+      PackArrayRaw(ty, v, rep);
+      return true;
+    }
+
+    std::vector<uint8_t> data;
+    Append(data, uint64_t(v.size()));
+    if (!AppendCompressedIntData<T, Compressor>(data, v)) {
+      return false;
+    }
+    AddOutOfLine(ty, /* array */ true, data, rep);
+    rep->SetIsCompressed();
+
+    return true;
+  }
+
+  // half, float, double
+  //
+  // Same encoding as pxrUSD: when all elements are exactly representable as
+  // int32, they are stored as compressed ints('i'). Otherwise, when the
+  // array contains few distinct values, they are stored as lookup table +
+  // compressed indices('t'). Other arrays are stored uncompressed.
+  template <typename T, typename ToDouble>
+  bool PackFloatArray(crate::CrateDataTypeId ty, const std::vector<T> &v,
+                      ToDouble to_double, crate::ValueRep *rep) {
+    if (v.size() < crate::kMinCompressedArraySize) {
+      PackArrayRaw(ty, v, rep);
+      return true;
+    }
+
+    std::vector<int32_t> ints(v.size());
+    bool all_ints = true;
+    for (size_t i = 0; i < v.size(); i++) {
+      const double d = to_double(v[i]);
+      // NaN fails the range check. -0.0 is rejected since int loses its sign.
+      if (!((d >= double(std::numeric_limits<int32_t>::min())) &&
+            (d <= double(std::numeric_limits<int32_t>::max()))) ||
+          ((d == 0.0) && std::signbit(d))) {
+        all_ints = false;
+        break;
+      }
+      const int32_t iv = int32_t(d);
+      if (double(iv) != d) {
+        all_ints = false;
+        break;
+      }
+      ints[i] = iv;
+    }
+
+    if (all_ints) {
+      std::vector<uint8_t> data;
+      Append(data, uint64_t(v.size()));
+      Append(data, uint8_t('i'));
+      if (!AppendCompressedIntData<int32_t, Usd_IntegerCompression>(data,
+                                                                    ints)) {
+        return false;
+      }
+      AddOutOfLine(ty, /* array */ true, data, rep);
+      rep->SetIsCompressed();
+      return true;
+    }
+
+    // Elements are compared by its bit pattern.
+    const size_t max_lut_size = v.size() / 4;
+    std::unordered_map<uint64_t, uint32_t> lut_map;
+    std::vector<T> lut;
+    std::vector<uint32_t> indices(v.size());
+    bool use_lut = true;
+    for (size_t i = 0; i < v.size(); i++) {
+      uint64_t key{0};
+      memcpy(&key, &v[i], sizeof(T));
+      auto it = lut_map.find(key);
+      if (it == lut_map.end()) {
+        if (lut.size() >= max_lut_size) {
+          use_lut = false;
+          break;
+        }
+        it = lut_map.emplace(key, uint32_t(lut.size())).first;
+        lut.push_back(v[i]);
+      }
+      indices[i] = it->second;
+    }
+
+    if (use_lut) {
+      std::vector<uint8_t> data;
+      Append(data, uint64_t(v.size()));
+      Append(data, uint8_t('t'));
+      Append(data, uint32_t(lut.size()));
+      Append(data, lut.data(), sizeof(T) * lut.size());
+      if (!AppendCompressedIntData<uint32_t, Usd_IntegerCompression>(data,
+                                                                     indices)) {
+        return false;
+      }
+      AddOutOfLine(ty, /* array */ true, data, rep);
+      rep->SetIsCompressed();
+      return true;
+    }
+
+    PackArrayRaw(ty, v, rep);
+    return true;
+  }
+
+  void PackTokenInline(crate::CrateDataTypeId ty, const value::token &tok,
+                       crate::ValueRep *rep) {
+    (*rep) = crate::ValueRep(int32_t(ty), /* inlined */ true, false,
+                             packer_.AddToken(tok).value);
+  }
+
+  void PackStringInline(const std::string &s, crate::ValueRep *rep) {
+    (*rep) =
+        crate::ValueRep(int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_STRING),
+                        /* inlined */ true, false, packer_.AddString(s).value);
+  }
+
+  // u64 n + StringIndex[n]
+  void AppendStringIndices(std::vector<uint8_t> &data,
+                           const std::vector<std::string> &strs) {
+    Append(data, uint64_t(strs.size()));
+    for (const auto &s : strs) {
+      Append(data, packer_.AddString(s).value);
+    }
+  }
+
+  // u64 n + TokenIndex[n]
+  void AppendTokenIndices(std::vector<uint8_t> &data,
+                          const std::vector<value::token> &toks) {
+    Append(data, uint64_t(toks.size()));
+    for (const auto &tok : toks) {
+      Append(data, packer_.AddToken(tok).value);
+    }
+  }
+
+  // u64 n + PathIndex[n]
+  bool AppendPathIndices(std::vector<uint8_t> &data,
+                         const std::vector<Path> &paths) {
+    Append(data, uint64_t(paths.size()));
+    for (const auto &p : paths) {
+      crate::PathIndex idx;
+      if (!GetPathIndex(p, &idx)) {
+        return false;
+      }
+      Append(data, idx.value);
+    }
+    return true;
+  }
+
+  void PackTokenVector(const std::vector<value::token> &toks,
+                       crate::ValueRep *rep) {
+    std::vector<uint8_t> data;
+    AppendTokenIndices(data, toks);
+    AddOutOfLine(crate::CrateDataTypeId::CRATE_DATA_TYPE_TOKEN_VECTOR,
+                 /* array */ false, data, rep);
+  }
+
+  void PackStringVector(const std::vector<std::string> &strs,
+                        crate::ValueRep *rep) {
+    std::vector<uint8_t> data;
+    AppendStringIndices(data, strs);
+    AddOutOfLine(crate::CrateDataTypeId::CRATE_DATA_TYPE_STRING_VECTOR,
+                 /* array */ false, data, rep);
+  }
+
+  // Dictionary items: u64 n + (StringIndex key, int64 offset, ValueRep) x n
+  // Values are written before the dictionary data.
+  bool AppendDictionary(std::vector<uint8_t> &data,
+                        const CustomDataType &dict) {
+    std::vector<std::pair<crate::StringIndex, crate::ValueRep>> items;
+    for (const auto &item : dict) {
+      crate::ValueRep rep;
+      if (!PackValue(item.second.get_raw_value(), &rep)) {
+        PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to pack dictionary value `"
+                                            << item.first << "`");
+      }
+      items.emplace_back(packer_.AddString(item.first), rep);
+    }
+
+    Append(data, uint64_t(items.size()));
+    for (const auto &item : items) {
+      Append(data, item.first.value);
+      // Relative offset to ValueRep(8 = ValueRep is placed right after the
+      // offset).
+      Append(data, int64_t(8));
+      Append(data, item.second.GetData());
+    }
+
+    return true;
+  }
+
+  bool PackDictionary(const CustomDataType &dict, crate::ValueRep *rep) {
+    if (dict.empty()) {
+      (*rep) = crate::ValueRep(
+          int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_DICTIONARY),
+          /* inlined */ true, false, 0);
+      return true;
+    }
+
+    std::vector<uint8_t> data;
+    if (!AppendDictionary(data, dict)) {
+      return false;
+    }
+
+    AddOutOfLine(crate::CrateDataTypeId::CRATE_DATA_TYPE_DICTIONARY, false,
+                 data, rep);
+    return true;
+  }
+
+  static uint8_t ListOpHeaderBits(ListEditQual qual) {
+    switch (qual) {
+      case ListEditQual::ResetToExplicit:
+        return ListOpHeader::IsExplicitBit | ListOpHeader::HasExplicitItemsBit;
+      case ListEditQual::Append:
+        return ListOpHeader::HasAppendedItemsBit;
+      case ListEditQual::Add:
+        return ListOpHeader::HasAddedItemsBit;
+      case ListEditQual::Delete:
+        return ListOpHeader::HasDeletedItemsBit;
+      case ListEditQual::Prepend:
+        return ListOpHeader::HasPrependedItemsBit;
+      case ListEditQual::Order:
+        return ListOpHeader::HasOrderedItemsBit;
+      case ListEditQual::Invalid:
+        break;
+    }
+    return 0;
+  }
+
+  //
+  // ListOp with single list.
+  // `append_items` appends `u64 n + items` to the data.
+  //
+  template <typename F>
+  bool PackListOp(crate::CrateDataTypeId ty, ListEditQual qual,
+                  F append_items, crate::ValueRep *rep) {
+    uint8_t bits = ListOpHeaderBits(qual);
+    if (bits == 0) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Invalid ListEdit qualifier.");
+    }
+
+    std::vector<uint8_t> data;
+    Append(data, bits);
+    if (!append_items(data)) {
+      return false;
+    }
+
+    AddOutOfLine(ty, false, data, rep);
+    return true;
+  }
+
+  bool PackTokenListOp(ListEditQual qual, const std::vector<value::token> &toks,
+                       crate::ValueRep *rep) {
+    return PackListOp(crate::CrateDataTypeId::CRATE_DATA_TYPE_TOKEN_LIST_OP,
+                      qual,
+                      [&](std::vector<uint8_t> &data) {
+                        AppendTokenIndices(data, toks);
+                        return true;
+                      },
+                      rep);
+  }
+
+  bool PackStringListOp(ListEditQual qual, const std::vector<std::string> &strs,
+                        crate::ValueRep *rep) {
+    return PackListOp(crate::CrateDataTypeId::CRATE_DATA_TYPE_STRING_LIST_OP,
+                      qual,
+                      [&](std::vector<uint8_t> &data) {
+                        AppendStringIndices(data, strs);
+                        return true;
+                      },
+                      rep);
+  }
+
+  bool PackPathListOp(ListEditQual qual, const std::vector<Path> &paths,
+                      crate::ValueRep *rep) {
+    return PackListOp(crate::CrateDataTypeId::CRATE_DATA_TYPE_PATH_LIST_OP,
+                      qual,
+                      [&](std::vector<uint8_t> &data) {
+                        return AppendPathIndices(data, paths);
+                      },
+                      rep);
+  }
+
+  bool PackReferenceListOp(ListEditQual qual, const std::vector<Reference> &refs,
+                           crate::ValueRep *rep) {
+    return PackListOp(
+        crate::CrateDataTypeId::CRATE_DATA_TYPE_REFERENCE_LIST_OP, qual,
+        [&](std::vector<uint8_t> &data) {
+          Append(data, uint64_t(refs.size()));
+          for (const auto &ref : refs) {
+            crate::PathIndex path_idx;
+            if (!GetPathIndex(ref.prim_path, &path_idx)) {
+              return false;
+            }
+            Append(data, packer_.AddString(ref.asset_path.GetAssetPath()).value);
+            Append(data, path_idx.value);
+            Append(data, ref.layerOffset._offset);
+            Append(data, ref.layerOffset._scale);
+            if (!AppendDictionary(data, ref.customData)) {
+              return false;
+            }
+          }
+          return true;
+        },
+        rep);
+  }
+
+  bool PackPayloadListOp(ListEditQual qual, const std::vector<Payload> &pls,
+                         crate::ValueRep *rep) {
+    return PackListOp(
+        crate::CrateDataTypeId::CRATE_DATA_TYPE_PAYLOAD_LIST_OP, qual,
+        [&](std::vector<uint8_t> &data) {
+          Append(data, uint64_t(pls.size()));
+          for (const auto &pl : pls) {
+            crate::PathIndex path_idx;
+            if (!GetPathIndex(pl.prim_path, &path_idx)) {
+              return false;
+            }
+            Append(data, packer_.AddString(pl.asset_path.GetAssetPath()).value);
+            Append(data, path_idx.value);
+            Append(data, pl.layerOffset._offset);
+            Append(data, pl.layerOffset._scale);
+          }
+          return true;
+        },
+        rep);
+  }
+
+  void PackVariantSelectionMap(const VariantSelectionMap &vsmap,
+                               crate::ValueRep *rep) {
+    std::vector<uint8_t> data;
+    Append(data, uint64_t(vsmap.size()));
+    for (const auto &item : vsmap) {
+      Append(data, packer_.AddString(item.first).value);
+      Append(data, packer_.AddString(item.second).value);
+    }
+    AddOutOfLine(crate::CrateDataTypeId::CRATE_DATA_TYPE_VARIANT_SELECTION_MAP,
+                 false, data, rep);
+  }
+
+  bool PackTimeSamples(const value::TimeSamples &ts, crate::ValueRep *rep) {
+    const std::vector<double> &times = ts.get_times();
+    std::vector<crate::ValueRep> values;
+    values.reserve(times.size());
+    for (size_t i = 0; i < times.size(); i++) {
+      crate::ValueRep vrep;
+      if (ts.is_blocked(i)) {
+        vrep = crate::ValueRep(
+            int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_VALUE_BLOCK),
+            /* inlined */ true, false, 0);
+      } else if (!PackValue(ts.get_value(i).value(), &vrep)) {
+        PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to pack TimeSamples value.");
+      }
+      values.push_back(vrep);
+    }
+
+    // `times` is stored as double[] and shared among TimeSamples.
+    crate::ValueRep times_rep;
+    PackArrayRaw(crate::CrateDataTypeId::CRATE_DATA_TYPE_DOUBLE, times,
+                 &times_rep);
+
+    std::vector<uint8_t> data;
+    Append(data, int64_t(8));
+    Append(data, times_rep.GetData());
+    Append(data, int64_t(8));
+    Append(data, uint64_t(values.size()));
+    for (const auto &v : values) {
+      Append(data, v.GetData());
+    }
+
+    AddOutOfLine(crate::CrateDataTypeId::CRATE_DATA_TYPE_TIME_SAMPLES, false,
+                 data, rep);
+    return true;
+  }
+
+  ///
+  /// Pack value into ValueRep. Out-of-line values are written to the value
+  /// data.
+  ///
+  bool PackValue(const value::Value &v, crate::ValueRep *rep) {
+    using Ty = crate::CrateDataTypeId;
+
+    const uint32_t tyid = v.underlying_type_id();
+
+#define PACK_INLINE_OR_RAW(__tyid, __ty, __crate_ty)     \
+  case value::TypeId::__tyid: {                          \
+    PackInlineOrRaw(Ty::__crate_ty, *v.as<__ty>(), rep); \
+    return true;                                         \
+  }
+
+#define PACK_RAW(__tyid, __ty, __crate_ty)     \
+  case value::TypeId::__tyid: {                \
+    PackRaw(Ty::__crate_ty, *v.as<__ty>(), rep); \
+    return true;                               \
+  }
+
+#define PACK_ARRAY_RAW(__tyid, __ty, __crate_ty)                      \
+  case value::TypeId::__tyid | value::TYPE_ID_1D_ARRAY_BIT: {         \
+    PackArrayRaw(Ty::__crate_ty, *v.as<std::vector<__ty>>(), rep);    \
+    return true;                                                      \
+  }
+
+    switch (tyid) {
+      case value::TypeId::TYPE_ID_VALUEBLOCK: {
+        (*rep) = crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_VALUE_BLOCK),
+                                 /* inlined */ true, false, 0);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_BOOL: {
+        (*rep) = crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_BOOL), true, false,
+                                 (*v.as<bool>()) ? 1 : 0);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_UCHAR: {
+        (*rep) = crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_UCHAR), true,
+                                 false, *v.as<uint8_t>());
+        return true;
+      }
+      case value::TypeId::TYPE_ID_INT32: {
+        uint32_t d{0};
+        memcpy(&d, v.as<int32_t>(), sizeof(int32_t));
+        (*rep) =
+            crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_INT), true, false, d);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_UINT32: {
+        (*rep) = crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_UINT), true, false,
+                                 *v.as<uint32_t>());
+        return true;
+      }
+      case value::TypeId::TYPE_ID_HALF: {
+        (*rep) = crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_HALF), true, false,
+                                 v.as<value::half>()->value);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_FLOAT: {
+        uint32_t d{0};
+        memcpy(&d, v.as<float>(), sizeof(float));
+        (*rep) =
+            crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_FLOAT), true, false, d);
+        return true;
+      }
+      PACK_INLINE_OR_RAW(TYPE_ID_INT64, int64_t, CRATE_DATA_TYPE_INT64)
+      PACK_INLINE_OR_RAW(TYPE_ID_UINT64, uint64_t, CRATE_DATA_TYPE_UINT64)
+      PACK_INLINE_OR_RAW(TYPE_ID_DOUBLE, double, CRATE_DATA_TYPE_DOUBLE)
+      case value::TypeId::TYPE_ID_TIMECODE: {
+        PackInlineOrRaw(Ty::CRATE_DATA_TYPE_DOUBLE,
+                        v.as<value::timecode>()->value, rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_TOKEN: {
+        PackTokenInline(Ty::CRATE_DATA_TYPE_TOKEN, *v.as<value::token>(), rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_STRING: {
+        PackStringInline(*v.as<std::string>(), rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_STRING_DATA: {
+        PackStringInline(v.as<value::StringData>()->value, rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_ASSET_PATH: {
+        PackTokenInline(Ty::CRATE_DATA_TYPE_ASSET_PATH,
+                        value::token(v.as<value::AssetPath>()->GetAssetPath()),
+                        rep);
+        return true;
+      }
+      PACK_INLINE_OR_RAW(TYPE_ID_MATRIX2D, value::matrix2d,
+                         CRATE_DATA_TYPE_MATRIX2D)
+      PACK_INLINE_OR_RAW(TYPE_ID_MATRIX3D, value::matrix3d,
+                         CRATE_DATA_TYPE_MATRIX3D)
+      PACK_INLINE_OR_RAW(TYPE_ID_MATRIX4D, value::matrix4d,
+                         CRATE_DATA_TYPE_MATRIX4D)
+      PACK_RAW(TYPE_ID_QUATD, value::quatd, CRATE_DATA_TYPE_QUATD)
+      PACK_RAW(TYPE_ID_QUATF, value::quatf, CRATE_DATA_TYPE_QUATF)
+      PACK_RAW(TYPE_ID_QUATH, value::quath, CRATE_DATA_TYPE_QUATH)
+      PACK_INLINE_OR_RAW(TYPE_ID_DOUBLE2, value::double2, CRATE_DATA_TYPE_VEC2D)
+      PACK_INLINE_OR_RAW(TYPE_ID_FLOAT2, value::float2, CRATE_DATA_TYPE_VEC2F)
+      PACK_RAW(TYPE_ID_HALF2, value::half2, CRATE_DATA_TYPE_VEC2H)
+      PACK_INLINE_OR_RAW(TYPE_ID_INT2, value::int2, CRATE_DATA_TYPE_VEC2I)
+      PACK_INLINE_OR_RAW(TYPE_ID_DOUBLE3, value::double3, CRATE_DATA_TYPE_VEC3D)
+      PACK_INLINE_OR_RAW(TYPE_ID_FLOAT3, value::float3, CRATE_DATA_TYPE_VEC3F)
+      PACK_RAW(TYPE_ID_HALF3, value::half3, CRATE_DATA_TYPE_VEC3H)
+      PACK_INLINE_OR_RAW(TYPE_ID_INT3, value::int3, CRATE_DATA_TYPE_VEC3I)
+      PACK_INLINE_OR_RAW(TYPE_ID_DOUBLE4, value::double4, CRATE_DATA_TYPE_VEC4D)
+      PACK_INLINE_OR_RAW(TYPE_ID_FLOAT4, value::float4, CRATE_DATA_TYPE_VEC4F)
+      PACK_RAW(TYPE_ID_HALF4, value::half4, CRATE_DATA_TYPE_VEC4H)
+      PACK_INLINE_OR_RAW(TYPE_ID_INT4, value::int4, CRATE_DATA_TYPE_VEC4I)
+      case value::TypeId::TYPE_ID_DICT: {
+        if (auto d = crate::TryEncodeInline(*v.as<value::dict>())) {
+          (*rep) = crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_DICTIONARY),
+                                   true, false, d.value());
+          return true;
+        }
+        PUSH_ERROR_AND_RETURN_TAG(
+            kTag, "Non-empty `dict` value is not supported. Use CustomData.");
+      }
+      case value::TypeId::TYPE_ID_CUSTOMDATA: {
+        return PackDictionary(*v.as<CustomDataType>(), rep);
+      }
+
+      //
+      // Arrays
+      //
+      case value::TypeId::TYPE_ID_BOOL | value::TYPE_ID_1D_ARRAY_BIT: {
+        const std::vector<bool> &bv = *v.as<std::vector<bool>>();
+        std::vector<uint8_t> u8v(bv.size());
+        for (size_t i = 0; i < bv.size(); i++) {
+          u8v[i] = bv[i] ? 1 : 0;
+        }
+        PackArrayRaw(Ty::CRATE_DATA_TYPE_BOOL, u8v, rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_INT32 | value::TYPE_ID_1D_ARRAY_BIT: {
+        return PackIntArray<int32_t, Usd_IntegerCompression>(
+            Ty::CRATE_DATA_TYPE_INT, *v.as<std::vector<int32_t>>(), rep);
+      }
+      case value::TypeId::TYPE_ID_UINT32 | value::TYPE_ID_1D_ARRAY_BIT: {
+        return PackIntArray<uint32_t, Usd_IntegerCompression>(
+            Ty::CRATE_DATA_TYPE_UINT, *v.as<std::vector<uint32_t>>(), rep);
+      }
+      case value::TypeId::TYPE_ID_INT64 | value::TYPE_ID_1D_ARRAY_BIT: {
+        return PackIntArray<int64_t, Usd_IntegerCompression64>(
+            Ty::CRATE_DATA_TYPE_INT64, *v.as<std::vector<int64_t>>(), rep);
+      }
+      case value::TypeId::TYPE_ID_UINT64 | value::TYPE_ID_1D_ARRAY_BIT: {
+        return PackIntArray<uint64_t, Usd_IntegerCompression64>(
+            Ty::CRATE_DATA_TYPE_UINT64, *v.as<std::vector<uint64_t>>(), rep);
+      }
+      case value::TypeId::TYPE_ID_TIMECODE | value::TYPE_ID_1D_ARRAY_BIT: {
+        const auto &tv = *v.as<std::vector<value::timecode>>();
+        std::vector<double> dv(tv.size());
+        for (size_t i = 0; i < tv.size(); i++) {
+          dv[i] = tv[i].value;
+        }
+        PackArrayRaw(Ty::CRATE_DATA_TYPE_DOUBLE, dv, rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_TOKEN_VECTOR:  // == token[]
+      case value::TypeId::TYPE_ID_TOKEN | value::TYPE_ID_1D_ARRAY_BIT: {
+        const auto &tv = *v.as<std::vector<value::token>>();
+        if (tv.empty()) {
+          (*rep) = crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_TOKEN), false,
+                                   true, 0);
+          return true;
+        }
+        std::vector<uint8_t> data;
+        AppendTokenIndices(data, tv);
+        AddOutOfLine(Ty::CRATE_DATA_TYPE_TOKEN, /* array */ true, data, rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_STRING | value::TYPE_ID_1D_ARRAY_BIT: {
+        std::vector<uint8_t> data;
+        AppendStringIndices(data, *v.as<std::vector<std::string>>());
+        AddOutOfLine(Ty::CRATE_DATA_TYPE_STRING, /* array */ true, data, rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_STRING_DATA | value::TYPE_ID_1D_ARRAY_BIT: {
+        std::vector<std::string> strs;
+        for (const auto &s : *v.as<std::vector<value::StringData>>()) {
+          strs.push_back(s.value);
+        }
+        std::vector<uint8_t> data;
+        AppendStringIndices(data, strs);
+        AddOutOfLine(Ty::CRATE_DATA_TYPE_STRING, /* array */ true, data, rep);
+        return true;
+      }
+      case value::TypeId::TYPE_ID_ASSET_PATH | value::TYPE_ID_1D_ARRAY_BIT: {
+        const auto &av = *v.as<std::vector<value::AssetPath>>();
+        if (av.empty()) {
+          (*rep) = crate::ValueRep(int32_t(Ty::CRATE_DATA_TYPE_ASSET_PATH),
+                                   false, true, 0);
+          return true;
+        }
+        std::vector<std::string> strs;
+        for (const auto &a : av) {
+          strs.push_back(a.GetAssetPath());
+        }
+        std::vector<uint8_t> data;
+        AppendStringIndices(data, strs);
+        AddOutOfLine(Ty::CRATE_DATA_TYPE_ASSET_PATH, /* array */ true, data,
+                     rep);
+        return true;
+      }
+      PACK_ARRAY_RAW(TYPE_ID_UCHAR, uint8_t, CRATE_DATA_TYPE_UCHAR)
+      case value::TypeId::TYPE_ID_HALF | value::TYPE_ID_1D_ARRAY_BIT: {
+        return PackFloatArray(
+            Ty::CRATE_DATA_TYPE_HALF, *v.as<std::vector<value::half>>(),
+            [](const value::half h) { return double(value::half_to_float(h)); },
+            rep);
+      }
+      case value::TypeId::TYPE_ID_FLOAT | value::TYPE_ID_1D_ARRAY_BIT: {
+        return PackFloatArray(Ty::CRATE_DATA_TYPE_FLOAT,
+                              *v.as<std::vector<float>>(),
+                              [](const float f) { return double(f); }, rep);
+      }
+      case value::TypeId::TYPE_ID_DOUBLE | value::TYPE_ID_1D_ARRAY_BIT: {
+        return PackFloatArray(Ty::CRATE_DATA_TYPE_DOUBLE,
+                              *v.as<std::vector<double>>(),
+                              [](const double d) { return d; }, rep);
+      }
+      PACK_ARRAY_RAW(TYPE_ID_MATRIX2D, value::matrix2d, CRATE_DATA_TYPE_MATRIX2D)
+      PACK_ARRAY_RAW(TYPE_ID_MATRIX3D, value::matrix3d, CRATE_DATA_TYPE_MATRIX3D)
+      PACK_ARRAY_RAW(TYPE_ID_MATRIX4D, value::matrix4d, CRATE_DATA_TYPE_MATRIX4D)
+      PACK_ARRAY_RAW(TYPE_ID_QUATD, value::quatd, CRATE_DATA_TYPE_QUATD)
+      PACK_ARRAY_RAW(TYPE_ID_QUATF, value::quatf, CRATE_DATA_TYPE_QUATF)
+      PACK_ARRAY_RAW(TYPE_ID_QUATH, value::quath, CRATE_DATA_TYPE_QUATH)
+      PACK_ARRAY_RAW(TYPE_ID_DOUBLE2, value::double2, CRATE_DATA_TYPE_VEC2D)
+      PACK_ARRAY_RAW(TYPE_ID_FLOAT2, value::float2, CRATE_DATA_TYPE_VEC2F)
+      PACK_ARRAY_RAW(TYPE_ID_HALF2, value::half2, CRATE_DATA_TYPE_VEC2H)
+      PACK_ARRAY_RAW(TYPE_ID_INT2, value::int2, CRATE_DATA_TYPE_VEC2I)
+      PACK_ARRAY_RAW(TYPE_ID_DOUBLE3, value::double3, CRATE_DATA_TYPE_VEC3D)
+      PACK_ARRAY_RAW(TYPE_ID_FLOAT3, value::float3, CRATE_DATA_TYPE_VEC3F)
+      PACK_ARRAY_RAW(TYPE_ID_HALF3, value::half3, CRATE_DATA_TYPE_VEC3H)
+      PACK_ARRAY_RAW(TYPE_ID_INT3, value::int3, CRATE_DATA_TYPE_VEC3I)
+      PACK_ARRAY_RAW(TYPE_ID_DOUBLE4, value::double4, CRATE_DATA_TYPE_VEC4D)
+      PACK_ARRAY_RAW(TYPE_ID_FLOAT4, value::float4, CRATE_DATA_TYPE_VEC4F)
+      PACK_ARRAY_RAW(TYPE_ID_HALF4, value::half4, CRATE_DATA_TYPE_VEC4H)
+      PACK_ARRAY_RAW(TYPE_ID_INT4, value::int4, CRATE_DATA_TYPE_VEC4I)
+      default:
+        break;
+    }
+
+#undef PACK_INLINE_OR_RAW
+#undef PACK_RAW
+#undef PACK_ARRAY_RAW
+
+    PUSH_ERROR_AND_RETURN_TAG(kTag, "Unsupported value type for USDC writer: "
+                                        << v.type_name());
+  }
+
+  //
+  // Fields
+  //
+
+  void AddField(const std::string &name, const crate::ValueRep &rep,
+                std::vector<crate::FieldIndex> *fields) {
+    crate::Field field;
+    field.token_index = packer_.AddToken(value::token(name));
+    field.value_rep = rep;
+    fields->push_back(packer_.AddField(field));
+  }
+
+  void AddTokenField(const std::string &name, const value::token &tok,
+                     std::vector<crate::FieldIndex> *fields) {
+    crate::ValueRep rep;
+    PackTokenInline(crate::CrateDataTypeId::CRATE_DATA_TYPE_TOKEN, tok, &rep);
+    AddField(name, rep, fields);
+  }
+
+  void AddStringField(const std::string &name, const std::string &s,
+                      std::vector<crate::FieldIndex> *fields) {
+    crate::ValueRep rep;
+    PackStringInline(s, &rep);
+    AddField(name, rep, fields);
+  }
+
+  void AddBoolField(const std::string &name, bool b,
+                    std::vector<crate::FieldIndex> *fields) {
+    AddField(name,
+             crate::ValueRep(
+                 int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_BOOL), true,
+                 false, b ? 1 : 0),
+             fields);
+  }
+
+  void AddDoubleField(const std::string &name, double d,
+                      std::vector<crate::FieldIndex> *fields) {
+    crate::ValueRep rep;
+    PackInlineOrRaw(crate::CrateDataTypeId::CRATE_DATA_TYPE_DOUBLE, d, &rep);
+    AddField(name, rep, fields);
+  }
+
+  bool AddDictionaryField(const std::string &name, const CustomDataType &dict,
+                          std::vector<crate::FieldIndex> *fields) {
+    crate::ValueRep rep;
+    if (!PackDictionary(dict, &rep)) {
+      return false;
+    }
+    AddField(name, rep, fields);
+    return true;
+  }
+
+  void AddTokenVectorField(const std::string &name,
+                           const std::vector<value::token> &toks,
+                           std::vector<crate::FieldIndex> *fields) {
+    crate::ValueRep rep;
+    PackTokenVector(toks, &rep);
+    AddField(name, rep, fields);
+  }
+
+  bool AddPathListOpField(
+      const std::string &name,
+      const std::pair<ListEditQual, std::vector<Path>> &listop,
+      std::vector<crate::FieldIndex> *fields) {
+    crate::ValueRep rep;
+    if (!PackPathListOp(listop.first, listop.second, &rep)) {
+      return false;
+    }
+    AddField(name, rep, fields);
+    return true;
+  }
+
+  bool BuildLayerFields(const std::vector<std::string> &root_prim_names,
+                        std::vector<crate::FieldIndex> *fields) {
+    const LayerMetas &metas = layer_.metas();
+
+    if (metas.upAxis.authored()) {
+      AddTokenField("upAxis", value::token(to_string(metas.upAxis.get_value())),
+                    fields);
+    }
+    if (metas.metersPerUnit.authored()) {
+      AddDoubleField("metersPerUnit", metas.metersPerUnit.get_value(), fields);
+    }
+    if (metas.timeCodesPerSecond.authored()) {
+      AddDoubleField("timeCodesPerSecond",
+                     metas.timeCodesPerSecond.get_value(), fields);
+    }
+    if (metas.framesPerSecond.authored()) {
+      AddDoubleField("framesPerSecond", metas.framesPerSecond.get_value(),
+                     fields);
+    }
+    if (metas.startTimeCode.authored()) {
+      AddDoubleField("startTimeCode", metas.startTimeCode.get_value(), fields);
+    }
+    if (metas.endTimeCode.authored()) {
+      AddDoubleField("endTimeCode", metas.endTimeCode.get_value(), fields);
+    }
+    if (metas.defaultPrim.valid()) {
+      AddTokenField("defaultPrim", metas.defaultPrim, fields);
+    }
+    if (metas.subLayers.size()) {
+      std::vector<std::string> paths;
+      std::vector<uint8_t> offsets;
+      Append(offsets, uint64_t(metas.subLayers.size()));
+      for (const auto &sublayer : metas.subLayers) {
+        paths.push_back(sublayer.assetPath.GetAssetPath());
+        Append(offsets, sublayer.layerOffset._offset);
+        Append(offsets, sublayer.layerOffset._scale);
+      }
+
+      crate::ValueRep rep;
+      PackStringVector(paths, &rep);
+      AddField("subLayers", rep, fields);
+
+      AddOutOfLine(crate::CrateDataTypeId::CRATE_DATA_TYPE_LAYER_OFFSET_VECTOR,
+                   false, offsets, &rep);
+      AddField("subLayerOffsets", rep, fields);
+    }
+    if (metas.comment.value.size()) {
+      AddStringField("comment", metas.comment.value, fields);
+    }
+    if (metas.doc.value.size()) {
+      AddStringField("documentation", metas.doc.value, fields);
+    }
+    if (metas.customLayerData.size()) {
+      if (!AddDictionaryField("customLayerData", metas.customLayerData,
+                              fields)) {
+        return false;
+      }
+    }
+    if (metas.autoPlay.authored()) {
+      AddBoolField("autoPlay", metas.autoPlay.get_value(), fields);
+    }
+    if (metas.playbackMode.authored()) {
+      AddTokenField(
+          "playbackMode",
+          value::token(metas.playbackMode.get_value() ==
+                               LayerMetas::PlaybackMode::PlaybackModeNone
+                           ? "none"
+                           : "loop"),
+          fields);
+    }
+
+    // Always write `primChildren` so that FIELDS section is not empty.
+    std::vector<value::token> primChildren;
+    for (const auto &name : root_prim_names) {
+      primChildren.push_back(value::token(name));
+    }
+    AddTokenVectorField("primChildren", primChildren, fields);
+
+    return true;
+  }
+
+  // Variant(`is_variant` = true) has the same fields with Prim except for
+  // `specifier`.
+  bool BuildPrimFields(const PrimSpec &ps, bool is_variant,
+                       std::vector<crate::FieldIndex> *fields) {
+    if (!is_variant) {
+      AddField("specifier",
+               crate::ValueRep(
+                   int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_SPECIFIER),
+                   true, false, uint64_t(ps.specifier())),
+               fields);
+    }
+
+    if (ps.typeName().size()) {
+      AddTokenField("typeName", value::token(ps.typeName()), fields);
+    }
+
+    const auto prop_names = GetPropertyNames(ps);
+    if (prop_names.size()) {
+      std::vector<value::token> toks;
+      for (const auto &name : prop_names) {
+        toks.push_back(value::token(name));
+      }
+      AddTokenVectorField("properties", toks, fields);
+    }
+
+    if (ps.children().size()) {
+      std::vector<value::token> toks;
+      for (const auto &child : ps.children()) {
+        toks.push_back(value::token(child.name()));
+      }
+      AddTokenVectorField("primChildren", toks, fields);
+    }
+
+    const auto vs_names = GetVariantSetNames(ps);
+    if (vs_names.size()) {
+      std::vector<value::token> toks;
+      for (const auto &name : vs_names) {
+        toks.push_back(value::token(name));
+      }
+      AddTokenVectorField("variantSetChildren", toks, fields);
+    }
+
+    const PrimMeta &metas = ps.metas();
+
+    if (metas.active) {
+      AddBoolField("active", metas.active.value(), fields);
+    }
+    if (metas.hidden) {
+      AddBoolField("hidden", metas.hidden.value(), fields);
+    }
+    if (metas.instanceable) {
+      AddBoolField("instanceable", metas.instanceable.value(), fields);
+    }
+    if (metas.kind) {
+      AddTokenField("kind", value::token(metas.get_kind()), fields);
+    }
+    if (metas.assetInfo) {
+      if (!AddDictionaryField("assetInfo", metas.assetInfo.value(), fields)) {
+        return false;
+      }
+    }
+    if (metas.customData) {
+      if (!AddDictionaryField("customData", metas.customData.value(), fields)) {
+        return false;
+      }
+    }
+    if (metas.sdrMetadata) {
+      if (!AddDictionaryField("sdrMetadata", metas.sdrMetadata.value(),
+                              fields)) {
+        return false;
+      }
+    }
+    if (metas.clips) {
+      if (!AddDictionaryField("clips", metas.clips.value(), fields)) {
+        return false;
+      }
+    }
+    if (metas.doc) {
+      AddStringField("documentation", metas.doc.value().value, fields);
+    }
+    if (metas.comment) {
+      AddStringField("comment", metas.comment.value().value, fields);
+    }
+    if (metas.apiSchemas) {
+      const APISchemas &schemas = metas.apiSchemas.value();
+      std::vector<value::token> toks;
+      for (const auto &item : schemas.names) {
+        std::string name = to_string(item.first);
+        if (item.second.size()) {
+          name += ":" + item.second;
+        }
+        toks.push_back(value::token(name));
+      }
+
+      crate::ValueRep rep;
+      if (!PackTokenListOp(schemas.listOpQual, toks, &rep)) {
+        return false;
+      }
+      AddField("apiSchemas", rep, fields);
+    }
+    if (metas.references) {
+      crate::ValueRep rep;
+      if (!PackReferenceListOp(metas.references.value().first,
+                               metas.references.value().second, &rep)) {
+        return false;
+      }
+      AddField("references", rep, fields);
+    }
+    if (metas.payload) {
+      crate::ValueRep rep;
+      if (!PackPayloadListOp(metas.payload.value().first,
+                             metas.payload.value().second, &rep)) {
+        return false;
+      }
+      AddField("payload", rep, fields);
+    }
+    if (metas.inherits) {
+      if (!AddPathListOpField("inherits", metas.inherits.value(), fields)) {
+        return false;
+      }
+    }
+    if (metas.specializes) {
+      if (!AddPathListOpField("specializes", metas.specializes.value(),
+                              fields)) {
+        return false;
+      }
+    }
+    if (metas.inheritPaths) {
+      if (!AddPathListOpField("inheritPaths", metas.inheritPaths.value(),
+                              fields)) {
+        return false;
+      }
+    }
+    if (metas.variantSets) {
+      crate::ValueRep rep;
+      if (!PackStringListOp(metas.variantSets.value().first,
+                            metas.variantSets.value().second, &rep)) {
+        return false;
+      }
+      AddField("variantSetNames", rep, fields);
+    }
+    if (metas.variants) {
+      crate::ValueRep rep;
+      PackVariantSelectionMap(metas.variants.value(), &rep);
+      AddField("variantSelection", rep, fields);
+    }
+    if (metas.sceneName) {
+      AddStringField("sceneName", metas.sceneName.value(), fields);
+    }
+    if (metas.displayName) {
+      AddStringField("displayName", metas.displayName.value(), fields);
+    }
+    for (const auto &item : metas.unregisteredMetas) {
+      AddStringField(item.first, item.second, fields);
+    }
+    for (const auto &item : metas.meta) {
+      if (!AddMetaVariableField(item.first, item.second, fields)) {
+        return false;
+      }
+    }
+
+    return true;
   }
 
-  // index = size of umap
-  string_to_index_map[str] = crate::StringIndex(uint32_t(strings_.size()));
-  strings_.emplace_back(str);
+  // Non-builtin metadatum. Written as a field with its value as is.
+  bool AddMetaVariableField(const std::string &name, const MetaVariable &var,
+                            std::vector<crate::FieldIndex> *fields) {
+    crate::ValueRep rep;
+    if (!PackValue(var.get_raw_value(), &rep)) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to pack metadatum `" << name
+                                          << "` of type `" << var.type_name()
+                                          << "`.");
+    }
+    AddField(name, rep, fields);
+    return true;
+  }
 
-  return string_to_index_map[str];
-}
+  bool BuildPropMetaFields(const AttrMeta &metas,
+                           std::vector<crate::FieldIndex> *fields) {
+    if (metas.interpolation) {
+      AddTokenField("interpolation",
+                    value::token(to_string(metas.interpolation.value())),
+                    fields);
+    }
+    if (metas.elementSize) {
+      AddField("elementSize",
+               crate::ValueRep(
+                   int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_INT), true,
+                   false, metas.elementSize.value()),
+               fields);
+    }
+    if (metas.hidden) {
+      AddBoolField("hidden", metas.hidden.value(), fields);
+    }
+    if (metas.comment) {
+      AddStringField("comment", metas.comment.value().value, fields);
+    }
+    if (metas.customData) {
+      if (!AddDictionaryField("customData", metas.customData.value(), fields)) {
+        return false;
+      }
+    }
+    if (metas.weight) {
+      // pxrUSD uses float type.
+      float w = float(metas.weight.value());
+      uint32_t d{0};
+      memcpy(&d, &w, sizeof(float));
+      AddField("weight",
+               crate::ValueRep(
+                   int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_FLOAT), true,
+                   false, d),
+               fields);
+    }
+    if (metas.connectability) {
+      AddTokenField("connectability", metas.connectability.value(), fields);
+    }
+    if (metas.outputName) {
+      AddTokenField("outputName", metas.outputName.value(), fields);
+    }
+    if (metas.renderType) {
+      AddTokenField("renderType", metas.renderType.value(), fields);
+    }
+    if (metas.sdrMetadata) {
+      if (!AddDictionaryField("sdrMetadata", metas.sdrMetadata.value(),
+                              fields)) {
+        return false;
+      }
+    }
+    if (metas.displayName) {
+      AddStringField("displayName", metas.displayName.value(), fields);
+    }
+    if (metas.bindMaterialAs) {
+      AddTokenField("bindMaterialAs", metas.bindMaterialAs.value(), fields);
+    }
+    for (const auto &item : metas.meta) {
+      if (item.first == "colorSpace") {
+        AddTokenField("colorSpace", metas.get_colorSpace(), fields);
+      } else if (item.first == "unauthoredValuesIndex") {
+        int idx = metas.get_unauthoredValuesIndex();
+        uint32_t d{0};
+        memcpy(&d, &idx, sizeof(int));
+        AddField("unauthoredValuesIndex",
+                 crate::ValueRep(
+                     int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_INT), true,
+                     false, d),
+                 fields);
+      } else {
+        if (!AddMetaVariableField(item.first, item.second, fields)) {
+          return false;
+        }
+      }
+    }
+    if (metas.stringData.size() == 1) {
+      // String-only metadatum is `doc` in pxrUSD.
+      AddStringField("documentation", metas.stringData[0].value, fields);
+    } else if (metas.stringData.size() > 1) {
+      PUSH_ERROR_AND_RETURN_TAG(
+          kTag, "Property can have at most one string-only metadatum(`doc`), "
+                "but got " << metas.stringData.size() << ".");
+    }
 
-crate::PathIndex Packer::AddPath(const Path &path) {
-  if (path_to_index_map.count(path)) {
-    return path_to_index_map[path];
+    return true;
   }
 
-  // index = size of umap
-  path_to_index_map[path] = crate::PathIndex(uint32_t(paths_.size()));
-  paths_.emplace_back(path);
+  bool BuildAttributeFields(const std::string &prop_name, const Property &prop,
+                            std::vector<crate::FieldIndex> *fields) {
+    const Attribute &attr = prop.get_attribute();
 
-  return path_to_index_map[path];
-}
+    AddTokenField("typeName", value::token(attr.type_name()), fields);
 
-crate::FieldIndex Packer::AddField(const crate::Field &field) {
-  if (field_to_index_map.count(field)) {
-    return field_to_index_map[field];
-  }
+    if (prop.has_custom()) {
+      AddBoolField("custom", true, fields);
+    }
 
-  // index = size of umap
-  field_to_index_map[field] = crate::FieldIndex(uint32_t(fields_.size()));
-  fields_.emplace_back(field);
+    if (attr.variability() == Variability::Uniform) {
+      AddField("variability",
+               crate::ValueRep(
+                   int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_VARIABILITY),
+                   true, false, 1),
+               fields);
+    }
 
-  return field_to_index_map[field];
-}
+    const primvar::PrimVar &var = attr.get_var();
+    if (var.is_blocked()) {
+      AddField("default",
+               crate::ValueRep(
+                   int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_VALUE_BLOCK),
+                   true, false, 0),
+               fields);
+    } else if (var.has_value()) {
+      crate::ValueRep rep;
+      if (!PackValue(var.value_raw(), &rep)) {
+        PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to pack default value of `"
+                                            << prop_name << "`");
+      }
+      AddField("default", rep, fields);
+    }
 
-crate::FieldSetIndex Packer::AddFieldSet(
-    const std::vector<crate::FieldIndex> &fieldset) {
-  if (fieldset_to_index_map.count(fieldset)) {
-    return fieldset_to_index_map[fieldset];
-  }
+    if (var.has_timesamples() && var.ts_raw().size()) {
+      crate::ValueRep rep;
+      if (!PackTimeSamples(var.ts_raw(), &rep)) {
+        PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to pack timeSamples of `"
+                                            << prop_name << "`");
+      }
+      AddField("timeSamples", rep, fields);
+    }
 
-  // index = size of umap = star index of FieldSet span.
-  fieldset_to_index_map[fieldset] =
-      crate::FieldSetIndex(uint32_t(fieldsets_.size()));
+    if (attr.connections().size()) {
+      if (!AddPathListOpField(
+              "connectionPaths",
+              std::make_pair(ListEditQual::ResetToExplicit, attr.connections()),
+              fields)) {
+        return false;
+      }
+    }
 
-  fieldsets_.insert(fieldsets_.end(), fieldset.begin(), fieldset.end());
-  fieldsets_.push_back(crate::FieldIndex());  // terminator(~0)
+    return BuildPropMetaFields(attr.metas(), fields);
+  }
 
-  return fieldset_to_index_map[fieldset];
-}
-#endif
+  bool BuildRelationshipFields(const Property &prop,
+                               std::vector<crate::FieldIndex> *fields) {
+    const Relationship &rel = prop.get_relationship();
 
-class Writer {
- public:
-  Writer(const Stage &stage) : stage_(stage) {}
+    if (prop.has_custom()) {
+      AddBoolField("custom", true, fields);
+    }
 
-  const Stage &stage_;
+    if (rel.is_varying_authored()) {
+      AddField("variability",
+               crate::ValueRep(
+                   int32_t(crate::CrateDataTypeId::CRATE_DATA_TYPE_VARIABILITY),
+                   true, false, 0),
+               fields);
+    }
 
-  const std::string &GetError() const { return err_; }
-  const std::string &GetWarning() const { return warn_; }
+    if (rel.is_blocked()) {
+      PUSH_WARN("ValueBlock Relationship is written as Relationship without "
+                "targets.");
+    } else if (rel.is_path()) {
+      if (!AddPathListOpField(
+              "targetPaths",
+              std::make_pair(prop.get_listedit_qual(),
+                             std::vector<Path>{rel.targetPath}),
+              fields)) {
+        return false;
+      }
+    } else if (rel.is_pathvector()) {
+      if (!AddPathListOpField(
+              "targetPaths",
+              std::make_pair(prop.get_listedit_qual(), rel.targetPathVector),
+              fields)) {
+        return false;
+      }
+    }
 
-  void PushError(const std::string &s) {
-    err_ += s;
+    return BuildPropMetaFields(rel.metas(), fields);
   }
 
-  void PushWarn(const std::string &s) {
-    warn_ += s;
+  bool BuildSpecs() {
+    std::vector<crate::FieldIndex> fields;
+    for (auto &spec : specs_) {
+      fields.clear();
+      if (spec.spec_type == SpecType::PseudoRoot) {
+        if (!BuildLayerFields(GetRootPrimNames(), &fields)) {
+          return false;
+        }
+      } else if ((spec.spec_type == SpecType::Prim) ||
+                 (spec.spec_type == SpecType::Variant)) {
+        if (!BuildPrimFields(*spec.prim, spec.spec_type == SpecType::Variant,
+                             &fields)) {
+          return false;
+        }
+      } else if (spec.spec_type == SpecType::VariantSet) {
+        std::vector<value::token> toks;
+        for (const auto &variant : spec.variant_set->variantSet) {
+          toks.push_back(value::token(variant.first));
+        }
+        AddTokenVectorField("variantChildren", toks, &fields);
+      } else if (spec.spec_type == SpecType::Relationship) {
+        if (!BuildRelationshipFields(*spec.prop, &fields)) {
+          return false;
+        }
+      } else {
+        if (!BuildAttributeFields(spec.prop_name, *spec.prop, &fields)) {
+          return false;
+        }
+      }
+      spec.fieldset = packer_.AddFieldSet(fields);
+    }
+
+    return true;
   }
 
-  bool WriteHeader(uint64_t toc_offset) {
-    char magic[8];
-    magic[0] = 'P';
-    magic[1] = 'X';
-    magic[2] = 'R';
-    magic[3] = '-';
-    magic[4] = 'U';
-    magic[5] = 'S';
-    magic[6] = 'D';
-    magic[7] = 'C';
+  //
+  // Sections
+  //
 
-    uint8_t version[8];  // Only first 3 bytes are used.
-    version[0] = 0;
-    version[1] = 8;
-    version[2] = 0;
+  void AddSection(const char *name, uint64_t start) {
+    crate::Section s;
+    strncpy(s.name, name, crate::kSectionNameMaxLength);
+    s.start = int64_t(start);
+    s.size = int64_t(buf_.size() - start);
+    toc_.sections.push_back(s);
+  }
 
-    std::array<uint8_t, 88> header;
-    memset(&header, 0, 88);
+  // u64 compressed size + compressed ints
+  template <typename T, typename Compressor>
+  bool AppendCompressedInts(const std::vector<T> &ints) {
+    std::vector<char> comp(Compressor::GetCompressedBufferSize(ints.size()));
+    std::string err;
+    size_t comp_size =
+        Compressor::CompressToBuffer(ints.data(), ints.size(), comp.data(), &err);
+    if (!err.empty() || (comp_size > comp.size())) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to compress integers. " << err);
+    }
 
-    memcpy(&header[0], magic, 8);
-    memcpy(&header[8], version, 8);
-    memcpy(&header[16], &toc_offset, 8);
+    Append(buf_, uint64_t(comp_size));
+    Append(buf_, comp.data(), comp_size);
+    return true;
+  }
 
-    oss_.write(reinterpret_cast<const char *>(&header[0]), 88);
+  // u64 compressed size + LZ4 compressed bytes
+  bool AppendLZ4(const char *data, size_t n) {
+    std::vector<char> comp(LZ4Compression::GetCompressedBufferSize(n));
+    std::string err;
+    size_t comp_size = LZ4Compression::CompressToBuffer(data, comp.data(), n, &err);
+    if (!err.empty() || (comp_size == ~size_t(0)) || (comp_size > comp.size())) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "LZ4 compression failed. " << err);
+    }
 
+    Append(buf_, uint64_t(comp_size));
+    Append(buf_, comp.data(), comp_size);
     return true;
   }
 
   bool WriteTokens() {
-    // Build single string separated by '\0', then compress it with lz4
-    std::ostringstream oss;
+    const uint64_t start = buf_.size();
 
-    auto tokens = packer_.GetTokens();
-
-    for (size_t i = 0; i < tokens.size(); i++) {
-      oss << tokens[i].str();
-
-      if (i != (tokens.size() - 1)) {
-        oss.put('\0');  // separator
-      }
+    // Build single string separated by '\0', then compress it with lz4
+    const auto &tokens = packer_.GetTokens();
+    std::string s;
+    for (const auto &tok : tokens) {
+      s += tok.str();
+      s.push_back('\0');
     }
-    // Last string does not terminated with `\0'
 
-    // compress
-    size_t input_bytes = oss.str().size();
-    if (input_bytes == 0) {
-      PUSH_ERROR("Invalid data size.");
+    Append(buf_, uint64_t(tokens.size()));
+    Append(buf_, uint64_t(s.size()));
+    if (!AppendLZ4(s.data(), s.size())) {
       return false;
     }
 
-    std::vector<char> buf;
-    buf.resize(LZ4Compression::GetCompressedBufferSize(input_bytes));
-
-    std::string err;
-    size_t n = LZ4Compression::CompressToBuffer(oss.str().data(), buf.data(),
-                                                input_bytes, &err);
+    AddSection("TOKENS", start);
+    return true;
+  }
 
-    (void)n;
+  bool WriteStrings() {
+    const uint64_t start = buf_.size();
 
-    if (!err.empty()) {
-      PUSH_ERROR(err);
-      return false;
+    const auto &strings = packer_.GetStrings();
+    Append(buf_, uint64_t(strings.size()));
+    for (const auto &idx : strings) {
+      Append(buf_, idx.value);
     }
 
+    AddSection("STRINGS", start);
     return true;
   }
 
-  bool WriteStrings() { return false; }
+  bool WriteFields() {
+    const uint64_t start = buf_.size();
 
-  bool WriteFields() { return false; }
+    const auto &fields = packer_.GetFields();
+    if (fields.empty()) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Empty fields.");
+    }
 
-  bool WriteFieldSets() { return false; }
+    std::vector<uint32_t> token_indices(fields.size());
+    std::vector<uint64_t> reps(fields.size());
+    for (size_t i = 0; i < fields.size(); i++) {
+      token_indices[i] = fields[i].token_index.value;
+      reps[i] = fields[i].value_rep.GetData();
+    }
 
-  bool WritePaths() { return false; }
+    Append(buf_, uint64_t(fields.size()));
+    if (!AppendCompressedInts<uint32_t, Usd_IntegerCompression>(
+            token_indices)) {
+      return false;
+    }
+    if (!AppendLZ4(reinterpret_cast<const char *>(reps.data()),
+                   sizeof(uint64_t) * reps.size())) {
+      return false;
+    }
 
-  bool WriteSpecs() { return false; }
+    AddSection("FIELDS", start);
+    return true;
+  }
 
-  bool WriteTOC() {
-    uint64_t num_sections = toc_.sections.size();
+  bool WriteFieldSets() {
+    const uint64_t start = buf_.size();
 
-    DCOUT("# of sections = " << std::to_string(num_sections));
+    const auto &fieldsets = packer_.GetFieldSets();
+    std::vector<uint32_t> indices(fieldsets.size());
+    for (size_t i = 0; i < fieldsets.size(); i++) {
+      indices[i] = fieldsets[i].value;
+    }
 
-    if (num_sections == 0) {
-      err_ += "Zero sections in TOC.\n";
+    Append(buf_, uint64_t(indices.size()));
+    if (!AppendCompressedInts<uint32_t, Usd_IntegerCompression>(indices)) {
       return false;
     }
 
-    // # of sections
-    oss_.write(reinterpret_cast<const char *>(&num_sections), 8);
-
+    AddSection("FIELDSETS", start);
     return true;
   }
 
-  bool Write() {
-    //
-    //  - TOC
-    //  - Tokens
-    //  - Strings
-    //  - Fields
-    //  - FieldSets
-    //  - Paths
-    //  - Specs
-    //
+  bool WritePaths() {
+    const uint64_t start = buf_.size();
 
-    if (!WriteTokens()) {
-      PUSH_ERROR("Failed to write Tokens.");
-      return false;
-    }
+    const size_t num_nodes = path_order_.size();
 
-    if (!WriteStrings()) {
-      PUSH_ERROR("Failed to write Strings.");
-      return false;
+    std::vector<uint32_t> path_indices(num_nodes);
+    std::vector<int32_t> element_token_indices(num_nodes);
+    std::vector<int32_t> jumps(num_nodes);
+
+    // Position of next sibling for each node.
+    std::vector<size_t> next_sibling(path_nodes_.size(), 0);
+    for (const auto &node : path_nodes_) {
+      for (size_t i = 0; (i + 1) < node.children.size(); i++) {
+        next_sibling[node.children[i]] = node.children[i + 1];
+      }
     }
 
-    if (!WriteFields()) {
-      PUSH_ERROR("Failed to write Fields.");
-      return false;
+    for (size_t i = 0; i < num_nodes; i++) {
+      const size_t id = path_order_[i];
+      const PathNode &node = path_nodes_[id];
+
+      path_indices[i] = node.path_index;
+      element_token_indices[i] = node.is_property
+                                     ? -int32_t(node.element.value)
+                                     : int32_t(node.element.value);
+
+      bool has_child = !node.children.empty();
+      bool has_sibling = next_sibling[id] != 0;
+      if (has_child && has_sibling) {
+        jumps[i] = int32_t(path_nodes_[next_sibling[id]].path_index) - int32_t(i);
+      } else if (has_child) {
+        jumps[i] = -1;
+      } else if (has_sibling) {
+        jumps[i] = 0;
+      } else {
+        jumps[i] = -2;
+      }
     }
 
-    if (!WriteFieldSets()) {
-      PUSH_ERROR("Failed to write FieldSets.");
+    const uint64_t num_paths = num_nodes + (has_empty_path_ ? 1 : 0);
+    Append(buf_, num_paths);
+    Append(buf_, uint64_t(num_nodes));
+
+    if (!AppendCompressedInts<uint32_t, Usd_IntegerCompression>(path_indices)) {
       return false;
     }
-
-    if (!WritePaths()) {
-      PUSH_ERROR("Failed to write Paths.");
+    if (!AppendCompressedInts<int32_t, Usd_IntegerCompression>(
+            element_token_indices)) {
       return false;
     }
-
-    if (!WriteSpecs()) {
-      PUSH_ERROR("Failed to write Specs.");
+    if (!AppendCompressedInts<int32_t, Usd_IntegerCompression>(jumps)) {
       return false;
     }
 
-    // TODO(syoyo): Add feature to support writing unknown section(custom user
-    // data)
-    // if (!WriteUnknownSections()) {
-    //  PUSH_ERROR("Failed to write custom sections.");
-    //  return false;
-    //}
+    AddSection("PATHS", start);
+    return true;
+  }
 
-    const uint64_t toc_offset = static_cast<uint64_t>(oss_.tellp());
-    if (!WriteTOC()) {
-      PUSH_ERROR("Failed to write TOC.");
-      return false;
+  bool WriteSpecs() {
+    const uint64_t start = buf_.size();
+
+    std::vector<uint32_t> path_indices;
+    std::vector<uint32_t> fieldset_indices;
+    std::vector<uint32_t> spec_types;
+    for (const auto &spec : specs_) {
+      path_indices.push_back(path_nodes_[spec.node].path_index);
+      fieldset_indices.push_back(spec.fieldset.value);
+      spec_types.push_back(uint32_t(spec.spec_type));
     }
 
-    // write header
-    oss_.seekp(0, std::ios::beg);
-    if (!WriteHeader(toc_offset)) {
-      PUSH_ERROR("Failed to write Header.");
+    Append(buf_, uint64_t(specs_.size()));
+    if (!AppendCompressedInts<uint32_t, Usd_IntegerCompression>(
+            path_indices)) {
+      return false;
+    }
+    if (!AppendCompressedInts<uint32_t, Usd_IntegerCompression>(
+            fieldset_indices)) {
+      return false;
+    }
+    if (!AppendCompressedInts<uint32_t, Usd_IntegerCompression>(spec_types)) {
       return false;
     }
 
+    AddSection("SPECS", start);
     return true;
   }
 
-  // Get serialized USDC binary data
-  bool GetOutput(std::vector<uint8_t> *output) {
-    if (!err_.empty()) {
-      return false;
+  bool WriteTOC() {
+    uint64_t num_sections = toc_.sections.size();
+
+    DCOUT("# of sections = " << std::to_string(num_sections));
+
+    if (num_sections == 0) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Zero sections in TOC.");
     }
 
-    (void)output;
+    // # of sections
+    Append(buf_, num_sections);
 
-    // TODO
-    return false;
+    for (const auto &s : toc_.sections) {
+      Append(buf_, s.name, crate::kSectionNameMaxLength + 1);
+      Append(buf_, s.start);
+      Append(buf_, s.size);
+    }
+
+    return true;
   }
 
- private:
-  Writer() = delete;
-  Writer(const Writer &) = delete;
+  static constexpr size_t kEmptyPathNode = ~size_t(0);
 
-  TableOfContents toc_;
+  const Layer &layer_;
 
   Packer packer_;
+  crate::TableOfContents toc_;
+
+  std::vector<PathNode> path_nodes_;  // [0] = root
+  std::unordered_map<std::string, size_t> path_to_node_;
+  std::vector<size_t> path_order_;  // node ids in depth-first order
+  bool has_empty_path_{false};
+  uint32_t empty_path_index_{0};
+
+  std::vector<SpecItem> specs_;
+
+  // hash -> offset of value data in `buf_`
+  std::unordered_multimap<uint64_t, uint64_t> value_data_map_;
 
   //
   // Serialized data
   //
-  std::ostringstream oss_;
+  std::vector<uint8_t> buf_;
 
   std::string err_;
   std::string warn_;
 };
 
-}  // namespace
+constexpr size_t Writer::kHeaderSize;
+constexpr size_t Writer::kEmptyPathNode;
 
-bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
-                      std::string *warn, std::string *err) {
+bool WriteToFile(const std::string &filename,
+                 const std::vector<uint8_t> &output, std::string *err) {
 #ifdef __ANDROID__
   (void)filename;
-  (void)stage;
-  (void)warn;
+  (void)output;
 
   if (err) {
     (*err) += "Saving USDC to a file is not supported for Android platform(at the moment).\n";
@@ -492,12 +2295,6 @@ bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
   return false;
 #else
 
-  std::vector<uint8_t> output;
-
-  if (!SaveAsUSDCToMemory(stage, &output, warn, err)) {
-    return false;
-  }
-
 #ifdef _WIN32
 #if defined(_MSC_VER) || defined(__GLIBCXX__) || defined(__clang__)
   FILE *fp = nullptr;
@@ -531,6 +2328,7 @@ bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
 #endif
 
   size_t n = fwrite(output.data(), /* size */ 1, /* count */ output.size(), fp);
+  fclose(fp);
   if (n < output.size()) {
     // TODO: Retry writing data when n < output.size()
 
@@ -544,19 +2342,69 @@ bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
 #endif
 }
 
+}  // namespace
+
+bool SaveAsUSDCToMemory(const Layer &layer, std::vector<uint8_t> *output,
+                        std::string *warn, std::string *err) {
+  if (!output) {
+    if (err) {
+      (*err) += "`output` argument is nullptr.\n";
+    }
+    return false;
+  }
+
+  Writer writer(layer);
+
+  bool ret = writer.Write();
+
+  if (warn && writer.GetWarning().size()) {
+    (*warn) += writer.GetWarning();
+  }
+
+  if (!ret) {
+    if (err) {
+      (*err) += writer.GetError();
+    }
+    return false;
+  }
+
+  return writer.GetOutput(output);
+}
+
 bool SaveAsUSDCToMemory(const Stage &stage, std::vector<uint8_t> *output,
                         std::string *warn, std::string *err) {
-  (void)warn;
-  (void)output;
+  // Stage holds composed Prims, so convert them back to PrimSpecs.
+  Layer layer;
+  if (!prim::StageToLayer(stage, &layer, warn, err)) {
+    if (err) {
+      (*err) += "Failed to convert Stage to Layer.\n";
+    }
+    return false;
+  }
 
-  // TODO
-  Writer writer(stage);
+  return SaveAsUSDCToMemory(layer, output, warn, err);
+}
 
-  if (err) {
-    (*err) += "USDC writer is not yet implemented.\n";
+bool SaveAsUSDCToFile(const std::string &filename, const Layer &layer,
+                      std::string *warn, std::string *err) {
+  std::vector<uint8_t> output;
+
+  if (!SaveAsUSDCToMemory(layer, &output, warn, err)) {
+    return false;
   }
 
-  return false;
+  return WriteToFile(filename, output, err);
+}
+
+bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
+                      std::string *warn, std::string *err) {
+  std::vector<uint8_t> output;
+
+  if (!SaveAsUSDCToMemory(stage, &output, warn, err)) {
+    return false;
+  }
+
+  return WriteToFile(filename, output, err);
 }
 
 }  // namespace usdc
@@ -593,6 +2441,33 @@ bool SaveAsUSDCToMemory(const Stage &stage, std::vector<uint8_t> *output,
   return false;
 }
 
+
+bool SaveAsUSDCToFile(const std::string &filename, const Layer &layer,
+                      std::string *warn, std::string *err) {
+  (void)filename;
+  (void)layer;
+  (void)warn;
+
+  if (err) {
+    (*err) = "USDC writer feature is disabled in this build.\n";
+  }
+
+  return false;
+}
+
+bool SaveAsUSDCToMemory(const Layer &layer, std::vector<uint8_t> *output,
+                        std::string *warn, std::string *err) {
+  (void)layer;
+  (void)output;
+  (void)warn;
+
+  if (err) {
+    (*err) = "USDC writer feature is disabled in this build.\n";
+  }
+
+  return false;
+}
+
 }  // namespace usdc
 }  // namespace tinyusdz
 
@@ -8,9 +8,40 @@
 namespace tinyusdz {
 namespace usdc {
 
+///
+/// Save Layer(PrimSpec tree) as USDC(binary) to a file
+///
+/// @param[in] filename USDC filename
+/// @param[in] layer Layer
+/// @param[out] warn Warning message
+/// @param[out] err Error message
+///
+/// @return true upon success.
+///
+bool SaveAsUSDCToFile(const std::string &filename, const Layer &layer,
+                      std::string *warn, std::string *err);
+
+///
+/// Save Layer(PrimSpec tree) as USDC(binary) to a memory
+///
+/// The result can be read back with `LoadLayerFromMemory`.
+///
+/// @param[in] layer Layer
+/// @param[out] output Binary data
+/// @param[out] warn Warning message
+/// @param[out] err Error message
+///
+/// @return true upon success.
+///
+bool SaveAsUSDCToMemory(const Layer &layer, std::vector<uint8_t> *output,
+                        std::string *warn, std::string *err);
+
 ///
 /// Save scene as USDC(binary) to a file
 ///
+/// Prims in Stage are converted to PrimSpecs(`prim::StageToLayer`) before
+/// writing.
+///
 /// @param[in] filename USDC filename
 /// @param[in] stage Stage
 /// @param[out] warn Warning message
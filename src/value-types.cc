@@ -3,6 +3,15 @@
 // Copyright 2023 - Present, Light Transport Entertainment Inc.
 #include "value-types.hh"
 
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+#include <mutex>
+#endif
+
 #include "str-util.hh"
 #include "value-pprint.hh"
 #include "value-eval-util.hh"
@@ -1076,36 +1085,608 @@ bool FlexibleTypeCast(const value::Value &src, value::Value &dst) {
 }
 #endif
 
-bool TimeSamples::has_sample_at(const double t) const {
-  if (_dirty) {
-    update();
+namespace {
+
+// Value types stored in the contiguous POD buffer of TimeSamples.
+#define APPLY_FUNC_TO_POD_TIMESAMPLE_TYPES(__FUNC) \
+  __FUNC(bool)                 \
+  __FUNC(int32_t)              \
+  __FUNC(uint32_t)             \
+  __FUNC(int2)                 \
+  __FUNC(int3)                 \
+  __FUNC(int4)                 \
+  __FUNC(uint2)                \
+  __FUNC(uint3)                \
+  __FUNC(uint4)                \
+  __FUNC(int64_t)              \
+  __FUNC(uint64_t)             \
+  __FUNC(half)                 \
+  __FUNC(half2)                \
+  __FUNC(half3)                \
+  __FUNC(half4)                \
+  __FUNC(float)                \
+  __FUNC(float2)               \
+  __FUNC(float3)               \
+  __FUNC(float4)               \
+  __FUNC(double)               \
+  __FUNC(double2)              \
+  __FUNC(double3)              \
+  __FUNC(double4)              \
+  __FUNC(quath)                \
+  __FUNC(quatf)                \
+  __FUNC(quatd)                \
+  __FUNC(normal3h)             \
+  __FUNC(normal3f)             \
+  __FUNC(normal3d)             \
+  __FUNC(vector3h)             \
+  __FUNC(vector3f)             \
+  __FUNC(vector3d)             \
+  __FUNC(point3h)              \
+  __FUNC(point3f)              \
+  __FUNC(point3d)              \
+  __FUNC(color3h)              \
+  __FUNC(color3f)              \
+  __FUNC(color3d)              \
+  __FUNC(color4h)              \
+  __FUNC(color4f)              \
+  __FUNC(color4d)              \
+  __FUNC(texcoord2h)           \
+  __FUNC(texcoord2f)           \
+  __FUNC(texcoord2d)           \
+  __FUNC(texcoord3h)           \
+  __FUNC(texcoord3f)           \
+  __FUNC(texcoord3d)           \
+  __FUNC(matrix2f)             \
+  __FUNC(matrix3f)             \
+  __FUNC(matrix4f)             \
+  __FUNC(matrix2d)             \
+  __FUNC(matrix3d)             \
+  __FUNC(matrix4d)             \
+  __FUNC(frame4d)
+
+// Returns 0 when the type is not stored as POD.
+size_t GetPODTimeSampleTypeSize(const uint32_t tyid) {
+#define POD_SIZE_GET(__ty) \
+  case TypeTraits<__ty>::type_id(): { \
+    return sizeof(__ty); \
   }
 
-  const auto it = std::find_if(_samples.begin(), _samples.end(), [&t](const Sample &s) {
-    return math::is_close(t, s.t);
-  });
+  switch (tyid) {
+    APPLY_FUNC_TO_POD_TIMESAMPLE_TYPES(POD_SIZE_GET)
+    default:
+      return 0;
+  }
+
+#undef POD_SIZE_GET
+}
+
+bool PODToValue(const uint32_t tyid, const uint8_t *src, Value *dst) {
+#define POD_TO_VALUE(__ty) \
+  case TypeTraits<__ty>::type_id(): { \
+    __ty v; \
+    memcpy(reinterpret_cast<void *>(&v), src, sizeof(__ty)); \
+    (*dst) = v; \
+    return true; \
+  }
+
+  switch (tyid) {
+    APPLY_FUNC_TO_POD_TIMESAMPLE_TYPES(POD_TO_VALUE)
+    default:
+      return false;
+  }
+
+#undef POD_TO_VALUE
+}
+
+bool ValueToPOD(const Value &v, uint8_t *dst) {
+#define VALUE_TO_POD(__ty) \
+  case TypeTraits<__ty>::type_id(): { \
+    if (const __ty *pv = v.as<__ty>()) { \
+      memcpy(dst, reinterpret_cast<const void *>(pv), sizeof(__ty)); \
+      return true; \
+    } \
+    return false; \
+  }
+
+  switch (v.type_id()) {
+    APPLY_FUNC_TO_POD_TIMESAMPLE_TYPES(VALUE_TO_POD)
+    default:
+      return false;
+  }
+
+#undef VALUE_TO_POD
+}
+
+#undef APPLY_FUNC_TO_POD_TIMESAMPLE_TYPES
+
+}  // namespace
+
+void TimeSamples::add_sample_impl(double t, const value::Value &v, bool blocked) {
+  if (v.type_id() == TypeTraits<ValueBlock>::type_id()) {
+    blocked = true;
+  }
+
+  if (_times.empty() && !blocked) {
+    size_t sz = GetPODTimeSampleTypeSize(v.type_id());
+    if (sz > 0) {
+      _values.clear();
+      _pod_values.clear();
+      _pod_type_id = v.type_id();
+      _pod_underlying_type_id = v.underlying_type_id();
+      _pod_size = sz;
+    }
+  }
+
+  // Keep samples sorted by time, so that const methods never need to reorder
+  // them. Samples are usually added in time order(append).
+  size_t pos = _times.size();
+  if (!_times.empty() && (t < _times.back())) {
+    pos = size_t(std::distance(
+        _times.begin(), std::upper_bound(_times.begin(), _times.end(), t)));
+  }
+
+  if (is_pod()) {
+    if (blocked && (v.type_id() != _pod_type_id)) {
+      // Store zeros for `None` sample.
+      _pod_values.insert(_pod_values.begin() + std::ptrdiff_t(pos * _pod_size),
+                         _pod_size, uint8_t(0));
+    } else if (v.type_id() == _pod_type_id) {
+      _pod_values.insert(_pod_values.begin() + std::ptrdiff_t(pos * _pod_size),
+                         _pod_size, uint8_t(0));
+      ValueToPOD(v, &_pod_values[pos * _pod_size]);
+    } else {
+      // Type differs from the previous samples. Fallback to `value::Value`
+      // storage.
+      unpack_pod_values();
+      _values.insert(_values.begin() + std::ptrdiff_t(pos), v);
+    }
+  } else {
+    _values.insert(_values.begin() + std::ptrdiff_t(pos), v);
+  }
+
+  _times.insert(_times.begin() + std::ptrdiff_t(pos), t);
+  _blocked.insert(_blocked.begin() + std::ptrdiff_t(pos), blocked);
+}
+
+void TimeSamples::unpack_pod_values() {
+  if (!is_pod()) {
+    return;
+  }
+
+  size_t n = _pod_size ? (_pod_values.size() / _pod_size) : 0;
+  _values.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    if (_blocked[i]) {
+      _values[i] = ValueBlock();
+    } else {
+      PODToValue(_pod_type_id, &_pod_values[i * _pod_size], &_values[i]);
+    }
+  }
+
+  _pod_values.clear();
+  _pod_values.shrink_to_fit();
+  _pod_type_id = TypeId::TYPE_ID_INVALID;
+  _pod_underlying_type_id = TypeId::TYPE_ID_INVALID;
+  _pod_size = 0;
+}
+
+void TimeSamples::reserve(size_t n) {
+  _times.reserve(n);
+  _blocked.reserve(n);
+  if (is_pod()) {
+    _pod_values.reserve(n * _pod_size);
+  } else {
+    _values.reserve(n);
+  }
+}
+
+nonstd::optional<value::Value> TimeSamples::get_value(size_t idx) const {
+  if (idx >= _times.size()) {
+    return nonstd::nullopt;
+  }
+
+  if (is_pod()) {
+    if (_blocked[idx]) {
+      return value::Value(ValueBlock());
+    }
+
+    value::Value v;
+    if (!PODToValue(_pod_type_id, &_pod_values[idx * _pod_size], &v)) {
+      return nonstd::nullopt;
+    }
+    return v;
+  }
+
+  return _values[idx];
+}
 
-  return (it != _samples.end());
+bool TimeSamples::lerp_pod_values(size_t idx0, size_t idx1, double dt,
+                                  void *dst) const {
+  const uint8_t *p0 = &_pod_values[idx0 * _pod_size];
+  const uint8_t *p1 = &_pod_values[idx1 * _pod_size];
+
+#define POD_LERP(__ty) \
+  case TypeTraits<__ty>::type_id(): { \
+    __ty v0, v1; \
+    memcpy(reinterpret_cast<void *>(&v0), p0, sizeof(__ty)); \
+    memcpy(reinterpret_cast<void *>(&v1), p1, sizeof(__ty)); \
+    const __ty c = lerp(v0, v1, dt); \
+    memcpy(dst, reinterpret_cast<const void *>(&c), sizeof(__ty)); \
+    return true; \
+  }
+
+  switch (_pod_type_id) {
+    POD_LERP(value::half)
+    POD_LERP(value::half2)
+    POD_LERP(value::half3)
+    POD_LERP(value::half4)
+    POD_LERP(float)
+    POD_LERP(value::float2)
+    POD_LERP(value::float3)
+    POD_LERP(value::float4)
+    POD_LERP(double)
+    POD_LERP(value::double2)
+    POD_LERP(value::double3)
+    POD_LERP(value::double4)
+    POD_LERP(value::quath)
+    POD_LERP(value::quatf)
+    POD_LERP(value::quatd)
+    POD_LERP(value::color3h)
+    POD_LERP(value::color3f)
+    POD_LERP(value::color3d)
+    POD_LERP(value::color4h)
+    POD_LERP(value::color4f)
+    POD_LERP(value::color4d)
+    POD_LERP(value::point3h)
+    POD_LERP(value::point3f)
+    POD_LERP(value::point3d)
+    POD_LERP(value::normal3h)
+    POD_LERP(value::normal3f)
+    POD_LERP(value::normal3d)
+    POD_LERP(value::vector3h)
+    POD_LERP(value::vector3f)
+    POD_LERP(value::vector3d)
+    POD_LERP(value::texcoord2h)
+    POD_LERP(value::texcoord2f)
+    POD_LERP(value::texcoord2d)
+    POD_LERP(value::texcoord3h)
+    POD_LERP(value::texcoord3f)
+    POD_LERP(value::texcoord3d)
+    POD_LERP(value::matrix2f)
+    POD_LERP(value::matrix3f)
+    POD_LERP(value::matrix4f)
+    POD_LERP(value::matrix2d)
+    POD_LERP(value::matrix3d)
+    POD_LERP(value::matrix4d)
+    POD_LERP(value::frame4d)
+    default:
+      return false;
+  }
+
+#undef POD_LERP
 }
 
-bool TimeSamples::get_sample_at(const double t, Sample **dst) {
+bool TimeSamples::get_interpolated_value(double t,
+                                         TimeSampleInterpolationType interp,
+                                         value::Value *dst,
+                                         TimeSampleCursor *cursor) const {
   if (!dst) {
     return false;
   }
 
-  if (_dirty) {
-    update();
+  if (empty()) {
+    return false;
   }
 
-  const auto it = std::find_if(_samples.begin(), _samples.end(), [&t](const Sample &sample) {
-    return math::is_close(t, sample.t);
+  if (value::TimeCode(t).is_default()) {
+    // FIXME: Use the first item for now.
+    if (_blocked[0]) {
+      return false;
+    }
+
+    (*dst) = get_value(0).value();
+    return true;
+  }
+
+  if ((interp == TimeSampleInterpolationType::Held) ||
+      !IsLerpSupportedType(type_id())) {
+    (*dst) = get_value(FindHeldTimeSampleIndex(_times, t, cursor)).value();
+    return true;
+  }
+
+  size_t idx0, idx1;
+  double dt;
+  FindLerpTimeSampleIndices(_times, t, &idx0, &idx1, &dt, cursor);
+
+  if (is_pod()) {
+    if (_blocked[idx0] || ((dt > 0.0) && _blocked[idx1])) {
+      return false;
+    }
+
+    std::vector<uint8_t> buf(_pod_size);
+    if (!lerp_pod_values(idx0, idx1, dt, buf.data())) {
+      return false;
+    }
+    return PODToValue(_pod_type_id, buf.data(), dst);
+  }
+
+  if (dt <= 0.0) {
+    (*dst) = _values[idx0];
+    return true;
+  }
+
+  return Lerp(_values[idx0], _values[idx1], dt, dst);
+}
+
+nonstd::optional<size_t> TimeSamples::get_sample_index_at(
+    const double t) const {
+  const auto it = std::find_if(_times.begin(), _times.end(), [&t](double st) {
+    return math::is_close(t, st);
   });
 
-  if (it != _samples.end()) {
-    (*dst) = &(*it); 
+  if (it == _times.end()) {
+    return nonstd::nullopt;
   }
-  return false;
+
+  return size_t(std::distance(_times.begin(), it));
+}
+
+bool TimeSamples::has_sample_at(const double t) const {
+  return get_sample_index_at(t).has_value();
+}
+
+bool TimeSamples::set_sample_at(const double t, const value::Value &v) {
+  auto idx = get_sample_index_at(t);
+  if (!idx) {
+    return false;
+  }
+
+  const bool blocked = (v.type_id() == TypeTraits<ValueBlock>::type_id());
+
+  if (is_pod()) {
+    if (blocked) {
+      memset(&_pod_values[idx.value() * _pod_size], 0, _pod_size);
+    } else if (v.type_id() == _pod_type_id) {
+      ValueToPOD(v, &_pod_values[idx.value() * _pod_size]);
+    } else {
+      unpack_pod_values();
+      _values[idx.value()] = v;
+    }
+  } else {
+    _values[idx.value()] = v;
+  }
+
+  _blocked[idx.value()] = blocked;
+
+  return true;
 }
 
 }  // namespace value
+
+#if !defined(TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE)
+
+//
+// -- TokenStorage
+//
+
+namespace {
+
+// Schema tokens used in prim-reconstruct.cc(allowedTokens of enum attributes,
+// interpolation, Prim type names), so that Tokens for them are found without
+// a lock.
+const char *const kSchemaTokens[] = {
+    // interpolation
+    "constant", "uniform", "varying", "vertex", "faceVarying",
+    // axis, visibility, purpose, orientation
+    "X", "Y", "Z", "inherited", "invisible", "default", "proxy", "render",
+    "guide", "rightHanded", "leftHanded",
+    // BasisCurves
+    "bezier", "bspline", "catmullRom", "cubic", "linear", "nonperiodic",
+    "periodic", "pinned",
+    // Mesh
+    "none", "catmullClark", "loop", "bilinear", "edgeAndCorner", "edgeOnly",
+    "cornersPlus1", "cornersPlus2", "cornersOnly", "boundaries", "all",
+    // GeomSubset
+    "face", "point", "edge", "partition", "nonOverlapping", "unrestricted",
+    "materialBind",
+    // Camera
+    "perspective", "orthographic", "mono", "left", "right",
+    // Shader
+    "auto", "raw", "sRGB", "useMetadata", "black", "clamp", "repeat", "mirror",
+    "surface", "displacement", "volume", "out", "rgb", "r", "g", "b", "a",
+    "UsdPreviewSurface", "UsdUVTexture", "UsdTransform2d",
+    "UsdPrimvarReader_int", "UsdPrimvarReader_float",
+    "UsdPrimvarReader_float2", "UsdPrimvarReader_float3",
+    "UsdPrimvarReader_float4",
+    // Kind
+    "model", "group", "assembly", "component", "subcomponent",
+    // Prim types
+    "Xform", "Mesh", "GeomSubset", "BasisCurves", "NurbsCurves", "Points",
+    "Cube", "Sphere", "Cone", "Cylinder", "Capsule", "Camera",
+    "PointInstancer", "Material", "Shader", "NodeGraph", "Scope", "Skeleton",
+    "SkelRoot", "SkelAnimation", "BlendShape", "SphereLight", "CylinderLight",
+    "DomeLight", "DiskLight", "RectLight", "DistantLight", "GeometryLight",
+    "PortalLight", "PluginLight",
+};
+
+constexpr size_t kTokenShardBits = 5;
+constexpr size_t kNumTokenShards = size_t(1) << kTokenShardBits;
+constexpr size_t kInitialTokenBuckets = 64;
+
+// FNV-1a
+size_t HashTokenString(const char *str, size_t len) {
+  uint64_t h = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; i++) {
+    h ^= uint64_t(uint8_t(str[i]));
+    h *= 1099511628211ULL;
+  }
+  return size_t(h ^ (h >> 32));
+}
+
+struct TokenBucketNode {
+  const TokenEntry *entry{nullptr};
+  const TokenBucketNode *next{nullptr};
+};
+
+struct TokenBuckets {
+  explicit TokenBuckets(size_t n)
+      : mask(n - 1), heads(new std::atomic<const TokenBucketNode *>[n]) {
+    for (size_t i = 0; i < n; i++) {
+      heads[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<const TokenBucketNode *> &head(size_t hash) {
+    return heads[(hash >> kTokenShardBits) & mask];
+  }
+
+  const std::atomic<const TokenBucketNode *> &head(size_t hash) const {
+    return heads[(hash >> kTokenShardBits) & mask];
+  }
+
+  size_t mask;
+  std::unique_ptr<std::atomic<const TokenBucketNode *>[]> heads;
+};
+
+//
+// Shard of the token table(chained hash table).
+// Nodes are published with release store, so readers can traverse a chain
+// without a lock. When the table grows, a new bucket array with new chain
+// nodes is published. Old bucket arrays are kept alive since readers may
+// still traverse them.
+//
+class TokenShard {
+ public:
+  TokenShard() {
+    _bucket_arrays.emplace_back(new TokenBuckets(kInitialTokenBuckets));
+    _buckets.store(_bucket_arrays.back().get(), std::memory_order_release);
+  }
+
+  // Lock-free
+  const TokenEntry *find(const char *str, size_t len, size_t hash) const {
+    const TokenBuckets *buckets = _buckets.load(std::memory_order_acquire);
+    const TokenBucketNode *node =
+        buckets->head(hash).load(std::memory_order_acquire);
+    while (node) {
+      const TokenEntry *e = node->entry;
+      if ((e->hash == hash) && (e->str.size() == len) &&
+          (memcmp(e->str.data(), str, len) == 0)) {
+        return e;
+      }
+      node = node->next;
+    }
+    return nullptr;
+  }
+
+  const TokenEntry *insert(const char *str, size_t len, size_t hash) {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+    std::lock_guard<std::mutex> lock(_mutex);
+#endif
+
+    // Other thread may already insert the string.
+    if (const TokenEntry *found = find(str, len, hash)) {
+      return found;
+    }
+
+    _entries.emplace_back();
+    TokenEntry *e = &_entries.back();
+    e->str.assign(str, len);
+    e->hash = hash;
+
+    TokenBuckets *buckets = _bucket_arrays.back().get();
+    if (_entries.size() > 2 * (buckets->mask + 1)) {
+      // Grow. Build chains for all entries then publish the new buckets.
+      _bucket_arrays.emplace_back(new TokenBuckets(4 * (buckets->mask + 1)));
+      buckets = _bucket_arrays.back().get();
+      for (const TokenEntry &entry : _entries) {
+        link(buckets, &entry);
+      }
+      _buckets.store(buckets, std::memory_order_release);
+    } else {
+      link(buckets, e);
+    }
+
+    return e;
+  }
+
+  size_t size() {
+#if defined(TINYUSDZ_ENABLE_THREAD)
+    std::lock_guard<std::mutex> lock(_mutex);
+#endif
+    return _entries.size();
+  }
+
+ private:
+  void link(TokenBuckets *buckets, const TokenEntry *e) {
+    std::atomic<const TokenBucketNode *> &head = buckets->head(e->hash);
+
+    _nodes.emplace_back();
+    TokenBucketNode *node = &_nodes.back();
+    node->entry = e;
+    node->next = head.load(std::memory_order_relaxed);
+    head.store(node, std::memory_order_release);
+  }
+
+#if defined(TINYUSDZ_ENABLE_THREAD)
+  std::mutex _mutex;
+#endif
+  std::atomic<const TokenBuckets *> _buckets{nullptr};
+
+  // std::deque does not move elements on emplace_back.
+  std::deque<TokenEntry> _entries;
+  std::deque<TokenBucketNode> _nodes;
+  std::vector<std::unique_ptr<TokenBuckets>> _bucket_arrays;
+};
+
+class TokenTable {
+ public:
+  static TokenTable &instance() {
+    // Intentionally leaked so that Tokens in static objects are valid until
+    // the program exits.
+    static TokenTable *table = new TokenTable();
+    return *table;
+  }
+
+  const TokenEntry *intern(const char *str, size_t len) {
+    if (len == 0) {
+      return nullptr;
+    }
+
+    size_t hash = HashTokenString(str, len);
+    TokenShard &shard = _shards[hash & (kNumTokenShards - 1)];
+    if (const TokenEntry *e = shard.find(str, len, hash)) {
+      return e;
+    }
+
+    return shard.insert(str, len, hash);
+  }
+
+  size_t size() {
+    size_t n = 0;
+    for (TokenShard &shard : _shards) {
+      n += shard.size();
+    }
+    return n;
+  }
+
+ private:
+  TokenTable() {
+    for (const char *tok : kSchemaTokens) {
+      intern(tok, strlen(tok));
+    }
+  }
+
+  TokenShard _shards[kNumTokenShards];
+};
+
+}  // namespace
+
+const TokenEntry *TokenStorage::intern(const char *str, size_t len) {
+  return TokenTable::instance().intern(str, len);
+}
+
+size_t TokenStorage::size() { return TokenTable::instance().size(); }
+
+#endif  // !TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
+
 }  // namespace tinyusdz
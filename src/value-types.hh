@@ -2254,18 +2254,131 @@ bool Lerp(const value::Value &a, const value::Value &b, double dt,
 
 
 
-// Handy, but may not be efficient for large time samples(e.g. 1M samples or
-// more)
+///
+/// Cursor for sequential time-sample lookup.
+///
+/// Remembers the index of the last found sample, so monotonically increasing
+/// queries(e.g. playback) reuse the last bracket instead of doing binary
+/// search over all samples. Owned by the caller: use one cursor per
+/// attribute(and per thread).
+///
+struct TimeSampleCursor {
+  size_t index{0};
+};
+
+///
+/// Find the index of the nearest preceding sample for a given time(`Held`
+/// interpolation). Returns 0 when `t` is less than the first time.
+///
+/// example:
+/// times = [0.0, 1.0]
+///
+/// t -1.0 => 0(time 0.0)
+/// t 0.0 => 0(time 0.0)
+/// t 0.9 => 0(time 0.0)
+/// t 1.0 => 1(time 1.0)
+///
+/// `times` must be sorted and non-empty.
+/// When `cursor` is given, search starts from the cursor position(exponential
+/// search), which is O(1) for sequential access and O(log n) at worst.
+///
+inline size_t FindHeldTimeSampleIndex(const std::vector<double> &times,
+                                      const double t,
+                                      TimeSampleCursor *cursor = nullptr) {
+  const size_t n = times.size();
+
+  // Search in [lo, hi). times[lo] <= t(unless lo == 0), t < times[hi](unless
+  // hi == n)
+  size_t lo = 0;
+  size_t hi = n;
+
+  if (cursor && (cursor->index < n)) {
+    const size_t c = cursor->index;
+    size_t step = 1;
+    if (times[c] <= t) {
+      lo = c;
+      while ((lo + step) < n) {
+        if (times[lo + step] <= t) {
+          lo += step;
+          step *= 2;
+        } else {
+          hi = lo + step;
+          break;
+        }
+      }
+    } else {
+      hi = c;
+      while (hi > 0) {
+        const size_t prev = (hi > step) ? (hi - step) : 0;
+        if (times[prev] <= t) {
+          lo = prev;
+          break;
+        }
+        hi = prev;
+        step *= 2;
+      }
+    }
+  }
+
+  // MS STL does not allow seek vector iterator before begin
+  // Issue #110
+  const auto begin = times.begin();
+  const auto it = std::upper_bound(begin + std::ptrdiff_t(lo),
+                                   begin + std::ptrdiff_t(hi), t);
+  const size_t idx = (it == begin) ? 0 : size_t(std::distance(begin, it) - 1);
+
+  if (cursor) {
+    cursor->index = idx;
+  }
+
+  return idx;
+}
+
+///
+/// Find the pair of samples and the interpolator [0.0, 1.0] for `Linear`
+/// interpolation at time `t`.
+///
+/// `times` must be sorted and non-empty.
+///
+inline void FindLerpTimeSampleIndices(const std::vector<double> &times,
+                                      const double t, size_t *idx0,
+                                      size_t *idx1, double *dt,
+                                      TimeSampleCursor *cursor = nullptr) {
+  const size_t i0 = FindHeldTimeSampleIndex(times, t, cursor);
+  const size_t i1 = (std::min)(times.size() - 1, i0 + 1);
+
+  double tl = times[i0];
+  double tu = times[i1];
+
+  double d = (t - tl);
+  if (std::fabs(tu - tl) < std::numeric_limits<double>::epsilon()) {
+    // slope is zero.
+    d = 0.0;
+  } else {
+    d /= (tu - tl);
+  }
+
+  // Just in case.
+  (*dt) = (std::max)(0.0, (std::min)(1.0, d));
+  (*idx0) = i0;
+  (*idx1) = i1;
+}
+
+// Time samples are stored in columnar(SoA) layout: sorted `times` array,
+// `blocked` bitset and values.
 //
-// For the runtime speed, with "-O2 -g" optimization, adding 10M `double`
-// samples to linb::any takes roughly 1.8 ms on Threadripper 1950X, whereas
-// simple vector<double> push_back takes 390 us(roughly x4 times faster). (Build
-// benchmarks to see the numbers on your CPU)
+// Values of POD types(scalar, vector, quat and matrix. e.g. `float`,
+// `point3f`, `matrix4d`) are stored in a contiguous byte buffer, without
+// `linb::any` boxing for each sample. Other types(array, string, ...) are
+// stored as `value::Value`.
 //
-// We assume having large time samples is rare situlation, and above benchmark
-// speed is acceptable in general  usecases.
+// For reference, with "-O2 -g" optimization, adding 10M `double` samples to
+// linb::any takes roughly 1.8 ms on Threadripper 1950X, whereas simple
+// vector<double> push_back takes 390 us(roughly x4 times faster). (Build
+// benchmarks to see the numbers on your CPU)
 //
-// `None`(ValueBlock) is represented by setting `Sample::blocked` true.
+// `None`(ValueBlock) is represented by setting the blocked bit. A sample
+// whose value is `value::ValueBlock` is also treated as blocked.
 //
 struct TimeSamples {
   struct Sample {
@@ -2274,176 +2387,155 @@ struct TimeSamples {
     bool blocked{false};
   };
 
-  bool empty() const { return _samples.empty(); }
+  bool empty() const { return _times.empty(); }
 
-  size_t size() const { return _samples.size(); }
+  size_t size() const { return _times.size(); }
 
   void clear() {
-    _samples.clear();
-    _dirty = true;
+    _times.clear();
+    _blocked.clear();
+    _values.clear();
+    _pod_values.clear();
+    _pod_type_id = value::TypeId::TYPE_ID_INVALID;
+    _pod_underlying_type_id = value::TypeId::TYPE_ID_INVALID;
+    _pod_size = 0;
   }
 
-  void update() const {
-    std::sort(_samples.begin(), _samples.end(),
-              [](const Sample &a, const Sample &b) { return a.t < b.t; });
+  bool has_sample_at(const double t) const;
 
-    _dirty = false;
-  }
+  // Returns the index of the sample at time `t`.
+  nonstd::optional<size_t> get_sample_index_at(const double t) const;
 
-  bool has_sample_at(const double t) const;
-  bool get_sample_at(const double t, Sample **s);
+  // Overwrite the value of the sample at time `t`.
+  // Returns false when no sample exists at `t`.
+  bool set_sample_at(const double t, const value::Value &v);
 
   nonstd::optional<double> get_time(size_t idx) const {
-    if (idx >= _samples.size()) {
+    if (idx >= _times.size()) {
       return nonstd::nullopt;
     }
 
-    if (_dirty) {
-      update();
+    return _times[idx];
+  }
+
+  nonstd::optional<value::Value> get_value(size_t idx) const;
+
+  bool is_blocked(size_t idx) const {
+    if (idx >= _blocked.size()) {
+      return false;
     }
 
-    return _samples[idx].t;
+    return _blocked[idx];
   }
 
-  nonstd::optional<value::Value> get_value(size_t idx) const {
-    if (idx >= _samples.size()) {
+  nonstd::optional<Sample> get_sample(size_t idx) const {
+    if (idx >= _times.size()) {
       return nonstd::nullopt;
     }
 
-    if (_dirty) {
-      update();
-    }
+    Sample s;
+    s.t = get_time(idx).value();
+    s.value = get_value(idx).value();
+    s.blocked = is_blocked(idx);
+    return s;
+  }
+
+  // Sorted time array.
+  const std::vector<double> &get_times() const {
+    return _times;
+  }
 
-    return _samples[idx].value;
+  // true when values are stored in the contiguous POD buffer.
+  bool is_pod() const {
+    return _pod_type_id != value::TypeId::TYPE_ID_INVALID;
   }
 
   uint32_t type_id() const {
-    if (_samples.size()) {
-      if (_dirty) {
-        update();
-      }
-      return _samples[0].value.type_id();
+    if (is_pod()) {
+      return _pod_type_id;
+    }
+
+    if (_values.size()) {
+      return _values[0].type_id();
     } else {
       return value::TypeId::TYPE_ID_INVALID;
     }
   }
 
   std::string type_name() const {
-    if (_samples.size()) {
-      if (_dirty) {
-        update();
-      }
-      return _samples[0].value.type_name();
+    if (is_pod()) {
+      return GetTypeName(_pod_type_id);
+    }
+
+    if (_values.size()) {
+      return _values[0].type_name();
     } else {
       return std::string();
     }
   }
 
   void add_sample(const Sample &s) {
-    _samples.push_back(s);
-    _dirty = true;
+    add_sample_impl(s.t, s.value, s.blocked);
   }
 
   void add_sample(double t, const value::Value &v) {
-    Sample s;
-    s.t = t;
-    s.value = v;
-    s.blocked = false;
-    _samples.push_back(s);
-    _dirty = true;
+    add_sample_impl(t, v, false);
   }
 
   // We still need "dummy" value for type_name() and type_id()
   void add_blocked_sample(double t, const value::Value &v) {
-    Sample s;
-    s.t = t;
-    s.value = v;
-    s.blocked = true;
-
-    _samples.emplace_back(s);
-    _dirty = true;
+    add_sample_impl(t, v, true);
   }
 
-  const std::vector<Sample> &get_samples() const {
-    if (_dirty) {
-      update();
-    }
-    return _samples;
-  }
-
-  std::vector<Sample> &samples() {
-    if (_dirty) {
-      update();
-    }
-    return _samples;
-  }
-
-#if 1  // TODO: Write implementation in .cc
-
-    // Get value at specified time.
-    // For non-interpolatable types(includes enums and unknown types)
-    //
-    // Return `Held` value even when TimeSampleInterpolationType is
-    // Linear. Returns nullopt when specified time is out-of-range.
-    template<typename T, std::enable_if_t<!value::LerpTraits<T>::supported(), std::nullptr_t> = nullptr>
-    bool get(T *dst, double t = value::TimeCode::Default(),
-             value::TimeSampleInterpolationType interp =
-                 value::TimeSampleInterpolationType::Linear) const {
-
-      (void)interp;
-
-      if (!dst) {
-        return false;
-      }
-
-      if (empty()) {
-        return false;
-      }
+  void reserve(size_t n);
 
-      if (_dirty) {
-        update();
-      }
+  // Get value at specified time.
+  // For non-interpolatable types(includes enums and unknown types)
+  //
+  // Return `Held` value even when TimeSampleInterpolationType is
+  // Linear. Returns false when samples is empty or the sample is blocked.
+  //
+  // `cursor` is an optional hint for sequential lookup. See TimeSampleCursor.
+  template<typename T, std::enable_if_t<!value::LerpTraits<T>::supported(), std::nullptr_t> = nullptr>
+  bool get(T *dst, double t = value::TimeCode::Default(),
+           value::TimeSampleInterpolationType interp =
+               value::TimeSampleInterpolationType::Linear,
+           TimeSampleCursor *cursor = nullptr) const {
 
-      if (value::TimeCode(t).is_default()) {
-        // TODO: Handle bloked
-        if (const auto pv = _samples[0].value.as<T>()) {
-          (*dst) = *pv;
-          return true;
-        }
-        return false;
-      } else {
+    (void)interp;
 
-        if (_samples.size() == 1) {
-          if (const auto pv = _samples[0].value.as<T>()) {
-            (*dst) = *pv;
-            return true;
-          }
-          return false;
-        }
+    if (!dst) {
+      return false;
+    }
 
-        auto it = std::upper_bound(
-          _samples.begin(), _samples.end(), t,
-          [](double tval, const Sample &a) { return tval < a.t; });
+    if (empty()) {
+      return false;
+    }
 
-        const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
+    if (value::TimeCode(t).is_default() || (_times.size() == 1)) {
+      // TODO: Handle bloked
+      return get_typed_value(0, dst);
+    }
 
-        const value::Value &v = it_minus_1->value;
+    const size_t idx = FindHeldTimeSampleIndex(_times, t, cursor);
+    if (_blocked[idx]) {
+      return false;
+    }
 
-        if (const T *pv = v.as<T>()) {
-          (*dst) = *pv;
-          return true;
-        }
-        return false;
-      }
+    return get_typed_value(idx, dst);
   }
 
   // Get value at specified time.
   // Return linearly interpolated value when TimeSampleInterpolationType is
-  // Linear. Returns false when samples is empty or some internal error.
+  // Linear. Returns false when samples is empty, the sample is blocked or some
+  // internal error.
+  //
+  // `cursor` is an optional hint for sequential lookup. See TimeSampleCursor.
   template<typename T, std::enable_if_t<value::LerpTraits<T>::supported(), std::nullptr_t> = nullptr>
   bool get(T *dst, double t = value::TimeCode::Default(),
            TimeSampleInterpolationType interp =
-               TimeSampleInterpolationType::Linear) const {
+               TimeSampleInterpolationType::Linear,
+           TimeSampleCursor *cursor = nullptr) const {
     if (!dst) {
       return false;
     }
@@ -2452,102 +2544,154 @@ struct TimeSamples {
       return false;
     }
 
-    if (_dirty) {
-      update();
-    }
-
-    if (value::TimeCode(t).is_default()) {
+    if (value::TimeCode(t).is_default() || (_times.size() == 1)) {
       // FIXME: Use the first item for now.
       // TODO: Handle bloked
-      if (const auto pv = _samples[0].value.as<T>()) {
+      return get_typed_value(0, dst);
+    }
+
+    if (interp == TimeSampleInterpolationType::Linear) {
+      size_t idx0, idx1;
+      double dt;
+      FindLerpTimeSampleIndices(_times, t, &idx0, &idx1, &dt, cursor);
+
+      if (_blocked[idx0] || ((dt > 0.0) && _blocked[idx1])) {
+        return false;
+      }
+
+      if (is_pod()) {
+        // Lerp directly on the typed buffer.
+        if (!is_pod_compatible<T>()) {
+          return false;
+        }
+        return lerp_pod_values(idx0, idx1, dt, reinterpret_cast<void *>(dst));
+      }
+
+      if (dt <= 0.0) {
+        return get_typed_value(idx0, dst);
+      }
+
+      value::Value p;
+      if (!Lerp(_values[idx0], _values[idx1], dt, &p)) {
+        return false;
+      }
+
+      if (const auto pv = p.as<T>()) {
         (*dst) = *pv;
         return true;
       }
       return false;
     } else {
-
-      if (_samples.size() == 1) {
-        if (const auto pv = _samples[0].value.as<T>()) {
-          (*dst) = *pv;
-          return true;
-        }
-        return true;
+      // Held
+      const size_t idx = FindHeldTimeSampleIndex(_times, t, cursor);
+      if (_blocked[idx]) {
+        return false;
       }
 
-      if (interp == TimeSampleInterpolationType::Linear) {
-        auto it = std::lower_bound(
-            _samples.begin(), _samples.end(), t,
-            [](const Sample &a, double tval) { return a.t < tval; });
+      return get_typed_value(idx, dst);
+    }
 
+    return false;
+  }
 
-        // MS STL does not allow seek vector iterator before begin
-        // Issue #110
-        const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
+  ///
+  /// Get value at specified time as `value::Value`.
+  /// Linearly interpolated when `interp` is Linear and the value type
+  /// supports lerp, otherwise `Held` value is returned.
+  ///
+  bool get_interpolated_value(double t, TimeSampleInterpolationType interp,
+                              value::Value *dst,
+                              TimeSampleCursor *cursor = nullptr) const;
+
+  ///
+  /// Get values at multiple times.
+  /// Faster than calling `get` for each time when `times` is sorted, since the
+  /// lookup reuses the last bracket.
+  ///
+  template<typename T>
+  bool get_many(const std::vector<double> &times, std::vector<T> *dst,
+                TimeSampleInterpolationType interp =
+                    TimeSampleInterpolationType::Linear) const {
+    if (!dst) {
+      return false;
+    }
 
-        size_t idx0 = size_t(std::max(
-            int64_t(0),
-            std::min(int64_t(_samples.size() - 1),
-                     int64_t(std::distance(_samples.begin(), it_minus_1)))));
-        size_t idx1 =
-            size_t(std::max(int64_t(0), std::min(int64_t(_samples.size() - 1),
-                                                 int64_t(idx0) + 1)));
+    dst->resize(times.size());
 
-        double tl = _samples[idx0].t;
-        double tu = _samples[idx1].t;
+    TimeSampleCursor cursor;
+    for (size_t i = 0; i < times.size(); i++) {
+      T v;
+      if (!get(&v, times[i], interp, &cursor)) {
+        return false;
+      }
+      (*dst)[i] = std::move(v);
+    }
 
-        double dt = (t - tl);
-        if (std::fabs(tu - tl) < std::numeric_limits<double>::epsilon()) {
-          // slope is zero.
-          dt = 0.0;
-        } else {
-          dt /= (tu - tl);
-        }
+    return true;
+  }
 
-        // Just in case.
-        dt = std::max(0.0, std::min(1.0, dt));
+ private:
+  void add_sample_impl(double t, const value::Value &v, bool blocked);
 
-        const value::Value &p0 = _samples[idx0].value;
-        const value::Value &p1 = _samples[idx1].value;
+  // Move POD values to `_values`
+  void unpack_pod_values();
 
-        value::Value p;
-        if (!Lerp(p0, p1, dt, &p)) {
-          return false;
-        }
+  // Lerp POD values and write the result to `dst`(`_pod_size` bytes).
+  bool lerp_pod_values(size_t idx0, size_t idx1, double dt, void *dst) const;
 
-        if (const auto pv = p.as<T>()) {
-          (*dst) = *pv;
-          return true;
-        }
-        return false;
-      } else {
-        // Held
-        auto it = std::upper_bound(
-          _samples.begin(), _samples.end(), t,
-          [](double tval, const Sample &a) { return tval < a.t; });
+  // Allow role type cast(e.g. float3 <-> point3f)
+  template<typename T>
+  bool is_pod_compatible() const {
+    return std::is_trivially_copyable<T>::value &&
+           ((value::TypeTraits<T>::type_id() == _pod_type_id) ||
+            ((value::TypeTraits<T>::underlying_type_id() == _pod_underlying_type_id) &&
+             (sizeof(T) == _pod_size)));
+  }
 
-        const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
+  template<typename T, std::enable_if_t<std::is_trivially_copyable<T>::value, std::nullptr_t> = nullptr>
+  bool get_typed_value(size_t idx, T *dst) const {
+    if (is_pod()) {
+      if (is_pod_compatible<T>()) {
+        memcpy(reinterpret_cast<void *>(dst), &_pod_values[idx * _pod_size], sizeof(T));
+        return true;
+      }
+      return false;
+    }
 
-        const value::Value &v = it_minus_1->value;
+    if (const T *pv = _values[idx].as<T>()) {
+      (*dst) = *pv;
+      return true;
+    }
+    return false;
+  }
 
-        if (const T *pv = v.as<T>()) {
-          (*dst) = *pv;
-          return true;
-        }
-        
-        return false;
-      }
+  template<typename T, std::enable_if_t<!std::is_trivially_copyable<T>::value, std::nullptr_t> = nullptr>
+  bool get_typed_value(size_t idx, T *dst) const {
+    if (is_pod()) {
+      return false;
     }
 
+    if (const T *pv = _values[idx].as<T>()) {
+      (*dst) = *pv;
+      return true;
+    }
     return false;
   }
-#endif
 
- private:
-  mutable std::vector<Sample> _samples;
-  mutable bool _dirty{false};
-};
+  // Always sorted by time(samples are inserted in order), so const methods
+  // never modify the container and can be called from multiple threads.
+  std::vector<double> _times;
+  std::vector<bool> _blocked;  // bitset
 
+  // Used when the value type is not POD.
+  std::vector<value::Value> _values;
 
+  // Contiguous POD values. `_pod_size` bytes per sample.
+  std::vector<uint8_t> _pod_values;
+  uint32_t _pod_type_id{value::TypeId::TYPE_ID_INVALID};
+  uint32_t _pod_underlying_type_id{value::TypeId::TYPE_ID_INVALID};
+  size_t _pod_size{0};
+};
 
 ///
 /// Try to cast the value with src type to dest type as much as possible.
@@ -623,6 +623,26 @@ class XformEvaluator {
   value::matrix4d m;
 };
 
+// Evaluate xformOp value at time `t`.
+template <typename T>
+nonstd::optional<T> EvalXformOpValue(
+    const XformOp &x, double t, value::TimeSampleInterpolationType tinterp) {
+  if (!x.has_timesamples()) {
+    return x.get_value<T>();
+  }
+
+  value::Value v;
+  if (!x.get_var().get_interpolated_value(t, tinterp, &v)) {
+    return nonstd::nullopt;
+  }
+
+  if (const T *pv = v.as<T>()) {
+    return *pv;
+  }
+
+  return nonstd::nullopt;
+}
+
 }  // namespace
 
 bool Xformable::EvaluateXformOps(double t,
@@ -631,17 +651,17 @@ bool Xformable::EvaluateXformOps(double t,
                                  bool *resetXformStack,
                                  std::string *err) const {
   const auto RotateABC =
-      [](const XformOp &x) -> nonstd::expected<value::matrix4d, std::string> {
+      [t, tinterp](const XformOp &x) -> nonstd::expected<value::matrix4d, std::string> {
     value::double3 v;
-    if (auto h = x.get_value<value::half3>()) {
+    if (auto h = EvalXformOpValue<value::half3>(x, t, tinterp)) {
       v[0] = double(half_to_float(h.value()[0]));
       v[1] = double(half_to_float(h.value()[1]));
       v[2] = double(half_to_float(h.value()[2]));
-    } else if (auto f = x.get_value<value::float3>()) {
+    } else if (auto f = EvalXformOpValue<value::float3>(x, t, tinterp)) {
       v[0] = double(f.value()[0]);
       v[1] = double(f.value()[1]);
       v[2] = double(f.value()[2]);
-    } else if (auto d = x.get_value<value::double3>()) {
+    } else if (auto d = EvalXformOpValue<value::double3>(x, t, tinterp)) {
       v = d.value();
     } else {
       if (x.suffix.empty()) {
@@ -838,15 +858,6 @@ bool Xformable::EvaluateXformOps(double t,
     value::matrix4d m;  // local matrix
     Identity(&m);
 
-    if (x.is_timesamples()) {
-      (void)t;
-      (void)tinterp;
-      if (err) {
-        (*err) += "TODO: xformOp property with timeSamples.\n";
-      }
-      return false;
-    }
-
     switch (x.op_type) {
       case XformOp::OpType::ResetXformStack: {
         if (i != 0) {
@@ -865,14 +876,14 @@ bool Xformable::EvaluateXformOps(double t,
         break;
       }
       case XformOp::OpType::Transform: {
-        if (auto sxf = x.get_value<value::matrix4f>()) {
+        if (auto sxf = EvalXformOpValue<value::matrix4f>(x, t, tinterp)) {
           value::matrix4f mf = sxf.value();
           for (size_t j = 0; j < 4; j++) {
             for (size_t k = 0; k < 4; k++) {
               m.m[j][k] = double(mf.m[j][k]);
             }
           }
-        } else if (auto sxd = x.get_value<value::matrix4d>()) {
+        } else if (auto sxd = EvalXformOpValue<value::matrix4d>(x, t, tinterp)) {
           m = sxd.value();
         } else {
           if (err) {
@@ -911,15 +922,15 @@ bool Xformable::EvaluateXformOps(double t,
       case XformOp::OpType::Scale: {
         double sx, sy, sz;
 
-        if (auto sxh = x.get_value<value::half3>()) {
+        if (auto sxh = EvalXformOpValue<value::half3>(x, t, tinterp)) {
           sx = double(half_to_float(sxh.value()[0]));
           sy = double(half_to_float(sxh.value()[1]));
           sz = double(half_to_float(sxh.value()[2]));
-        } else if (auto sxf = x.get_value<value::float3>()) {
+        } else if (auto sxf = EvalXformOpValue<value::float3>(x, t, tinterp)) {
           sx = double(sxf.value()[0]);
           sy = double(sxf.value()[1]);
           sz = double(sxf.value()[2]);
-        } else if (auto sxd = x.get_value<value::double3>()) {
+        } else if (auto sxd = EvalXformOpValue<value::double3>(x, t, tinterp)) {
           sx = sxd.value()[0];
           sy = sxd.value()[1];
           sz = sxd.value()[2];
@@ -945,15 +956,15 @@ bool Xformable::EvaluateXformOps(double t,
       }
       case XformOp::OpType::Translate: {
         double tx, ty, tz;
-        if (auto txh = x.get_value<value::half3>()) {
+        if (auto txh = EvalXformOpValue<value::half3>(x, t, tinterp)) {
           tx = double(half_to_float(txh.value()[0]));
           ty = double(half_to_float(txh.value()[1]));
           tz = double(half_to_float(txh.value()[2]));
-        } else if (auto txf = x.get_value<value::float3>()) {
+        } else if (auto txf = EvalXformOpValue<value::float3>(x, t, tinterp)) {
           tx = double(txf.value()[0]);
           ty = double(txf.value()[1]);
           tz = double(txf.value()[2]);
-        } else if (auto txd = x.get_value<value::double3>()) {
+        } else if (auto txd = EvalXformOpValue<value::double3>(x, t, tinterp)) {
           tx = txd.value()[0];
           ty = txd.value()[1];
           tz = txd.value()[2];
@@ -980,11 +991,11 @@ bool Xformable::EvaluateXformOps(double t,
       // FIXME: Validate ROTATE_X, _Y, _Z implementation
       case XformOp::OpType::RotateX: {
         double angle;  // in degrees
-        if (auto h = x.get_value<value::half>()) {
+        if (auto h = EvalXformOpValue<value::half>(x, t, tinterp)) {
           angle = double(half_to_float(h.value()));
-        } else if (auto f = x.get_value<float>()) {
+        } else if (auto f = EvalXformOpValue<float>(x, t, tinterp)) {
           angle = double(f.value());
-        } else if (auto d = x.get_value<double>()) {
+        } else if (auto d = EvalXformOpValue<double>(x, t, tinterp)) {
           angle = d.value();
         } else {
           if (err) {
@@ -1020,11 +1031,11 @@ bool Xformable::EvaluateXformOps(double t,
       }
       case XformOp::OpType::RotateY: {
         double angle;  // in degrees
-        if (auto h = x.get_value<value::half>()) {
+        if (auto h = EvalXformOpValue<value::half>(x, t, tinterp)) {
           angle = double(half_to_float(h.value()));
-        } else if (auto f = x.get_value<float>()) {
+        } else if (auto f = EvalXformOpValue<float>(x, t, tinterp)) {
           angle = double(f.value());
-        } else if (auto d = x.get_value<double>()) {
+        } else if (auto d = EvalXformOpValue<double>(x, t, tinterp)) {
           angle = d.value();
         } else {
           if (err) {
@@ -1060,11 +1071,11 @@ bool Xformable::EvaluateXformOps(double t,
       }
       case XformOp::OpType::RotateZ: {
         double angle;  // in degrees
-        if (auto h = x.get_value<value::half>()) {
+        if (auto h = EvalXformOpValue<value::half>(x, t, tinterp)) {
           angle = double(half_to_float(h.value()));
-        } else if (auto f = x.get_value<float>()) {
+        } else if (auto f = EvalXformOpValue<float>(x, t, tinterp)) {
           angle = double(f.value());
-        } else if (auto d = x.get_value<double>()) {
+        } else if (auto d = EvalXformOpValue<double>(x, t, tinterp)) {
           angle = d.value();
         } else {
           if (err) {
@@ -1103,11 +1114,11 @@ bool Xformable::EvaluateXformOps(double t,
         // linalg::quat also stores elements in (x, y, z, w)
 
         value::matrix3d rm;
-        if (auto h = x.get_value<value::quath>()) {
+        if (auto h = EvalXformOpValue<value::quath>(x, t, tinterp)) {
           rm = to_matrix3x3(h.value());
-        } else if (auto f = x.get_value<value::quatf>()) {
+        } else if (auto f = EvalXformOpValue<value::quatf>(x, t, tinterp)) {
           rm = to_matrix3x3(f.value());
-        } else if (auto d = x.get_value<value::quatd>()) {
+        } else if (auto d = EvalXformOpValue<value::quatd>(x, t, tinterp)) {
           rm = to_matrix3x3(d.value());
         } else {
           if (err) {
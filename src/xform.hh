@@ -190,29 +190,30 @@ struct Xformable {
   /// @param[out] resetTransformStack Is xformOpOrder contains !resetTransformStack!? 
   ///
   nonstd::expected<value::matrix4d, std::string> GetLocalMatrix(double t = value::TimeCode::Default(), value::TimeSampleInterpolationType tinterp = value::TimeSampleInterpolationType::Linear, bool *resetTransformStack = nullptr) const {
-    if (_dirty) {
-      value::matrix4d m;
-      std::string err;
-      if (EvaluateXformOps(t, tinterp, &m, resetTransformStack, &err)) {
-        _matrix = m;
-        _dirty = false;
-      } else {
-        return nonstd::make_unexpected(err);
-      }
+    // Not cached, so that GetLocalMatrix() can be called from multiple threads.
+    value::matrix4d m;
+    std::string err;
+    if (!EvaluateXformOps(t, tinterp, &m, resetTransformStack, &err)) {
+      return nonstd::make_unexpected(err);
     }
 
-    return _matrix;
+    return m;
   }
 
-  void set_dirty(bool onoff) { _dirty = onoff; }
+  // true when any of xformOps has timeSamples.
+  bool has_timesampled_xformOps() const {
+    for (const auto &op : xformOps) {
+      if (op.has_timesamples()) {
+        return true;
+      }
+    }
+    return false;
+  }
 
   // Return `token[]` representation of `xformOps`
   std::vector<value::token> xformOpOrder() const;
 
   std::vector<XformOp> xformOps;
-
-  mutable bool _dirty{true};
-  mutable value::matrix4d _matrix;  // Matrix of this Xform(local matrix)
 };
 
 
@@ -0,0 +1,79 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <cstdint>
+#include <string>
+
+#include "unit-ascii-scan.h"
+#include "ascii-scan.hh"
+
+using namespace tinyusdz::ascii;
+
+void ascii_scan_test(void) {
+  {
+    std::string s = "    \t\f  abc";
+    TEST_CHECK(scan::SkipBlanks(s.data(), s.size()) == 8);
+    TEST_CHECK(scan::SkipBlanks(s.data(), 3) == 3);
+    TEST_CHECK(scan::SkipBlanks(s.data(), 0) == 0);
+  }
+
+  {
+    std::string s = " ; ;\n";
+    TEST_CHECK(scan::SkipBlanks(s.data(), s.size()) == 1);
+    TEST_CHECK(scan::SkipBlanks(s.data(), s.size(), true) == 4);
+  }
+
+  {
+    // Longer than one SIMD register.
+    std::string s(100, ' ');
+    s += "# comment which is longer than 32 chars......... end\r\nx";
+    TEST_CHECK(scan::SkipBlanks(s.data(), s.size()) == 100);
+    TEST_CHECK(scan::FindNewline(s.data(), s.size()) == s.size() - 3);
+    TEST_CHECK(scan::FindNewline(s.data(), s.size() - 3) == s.size() - 3);
+  }
+
+  {
+    // SIMD and scalar path must give the same result for every offset and
+    // length.
+    std::string s;
+    uint32_t seed = 12345;
+    const char alphabet[] = " \t\f;\n\r#\"'@(){}[],ab1.";
+    for (size_t i = 0; i < 300; i++) {
+      seed = seed * 1103515245u + 12345u;
+      // Long runs of spaces to exercise the vector loop.
+      if ((seed >> 16) % 3 == 0) {
+        s += std::string((seed >> 8) % 40, ' ');
+      }
+      s += alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+    }
+
+    const char sets[][4] = {{' ', '\t', '\f', ';'},
+                            {'\n', '\r', '\n', '\r'},
+                            {'"', '\\', '\n', '"'},
+                            {',', ']', ')', '"'}};
+
+    bool ok = true;
+    for (size_t k = 0; k < 4; k++) {
+      for (size_t nset = 1; nset <= 4; nset++) {
+        for (size_t off = 0; off < 64; off++) {
+          for (size_t n = 0; (off + n) <= s.size(); n += 7) {
+            const char *p = s.data() + off;
+            if (scan::FindFirstOf(p, n, sets[k], nset) !=
+                scan::FindFirstOfScalar(p, n, sets[k], nset)) {
+              ok = false;
+            }
+            if (scan::SkipChars(p, n, sets[k], nset) !=
+                scan::SkipCharsScalar(p, n, sets[k], nset)) {
+              ok = false;
+            }
+          }
+        }
+      }
+    }
+    TEST_CHECK(ok);
+  }
+}
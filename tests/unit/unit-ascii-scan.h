@@ -0,0 +1,3 @@
+#pragma once
+
+void ascii_scan_test(void);
@@ -0,0 +1,200 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "unit-composition.h"
+#include "composition.hh"
+#include "pprinter.hh"
+#include "tinyusdz.hh"
+
+using namespace tinyusdz;
+
+namespace {
+
+// Assets are written to the working directory of the unit tester.
+const int kNumAssets = 16;
+
+std::string AssetName(int i) {
+  return "unit-composition-asset-" + std::to_string(i) + ".usda";
+}
+
+const char *kMissingAssetName = "unit-composition-missing.usda";
+const char *kBrokenAssetName = "unit-composition-broken.usda";
+
+bool WriteTextFile(const std::string &filename, const std::string &s) {
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs) {
+    return false;
+  }
+  ofs << s;
+  return bool(ofs);
+}
+
+bool WriteAssets() {
+  for (int i = 0; i < kNumAssets; i++) {
+    std::string s = "#usda 1.0\n(\n  defaultPrim = \"asset\"\n)\n";
+    s += "def Xform \"asset\" {\n";
+    s += "  double value = " + std::to_string(i) + "\n";
+    s += "  def Sphere \"sphere\" {\n";
+    s += "    double radius = " + std::to_string(i + 1) + "\n";
+    s += "  }\n}\n";
+    if (!WriteTextFile(AssetName(i), s)) {
+      return false;
+    }
+  }
+
+  // Syntax error.
+  return WriteTextFile(kBrokenAssetName,
+                       "#usda 1.0\n"
+                       "def Xform \"asset\" {\n"
+                       "  double value = ]\n"
+                       "}\n");
+}
+
+void RemoveAssets() {
+  for (int i = 0; i < kNumAssets; i++) {
+    std::remove(AssetName(i).c_str());
+  }
+  std::remove(kBrokenAssetName);
+}
+
+// `num_prims` Prims, each of them has an arc to one of the assets.
+// `extra_asset` is appended as the arc of the last Prim when not empty.
+std::string MakeRootUSDA(const std::string &arc, int num_prims,
+                         const std::string &extra_asset) {
+  std::string s = "#usda 1.0\n";
+  for (int i = 0; i < num_prims; i++) {
+    s += "def Xform \"prim" + std::to_string(i) + "\" (\n";
+    s += "  " + arc + " = @" + AssetName((i * 7) % kNumAssets) + "@\n";
+    s += ") {\n}\n";
+  }
+  if (!extra_asset.empty()) {
+    s += "def Xform \"extra\" (\n";
+    s += "  " + arc + " = @" + extra_asset + "@\n";
+    s += ") {\n}\n";
+  }
+  return s;
+}
+
+struct CompositionResult {
+  bool ret{false};
+  std::string layer;
+  std::string warn;
+  std::string err;
+};
+
+CompositionResult Composite(const std::string &usda, const bool payload,
+                            const int num_threads,
+                            const bool error_when_asset_not_found) {
+  CompositionResult result;
+
+  Layer layer;
+  std::string warn, err;
+  if (!LoadLayerFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                           usda.size(), "root.usda", &layer, &warn, &err)) {
+    result.err = err;
+    return result;
+  }
+
+  AssetResolutionResolver resolver;
+  resolver.set_current_working_path(".");
+  resolver.set_search_paths({"."});
+
+  Layer composited;
+  if (payload) {
+    PayloadCompositionOptions options;
+    options.num_threads = num_threads;
+    options.error_when_asset_not_found = error_when_asset_not_found;
+    result.ret = CompositePayload(resolver, layer, &composited, &result.warn,
+                                  &result.err, options);
+  } else {
+    ReferencesCompositionOptions options;
+    options.num_threads = num_threads;
+    options.error_when_asset_not_found = error_when_asset_not_found;
+    result.ret = CompositeReferences(resolver, layer, &composited,
+                                     &result.warn, &result.err, options);
+  }
+
+  if (result.ret) {
+    result.layer = to_string(composited);
+  }
+
+  return result;
+}
+
+void CheckSameResult(const CompositionResult &expected,
+                     const CompositionResult &result, int num_threads) {
+  TEST_CHECK(expected.ret == result.ret);
+  TEST_MSG("num_threads %d", num_threads);
+  TEST_CHECK(expected.layer == result.layer);
+  TEST_MSG("num_threads %d\nexpected:\n%s\ngot:\n%s", num_threads,
+           expected.layer.c_str(), result.layer.c_str());
+  TEST_CHECK(expected.warn == result.warn);
+  TEST_MSG("num_threads %d\nexpected:\n%s\ngot:\n%s", num_threads,
+           expected.warn.c_str(), result.warn.c_str());
+  TEST_CHECK(expected.err == result.err);
+  TEST_MSG("num_threads %d\nexpected:\n%s\ngot:\n%s", num_threads,
+           expected.err.c_str(), result.err.c_str());
+}
+
+// Composite with num_threads = 1 and others, and compare the results.
+void CheckParallelComposition(const std::string &usda, const bool payload,
+                              const bool error_when_asset_not_found,
+                              const bool expected_ret) {
+  const CompositionResult expected =
+      Composite(usda, payload, /* num_threads */ 1, error_when_asset_not_found);
+  TEST_CHECK(expected.ret == expected_ret);
+  TEST_MSG("%s", expected.err.c_str());
+
+  for (int num_threads : {2, 8, 0}) {
+    const CompositionResult result =
+        Composite(usda, payload, num_threads, error_when_asset_not_found);
+    CheckSameResult(expected, result, num_threads);
+  }
+}
+
+}  // namespace
+
+void composition_parallel_test(void) {
+  TEST_CHECK(WriteAssets());
+
+  for (const bool payload : {false, true}) {
+    const std::string arc = payload ? "payload" : "references";
+
+    // All assets are found.
+    {
+      const std::string usda = MakeRootUSDA(arc, 64, "");
+      const CompositionResult expected =
+          Composite(usda, payload, /* num_threads */ 1, false);
+      TEST_CHECK(expected.ret);
+      TEST_MSG("%s", expected.err.c_str());
+      // Composited assets must appear in the Layer.
+      TEST_CHECK(expected.layer.find("radius = 16") != std::string::npos);
+
+      CheckParallelComposition(usda, payload, false, true);
+    }
+
+    // Missing asset is a warning.
+    CheckParallelComposition(MakeRootUSDA(arc, 64, kMissingAssetName), payload,
+                             false, true);
+
+    // Missing asset is an error.
+    CheckParallelComposition(MakeRootUSDA(arc, 64, kMissingAssetName), payload,
+                             true, false);
+
+    // Asset failed to parse.
+    CheckParallelComposition(MakeRootUSDA(arc, 64, kBrokenAssetName), payload,
+                             false, false);
+  }
+
+  RemoveAssets();
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void composition_parallel_test(void);
@@ -15,19 +15,34 @@
 #include "unit-ioutil.h"
 #include "unit-strutil.h"
 #include "unit-timesamples.h"
+#include "unit-stream-reader.h"
+#include "unit-ascii-scan.h"
+#include "unit-usdc-reader.h"
+#include "unit-usda-reader.h"
+#include "unit-usdc-writer.h"
+#include "unit-composition.h"
 #include "unit-pprint.h"
 
 #if defined(TINYUSDZ_WITH_PXR_COMPAT_API)
 #include "unit-pxr-compat-api.h"
 #endif
 
+#if defined(TINYUSDZ_WITH_TYDRA)
+#include "unit-tydra-mesh.h"
+#include "unit-tydra-render-scene.h"
+#endif
+
 
 
 TEST_LIST = {
   { "prim_type_test", prim_type_test },
+  { "path_intern_test", path_intern_test },
   { "prim_add_test", prim_add_test },
+  { "stage_commit_test", stage_commit_test },
+  { "typed_timesamples_test", typed_timesamples_test },
   { "primvar_test", primvar_test },
   { "value_types_test", value_types_test },
+  { "token_intern_test", token_intern_test },
   { "xformOp_test", xformOp_test },
   { "customdata_test", customdata_test },
   { "handle_allocator_test", handle_allocator_test },
@@ -38,6 +53,19 @@ TEST_LIST = {
   { "ioutil_test", ioutil_test },
   { "strutil_test", strutil_test },
   { "timesamples_test", timesamples_test },
+  { "stream_reader_test", stream_reader_test },
+  { "ascii_scan_test", ascii_scan_test },
+  { "usdc_reader_memory_budget_test", usdc_reader_memory_budget_test },
+  { "usdc_reader_deferred_value_test", usdc_reader_deferred_value_test },
+  { "usda_reader_parallel_test", usda_reader_parallel_test },
+  { "usdc_writer_test", usdc_writer_test },
+  { "composition_parallel_test", composition_parallel_test },
+#if defined(TINYUSDZ_WITH_TYDRA)
+  { "tydra_mesh_weld_test", tydra_mesh_weld_test },
+  { "tydra_mesh_buffer_test", tydra_mesh_buffer_test },
+  { "tydra_mesh_tangent_test", tydra_mesh_tangent_test },
+  { "tydra_render_scene_update_test", tydra_render_scene_update_test },
+#endif
 #if defined(TINYUSDZ_WITH_PXR_COMPAT_API)
   { "pxr_compat_api_test", pxr_compat_api_test },
 #endif
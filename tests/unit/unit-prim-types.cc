@@ -5,8 +5,13 @@
 #define TEST_NO_MAIN
 #include "acutest.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "unit-prim-types.h"
 #include "prim-types.hh"
+#include "stage.hh"
+#include "thread-util.hh"
 
 using namespace tinyusdz;
 
@@ -114,6 +119,88 @@ void prim_type_test(void) {
     TEST_CHECK(gpath.has_prefix(fpath) == false);
   }
 
+  // Interned Path
+  {
+    Path apath("/dora/bora", "muda");
+    Path bpath = Path::make_root_path()
+                     .AppendPrim("dora")
+                     .AppendPrim("bora")
+                     .AppendProperty("muda");
+    Path cpath("/dora/bora.muda", "");
+    TEST_CHECK(apath.node() == bpath.node());
+    TEST_CHECK(apath.node() == cpath.node());
+    TEST_CHECK(apath == bpath);
+    TEST_CHECK(apath.hash() == bpath.hash());
+    TEST_CHECK(bpath.full_path_name() == "/dora/bora.muda");
+    TEST_CHECK(bpath.element_name() == "muda");
+
+    Path ppath = apath.get_parent_path();
+    TEST_CHECK(ppath == Path("/dora/bora", ""));
+    TEST_CHECK(ppath.element_name() == "bora");
+    TEST_CHECK(ppath.get_parent_path() == Path("/dora", ""));
+    TEST_CHECK(apath.prim_path() == ppath);
+
+    // replace property
+    TEST_CHECK(apath.AppendProperty("ari") == Path("/dora/bora", "ari"));
+
+    Path vpath = Path("/dora", "").AppendElement("{var=green}");
+    TEST_CHECK(vpath.full_path_name() == "/dora{var=green}");
+    TEST_CHECK(vpath.element_name() == "{var=green}");
+    TEST_CHECK(vpath.variant_part() == "{var=green}");
+
+    Path dpath("/dora", "");
+    TEST_CHECK(!(dpath == Path("/dora2", "")));
+    TEST_CHECK(dpath.make_relative() == Path("dora", ""));
+
+    // invalid paths are not equal
+    TEST_CHECK(!(Path() == Path()));
+  }
+
+}
+
+void path_intern_test(void) {
+  size_t base = Path::num_interned_nodes();
+
+  // Nodes are freed when the last Path(and child node) referencing them is
+  // gone.
+  {
+    Path apath("/path_intern/bora", "muda");
+    // "/path_intern", "/path_intern/bora" and "/path_intern/bora.muda"
+    TEST_CHECK(Path::num_interned_nodes() >= base + 3);
+
+    Path bpath = apath.get_parent_path();
+    apath = Path();
+    TEST_CHECK(bpath.full_path_name() == "/path_intern/bora");
+    TEST_CHECK(bpath.get_parent_path().full_path_name() == "/path_intern");
+
+    Path cpath = std::move(bpath);
+    TEST_CHECK(cpath == Path("/path_intern/bora", ""));
+  }
+  TEST_CHECK(Path::num_interned_nodes() == base);
+
+  // Concurrent interning gives the same node for the same Path.
+  {
+    constexpr size_t kNumPaths = 16;
+    std::vector<Path> paths(1024);
+    thread_util::ParallelFor(0, paths.size(), 4, [&](size_t i) {
+      Path p = Path::make_root_path()
+                   .AppendPrim("path_intern")
+                   .AppendPrim("node" + std::to_string(i % kNumPaths))
+                   .AppendProperty("prop");
+      paths[i] = p;
+    });
+
+    for (size_t i = 0; i < paths.size(); i++) {
+      TEST_CHECK(paths[i].node() == paths[i % kNumPaths].node());
+      TEST_CHECK(paths[i].full_path_name() ==
+                 "/path_intern/node" + std::to_string(i % kNumPaths) +
+                     ".prop");
+    }
+
+    thread_util::ParallelFor(0, paths.size(), 4,
+                             [&](size_t i) { paths[i] = Path(); });
+  }
+  TEST_CHECK(Path::num_interned_nodes() == base);
 }
 
 void prim_add_test(void) {
@@ -140,3 +227,95 @@ void prim_add_test(void) {
   TEST_CHECK(root.add_child(std::move(dprim), /* rename_if_required */true)); 
   
 }
+
+void stage_commit_test(void) {
+  Stage stage;
+
+  {
+    Model rootmodel;
+    Prim root("root", rootmodel);
+    for (size_t i = 0; i < 16; i++) {
+      Model model;
+      Prim child("child" + std::to_string(i), model);
+      TEST_CHECK(root.add_child(std::move(child)));
+    }
+    TEST_CHECK(stage.add_root_prim(std::move(root)));
+  }
+
+  TEST_CHECK(!stage.is_committed());
+  TEST_CHECK(stage.commit());
+  TEST_CHECK(stage.is_committed());
+  TEST_CHECK(stage.root_prims()[0].is_committed());
+
+  // non-const access invalidates the committed state.
+  TEST_CHECK(!stage.is_committed());
+  TEST_CHECK(stage.commit());
+
+  const Stage &cstage = stage;
+
+  // Concurrent lookup on the committed Stage.
+  std::atomic<size_t> nfound(0);
+  thread_util::ParallelFor(0, 1024, /* num_threads */ -1, [&](size_t i) {
+    const std::string name = "/root/child" + std::to_string(i % 16);
+    auto ret = cstage.GetPrimAtPath(Path(name, ""));
+    if (ret && (ret.value()->element_name() == "child" + std::to_string(i % 16))) {
+      const Prim *p{nullptr};
+      if (cstage.find_prim_by_prim_id(uint64_t(ret.value()->prim_id()), p) &&
+          (p == ret.value())) {
+        nfound++;
+      }
+    }
+  });
+  TEST_CHECK(nfound == 1024);
+
+  TEST_CHECK(!cstage.GetPrimAtPath(Path("/root/child16", "")).has_value());
+
+  // Lazy lookup after modification.
+  {
+    Model model;
+    Prim root2("root2", model);
+    TEST_CHECK(stage.add_root_prim(std::move(root2)));
+  }
+  TEST_CHECK(!stage.is_committed());
+  TEST_CHECK(cstage.GetPrimAtPath(Path("/root/child3", "")).has_value());
+
+  // A copy does not share the cached Prim pointers of the source.
+  TEST_CHECK(stage.commit());
+  Stage copied = cstage;
+  TEST_CHECK(!copied.is_committed());
+  auto src_prim = cstage.GetPrimAtPath(Path("/root/child3", ""));
+  auto dst_prim = copied.GetPrimAtPath(Path("/root/child3", ""));
+  TEST_CHECK(src_prim.has_value() && dst_prim.has_value());
+  if (src_prim && dst_prim) {
+    TEST_CHECK(src_prim.value() != dst_prim.value());
+    TEST_CHECK(dst_prim.value() == &copied.root_prims()[0].children()[3]);
+  }
+
+  copied = cstage;
+  TEST_CHECK(!copied.is_committed());
+  TEST_CHECK(copied.commit());
+  TEST_CHECK(copied.is_committed());
+}
+
+void typed_timesamples_test(void) {
+  TypedTimeSamples<float> ts;
+  ts.add_sample(2.0, 2.0f);
+  ts.add_sample(0.0, 0.0f);
+  ts.add_blocked_sample(1.0);
+  ts.add_sample(3.0, 3.0f);
+  ts.add_sample(0.0, 0.5f);
+
+  // Sorted at the first read. Samples at the same time keep the insertion
+  // order.
+  const std::vector<double> &times = ts.get_times();
+  TEST_CHECK(times.size() == 5);
+  TEST_CHECK(std::is_sorted(times.begin(), times.end()));
+  TEST_CHECK(ts.get_values()[0] == 0.0f);
+  TEST_CHECK(ts.get_values()[1] == 0.5f);
+  TEST_CHECK(ts.is_blocked(2));
+  TEST_CHECK(!ts.is_blocked(3));
+
+  float v{0.0f};
+  TEST_CHECK(ts.get(&v, 2.5, value::TimeSampleInterpolationType::Linear));
+  TEST_CHECK(math::is_close(v, 2.5f));
+}
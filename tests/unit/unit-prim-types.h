@@ -1,4 +1,7 @@
 #pragma once
 
 void prim_type_test(void);
+void path_intern_test(void);
 void prim_add_test(void);
+void stage_commit_test(void);
+void typed_timesamples_test(void);
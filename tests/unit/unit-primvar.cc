@@ -33,4 +33,37 @@ void primvar_test(void) {
     
   }
 
+  // deferred value
+  {
+    int num_loads = 0;
+    auto dv = std::make_shared<DeferredValue>(
+        "float[]", /* timesamples */false,
+        [&num_loads](Value *v, TimeSamples *ts, std::string *err) {
+          (void)ts;
+          (void)err;
+          num_loads++;
+          (*v) = std::vector<float>{1.0f, 2.0f, 3.0f};
+          return true;
+        });
+
+    PrimVar var;
+    var.set_deferred_value(dv);
+    TEST_CHECK(var.has_value() == true);
+    TEST_CHECK(var.type_name() == "float[]");
+    TEST_CHECK(num_loads == 0);
+
+    auto pv = var.get_value<std::vector<float>>();
+    TEST_CHECK(pv.has_value());
+    TEST_CHECK(pv.value().size() == 3);
+
+    // Copy shares the decoded value.
+    PrimVar var2 = var;
+    TEST_CHECK(var2.get_value<std::vector<float>>().has_value());
+    TEST_CHECK(num_loads == 1);
+
+    var2.set_value(1.0f);
+    TEST_CHECK(var2.has_deferred_value() == false);
+    TEST_CHECK(var.has_deferred_value() == true);
+  }
+
 }
@@ -0,0 +1,89 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <vector>
+
+#include "unit-stream-reader.h"
+#include "stream-reader.hh"
+
+using namespace tinyusdz;
+
+void stream_reader_test(void) {
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = uint8_t(i % 251);
+  }
+
+  // chunked mode: 16 bytes chunk, 32 bytes history.
+  uint64_t nreads = 0;
+  StreamReader sr(
+      [&](uint64_t offset, uint64_t n, uint8_t *dst) -> uint64_t {
+        nreads++;
+        if (offset >= data.size()) {
+          return 0;
+        }
+        // Return partial reads to test refill loop.
+        n = (std::min)(n, uint64_t(5));
+        n = (std::min)(n, uint64_t(data.size()) - offset);
+        memcpy(dst, data.data() + offset, size_t(n));
+        return n;
+      },
+      data.size(), 16, 32, /* swap endian */ false);
+
+  TEST_CHECK(sr.is_chunked());
+  TEST_CHECK(sr.size() == 1000);
+
+  {
+    bool ok = true;
+    for (size_t i = 0; i < 100; i++) {
+      uint8_t c;
+      ok &= sr.read1(&c);
+      ok &= (c == data[i]);
+    }
+    TEST_CHECK(ok);
+    TEST_CHECK(sr.tell() == 100);
+    TEST_CHECK(nreads > 0);
+  }
+
+  {
+    // Rewind within history
+    TEST_CHECK(sr.seek_from_current(-20));
+    uint8_t c;
+    TEST_CHECK(sr.read1(&c));
+    TEST_CHECK(c == data[80]);
+
+    // Rewind past the history
+    TEST_CHECK(!sr.seek_set(0));
+    TEST_CHECK(sr.tell() == 81);
+  }
+
+  {
+    // Read across the window boundary
+    std::vector<uint8_t> buf(100);
+    TEST_CHECK(sr.read(100, 100, buf.data()) == 100);
+    TEST_CHECK(memcmp(buf.data(), data.data() + 81, 100) == 0);
+
+    uint32_t v;
+    TEST_CHECK(sr.read4(&v));
+    uint32_t ref;
+    memcpy(&ref, data.data() + 181, 4);
+    TEST_CHECK(v == ref);
+  }
+
+  {
+    // Seek forward past the window
+    TEST_CHECK(sr.seek_set(900));
+    uint8_t c;
+    TEST_CHECK(sr.read1(&c));
+    TEST_CHECK(c == data[900]);
+
+    TEST_CHECK(sr.seek_set(1000));
+    TEST_CHECK(sr.eof());
+    TEST_CHECK(!sr.read1(&c));
+    TEST_CHECK(!sr.seek_set(1001));
+  }
+}
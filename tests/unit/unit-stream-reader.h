@@ -0,0 +1,3 @@
+#pragma once
+
+void stream_reader_test(void);
@@ -188,6 +188,112 @@ void timesamples_test(void) {
     }      
   }
 
+  // Columnar storage. POD values are stored in the contiguous buffer.
+  {
+    value::TimeSamples ts;
+    // out-of-order
+    ts.add_sample(2, value::Value(value::point3f({2.0f, 4.0f, 6.0f})));
+    ts.add_sample(0, value::Value(value::point3f({0.0f, 0.0f, 0.0f})));
+    ts.add_sample(1, value::Value(value::ValueBlock()));
+    ts.add_sample(3, value::Value(value::point3f({3.0f, 6.0f, 9.0f})));
+
+    TEST_CHECK(ts.is_pod());
+    TEST_CHECK(ts.size() == 4);
+    TEST_CHECK(ts.type_id() == value::TypeTraits<value::point3f>::type_id());
+    TEST_CHECK(ts.get_times()[0] == 0.0);
+    TEST_CHECK(ts.get_times()[3] == 3.0);
+    TEST_CHECK(ts.is_blocked(1));
+    TEST_CHECK(!ts.is_blocked(2));
+
+    // role type cast
+    value::float3 f;
+    TEST_CHECK(ts.get(&f, 2.5));
+    TEST_CHECK(math::is_close(f[1], 5.0f));
+
+    // blocked
+    TEST_CHECK(!ts.get(&f, 0.5));
+
+    TEST_CHECK(ts.get(&f, 2.0, value::TimeSampleInterpolationType::Held));
+    TEST_CHECK(math::is_close(f[2], 6.0f));
+
+    value::Value v;
+    TEST_CHECK(ts.get_interpolated_value(2.5, value::TimeSampleInterpolationType::Linear, &v));
+    TEST_CHECK(v.type_id() == value::TypeTraits<value::point3f>::type_id());
+    if (const value::point3f *pv = v.as<value::point3f>()) {
+      TEST_CHECK(math::is_close((*pv)[0], 2.5f));
+    }
+
+    TEST_CHECK(ts.set_sample_at(3.0, value::Value(value::point3f({4.0f, 8.0f, 12.0f}))));
+    TEST_CHECK(ts.get(&f, 3.0));
+    TEST_CHECK(math::is_close(f[0], 4.0f));
+
+    // Type mismatch. Fallback to value::Value storage.
+    ts.add_sample(4, value::Value(std::string("muda")));
+    TEST_CHECK(!ts.is_pod());
+    TEST_CHECK(ts.size() == 5);
+    TEST_CHECK(ts.is_blocked(1));
+    TEST_CHECK(ts.get(&f, 2.5));
+    TEST_CHECK(math::is_close(f[1], 6.0f));
+  }
+
+  {
+    Animatable<double> samples;
+    samples.add_sample(1, 10.0);
+    samples.add_blocked_sample(2);
+    samples.add_sample(0, 0.0);
+
+    const TypedTimeSamples<double> &ts = samples.get_timesamples();
+    TEST_CHECK(ts.size() == 3);
+    TEST_CHECK(ts.get_times()[0] == 0.0);
+    TEST_CHECK(ts.get_values()[1] == 10.0);
+    TEST_CHECK(ts.is_blocked(2));
+
+    double d;
+    TEST_CHECK(samples.get(0.5, &d));
+    TEST_CHECK(math::is_close(d, 5.0));
+  }
+
+  // Cursor lookup must give the same result as binary search.
+  {
+    std::vector<double> times;
+    for (size_t i = 0; i < 100; i++) {
+      times.push_back(double(i) * 0.5);
+    }
+
+    value::TimeSampleCursor cursor;
+    // forward, backward and random jumps.
+    const double queries[] = {-1.0, 0.0, 0.1, 0.5, 0.7, 1.0, 3.2, 3.3, 40.0, 49.5, 100.0, 2.0, 1.9, 0.2, -5.0, 25.25};
+    for (double t : queries) {
+      size_t expected = value::FindHeldTimeSampleIndex(times, t);
+      TEST_CHECK(value::FindHeldTimeSampleIndex(times, t, &cursor) == expected);
+      TEST_CHECK(cursor.index == expected);
+    }
+
+    Animatable<float> samples;
+    for (size_t i = 0; i < times.size(); i++) {
+      samples.add_sample(times[i], float(i));
+    }
+
+    const TypedTimeSamples<float> &ts = samples.get_timesamples();
+    std::vector<double> qtimes;
+    for (size_t i = 0; i < 200; i++) {
+      qtimes.push_back(double(i) * 0.3 - 1.0);
+    }
+
+    std::vector<float> vs;
+    TEST_CHECK(ts.get_many(qtimes, &vs));
+    TEST_CHECK(vs.size() == qtimes.size());
+
+    value::TimeSampleCursor fcursor;
+    for (size_t i = 0; i < qtimes.size(); i++) {
+      float f0, f1;
+      TEST_CHECK(samples.get(qtimes[i], &f0));
+      TEST_CHECK(samples.get(qtimes[i], &f1, value::TimeSampleInterpolationType::Linear, &fcursor));
+      TEST_CHECK(math::is_close(f0, f1));
+      TEST_CHECK(math::is_close(f0, vs[i]));
+    }
+  }
+
   {
     TEST_CHECK(value::IsLerpSupportedType(value::TypeTraits<value::float2>::type_id()));
     TEST_CHECK(value::IsLerpSupportedType(value::TypeTraits<std::vector<value::float2>>::type_id()));
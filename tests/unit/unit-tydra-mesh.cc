@@ -0,0 +1,310 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "unit-tydra-mesh.h"
+#include "tinyusdz.hh"
+#include "tydra/mesh-buffer.hh"
+#include "tydra/render-data.hh"
+
+using namespace tinyusdz;
+
+// Quad with facevarying normals. Normals of the shared vertices(point 0 and 2)
+// differ slightly, as seen in DCC exports.
+static const char *kNoisyQuadUSDA = R"(#usda 1.0
+def Mesh "quad" {
+  int[] faceVertexCounts = [3, 3]
+  int[] faceVertexIndices = [0, 1, 2, 0, 2, 3]
+  point3f[] points = [(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0)]
+  normal3f[] normals = [(0, 0, 1), (0, 0, 1), (0, 0, 1), (0.00001, 0, 1), (0, 0.00001, 1), (0, 0, 1)] (
+    interpolation = "faceVarying"
+  )
+}
+)";
+
+static size_t ConvertAndCountVertices(const Stage &stage, bool weld) {
+  tydra::RenderSceneConverterEnv env(stage);
+  env.mesh_config.compute_tangents_and_binormals = false;
+  env.mesh_config.weld_vertices = weld;
+
+  tydra::RenderSceneConverter converter;
+  tydra::RenderScene scene;
+  bool ret = converter.ConvertToRenderScene(env, &scene);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", converter.GetError().c_str());
+  if (!ret || (scene.meshes.size() != 1)) {
+    return 0;
+  }
+
+  return scene.meshes[0].points.size();
+}
+
+void tydra_mesh_weld_test(void) {
+  Stage stage;
+  std::string warn, err;
+  const std::string usda(kNoisyQuadUSDA);
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  // Bitwise dedup keeps noisy vertices separated.
+  TEST_CHECK(ConvertAndCountVertices(stage, /* weld */ false) == 6);
+
+  // Welded within weld_normal_eps.
+  TEST_CHECK(ConvertAndCountVertices(stage, /* weld */ true) == 4);
+}
+
+// n x n quads grid with shuffled triangles.
+static tydra::RenderMesh ShuffledGridMesh(uint32_t n) {
+  tydra::RenderMesh mesh;
+  for (uint32_t y = 0; y <= n; y++) {
+    for (uint32_t x = 0; x <= n; x++) {
+      mesh.points.push_back({float(x), float(y), 0.0f});
+    }
+  }
+
+  std::vector<std::array<uint32_t, 3>> tris;
+  for (uint32_t y = 0; y < n; y++) {
+    for (uint32_t x = 0; x < n; x++) {
+      uint32_t i0 = y * (n + 1) + x;
+      uint32_t i1 = i0 + 1;
+      uint32_t i2 = i0 + (n + 1) + 1;
+      uint32_t i3 = i0 + (n + 1);
+      tris.push_back({i0, i1, i2});
+      tris.push_back({i0, i2, i3});
+    }
+  }
+
+  uint32_t seed = 12345;
+  for (size_t i = tris.size() - 1; i > 0; i--) {
+    seed = seed * 1664525u + 1013904223u;
+    std::swap(tris[i], tris[seed % (i + 1)]);
+  }
+
+  for (const auto &tri : tris) {
+    mesh.usdFaceVertexIndices.insert(mesh.usdFaceVertexIndices.end(),
+                                     tri.begin(), tri.end());
+    mesh.usdFaceVertexCounts.push_back(3);
+  }
+
+  std::vector<tinyusdz::value::float3> normals(mesh.points.size(),
+                                               {0.0f, 0.0f, 1.0f});
+  mesh.normals.format = tydra::VertexAttributeFormat::Vec3;
+  mesh.normals.variability = tydra::VertexVariability::Vertex;
+  mesh.normals.set_buffer(reinterpret_cast<const uint8_t *>(normals.data()),
+                          normals.size() * sizeof(tinyusdz::value::float3));
+
+  return mesh;
+}
+
+// Sorted list of triangles(each triangle is rotated so that the smallest
+// index comes first).
+static std::vector<std::array<uint32_t, 3>> SortedTriangles(
+    const std::vector<uint32_t> &indices) {
+  std::vector<std::array<uint32_t, 3>> tris;
+  for (size_t t = 0; (t + 2) < indices.size(); t += 3) {
+    std::array<uint32_t, 3> tri = {indices[t], indices[t + 1], indices[t + 2]};
+    while ((tri[0] > tri[1]) || (tri[0] > tri[2])) {
+      std::rotate(tri.begin(), tri.begin() + 1, tri.end());
+    }
+    tris.push_back(tri);
+  }
+  std::sort(tris.begin(), tris.end());
+  return tris;
+}
+
+void tydra_mesh_buffer_test(void) {
+  const tydra::RenderMesh mesh = ShuffledGridMesh(32);
+  const size_t nverts = mesh.points.size();
+
+  tydra::MeshBufferConfig config;
+  config.quantize_normals = true;
+  config.optimize_overdraw = true;
+
+  std::vector<tydra::BufferData> buffers;
+  tydra::MeshBuffers mb;
+  std::string warn, err;
+  bool ret = tydra::BuildMeshBuffers(mesh, config, buffers, &mb, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  TEST_CHECK(mb.vertex_count == nverts);
+  TEST_CHECK(mb.index_type == tydra::ComponentType::UInt16);
+  TEST_CHECK(mb.index_count == mesh.usdFaceVertexIndices.size());
+  TEST_CHECK(mb.primitives.size() == 1);
+  TEST_CHECK(buffers.size() == 2);  // interleaved vertices + indices
+
+  // points(float3) + normals(snorm16x4)
+  TEST_CHECK(mb.attributes.size() == 2);
+  TEST_CHECK(mb.attributes[0].stride == 20);
+  TEST_CHECK(mb.attributes[1].offset == 12);
+  TEST_CHECK(mb.attributes[1].format == tydra::VertexAttributeFormat::Short4);
+  TEST_CHECK(mb.attributes[1].normalized);
+
+  std::vector<uint32_t> indices(mb.index_count);
+  for (size_t i = 0; i < mb.index_count; i++) {
+    uint16_t idx;
+    memcpy(&idx, buffers[size_t(mb.index_buffer_id)].data.data() + 2 * i, 2);
+    indices[i] = idx;
+  }
+
+  // Triangles are preserved after remapping vertices.
+  std::vector<uint32_t> orig_indices(indices.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    orig_indices[i] = mb.vertex_remap[indices[i]];
+  }
+  TEST_CHECK(SortedTriangles(orig_indices) ==
+             SortedTriangles(mesh.usdFaceVertexIndices));
+
+  // Vertices are reordered by first use.
+  uint32_t max_index = 0;
+  bool first_use_order = true;
+  for (uint32_t idx : indices) {
+    if (idx > max_index + 1) {
+      first_use_order = false;
+    }
+    max_index = (std::max)(max_index, idx);
+  }
+  TEST_CHECK(first_use_order);
+
+  float acmr_before =
+      tydra::ComputeACMR(mesh.usdFaceVertexIndices, nverts, 16);
+  float acmr_after = tydra::ComputeACMR(indices, nverts, 16);
+  TEST_CHECK(acmr_after < acmr_before * 0.5f);
+  TEST_MSG("ACMR before %f, after %f", double(acmr_before), double(acmr_after));
+}
+
+// n x n quads wavy grid with vertex texcoords and no normals.
+static std::string WavyGridUSDA(uint32_t n) {
+  std::string counts, indices, points, st;
+  for (uint32_t y = 0; y <= n; y++) {
+    for (uint32_t x = 0; x <= n; x++) {
+      float u = float(x) / float(n);
+      float v = float(y) / float(n);
+      float z = 0.1f * std::sin(7.0f * u) * std::cos(5.0f * v);
+      points += (points.empty() ? "" : ", ") + std::string("(") +
+                std::to_string(u) + ", " + std::to_string(v) + ", " +
+                std::to_string(z) + ")";
+      st += (st.empty() ? "" : ", ") + std::string("(") + std::to_string(u) +
+            ", " + std::to_string(v) + ")";
+    }
+  }
+  for (uint32_t y = 0; y < n; y++) {
+    for (uint32_t x = 0; x < n; x++) {
+      uint32_t i0 = y * (n + 1) + x;
+      counts += (counts.empty() ? "4" : ", 4");
+      indices += (indices.empty() ? "" : ", ") + std::to_string(i0) + ", " +
+                 std::to_string(i0 + 1) + ", " + std::to_string(i0 + n + 2) +
+                 ", " + std::to_string(i0 + n + 1);
+    }
+  }
+
+  return "#usda 1.0\ndef Mesh \"grid\" {\n  int[] faceVertexCounts = [" +
+         counts + "]\n  int[] faceVertexIndices = [" + indices +
+         "]\n  point3f[] points = [" + points +
+         "]\n  texCoord2f[] primvars:st = [" + st +
+         "] (\n    interpolation = \"vertex\"\n  )\n}\n";
+}
+
+static bool ConvertWithTangents(const Stage &stage,
+                                tydra::TangentFrameMode mode, int num_threads,
+                                tydra::RenderMesh *mesh) {
+  tydra::RenderSceneConverterEnv env(stage);
+  env.mesh_config.compute_tangents_and_binormals = true;
+  env.mesh_config.tangent_frame_mode = mode;
+  env.mesh_config.num_threads = num_threads;
+
+  tydra::RenderSceneConverter converter;
+  tydra::RenderScene scene;
+  bool ret = converter.ConvertToRenderScene(env, &scene);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", converter.GetError().c_str());
+  if (!ret || (scene.meshes.size() != 1)) {
+    return false;
+  }
+
+  (*mesh) = std::move(scene.meshes[0]);
+  return true;
+}
+
+void tydra_mesh_tangent_test(void) {
+  Stage stage;
+  std::string warn, err;
+  const std::string usda = WavyGridUSDA(96);
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  for (auto mode : {tydra::TangentFrameMode::Default,
+                    tydra::TangentFrameMode::MikkTSpaceLike}) {
+    tydra::RenderMesh serial, parallel;
+    if (!ConvertWithTangents(stage, mode, 1, &serial) ||
+        !ConvertWithTangents(stage, mode, 4, &parallel)) {
+      return;
+    }
+
+    TEST_CHECK(serial.tangents.vertex_count() == serial.points.size());
+    TEST_CHECK(serial.binormals.vertex_count() == serial.points.size());
+
+    // Results do not depend on the number of threads.
+    TEST_CHECK(serial.points == parallel.points);
+    TEST_CHECK(serial.faceVertexIndices() == parallel.faceVertexIndices());
+    TEST_CHECK(serial.normals.get_data() == parallel.normals.get_data());
+    TEST_CHECK(serial.tangents.get_data() == parallel.tangents.get_data());
+    TEST_CHECK(serial.binormals.get_data() == parallel.binormals.get_data());
+
+    if (mode != tydra::TangentFrameMode::MikkTSpaceLike) {
+      continue;
+    }
+
+    // Orthonormal frame with binormal = +-cross(n, t).
+    std::vector<tydra::vec3> ns(serial.points.size());
+    std::vector<tydra::vec3> ts(ns.size());
+    std::vector<tydra::vec3> bs(ns.size());
+    memcpy(ns.data(), serial.normals.get_data().data(),
+           ns.size() * sizeof(tydra::vec3));
+    memcpy(ts.data(), serial.tangents.get_data().data(),
+           ts.size() * sizeof(tydra::vec3));
+    memcpy(bs.data(), serial.binormals.get_data().data(),
+           bs.size() * sizeof(tydra::vec3));
+
+    size_t num_bad = 0;
+    for (size_t i = 0; i < ns.size(); i++) {
+      const tydra::vec3 &n = ns[i];
+      const tydra::vec3 &t = ts[i];
+      const tydra::vec3 &b = bs[i];
+      float ndott = n[0] * t[0] + n[1] * t[1] + n[2] * t[2];
+      float tlen = std::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+      tydra::vec3 c = {n[1] * t[2] - n[2] * t[1], n[2] * t[0] - n[0] * t[2],
+                       n[0] * t[1] - n[1] * t[0]};
+      float bdotc = b[0] * c[0] + b[1] * c[1] + b[2] * c[2];
+      if ((std::fabs(ndott) > 1e-4f) || (std::fabs(tlen - 1.0f) > 1e-4f) ||
+          (std::fabs(std::fabs(bdotc) - 1.0f) > 1e-3f)) {
+        num_bad++;
+      }
+    }
+    TEST_CHECK(num_bad == 0);
+    TEST_MSG("%d non-orthonormal tangent frames", int(num_bad));
+  }
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void tydra_mesh_weld_test(void);
+void tydra_mesh_buffer_test(void);
+void tydra_mesh_tangent_test(void);
@@ -0,0 +1,144 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "unit-tydra-render-scene.h"
+#include "tinyusdz.hh"
+#include "tydra/render-data.hh"
+
+using namespace tinyusdz;
+
+// Animated Xform and points. `/root/static` is not animated.
+static const char *kAnimatedUSDA = R"(#usda 1.0
+def Xform "root" {
+  double3 xformOp:translate.timeSamples = {
+    0: (0, 0, 0),
+    1: (0, 2, 0),
+  }
+  uniform token[] xformOpOrder = ["xformOp:translate"]
+
+  def Mesh "animated" {
+    int[] faceVertexCounts = [3, 3]
+    int[] faceVertexIndices = [0, 1, 2, 0, 2, 3]
+    point3f[] points.timeSamples = {
+      0: [(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0)],
+      1: [(0, 0, 0), (1, 0, 0), (1, 1, 1), (0, 1, 0)],
+    }
+  }
+
+  def Mesh "static" {
+    int[] faceVertexCounts = [3]
+    int[] faceVertexIndices = [0, 1, 2]
+    point3f[] points = [(0, 0, 0), (1, 0, 0), (1, 1, 0)]
+  }
+}
+)";
+
+static bool Convert(const Stage &stage, double t,
+                    tydra::RenderSceneConverter &converter,
+                    tydra::RenderScene *scene) {
+  tydra::RenderSceneConverterEnv env(stage);
+  env.timecode = t;
+
+  bool ret = converter.ConvertToRenderScene(env, scene);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", converter.GetError().c_str());
+  return ret;
+}
+
+static bool IsSameMatrix(const value::matrix4d &a, const value::matrix4d &b) {
+  return memcmp(&a.m[0][0], &b.m[0][0], sizeof(double) * 16) == 0;
+}
+
+void tydra_render_scene_update_test(void) {
+  Stage stage;
+  std::string warn, err;
+  const std::string usda(kAnimatedUSDA);
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  tydra::RenderSceneConverter converter;
+  tydra::RenderScene scene;
+  if (!Convert(stage, 0.0, converter, &scene)) {
+    return;
+  }
+
+  // Reference: full conversion at t = 1
+  tydra::RenderSceneConverter ref_converter;
+  tydra::RenderScene ref_scene;
+  if (!Convert(stage, 1.0, ref_converter, &ref_scene)) {
+    return;
+  }
+
+  tydra::RenderSceneConverterEnv env(stage);
+  tydra::RenderSceneUpdateInfo info;
+  ret = converter.UpdateRenderScene(env, 1.0, &scene, &info);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", converter.GetError().c_str());
+  if (!ret) {
+    return;
+  }
+
+  // Updated scene matches the full conversion.
+  TEST_CHECK(scene.meshes.size() == ref_scene.meshes.size());
+  for (size_t i = 0; i < scene.meshes.size(); i++) {
+    TEST_CHECK(scene.meshes[i].points == ref_scene.meshes[i].points);
+    TEST_CHECK(scene.meshes[i].normals.get_data() ==
+               ref_scene.meshes[i].normals.get_data());
+  }
+
+  TEST_CHECK(scene.nodes.size() == 1);
+  TEST_CHECK(ref_scene.nodes.size() == 1);
+  if ((scene.nodes.size() != 1) || (ref_scene.nodes.size() != 1)) {
+    return;
+  }
+  const tydra::Node &root = scene.nodes[0];
+  const tydra::Node &ref_root = ref_scene.nodes[0];
+  TEST_CHECK(IsSameMatrix(root.local_matrix, ref_root.local_matrix));
+  TEST_CHECK(IsSameMatrix(root.global_matrix, ref_root.global_matrix));
+  TEST_CHECK(root.children.size() == ref_root.children.size());
+  for (size_t i = 0; i < root.children.size(); i++) {
+    TEST_CHECK(IsSameMatrix(root.children[i].global_matrix,
+                            ref_root.children[i].global_matrix));
+  }
+
+  // Global matrix of all nodes are changed by the parent's translation.
+  TEST_CHECK(info.nodes.size() == 3);
+  TEST_CHECK(std::find(info.nodes.begin(), info.nodes.end(), "/root") !=
+             info.nodes.end());
+
+  // Only the animated mesh is updated. One point is moved.
+  TEST_CHECK(info.meshes.size() == 1);
+  if (info.meshes.size() != 1) {
+    return;
+  }
+  const tydra::RenderMeshUpdate &update = info.meshes[0];
+  TEST_CHECK(scene.meshes[size_t(update.mesh_id)].abs_path ==
+             "/root/animated");
+  TEST_CHECK(!update.topology_changed);
+  TEST_CHECK(update.dirty_ranges.count("points") == 1);
+  TEST_CHECK(update.dirty_ranges.count("normals") == 1);
+  if (update.dirty_ranges.count("points")) {
+    TEST_CHECK(update.dirty_ranges.at("points").length ==
+               sizeof(tydra::vec3));
+  }
+
+  // No change at the same time.
+  ret = converter.UpdateRenderScene(env, 1.0, &scene, &info);
+  TEST_CHECK(ret);
+  TEST_CHECK(info.nodes.empty());
+  TEST_CHECK(info.meshes.empty());
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void tydra_render_scene_update_test(void);
@@ -0,0 +1,116 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <cstdint>
+#include <string>
+
+#include "unit-usda-reader.h"
+#include "pprinter.hh"
+#include "stage.hh"
+#include "stream-reader.hh"
+#include "usda-reader.hh"
+
+using namespace tinyusdz;
+
+namespace {
+
+struct ReadResult {
+  bool ret{false};
+  std::string scene;
+  std::string warn;
+  std::string err;
+};
+
+// Toplevel Prims with parser warnings(unsupported `bindMaterialAs`) and
+// reconstruction warnings, and a Stage meta warning(unknown `upAxis`).
+std::string MakeUSDA(const int num_prims, const int broken_prim) {
+  std::string s = "#usda 1.0\n(\n  upAxis = \"W\"\n)\n\n";
+  for (int i = 0; i < num_prims; i++) {
+    std::string name = "prim" + std::to_string(i);
+    s += "def Xform \"" + name + "\" {\n";
+    s += "  rel material:binding = </mat" + std::to_string(i) +
+         "> (\n    bindMaterialAs = \"bora" + std::to_string(i) + "\"\n  )\n";
+    s += "  def Mesh \"mesh\" {\n";
+    s += "    float3[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0)]\n";
+    s += "    int[] faceVertexCounts = [3]\n";
+    s += "    int[] faceVertexIndices = [0, 1, 2]\n";
+    if (i == broken_prim) {
+      s += "    int bora = \n";
+    }
+    s += "  }\n";
+    s += "  def Muda \"muda\" {\n  }\n";
+    s += "}\n\n";
+  }
+  return s;
+}
+
+ReadResult Read(const std::string &usda, const int num_threads,
+                const bool as_primspec) {
+  ReadResult result;
+
+  StreamReader sr(reinterpret_cast<const uint8_t *>(usda.data()), usda.size(),
+                  /* swap endian */ false);
+  usda::USDAReader reader(&sr);
+
+  usda::USDAReaderConfig config;
+  config.num_threads = num_threads;
+  config.min_parallel_parse_bytes = 0;
+  reader.set_reader_config(config);
+
+  result.ret = reader.read(static_cast<uint32_t>(LoadState::Toplevel),
+                           as_primspec);
+  if (result.ret) {
+    if (as_primspec) {
+      Layer layer;
+      result.ret = reader.get_as_layer(&layer);
+      result.scene = to_string(layer);
+    } else {
+      result.ret = reader.reconstruct_stage();
+      result.scene = to_string(reader.get_stage());
+    }
+  }
+
+  result.warn = reader.get_warning();
+  result.err = reader.get_error();
+
+  return result;
+}
+
+void CheckParallelRead(const std::string &usda, const bool expected_ret) {
+  for (const bool as_primspec : {true, false}) {
+    const ReadResult expected = Read(usda, /* num_threads */ 1, as_primspec);
+    TEST_CHECK(expected.ret == expected_ret);
+    TEST_MSG("%s", expected.err.c_str());
+    TEST_CHECK(expected.warn.find("bora0") != std::string::npos);
+    TEST_MSG("%s", expected.warn.c_str());
+
+    for (int num_threads : {2, 4, 8}) {
+      const ReadResult result = Read(usda, num_threads, as_primspec);
+      TEST_CHECK(expected.ret == result.ret);
+      TEST_MSG("num_threads %d", num_threads);
+      TEST_CHECK(expected.scene == result.scene);
+      TEST_MSG("num_threads %d\nexpected:\n%s\ngot:\n%s", num_threads,
+               expected.scene.c_str(), result.scene.c_str());
+      TEST_CHECK(expected.warn == result.warn);
+      TEST_MSG("num_threads %d\nexpected:\n%s\ngot:\n%s", num_threads,
+               expected.warn.c_str(), result.warn.c_str());
+      TEST_CHECK(expected.err == result.err);
+      TEST_MSG("num_threads %d\nexpected:\n%s\ngot:\n%s", num_threads,
+               expected.err.c_str(), result.err.c_str());
+    }
+  }
+}
+
+}  // namespace
+
+void usda_reader_parallel_test(void) {
+  // Serial and parallel parsing give the same scene, warnings and errors.
+  CheckParallelRead(MakeUSDA(32, /* broken_prim */ -1), true);
+
+  // Syntax error in the middle of the input.
+  CheckParallelRead(MakeUSDA(32, /* broken_prim */ 17), false);
+}
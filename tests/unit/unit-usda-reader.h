@@ -0,0 +1,3 @@
+#pragma once
+
+void usda_reader_parallel_test(void);
@@ -0,0 +1,225 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "unit-usdc-reader.h"
+#include "prim-types.hh"
+#include "stage.hh"
+#include "stream-reader.hh"
+#include "tinyusdz.hh"
+#include "usdGeom.hh"
+#include "usdc-reader.hh"
+#include "usdc-writer.hh"
+
+using namespace tinyusdz;
+
+namespace {
+
+bool USDAToUSDC(const std::string &usda, std::vector<uint8_t> *usdc) {
+  Layer layer;
+  std::string warn, err;
+  if (!LoadLayerFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                           usda.size(), "test.usda", &layer, &warn, &err)) {
+    return false;
+  }
+
+  return usdc::SaveAsUSDCToMemory(layer, usdc, &warn, &err);
+}
+
+bool ReadUSDC(const std::vector<uint8_t> &usdc,
+              const usdc::USDCReaderConfig &config) {
+  StreamReader sr(usdc.data(), usdc.size(), /* swap_endian */ false);
+  usdc::USDCReader reader(&sr, config);
+  return reader.ReadUSDC();
+}
+
+bool LoadUSDCStage(const std::vector<uint8_t> &usdc,
+                   const USDLoadOptions &options, Stage *stage) {
+  std::string warn, err;
+  bool ret = LoadUSDCFromMemory(usdc.data(), usdc.size(), "test.usdc", stage,
+                                &warn, &err, options);
+  TEST_MSG("%s", err.c_str());
+  return ret;
+}
+
+const GeomMesh *GetMesh(const Stage &stage) {
+  auto ret = stage.GetPrimAtPath(Path("/mesh", ""));
+  if (!ret) {
+    return nullptr;
+  }
+  return ret.value()->as<GeomMesh>();
+}
+
+template <typename T>
+bool GetScalar(const TypedAttribute<Animatable<T>> &attr, T *v) {
+  Animatable<T> anim;
+  return attr.get_value(&anim) && anim.get_scalar(v);
+}
+
+template <typename T>
+bool SameBytes(const std::vector<T> &a, const std::vector<T> &b) {
+  return (a.size() == b.size()) &&
+         (a.empty() || (memcmp(a.data(), b.data(), sizeof(T) * a.size()) == 0));
+}
+
+}  // namespace
+
+void usdc_reader_deferred_value_test(void) {
+  std::string points = "[";
+  std::string normals = "[";
+  std::string indices = "[";
+  for (size_t i = 0; i < 64; i++) {
+    points += (i > 0) ? ", " : "";
+    points += "(" + std::to_string(i) + ", " + std::to_string(i * 2) + ", " +
+              std::to_string(0.5 * double(i)) + ")";
+    normals += (i > 0) ? ", " : "";
+    normals += (i % 2) ? "(0, 1, 0)" : "(1, 0, 0)";
+    indices += (i > 0) ? ", " : "";
+    indices += std::to_string((i * 7) % 64);
+  }
+  points += "]";
+  normals += "]";
+  indices += "]";
+
+  std::string usda = "#usda 1.0\n";
+  usda += "def Mesh \"mesh\" {\n";
+  usda += "  point3f[] points = " + points + "\n";
+  usda += "  int[] faceVertexIndices = " + indices + "\n";
+  usda += "  normal3f[] normals.timeSamples = {0: " + normals + ", 1: " +
+          normals + "}\n";
+  usda += "  float3[] primvars:rest = " + points + "\n";
+  usda += "}\n";
+
+  std::vector<uint8_t> usdc;
+  TEST_CHECK(USDAToUSDC(usda, &usdc));
+
+  Stage eager_stage;
+  TEST_CHECK(LoadUSDCStage(usdc, USDLoadOptions(), &eager_stage));
+  const GeomMesh *eager_mesh = GetMesh(eager_stage);
+  TEST_CHECK(eager_mesh != nullptr);
+  if (!eager_mesh) {
+    return;
+  }
+  TEST_CHECK(!eager_mesh->points.has_deferred_value());
+
+  // In-memory input without `input_data_holder` is decoded at load time.
+  {
+    USDLoadOptions options;
+    options.defer_value_loading = true;
+
+    Stage stage;
+    TEST_CHECK(LoadUSDCStage(usdc, options, &stage));
+    const GeomMesh *mesh = GetMesh(stage);
+    TEST_CHECK(mesh != nullptr);
+    if (mesh) {
+      TEST_CHECK(!mesh->points.has_deferred_value());
+    }
+  }
+
+  auto buf = std::make_shared<std::vector<uint8_t>>(usdc);
+
+  USDLoadOptions options;
+  options.defer_value_loading = true;
+  options.input_data_holder = buf;
+
+  Stage stage;
+  TEST_CHECK(LoadUSDCStage(*buf, options, &stage));
+  const GeomMesh *mesh = GetMesh(stage);
+  TEST_CHECK(mesh != nullptr);
+  if (!mesh) {
+    return;
+  }
+
+  // Schema attributes are decoded on access.
+  TEST_CHECK(mesh->points.has_deferred_value());
+  TEST_CHECK(mesh->faceVertexIndices.has_deferred_value());
+  TEST_CHECK(mesh->normals.has_deferred_value());
+
+  // Type of the generic attribute is known without decoding.
+  TEST_CHECK(mesh->props.count("primvars:rest") == 1);
+  const primvar::PrimVar &rest =
+      mesh->props.at("primvars:rest").get_attribute().get_var();
+  TEST_CHECK(rest.has_deferred_value());
+  TEST_CHECK(rest.type_name() == "float3[]");
+  TEST_CHECK(!rest._deferred_value->is_loaded());
+
+  // Loaded attributes keep the input memory alive.
+  options.input_data_holder.reset();
+  buf.reset();
+
+  std::vector<value::point3f> eager_points, deferred_points;
+  TEST_CHECK(GetScalar(eager_mesh->points, &eager_points));
+  TEST_CHECK(GetScalar(mesh->points, &deferred_points));
+  TEST_CHECK(deferred_points.size() == 64);
+  TEST_CHECK(SameBytes(eager_points, deferred_points));
+
+  std::vector<int32_t> eager_indices, deferred_indices;
+  TEST_CHECK(GetScalar(eager_mesh->faceVertexIndices, &eager_indices));
+  TEST_CHECK(GetScalar(mesh->faceVertexIndices, &deferred_indices));
+  TEST_CHECK(SameBytes(eager_indices, deferred_indices));
+
+  Animatable<std::vector<value::normal3f>> eager_normals, deferred_normals;
+  TEST_CHECK(eager_mesh->normals.get_value(&eager_normals));
+  TEST_CHECK(mesh->normals.get_value(&deferred_normals));
+  TEST_CHECK(deferred_normals.get_timesamples().size() == 2);
+  for (double t : {0.0, 1.0}) {
+    std::vector<value::normal3f> a, b;
+    TEST_CHECK(eager_normals.get(t, &a));
+    TEST_CHECK(deferred_normals.get(t, &b));
+    TEST_CHECK(b.size() == 64);
+    TEST_CHECK(SameBytes(a, b));
+  }
+
+  auto rest_value = rest.get_value<std::vector<value::float3>>();
+  TEST_CHECK(rest_value.has_value());
+  TEST_CHECK(rest._deferred_value->is_loaded());
+  if (rest_value) {
+    TEST_CHECK(rest_value.value().size() == 64);
+  }
+}
+
+void usdc_reader_memory_budget_test(void) {
+  // 16 Prims share the same 256 KB array. Crate stores the array once, but
+  // each Prim gets its own copy when loaded.
+  std::string values = "[";
+  for (size_t i = 0; i < 65536; i++) {
+    values += (i > 0) ? ", " : "";
+    values += std::to_string(i % 10);
+  }
+  values += "]";
+
+  std::string usda = "#usda 1.0\n";
+  for (int i = 0; i < 16; i++) {
+    usda += "def Xform \"prim" + std::to_string(i) + "\" {\n";
+    // `displayName` makes the fieldset of each attribute distinct.
+    usda += "  float[] values = " + values + " (\n";
+    usda += "    displayName = \"" + std::to_string(i) + "\"\n  )\n";
+    usda += "}\n";
+  }
+
+  std::vector<uint8_t> usdc;
+  TEST_CHECK(USDAToUSDC(usda, &usdc));
+
+  for (int num_threads : {1, 4}) {
+    usdc::USDCReaderConfig config;
+    config.numThreads = num_threads;
+
+    config.kMaxAllowedMemoryInMB = 64;
+    TEST_CHECK(ReadUSDC(usdc, config));
+    TEST_MSG("num_threads %d", num_threads);
+
+    // A single copy fits in the budget, but all copies do not.
+    config.kMaxAllowedMemoryInMB = 2;
+    TEST_CHECK(!ReadUSDC(usdc, config));
+    TEST_MSG("num_threads %d", num_threads);
+  }
+}
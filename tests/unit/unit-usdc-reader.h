@@ -0,0 +1,4 @@
+#pragma once
+
+void usdc_reader_memory_budget_test(void);
+void usdc_reader_deferred_value_test(void);
@@ -0,0 +1,413 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "unit-usdc-writer.h"
+#include "pprinter.hh"
+#include "tinyusdz.hh"
+#include "usdc-writer.hh"
+#include "stage.hh"
+
+using namespace tinyusdz;
+
+static bool LoadUSDALayer(const std::string &usda, Layer *layer) {
+  std::string warn, err;
+  bool ret = LoadLayerFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                 usda.size(), "test.usda", layer, &warn, &err);
+  TEST_MSG("%s", err.c_str());
+  return ret;
+}
+
+// USDA -> Layer -> USDC -> Layer must give the same Layer.
+static void CheckRoundTrip(const std::string &usda) {
+  Layer layer;
+  TEST_CHECK(LoadUSDALayer(usda, &layer));
+
+  std::vector<uint8_t> usdc;
+  std::string warn, err;
+  bool ret = usdc::SaveAsUSDCToMemory(layer, &usdc, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  Layer layer2;
+  warn.clear();
+  err.clear();
+  ret = LoadLayerFromMemory(usdc.data(), usdc.size(), "test.usdc", &layer2,
+                            &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  TEST_CHECK(to_string(layer) == to_string(layer2));
+  TEST_MSG("expected:\n%s\ngot:\n%s", to_string(layer).c_str(),
+           to_string(layer2).c_str());
+}
+
+// USDA -> Stage -> USDC -> Stage must give the same Stage.
+static void CheckStageRoundTrip(const std::string &usda) {
+  Stage stage;
+  std::string warn, err;
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "test.usda", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  std::vector<uint8_t> usdc;
+  ret = usdc::SaveAsUSDCToMemory(stage, &usdc, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  Stage stage2;
+  ret = LoadUSDCFromMemory(usdc.data(), usdc.size(), "test.usdc", &stage2,
+                           &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  TEST_CHECK(stage.ExportToString() == stage2.ExportToString());
+  TEST_MSG("expected:\n%s\ngot:\n%s", stage.ExportToString().c_str(),
+           stage2.ExportToString().c_str());
+}
+
+static std::string FloatArrayLayer(const std::vector<float> &v) {
+  std::string s = "#usda 1.0\ndef \"a\"\n{\n    float[] p = [";
+  for (size_t i = 0; i < v.size(); i++) {
+    if (i > 0) {
+      s += ", ";
+    }
+    s += std::to_string(v[i]);
+  }
+  s += "]\n}\n";
+  return s;
+}
+
+void usdc_writer_test(void) {
+  // Layer metadataum, Prim hierarchy and basic types.
+  CheckRoundTrip(R"(#usda 1.0
+(
+    defaultPrim = "root"
+    metersPerUnit = 0.01
+    upAxis = "Z"
+    doc = "usdc writer test"
+)
+
+def Xform "root" (
+    kind = "component"
+    customData = {
+        int mycount = 3
+        string myname = "bora"
+    }
+)
+{
+    double3 xformOp:translate = (1.5, 2, 300000.1)
+    uniform token[] xformOpOrder = ["xformOp:translate"]
+
+    def Mesh "mesh" (
+        prepend apiSchemas = ["MaterialBindingAPI"]
+    )
+    {
+        int[] faceVertexCounts = [3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3]
+        int[] faceVertexIndices = [0, 1, 2]
+        point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1.5, 0)]
+        float3[] extent = [(0, 0, 0), (1, 1.5, 0)]
+        texCoord2f[] primvars:st = [(0, 0), (1, 0), (0, 1)] (
+            interpolation = "vertex"
+        )
+        uniform bool doubleSided = 1
+        uniform token subdivisionScheme = "none"
+        rel material:binding = </root/mat>
+    }
+
+    def Material "mat"
+    {
+        token outputs:surface.connect = </root/mat/shader.outputs:surface>
+
+        def Shader "shader"
+        {
+            uniform token info:id = "UsdPreviewSurface"
+            color3f inputs:diffuseColor = (0.1, 0.2, 0.3)
+            float inputs:roughness = 0.5
+            token outputs:surface
+        }
+    }
+}
+)");
+
+  // timeSamples, references and inherits.
+  CheckRoundTrip(R"(#usda 1.0
+
+class "base"
+{
+    over "ref" (
+        prepend references = @./ref.usda@</model>
+        inherits = </base>
+    )
+    {
+        float radius.timeSamples = {
+            0: 1,
+            1.5: 2.5,
+            2: None,
+        }
+        string mystr = "hello"
+        asset tex = @image.png@
+    }
+}
+)");
+
+  // Identical value data must be stored once.
+  {
+    std::string usda = R"(#usda 1.0
+def "a"
+{
+    float3[] p0 = [(0.1, 0.2, 0.3), (0.4, 0.5, 0.6), (0.7, 0.8, 0.9)]
+    float3[] p1 = [(0.1, 0.2, 0.3), (0.4, 0.5, 0.6), (0.7, 0.8, 0.9)]
+}
+)";
+
+    std::string usda2 = R"(#usda 1.0
+def "a"
+{
+    float3[] p0 = [(0.1, 0.2, 0.3), (0.4, 0.5, 0.6), (0.7, 0.8, 0.9)]
+    float3[] p1 = [(0.1, 0.2, 0.3), (0.4, 0.5, 0.6), (0.7, 0.8, 1.9)]
+}
+)";
+
+    Layer layer, layer2;
+    TEST_CHECK(LoadUSDALayer(usda, &layer));
+    TEST_CHECK(LoadUSDALayer(usda2, &layer2));
+
+    std::vector<uint8_t> usdc, usdc2;
+    std::string warn, err;
+    TEST_CHECK(usdc::SaveAsUSDCToMemory(layer, &usdc, &warn, &err));
+    TEST_CHECK(usdc::SaveAsUSDCToMemory(layer2, &usdc2, &warn, &err));
+
+    // `p1` in `usda2` needs its own array data(8(array size) + 9 floats).
+    TEST_CHECK(usdc2.size() >= (usdc.size() + 8 + sizeof(float) * 9));
+  }
+
+  // Float array compression: integer-valued('i'), lookup table('t') and
+  // uncompressed(random) data.
+  {
+    const size_t n = 256;
+    std::vector<float> ints(n), lut(n), randoms(n);
+    uint32_t seed = 7;
+    for (size_t i = 0; i < n; i++) {
+      ints[i] = float(int(i) - 100);
+      lut[i] = 0.25f * float(i % 5);
+      seed = seed * 1664525u + 1013904223u;
+      randoms[i] = float(seed >> 8) / float(1u << 24);
+    }
+
+    std::vector<size_t> sizes;
+    for (const auto *v : {&ints, &lut, &randoms}) {
+      std::string usda = FloatArrayLayer(*v);
+      CheckRoundTrip(usda);
+
+      Layer layer;
+      TEST_CHECK(LoadUSDALayer(usda, &layer));
+      std::vector<uint8_t> usdc;
+      std::string warn, err;
+      TEST_CHECK(usdc::SaveAsUSDCToMemory(layer, &usdc, &warn, &err));
+      sizes.push_back(usdc.size());
+    }
+
+    // Compressed arrays must be smaller than raw float data.
+    TEST_CHECK(sizes[0] + n * sizeof(float) / 2 < sizes[2]);
+    TEST_MSG("int: %d, random: %d", int(sizes[0]), int(sizes[2]));
+    TEST_CHECK(sizes[1] + n * sizeof(float) / 2 < sizes[2]);
+    TEST_MSG("lut: %d, random: %d", int(sizes[1]), int(sizes[2]));
+  }
+
+  // Prim and property metadata.
+  CheckRoundTrip(R"(#usda 1.0
+
+def Xform "root" (
+    doc = "root prim"
+    hidden = true
+    active = false
+    displayName = "Root"
+)
+{
+    float radius = 1 (
+        doc = "radius of the sphere"
+        customData = {
+            string author = "bora"
+        }
+    )
+    asset tex = @image.png@ (
+        colorSpace = "raw"
+    )
+    int[] primvars:ids = [1, 2] (
+        displayName = "IDs"
+        elementSize = 2
+        unauthoredValuesIndex = -1
+    )
+}
+)");
+
+  // variantSets
+  CheckRoundTrip(R"(#usda 1.0
+
+def Xform "root" (
+    variants = {
+        string shapeVariant = "sphere"
+    }
+    prepend variantSets = ["shapeVariant", "colorVariant"]
+)
+{
+    variantSet "shapeVariant" = {
+        "cube" (
+            doc = "cube variant"
+        ) {
+            float size = 2
+
+            def Cube "shape"
+            {
+                double size = 3
+            }
+        }
+        "sphere" {
+            def Sphere "shape"
+            {
+                double radius = 1.5
+
+                def Scope "child"
+                {
+                }
+            }
+        }
+    }
+    variantSet "colorVariant" = {
+        "red" {
+            color3f color = (1, 0, 0)
+        }
+    }
+}
+)");
+
+  // Stage is directly converted to PrimSpecs.
+  CheckStageRoundTrip(R"(#usda 1.0
+(
+    defaultPrim = "root"
+    upAxis = "Y"
+)
+
+def Xform "root" (
+    kind = "component"
+)
+{
+    double3 xformOp:translate = (1, 2, 3)
+    float xformOp:rotateY.timeSamples = {
+        0: 0,
+        10: 90,
+    }
+    uniform token[] xformOpOrder = ["xformOp:translate", "xformOp:rotateY"]
+
+    def Mesh "mesh" (
+        prepend apiSchemas = ["MaterialBindingAPI"]
+    )
+    {
+        int[] faceVertexCounts = [3]
+        int[] faceVertexIndices = [0, 1, 2]
+        point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0)]
+        float3[] extent = [(0, 0, 0), (1, 1, 0)]
+        normal3f[] normals = [(0, 0, 1), (0, 0, 1), (0, 0, 1)] (
+            interpolation = "vertex"
+        )
+        texCoord2f[] primvars:st = [(0, 0), (1, 0), (0, 1)] (
+            interpolation = "vertex"
+        )
+        uniform token subdivisionScheme = "none"
+        token visibility = "invisible"
+        rel material:binding = </root/mat>
+
+        def GeomSubset "subset"
+        {
+            uniform token elementType = "face"
+            uniform token familyName = "materialBind"
+            int[] indices = [0]
+        }
+    }
+
+    def Camera "cam"
+    {
+        float focalLength = 35
+        float2 clippingRange = (0.1, 1000)
+        token projection = "perspective"
+    }
+
+    def SphereLight "light"
+    {
+        float inputs:intensity = 10
+        float inputs:radius = 0.5
+        color3f inputs:color = (1, 0.5, 0.25)
+    }
+
+    def Material "mat"
+    {
+        token outputs:surface.connect = </root/mat/shader.outputs:surface>
+
+        def Shader "shader"
+        {
+            uniform token info:id = "UsdPreviewSurface"
+            color3f inputs:diffuseColor.connect = </root/mat/tex.outputs:rgb>
+            float inputs:roughness = 0.5
+            float inputs:displacement = 0.1
+            token outputs:surface
+        }
+
+        def Shader "tex"
+        {
+            uniform token info:id = "UsdUVTexture"
+            asset inputs:file = @image.png@
+            token inputs:wrapS = "repeat"
+            float2 inputs:st.connect = </root/mat/reader.outputs:result>
+            float3 outputs:rgb
+        }
+
+        def Shader "reader"
+        {
+            uniform token info:id = "UsdPrimvarReader_float2"
+            string inputs:varname = "st"
+            float2 outputs:result
+        }
+    }
+
+    def "generic" (
+        variants = {
+            string v = "a"
+        }
+        prepend variantSets = "v"
+    )
+    {
+        custom int myval = 3
+
+        variantSet "v" = {
+            "a" {
+                int val = 1
+            }
+        }
+    }
+}
+)");
+}
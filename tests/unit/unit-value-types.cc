@@ -5,8 +5,11 @@
 #define TEST_NO_MAIN
 #include "acutest.h"
 
+#include <atomic>
+
 #include "unit-value-types.h"
 #include "value-types.hh"
+#include "thread-util.hh"
 #include "math-util.inc"
 
 using namespace tinyusdz;
@@ -41,3 +44,37 @@ void value_types_test(void) {
 
 }
 
+
+void token_intern_test(void) {
+#if !defined(TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE)
+  value::token tok1("faceVarying");
+  value::token tok2(std::string("faceVarying"));
+  TEST_CHECK(tok1.entry() == tok2.entry());
+  TEST_CHECK(tok1.hash() == tok2.hash());
+  TEST_CHECK(tok1.str() == "faceVarying");
+
+  value::token empty_tok("");
+  TEST_CHECK(!empty_tok.valid());
+  TEST_CHECK(empty_tok == value::token());
+  TEST_CHECK(empty_tok.str().empty());
+
+  TEST_CHECK(value::token("bora") < value::token("dora"));
+
+  // Intern from multiple threads. The table grows while being read.
+  const size_t n = 4096;
+  std::vector<value::token> toks(n);
+  thread_util::ParallelFor(0, n, /* num_threads */ 8, [&](size_t i) {
+    toks[i] = value::token("intern_test_" + std::to_string(i % 1024));
+  });
+
+  std::atomic<size_t> nmatched{0};
+  thread_util::ParallelFor(0, n, /* num_threads */ 8, [&](size_t i) {
+    value::token tok("intern_test_" + std::to_string(i % 1024));
+    if ((tok.entry() == toks[i].entry()) &&
+        (tok.str() == "intern_test_" + std::to_string(i % 1024))) {
+      nmatched++;
+    }
+  });
+  TEST_CHECK(nmatched == n);
+#endif
+}
@@ -1,3 +1,4 @@
 #pragma once
 
 void value_types_test(void);
+void token_intern_test(void);